@@ -0,0 +1,59 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <Eina.h>
+#include <Ecore_Evas.h>
+#include <Edje.h>
+
+#include "edje_bench.h"
+
+typedef struct _Edje_Benchmark_Case Edje_Benchmark_Case;
+struct _Edje_Benchmark_Case
+{
+   const char *bench_case;
+   void (*build)(Eina_Benchmark *bench);
+   void (*shutdown)(void);
+};
+
+static const Edje_Benchmark_Case etc[] = {
+   { "Recalc", edje_bench_recalc, edje_bench_recalc_shutdown },
+   { "Signal", edje_bench_signal, edje_bench_signal_shutdown },
+   { NULL, NULL, NULL }
+};
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+   unsigned int i;
+
+   if (argc != 2)
+      return -1;
+
+   ecore_evas_init();
+   edje_init();
+
+   for (i = 0; etc[i].bench_case; ++i)
+     {
+        test = eina_benchmark_new(etc[i].bench_case, argv[1]);
+        if (!test)
+           continue;
+
+        etc[i].build(test);
+
+        eina_benchmark_run(test);
+
+        eina_benchmark_free(test);
+
+        if (etc[i].shutdown) etc[i].shutdown();
+     }
+
+   edje_shutdown();
+   ecore_evas_shutdown();
+
+   return 0;
+}
@@ -0,0 +1,9 @@
+#ifndef EDJE_BENCH_H_
+#define EDJE_BENCH_H_
+
+void edje_bench_recalc(Eina_Benchmark *bench);
+void edje_bench_recalc_shutdown(void);
+void edje_bench_signal(Eina_Benchmark *bench);
+void edje_bench_signal_shutdown(void);
+
+#endif
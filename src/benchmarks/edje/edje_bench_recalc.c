@@ -0,0 +1,142 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <Ecore_Evas.h>
+
+#include "edje_private.h"
+#include "edje_bench.h"
+
+/* Time to handle a signal that toggles a state on groups of the default
+ * theme, including the recalc it causes. The theme can be changed with
+ * EDJE_BENCH_FILE, how many parts each signal recalculates is printed once
+ * when the groups are loaded. */
+#define THEME_FILE PACKAGE_BUILD_DIR "/data/elementary/themes/default.edj"
+
+typedef struct _Edje_Bench_Group Edje_Bench_Group;
+
+struct _Edje_Bench_Group
+{
+   const char *name;
+   const char *on;
+   const char *off;
+   const char *source;
+   Evas_Object *obj;
+};
+
+static Edje_Bench_Group groups[] = {
+   { "elm/genlist/item/default/default", "elm,state,selected", "elm,state,unselected", "elm", NULL },
+   { "elm/list/item/default", "elm,state,selected", "elm,state,unselected", "elm", NULL },
+   { "elm/button/base/default", "elm,state,disabled", "elm,state,enabled", "elm", NULL },
+   { NULL, NULL, NULL, NULL, NULL }
+};
+
+static Ecore_Evas *ee = NULL;
+
+static unsigned int
+_bench_signal(Edje_Bench_Group *group, const char *signal)
+{
+   Edje *ed;
+
+   edje_object_signal_emit(group->obj, signal, group->source);
+   edje_message_signal_process();
+   evas_smart_objects_calculate(ecore_evas_get(ee));
+
+   ed = efl_data_scope_get(group->obj, EFL_CANVAS_LAYOUT_CLASS);
+   return ed->recalc_count;
+}
+
+static void
+_bench_group(int request, Edje_Bench_Group *group)
+{
+   int i;
+
+   if (!group->obj) return;
+
+   for (i = 0; i < request; i++)
+     {
+        _bench_signal(group, group->on);
+        _bench_signal(group, group->off);
+     }
+}
+
+static void
+edje_bench_recalc_genlist_item(int request)
+{
+   _bench_group(request, &groups[0]);
+}
+
+static void
+edje_bench_recalc_list_item(int request)
+{
+   _bench_group(request, &groups[1]);
+}
+
+static void
+edje_bench_recalc_button(int request)
+{
+   _bench_group(request, &groups[2]);
+}
+
+void
+edje_bench_recalc(Eina_Benchmark *bench)
+{
+   const char *file;
+   unsigned int i;
+
+   file = getenv("EDJE_BENCH_FILE");
+   if (!file) file = THEME_FILE;
+
+   ee = ecore_evas_buffer_new(480, 800);
+   if (!ee) return;
+
+   for (i = 0; groups[i].name; i++)
+     {
+        Evas_Object *obj;
+        unsigned int on, off;
+        Edje *ed;
+
+        obj = edje_object_add(ecore_evas_get(ee));
+        if (!edje_object_file_set(obj, file, groups[i].name))
+          {
+             fprintf(stderr, "Could not load %s from %s\n", groups[i].name, file);
+             evas_object_del(obj);
+             continue;
+          }
+
+        /* Transitions would only be recalculated from the animator */
+        edje_object_animation_set(obj, EINA_FALSE);
+        evas_object_resize(obj, 480, 64);
+        evas_object_show(obj);
+        evas_smart_objects_calculate(ecore_evas_get(ee));
+        groups[i].obj = obj;
+
+        ed = efl_data_scope_get(obj, EFL_CANVAS_LAYOUT_CLASS);
+        on = _bench_signal(&groups[i], groups[i].on);
+        off = _bench_signal(&groups[i], groups[i].off);
+        printf("%s: %u parts, %u recalculated on %s, %u on %s\n",
+               groups[i].name, ed->table_parts_size,
+               on, groups[i].on, off, groups[i].off);
+     }
+
+   eina_benchmark_register(bench, "genlist-item", EINA_BENCHMARK(edje_bench_recalc_genlist_item), 100, 2000, 200);
+   eina_benchmark_register(bench, "list-item", EINA_BENCHMARK(edje_bench_recalc_list_item), 100, 2000, 200);
+   eina_benchmark_register(bench, "button", EINA_BENCHMARK(edje_bench_recalc_button), 100, 2000, 200);
+}
+
+void
+edje_bench_recalc_shutdown(void)
+{
+   unsigned int i;
+
+   for (i = 0; groups[i].name; i++)
+     {
+        if (groups[i].obj) evas_object_del(groups[i].obj);
+        groups[i].obj = NULL;
+     }
+   if (ee) ecore_evas_free(ee);
+   ee = NULL;
+}
@@ -0,0 +1,133 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <Ecore_Evas.h>
+#include <Edje.h>
+
+#include "edje_bench.h"
+
+/* Signals handled per second by a genlist item of the default theme, with
+ * a few glob callbacks like the ones widgets add on their layout. The
+ * theme can be changed with EDJE_BENCH_FILE. */
+#define THEME_FILE PACKAGE_BUILD_DIR "/data/elementary/themes/default.edj"
+#define GROUP "elm/genlist/item/default/default"
+
+static const char *signals_mouse[] = {
+   "mouse,in", "elm.swallow.icon",
+   "mouse,move", "elm.text",
+   "mouse,down,1", "elm.swallow.end",
+   "mouse,up,1", "elm.text",
+   "mouse,out", "elm.swallow.icon",
+   NULL, NULL
+};
+
+static const char *signals_state[] = {
+   "elm,state,selected", "elm",
+   "elm,state,unselected", "elm",
+   "elm,state,focused", "elm",
+   "elm,state,unfocused", "elm",
+   NULL, NULL
+};
+
+/* Nothing in the theme listens to those, only the callbacks do */
+static const char *signals_miss[] = {
+   "elm,action,scroll", "elm",
+   "size,eval", "elm",
+   "app,custom,1", "app",
+   "drag,start", "elm.dragable",
+   NULL, NULL
+};
+
+static Ecore_Evas *ee = NULL;
+static Evas_Object *obj = NULL;
+static unsigned int count = 0;
+
+static void
+_signal_cb(void *data EINA_UNUSED, Evas_Object *o EINA_UNUSED,
+           const char *emission EINA_UNUSED, const char *source EINA_UNUSED)
+{
+   count++;
+}
+
+static void
+_bench_signals(int request, const char **signals)
+{
+   int i, j;
+
+   if (!obj) return;
+
+   for (i = 0, j = 0; i < request; i++)
+     {
+        if (!signals[j]) j = 0;
+        edje_object_signal_emit(obj, signals[j], signals[j + 1]);
+        j += 2;
+
+        /* Keep the queue short, like a main loop iteration would */
+        if (!(i & 15)) edje_message_signal_process();
+     }
+   edje_message_signal_process();
+}
+
+static void
+edje_bench_signal_mouse(int request)
+{
+   _bench_signals(request, signals_mouse);
+}
+
+static void
+edje_bench_signal_state(int request)
+{
+   _bench_signals(request, signals_state);
+}
+
+static void
+edje_bench_signal_miss(int request)
+{
+   _bench_signals(request, signals_miss);
+}
+
+void
+edje_bench_signal(Eina_Benchmark *bench)
+{
+   const char *file;
+
+   file = getenv("EDJE_BENCH_FILE");
+   if (!file) file = THEME_FILE;
+
+   ee = ecore_evas_buffer_new(480, 800);
+   if (!ee) return;
+
+   obj = edje_object_add(ecore_evas_get(ee));
+   if (!edje_object_file_set(obj, file, GROUP))
+     {
+        fprintf(stderr, "Could not load %s from %s\n", GROUP, file);
+        evas_object_del(obj);
+        obj = NULL;
+        return;
+     }
+   edje_object_animation_set(obj, EINA_FALSE);
+   evas_object_resize(obj, 480, 64);
+   evas_object_show(obj);
+
+   edje_object_signal_callback_add(obj, "*", "*", _signal_cb, NULL);
+   edje_object_signal_callback_add(obj, "elm,action,*", "elm", _signal_cb, NULL);
+   edje_object_signal_callback_add(obj, "mouse,down,*", "*", _signal_cb, NULL);
+   edje_object_signal_callback_add(obj, "size,eval", "elm", _signal_cb, NULL);
+
+   eina_benchmark_register(bench, "mouse", EINA_BENCHMARK(edje_bench_signal_mouse), 1000, 50000, 5000);
+   eina_benchmark_register(bench, "state", EINA_BENCHMARK(edje_bench_signal_state), 1000, 50000, 5000);
+   eina_benchmark_register(bench, "miss", EINA_BENCHMARK(edje_bench_signal_miss), 1000, 50000, 5000);
+}
+
+void
+edje_bench_signal_shutdown(void)
+{
+   if (obj) evas_object_del(obj);
+   obj = NULL;
+   if (ee) ecore_evas_free(ee);
+   ee = NULL;
+}
@@ -0,0 +1,61 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <Eina.h>
+
+#include "Eet.h"
+#include "eet_bench.h"
+
+typedef struct _Eet_Benchmark_Case Eet_Benchmark_Case;
+struct _Eet_Benchmark_Case
+{
+   const char *bench_case;
+   void (*build)(Eina_Benchmark *bench);
+   void (*shutdown)(void);
+};
+
+static const Eet_Benchmark_Case etc[] = {
+   { "Compression", eet_bench_compression, eet_bench_compression_shutdown },
+   { "Update", eet_bench_update, eet_bench_update_shutdown },
+   { "Threads", eet_bench_threads, eet_bench_threads_shutdown },
+   { "Data", eet_bench_data, eet_bench_data_shutdown },
+   { "Connection", eet_bench_connection, eet_bench_connection_shutdown },
+   { "Image", eet_bench_image, eet_bench_image_shutdown },
+   { "Directory", eet_bench_directory, eet_bench_directory_shutdown },
+   { NULL, NULL, NULL }
+};
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+   unsigned int i;
+
+   if (argc != 2)
+      return -1;
+
+   eet_init();
+
+   for (i = 0; etc[i].bench_case; ++i)
+     {
+        test = eina_benchmark_new(etc[i].bench_case, argv[1]);
+        if (!test)
+           continue;
+
+        etc[i].build(test);
+
+        eina_benchmark_run(test);
+
+        eina_benchmark_free(test);
+
+        if (etc[i].shutdown) etc[i].shutdown();
+     }
+
+   eet_shutdown();
+
+   return 0;
+}
@@ -0,0 +1,19 @@
+#ifndef EET_BENCH_H_
+#define EET_BENCH_H_
+
+void eet_bench_compression(Eina_Benchmark *bench);
+void eet_bench_compression_shutdown(void);
+void eet_bench_update(Eina_Benchmark *bench);
+void eet_bench_update_shutdown(void);
+void eet_bench_threads(Eina_Benchmark *bench);
+void eet_bench_threads_shutdown(void);
+void eet_bench_data(Eina_Benchmark *bench);
+void eet_bench_data_shutdown(void);
+void eet_bench_connection(Eina_Benchmark *bench);
+void eet_bench_connection_shutdown(void);
+void eet_bench_image(Eina_Benchmark *bench);
+void eet_bench_image_shutdown(void);
+void eet_bench_directory(Eina_Benchmark *bench);
+void eet_bench_directory_shutdown(void);
+
+#endif
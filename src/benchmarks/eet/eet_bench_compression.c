@@ -0,0 +1,261 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Eina.h>
+
+#include "Eet.h"
+#include "eet_bench.h"
+
+/* Decode speed of a real theme with each compression, and how long it
+ * takes to write it. The theme can be changed with EET_BENCH_FILE, the
+ * size of each variant is printed once when it is written. */
+#define THEME_FILE PACKAGE_BUILD_DIR "/data/elementary/themes/default.edj"
+
+typedef struct _Eet_Bench_Entry Eet_Bench_Entry;
+typedef struct _Eet_Bench_Mode  Eet_Bench_Mode;
+
+struct _Eet_Bench_Entry
+{
+   char *name;
+   void *data;
+   int size;
+};
+
+struct _Eet_Bench_Mode
+{
+   const char *name;
+   int comp;
+   Eina_Bool dictionary;
+   Eina_Tmpstr *path;
+};
+
+static Eet_Bench_Mode modes[] = {
+   { "zlib", EET_COMPRESSION_HI, EINA_FALSE, NULL },
+   { "lz4hc", EET_COMPRESSION_VERYFAST, EINA_FALSE, NULL },
+   { "lz4", EET_COMPRESSION_SUPERFAST, EINA_FALSE, NULL },
+   { "zstd", EET_COMPRESSION_ZSTD, EINA_FALSE, NULL },
+   { "zstd-dictionary", EET_COMPRESSION_ZSTD, EINA_TRUE, NULL },
+   { NULL, 0, EINA_FALSE, NULL }
+};
+
+static Eina_List *entries = NULL;
+
+static Eina_Bool
+_theme_load(void)
+{
+   Eet_File *ef;
+   Eina_Iterator *it;
+   Eet_Entry *entry;
+   Eet_Bench_Entry *e;
+   Eina_List *l;
+   const char *file;
+
+   file = getenv("EET_BENCH_FILE");
+   if (!file) file = THEME_FILE;
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   if (!ef)
+     {
+        fprintf(stderr, "Could not open %s\n", file);
+        return EINA_FALSE;
+     }
+
+   /* Images and sounds are stored as is, only keep what gets compressed */
+   it = eet_list_entries(ef);
+   EINA_ITERATOR_FOREACH(it, entry)
+     {
+        if (!entry->compression || entry->ciphered || entry->alias)
+          continue;
+
+        e = calloc(1, sizeof (Eet_Bench_Entry));
+        if (!e) break;
+        e->name = strdup(entry->name);
+        entries = eina_list_append(entries, e);
+     }
+   eina_iterator_free(it);
+
+   EINA_LIST_FOREACH(entries, l, e)
+     e->data = eet_read(ef, e->name, &e->size);
+
+   eet_close(ef);
+   return !!entries;
+}
+
+static Eina_Bool
+_mode_write(Eet_Bench_Mode *mode)
+{
+   Eet_Bench_Entry *e;
+   Eet_File *ef;
+   Eina_List *l;
+   Eina_File *f;
+   int raw = 0;
+   int fd;
+
+   fd = eina_file_mkstemp("eet_bench_XXXXXX.eet", &mode->path);
+   if (fd < 0) return EINA_FALSE;
+   close(fd);
+
+   ef = eet_open(mode->path, EET_FILE_MODE_WRITE);
+   if (!ef) return EINA_FALSE;
+
+   if (mode->dictionary)
+     eet_compression_dictionary_train(ef, 110 * 1024);
+   EINA_LIST_FOREACH(entries, l, e)
+     {
+        if (!e->data) continue;
+        eet_write(ef, e->name, e->data, e->size, mode->comp);
+        raw += e->size;
+     }
+   eet_close(ef);
+
+   f = eina_file_open(mode->path, EINA_FALSE);
+   if (!f) return EINA_FALSE;
+   printf("%s: %u entries, %i bytes compressed to %zu bytes\n",
+          mode->name, eina_list_count(entries), raw, eina_file_size_get(f));
+   eina_file_close(f);
+
+   return EINA_TRUE;
+}
+
+static void
+_bench_decode(int request, Eet_Bench_Mode *mode)
+{
+   Eet_Bench_Entry *e;
+   Eet_File *ef;
+   Eina_List *l;
+   int i;
+
+   if (!mode->path) return;
+
+   ef = eet_open(mode->path, EET_FILE_MODE_READ);
+   if (!ef) return;
+
+   for (i = 0; i < request; i++)
+     {
+        EINA_LIST_FOREACH(entries, l, e)
+          free(eet_read(ef, e->name, NULL));
+     }
+
+   eet_close(ef);
+}
+
+static void
+eet_bench_decode_zlib(int request)
+{
+   _bench_decode(request, &modes[0]);
+}
+
+static void
+eet_bench_decode_lz4hc(int request)
+{
+   _bench_decode(request, &modes[1]);
+}
+
+static void
+eet_bench_decode_lz4(int request)
+{
+   _bench_decode(request, &modes[2]);
+}
+
+static void
+eet_bench_decode_zstd(int request)
+{
+   _bench_decode(request, &modes[3]);
+}
+
+static void
+eet_bench_decode_zstd_dictionary(int request)
+{
+   _bench_decode(request, &modes[4]);
+}
+
+/* Writing a whole theme, as edje_cc does at the end of a build */
+static void
+_bench_write(int request, int threads)
+{
+   Eet_Bench_Entry *e;
+   Eina_Tmpstr *path;
+   Eet_File *ef;
+   Eina_List *l;
+   int fd;
+   int i;
+
+   fd = eina_file_mkstemp("eet_bench_XXXXXX.eet", &path);
+   if (fd < 0) return;
+   close(fd);
+
+   for (i = 0; i < request; i++)
+     {
+        ef = eet_open(path, EET_FILE_MODE_WRITE);
+        if (!ef) break;
+
+        eet_compression_threads_set(ef, threads);
+        EINA_LIST_FOREACH(entries, l, e)
+          if (e->data)
+            eet_write(ef, e->name, e->data, e->size, EET_COMPRESSION_HI);
+        eet_close(ef);
+     }
+
+   unlink(path);
+   eina_tmpstr_del(path);
+}
+
+static void
+eet_bench_write_serial(int request)
+{
+   _bench_write(request, 1);
+}
+
+static void
+eet_bench_write_threads(int request)
+{
+   _bench_write(request, -1);
+}
+
+void
+eet_bench_compression(Eina_Benchmark *bench)
+{
+   unsigned int i;
+
+   /* Files are written once here, so that only decoding is measured */
+   if (!_theme_load()) return;
+   for (i = 0; modes[i].name; i++)
+     if (!_mode_write(&modes[i]))
+       fprintf(stderr, "Could not write %s variant\n", modes[i].name);
+
+   eina_benchmark_register(bench, "decode-zlib", EINA_BENCHMARK(eet_bench_decode_zlib), 1, 20, 2);
+   eina_benchmark_register(bench, "decode-lz4hc", EINA_BENCHMARK(eet_bench_decode_lz4hc), 1, 20, 2);
+   eina_benchmark_register(bench, "decode-lz4", EINA_BENCHMARK(eet_bench_decode_lz4), 1, 20, 2);
+   eina_benchmark_register(bench, "decode-zstd", EINA_BENCHMARK(eet_bench_decode_zstd), 1, 20, 2);
+   eina_benchmark_register(bench, "decode-zstd-dictionary", EINA_BENCHMARK(eet_bench_decode_zstd_dictionary), 1, 20, 2);
+   eina_benchmark_register(bench, "write-serial", EINA_BENCHMARK(eet_bench_write_serial), 1, 5, 1);
+   eina_benchmark_register(bench, "write-threads", EINA_BENCHMARK(eet_bench_write_threads), 1, 5, 1);
+}
+
+void
+eet_bench_compression_shutdown(void)
+{
+   Eet_Bench_Entry *e;
+   unsigned int i;
+
+   for (i = 0; modes[i].name; i++)
+     {
+        if (!modes[i].path) continue;
+        unlink(modes[i].path);
+        eina_tmpstr_del(modes[i].path);
+        modes[i].path = NULL;
+     }
+
+   EINA_LIST_FREE(entries, e)
+     {
+        free(e->name);
+        free(e->data);
+        free(e);
+     }
+}
@@ -0,0 +1,287 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <Eina.h>
+
+#include "Eet.h"
+#include "eet_bench.h"
+
+/* Throughput of an Eet_Connection over a local socketpair, with a thread
+ * on the other end decoding what it receives. Small messages look like
+ * the input events and replies going over ecore_ipc, large ones like a
+ * whole state being pushed at once. */
+#define SMALL_COUNT 2000
+#define LARGE_COUNT 64
+#define LARGE_SIZE  (16 * 1024)
+
+#ifndef IOV_MAX
+# define IOV_MAX 1024
+#endif
+
+typedef struct _Bench_Message Bench_Message;
+typedef struct _Bench_Peer    Bench_Peer;
+
+struct _Bench_Message
+{
+   int id;
+   int x, y;
+   unsigned int timestamp;
+   const char *name;
+   const char *payload;
+};
+
+struct _Bench_Peer
+{
+   Eet_Connection *conn;
+   int fd;
+   int received;
+};
+
+static Eet_Data_Descriptor *_message_edd = NULL;
+static char *_payload = NULL;
+
+static Eina_Bool
+_peer_read(const void *eet_data, size_t size, void *user_data)
+{
+   Bench_Peer *peer = user_data;
+   Bench_Message *msg;
+
+   msg = eet_data_descriptor_decode(_message_edd, eet_data, size);
+   if (!msg) return EINA_FALSE;
+   eina_stringshare_del(msg->name);
+   eina_stringshare_del(msg->payload);
+   free(msg);
+   peer->received++;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_peer_write(const void *data, size_t size, void *user_data)
+{
+   Bench_Peer *peer = user_data;
+   const char *p = data;
+   ssize_t r;
+
+   while (size > 0)
+     {
+        r = write(peer->fd, p, size);
+        if (r < 0)
+          {
+             if (errno == EINTR) continue;
+             return EINA_FALSE;
+          }
+        p += r;
+        size -= r;
+     }
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_peer_writev(const Eina_Slice *slices, unsigned int count, void *user_data)
+{
+   Bench_Peer *peer = user_data;
+   struct iovec iov[IOV_MAX];
+   unsigned int i, n;
+   ssize_t r;
+
+   while (count > 0)
+     {
+        n = count > IOV_MAX ? IOV_MAX : count;
+        for (i = 0; i < n; i++)
+          {
+             iov[i].iov_base = (void *)slices[i].mem;
+             iov[i].iov_len = slices[i].len;
+          }
+
+        /* Only fall back to plain writes for what writev left over */
+        r = writev(peer->fd, iov, n);
+        if (r < 0)
+          {
+             if (errno == EINTR) continue;
+             return EINA_FALSE;
+          }
+        for (i = 0; i < n && (size_t)r >= iov[i].iov_len; i++)
+          r -= iov[i].iov_len;
+        if (i < n)
+          {
+             if (!_peer_write((const char *)iov[i].iov_base + r,
+                              iov[i].iov_len - r, peer))
+               return EINA_FALSE;
+             i++;
+          }
+        slices += i;
+        count -= i;
+     }
+   return EINA_TRUE;
+}
+
+static void *
+_receiver(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Bench_Peer *peer = data;
+   char buffer[64 * 1024];
+   size_t length = 0;
+   ssize_t r;
+   int still;
+
+   while ((r = read(peer->fd, buffer + length, sizeof (buffer) - length)) != 0)
+     {
+        if (r < 0)
+          {
+             if (errno == EINTR) continue;
+             break;
+          }
+        length += r;
+
+        /* A header cut in half comes back with the next read */
+        still = eet_connection_received(peer->conn, buffer, length);
+        if (still) memmove(buffer, buffer + length - still, still);
+        length = still;
+     }
+
+   return NULL;
+}
+
+static void
+_bench_send(int request, int count, const char *payload,
+            size_t batch, Eina_Bool writev_cb, Eina_Bool compress)
+{
+   Bench_Peer sender, receiver;
+   Bench_Message msg;
+   Eina_Thread tid;
+   int fds[2];
+   int i;
+
+   if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds)) return;
+
+   sender.fd = fds[0];
+   sender.received = 0;
+   sender.conn = eet_connection_new(_peer_read, _peer_write, &sender);
+   receiver.fd = fds[1];
+   receiver.received = 0;
+   receiver.conn = eet_connection_new(_peer_read, _peer_write, &receiver);
+
+   eet_connection_batch_set(sender.conn, batch, 0.0);
+   if (writev_cb) eet_connection_writev_set(sender.conn, _peer_writev);
+   eet_connection_compression_set(sender.conn, compress);
+
+   if (!eina_thread_create(&tid, EINA_THREAD_NORMAL, -1, _receiver, &receiver))
+     goto end;
+
+   msg.name = "mouse,move";
+   msg.payload = payload;
+   for (i = 0; i < request * count; i++)
+     {
+        msg.id = i;
+        msg.x = i % 1920;
+        msg.y = i % 1080;
+        msg.timestamp = i * 16;
+        eet_connection_send(sender.conn, _message_edd, &msg, NULL);
+     }
+   eet_connection_flush(sender.conn);
+
+   shutdown(fds[0], SHUT_WR);
+   eina_thread_join(tid);
+   if (receiver.received != request * count)
+     fprintf(stderr, "Received %i messages out of %i\n",
+             receiver.received, request * count);
+
+ end:
+   eet_connection_close(sender.conn, NULL);
+   eet_connection_close(receiver.conn, NULL);
+   close(fds[0]);
+   close(fds[1]);
+}
+
+static void
+eet_bench_connection_small_plain(int request)
+{
+   _bench_send(request, SMALL_COUNT, NULL, 0, EINA_FALSE, EINA_FALSE);
+}
+
+static void
+eet_bench_connection_small_writev(int request)
+{
+   _bench_send(request, SMALL_COUNT, NULL, 0, EINA_TRUE, EINA_FALSE);
+}
+
+static void
+eet_bench_connection_small_batched(int request)
+{
+   _bench_send(request, SMALL_COUNT, NULL, 64 * 1024, EINA_TRUE, EINA_FALSE);
+}
+
+static void
+eet_bench_connection_small_compressed(int request)
+{
+   _bench_send(request, SMALL_COUNT, NULL, 64 * 1024, EINA_TRUE, EINA_TRUE);
+}
+
+static void
+eet_bench_connection_large_plain(int request)
+{
+   _bench_send(request, LARGE_COUNT, _payload, 0, EINA_FALSE, EINA_FALSE);
+}
+
+static void
+eet_bench_connection_large_writev(int request)
+{
+   _bench_send(request, LARGE_COUNT, _payload, 0, EINA_TRUE, EINA_FALSE);
+}
+
+static void
+eet_bench_connection_large_compressed(int request)
+{
+   _bench_send(request, LARGE_COUNT, _payload, 0, EINA_TRUE, EINA_TRUE);
+}
+
+void
+eet_bench_connection(Eina_Benchmark *bench)
+{
+   Eet_Data_Descriptor_Class eddc;
+   int i;
+
+   EET_EINA_STREAM_DATA_DESCRIPTOR_CLASS_SET(&eddc, Bench_Message);
+   _message_edd = eet_data_descriptor_stream_new(&eddc);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_message_edd, Bench_Message, "id", id, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_message_edd, Bench_Message, "x", x, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_message_edd, Bench_Message, "y", y, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_message_edd, Bench_Message, "timestamp", timestamp, EET_T_UINT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_message_edd, Bench_Message, "name", name, EET_T_STRING);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_message_edd, Bench_Message, "payload", payload, EET_T_STRING);
+
+   /* Text like, so that it compresses about as well as real state does */
+   _payload = malloc(LARGE_SIZE + 1);
+   if (!_payload) return;
+   for (i = 0; i < LARGE_SIZE; i++)
+     _payload[i] = "abcdefghijklmnopqrstuvwxyz ,.;"[(i * 7 + i / 97) % 30];
+   _payload[LARGE_SIZE] = '\0';
+
+   eina_benchmark_register(bench, "small-plain", EINA_BENCHMARK(eet_bench_connection_small_plain), 1, 10, 1);
+   eina_benchmark_register(bench, "small-writev", EINA_BENCHMARK(eet_bench_connection_small_writev), 1, 10, 1);
+   eina_benchmark_register(bench, "small-batched", EINA_BENCHMARK(eet_bench_connection_small_batched), 1, 10, 1);
+   eina_benchmark_register(bench, "small-compressed", EINA_BENCHMARK(eet_bench_connection_small_compressed), 1, 10, 1);
+   eina_benchmark_register(bench, "large-plain", EINA_BENCHMARK(eet_bench_connection_large_plain), 1, 10, 1);
+   eina_benchmark_register(bench, "large-writev", EINA_BENCHMARK(eet_bench_connection_large_writev), 1, 10, 1);
+   eina_benchmark_register(bench, "large-compressed", EINA_BENCHMARK(eet_bench_connection_large_compressed), 1, 10, 1);
+}
+
+void
+eet_bench_connection_shutdown(void)
+{
+   if (_message_edd) eet_data_descriptor_free(_message_edd);
+   _message_edd = NULL;
+   free(_payload);
+   _payload = NULL;
+}
@@ -0,0 +1,369 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef HAVE_MALLINFO
+# include <malloc.h>
+#endif
+
+#include <Eina.h>
+
+#include "Eet.h"
+#include "eet_bench.h"
+
+/* Loading collections shaped like the ones edje stores in a theme: a
+ * group holding a list of parts, each with a few descriptions made of
+ * many small scalar fields. */
+#define COLLECTION_COUNT 64
+#define PART_COUNT       48
+#define DESC_COUNT       3
+
+typedef struct _Bench_Desc       Bench_Desc;
+typedef struct _Bench_Part       Bench_Part;
+typedef struct _Bench_Collection Bench_Collection;
+
+struct _Bench_Desc
+{
+   const char *state;
+   double value;
+   int min_w, min_h, max_w, max_h;
+   double align_x, align_y;
+   double rel1_x, rel1_y, rel2_x, rel2_y;
+   int rel1_offset_x, rel1_offset_y, rel2_offset_x, rel2_offset_y;
+   unsigned char r, g, b, a;
+   unsigned char visible;
+   unsigned char fixed_w, fixed_h;
+   const char *image;
+};
+
+struct _Bench_Part
+{
+   const char *name;
+   int id;
+   unsigned char type;
+   unsigned char mouse_events;
+   unsigned char repeat_events;
+   int clip_to_id;
+   Eina_List *descs;
+};
+
+struct _Bench_Collection
+{
+   const char *name;
+   int id;
+   int min_w, min_h, max_w, max_h;
+   Eina_List *parts;
+};
+
+static Eet_Data_Descriptor *_desc_edd = NULL;
+static Eet_Data_Descriptor *_part_edd = NULL;
+static Eet_Data_Descriptor *_collection_edd = NULL;
+static Eina_Tmpstr *path = NULL;
+
+static void
+_descriptors_init(void)
+{
+   Eet_Data_Descriptor_Class eddc;
+
+   EET_EINA_FILE_DATA_DESCRIPTOR_CLASS_SET(&eddc, Bench_Desc);
+   _desc_edd = eet_data_descriptor_file_new(&eddc);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "state", state, EET_T_STRING);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "value", value, EET_T_DOUBLE);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "min.w", min_w, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "min.h", min_h, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "max.w", max_w, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "max.h", max_h, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "align.x", align_x, EET_T_DOUBLE);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "align.y", align_y, EET_T_DOUBLE);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "rel1.x", rel1_x, EET_T_DOUBLE);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "rel1.y", rel1_y, EET_T_DOUBLE);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "rel2.x", rel2_x, EET_T_DOUBLE);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "rel2.y", rel2_y, EET_T_DOUBLE);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "rel1.offset_x", rel1_offset_x, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "rel1.offset_y", rel1_offset_y, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "rel2.offset_x", rel2_offset_x, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "rel2.offset_y", rel2_offset_y, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "color.r", r, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "color.g", g, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "color.b", b, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "color.a", a, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "visible", visible, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "fixed.w", fixed_w, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "fixed.h", fixed_h, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_desc_edd, Bench_Desc, "image", image, EET_T_STRING);
+
+   EET_EINA_FILE_DATA_DESCRIPTOR_CLASS_SET(&eddc, Bench_Part);
+   _part_edd = eet_data_descriptor_file_new(&eddc);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_part_edd, Bench_Part, "name", name, EET_T_STRING);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_part_edd, Bench_Part, "id", id, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_part_edd, Bench_Part, "type", type, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_part_edd, Bench_Part, "mouse_events", mouse_events, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_part_edd, Bench_Part, "repeat_events", repeat_events, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_part_edd, Bench_Part, "clip_to_id", clip_to_id, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_LIST(_part_edd, Bench_Part, "descs", descs, _desc_edd);
+
+   EET_EINA_FILE_DATA_DESCRIPTOR_CLASS_SET(&eddc, Bench_Collection);
+   _collection_edd = eet_data_descriptor_file_new(&eddc);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_collection_edd, Bench_Collection, "name", name, EET_T_STRING);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_collection_edd, Bench_Collection, "id", id, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_collection_edd, Bench_Collection, "prop.min.w", min_w, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_collection_edd, Bench_Collection, "prop.min.h", min_h, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_collection_edd, Bench_Collection, "prop.max.w", max_w, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_collection_edd, Bench_Collection, "prop.max.h", max_h, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_LIST(_collection_edd, Bench_Collection, "parts", parts, _part_edd);
+}
+
+/* Strings point into the dictionary when read from a file, they are only
+ * stringshared when decoded from a buffer. */
+static void
+_collection_free(Bench_Collection *c, Eina_Bool stringshared)
+{
+   Bench_Part *part;
+   Bench_Desc *desc;
+
+   EINA_LIST_FREE(c->parts, part)
+     {
+        EINA_LIST_FREE(part->descs, desc)
+          {
+             if (stringshared)
+               {
+                  eina_stringshare_del(desc->state);
+                  eina_stringshare_del(desc->image);
+               }
+             free(desc);
+          }
+        if (stringshared) eina_stringshare_del(part->name);
+        free(part);
+     }
+   if (stringshared) eina_stringshare_del(c->name);
+   free(c);
+}
+
+static Eina_Bool
+_file_create(void)
+{
+   static const char *states[] = { "default", "clicked", "disabled" };
+   Bench_Collection *c;
+   Bench_Part *part;
+   Bench_Desc *desc;
+   Eet_File *ef;
+   char key[64];
+   char name[64];
+   int fd;
+   int i, j, k;
+
+   fd = eina_file_mkstemp("eet_bench_XXXXXX.eet", &path);
+   if (fd < 0) return EINA_FALSE;
+   close(fd);
+
+   ef = eet_open(path, EET_FILE_MODE_WRITE);
+   if (!ef) return EINA_FALSE;
+
+   for (i = 0; i < COLLECTION_COUNT; i++)
+     {
+        c = calloc(1, sizeof (Bench_Collection));
+        if (!c) break;
+        snprintf(name, sizeof (name), "elm/bench/base/%i", i);
+        c->name = name;
+        c->id = i;
+        c->max_w = c->max_h = 9999;
+
+        for (j = 0; j < PART_COUNT; j++)
+          {
+             part = calloc(1, sizeof (Bench_Part));
+             if (!part) break;
+             part->name = j & 1 ? "elm.text" : "elm.swallow.content";
+             part->id = j;
+             part->type = j % 5;
+             part->mouse_events = 1;
+             part->clip_to_id = -1;
+
+             for (k = 0; k < DESC_COUNT; k++)
+               {
+                  desc = calloc(1, sizeof (Bench_Desc));
+                  if (!desc) break;
+                  desc->state = states[k];
+                  desc->min_w = desc->min_h = j;
+                  desc->max_w = desc->max_h = -1;
+                  desc->align_x = desc->align_y = 0.5;
+                  desc->rel2_x = desc->rel2_y = 1.0;
+                  desc->rel2_offset_x = desc->rel2_offset_y = -1;
+                  desc->r = desc->g = desc->b = desc->a = 255;
+                  desc->visible = k != 2;
+                  desc->image = k ? "bt_base1.png" : NULL;
+                  part->descs = eina_list_append(part->descs, desc);
+               }
+             c->parts = eina_list_append(c->parts, part);
+          }
+
+        snprintf(key, sizeof (key), "edje/collections/%i", i);
+        eet_data_write(ef, _collection_edd, key, c, EET_COMPRESSION_NONE);
+        _collection_free(c, EINA_FALSE);
+     }
+   eet_close(ef);
+
+   return EINA_TRUE;
+}
+
+static void
+eet_bench_data_collection_load(int request)
+{
+   Bench_Collection *c;
+   Eet_File *ef;
+   char key[64];
+   int i;
+
+   ef = eet_open(path, EET_FILE_MODE_READ);
+   if (!ef) return;
+
+   for (i = 0; i < request; i++)
+     {
+        snprintf(key, sizeof (key), "edje/collections/%i", i % COLLECTION_COUNT);
+        c = eet_data_read(ef, _collection_edd, key);
+        if (c) _collection_free(c, EINA_FALSE);
+     }
+
+   eet_close(ef);
+}
+
+/* Every structure of a collection carved out of one arena */
+static void
+eet_bench_data_collection_load_arena(int request)
+{
+   Eet_Data_Arena *arena;
+   Eet_File *ef;
+   char key[64];
+   int i;
+
+   ef = eet_open(path, EET_FILE_MODE_READ);
+   if (!ef) return;
+
+   for (i = 0; i < request; i++)
+     {
+        snprintf(key, sizeof (key), "edje/collections/%i", i % COLLECTION_COUNT);
+        if (eet_data_read_arena(ef, _collection_edd, key, &arena))
+          eet_data_arena_free(arena);
+     }
+
+   eet_close(ef);
+}
+
+#ifdef HAVE_MALLINFO
+static int
+_heap_used(void)
+{
+   struct mallinfo mi = mallinfo();
+
+   /* Large blocks are mmaped on their own and not part of uordblks */
+   return mi.uordblks + mi.hblkhd;
+}
+#endif
+
+/* Heap used to keep every collection loaded at once, with and without
+ * an arena. Lists still come from the eina mempool in both cases. */
+static void
+_memory_report(void)
+{
+#ifdef HAVE_MALLINFO
+   Bench_Collection *c[COLLECTION_COUNT];
+   Eet_Data_Arena *arena[COLLECTION_COUNT];
+   Eet_File *ef;
+   char key[64];
+   int before, plain, arenas;
+   int i;
+
+   ef = eet_open(path, EET_FILE_MODE_READ);
+   if (!ef) return;
+
+   before = _heap_used();
+   for (i = 0; i < COLLECTION_COUNT; i++)
+     {
+        snprintf(key, sizeof (key), "edje/collections/%i", i);
+        c[i] = eet_data_read(ef, _collection_edd, key);
+     }
+   plain = _heap_used() - before;
+   for (i = 0; i < COLLECTION_COUNT; i++)
+     if (c[i]) _collection_free(c[i], EINA_FALSE);
+
+   before = _heap_used();
+   for (i = 0; i < COLLECTION_COUNT; i++)
+     {
+        snprintf(key, sizeof (key), "edje/collections/%i", i);
+        eet_data_read_arena(ef, _collection_edd, key, &arena[i]);
+     }
+   arenas = _heap_used() - before;
+   for (i = 0; i < COLLECTION_COUNT; i++)
+     eet_data_arena_free(arena[i]);
+
+   eet_close(ef);
+
+   printf("%i collections: %i bytes of heap, %i bytes with arenas\n",
+          COLLECTION_COUNT, plain, arenas);
+#endif
+}
+
+/* The same collections without a dictionary, as sent over a connection */
+static void
+eet_bench_data_collection_stream(int request)
+{
+   Bench_Collection *c;
+   Eet_File *ef;
+   void *blob = NULL;
+   int size = 0;
+   int i;
+
+   ef = eet_open(path, EET_FILE_MODE_READ);
+   if (!ef) return;
+   c = eet_data_read(ef, _collection_edd, "edje/collections/0");
+   eet_close(ef);
+   if (!c) return;
+
+   blob = eet_data_descriptor_encode(_collection_edd, c, &size);
+   _collection_free(c, EINA_FALSE);
+   if (!blob) return;
+
+   for (i = 0; i < request; i++)
+     {
+        c = eet_data_descriptor_decode(_collection_edd, blob, size);
+        if (c) _collection_free(c, EINA_TRUE);
+     }
+
+   free(blob);
+}
+
+void
+eet_bench_data(Eina_Benchmark *bench)
+{
+   _descriptors_init();
+   if (!_file_create())
+     {
+        fprintf(stderr, "Could not write collections\n");
+        return;
+     }
+
+   _memory_report();
+
+   eina_benchmark_register(bench, "collection-load", EINA_BENCHMARK(eet_bench_data_collection_load), 100, 2000, 100);
+   eina_benchmark_register(bench, "collection-load-arena", EINA_BENCHMARK(eet_bench_data_collection_load_arena), 100, 2000, 100);
+   eina_benchmark_register(bench, "collection-stream", EINA_BENCHMARK(eet_bench_data_collection_stream), 100, 2000, 100);
+}
+
+void
+eet_bench_data_shutdown(void)
+{
+   if (path)
+     {
+        unlink(path);
+        eina_tmpstr_del(path);
+        path = NULL;
+     }
+
+   eet_data_descriptor_free(_collection_edd);
+   eet_data_descriptor_free(_part_edd);
+   eet_data_descriptor_free(_desc_edd);
+   _collection_edd = _part_edd = _desc_edd = NULL;
+}
@@ -0,0 +1,159 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <Eina.h>
+
+#include "Eet.h"
+#include "eet_bench.h"
+
+/* Opening a file with a lot of entries, and looking them up, with and
+ * without a directory index. The keys look like the images and groups
+ * of a big theme, so that they share long prefixes. */
+#define ENTRY_COUNT 50000
+#define LOOKUP_COUNT 10000
+
+static Eina_Tmpstr *plain_path = NULL;
+static Eina_Tmpstr *index_path = NULL;
+
+static void
+_key_get(char *buf, size_t size, unsigned int i)
+{
+   snprintf(buf, size, "edje/images/group_%u/part_%u", i / 37, i);
+}
+
+static Eina_Tmpstr *
+_directory_write(Eina_Bool index)
+{
+   Eina_Tmpstr *path;
+   Eet_File *ef;
+   char key[128];
+   unsigned int i;
+   int fd;
+
+   fd = eina_file_mkstemp("eet_bench_XXXXXX.eet", &path);
+   if (fd < 0) return NULL;
+   close(fd);
+
+   ef = eet_open(path, EET_FILE_MODE_WRITE);
+   if (!ef) goto on_error;
+
+   eet_directory_index_set(ef, index);
+   for (i = 0; i < ENTRY_COUNT; i++)
+     {
+        _key_get(key, sizeof (key), i);
+        eet_write(ef, key, &i, sizeof (i), 0);
+     }
+   if (eet_close(ef) != EET_ERROR_NONE) goto on_error;
+
+   return path;
+
+ on_error:
+   unlink(path);
+   eina_tmpstr_del(path);
+   return NULL;
+}
+
+static void
+_bench_open(int request, const char *path)
+{
+   Eet_File *ef;
+   int i;
+
+   if (!path) return;
+
+   /* Drop the cache each time, otherwise only the first open is measured */
+   for (i = 0; i < request; i++)
+     {
+        ef = eet_open(path, EET_FILE_MODE_READ);
+        if (!ef) return;
+        eet_close(ef);
+        eet_clearcache();
+     }
+}
+
+static void
+_bench_lookup(int request, const char *path)
+{
+   Eet_File *ef;
+   char key[128];
+   unsigned int seed = 1;
+   int size;
+   int i, j;
+
+   if (!path) return;
+
+   ef = eet_open(path, EET_FILE_MODE_READ);
+   if (!ef) return;
+
+   for (i = 0; i < request; i++)
+     for (j = 0; j < LOOKUP_COUNT; j++)
+       {
+          seed = seed * 1103515245 + 12345;
+          _key_get(key, sizeof (key), (seed >> 8) % ENTRY_COUNT);
+          eet_read_direct(ef, key, &size);
+       }
+
+   eet_close(ef);
+   eet_clearcache();
+}
+
+static void
+eet_bench_directory_open_plain(int request)
+{
+   _bench_open(request, plain_path);
+}
+
+static void
+eet_bench_directory_open_index(int request)
+{
+   _bench_open(request, index_path);
+}
+
+static void
+eet_bench_directory_lookup_plain(int request)
+{
+   _bench_lookup(request, plain_path);
+}
+
+static void
+eet_bench_directory_lookup_index(int request)
+{
+   _bench_lookup(request, index_path);
+}
+
+void
+eet_bench_directory(Eina_Benchmark *bench)
+{
+   /* Files are written once here, so that only reading is measured */
+   plain_path = _directory_write(EINA_FALSE);
+   index_path = _directory_write(EINA_TRUE);
+   if (!plain_path || !index_path)
+     fprintf(stderr, "Could not write %i entries\n", ENTRY_COUNT);
+
+   eina_benchmark_register(bench, "open-plain", EINA_BENCHMARK(eet_bench_directory_open_plain), 10, 200, 20);
+   eina_benchmark_register(bench, "open-index", EINA_BENCHMARK(eet_bench_directory_open_index), 10, 200, 20);
+   eina_benchmark_register(bench, "lookup-plain", EINA_BENCHMARK(eet_bench_directory_lookup_plain), 1, 20, 2);
+   eina_benchmark_register(bench, "lookup-index", EINA_BENCHMARK(eet_bench_directory_lookup_index), 1, 20, 2);
+}
+
+void
+eet_bench_directory_shutdown(void)
+{
+   if (plain_path)
+     {
+        unlink(plain_path);
+        eina_tmpstr_del(plain_path);
+        plain_path = NULL;
+     }
+   if (index_path)
+     {
+        unlink(index_path);
+        eina_tmpstr_del(index_path);
+        index_path = NULL;
+     }
+}
@@ -0,0 +1,169 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <Eina.h>
+
+#include "Eet.h"
+#include "eet_bench.h"
+
+/* Decode speed of each image encoding on something that looks like a
+ * theme image: a vertical gradient with a flat border, rounded corners
+ * fading out in the alpha channel and a bit of noise on the bottom. */
+#define IMAGE_W 256
+#define IMAGE_H 256
+
+typedef struct _Eet_Bench_Image Eet_Bench_Image;
+
+struct _Eet_Bench_Image
+{
+   const char *name;
+   int comp;
+   int quality;
+   Eet_Image_Encoding lossy;
+   void *data;
+   int size;
+};
+
+static Eet_Bench_Image images[] = {
+   { "lossless-zlib", EET_COMPRESSION_HI, 0, EET_IMAGE_LOSSLESS, NULL, 0 },
+   { "lossless-lz4hc", EET_COMPRESSION_VERYFAST, 0, EET_IMAGE_LOSSLESS, NULL, 0 },
+   { "lossless-predicted", EET_COMPRESSION_SUPERFAST, 0, EET_IMAGE_LOSSLESS_PREDICTED, NULL, 0 },
+   { "jpeg", 0, 90, EET_IMAGE_JPEG, NULL, 0 },
+   { "etc2", 0, 50, EET_IMAGE_ETC2_RGBA, NULL, 0 },
+   { NULL, 0, 0, 0, NULL, 0 }
+};
+
+static unsigned int *pixels = NULL;
+
+static void
+_image_fill(unsigned int *p)
+{
+   unsigned int x, y, a, c, dx, dy;
+
+   for (y = 0; y < IMAGE_H; y++)
+     for (x = 0; x < IMAGE_W; x++)
+       {
+          dx = x < 16 ? 16 - x : (x >= IMAGE_W - 16 ? x - (IMAGE_W - 17) : 0);
+          dy = y < 16 ? 16 - y : (y >= IMAGE_H - 16 ? y - (IMAGE_H - 17) : 0);
+          a = dx * dx + dy * dy;
+          a = a >= 256 ? 0 : 255 - a;
+
+          if (x < 4 || y < 4 || x >= IMAGE_W - 4 || y >= IMAGE_H - 4)
+            c = 0x40;
+          else
+            c = 0x60 + y / 2;
+          if (y > IMAGE_H - 32)
+            c += ((x * y * 2654435761U) >> 29);
+
+          /* Premultiplied, as evas hands them to us */
+          c = c * a / 255;
+          p[y * IMAGE_W + x] = (a << 24) | (c << 16) | (c << 8) | (c * 3 / 4);
+       }
+}
+
+static void
+_bench_decode(int request, Eet_Bench_Image *image)
+{
+   unsigned int w, h;
+   int alpha, comp, quality;
+   Eet_Image_Encoding lossy;
+   int i;
+
+   if (!image->data) return;
+
+   for (i = 0; i < request; i++)
+     free(eet_data_image_decode(image->data, image->size, &w, &h, &alpha,
+                                &comp, &quality, &lossy));
+}
+
+static void
+eet_bench_image_decode_zlib(int request)
+{
+   _bench_decode(request, &images[0]);
+}
+
+static void
+eet_bench_image_decode_lz4hc(int request)
+{
+   _bench_decode(request, &images[1]);
+}
+
+static void
+eet_bench_image_decode_predicted(int request)
+{
+   _bench_decode(request, &images[2]);
+}
+
+static void
+eet_bench_image_decode_jpeg(int request)
+{
+   _bench_decode(request, &images[3]);
+}
+
+static void
+eet_bench_image_decode_etc2(int request)
+{
+   _bench_decode(request, &images[4]);
+}
+
+/* What edje_cc spends its time on with an ETC2 theme */
+static void
+eet_bench_image_encode_etc2(int request)
+{
+   int size;
+   int i;
+
+   for (i = 0; i < request; i++)
+     free(eet_data_image_encode(pixels, &size, IMAGE_W, IMAGE_H, 1,
+                                0, 50, EET_IMAGE_ETC2_RGBA));
+}
+
+void
+eet_bench_image(Eina_Benchmark *bench)
+{
+   unsigned int i;
+
+   pixels = malloc(IMAGE_W * IMAGE_H * sizeof (unsigned int));
+   if (!pixels) return;
+   _image_fill(pixels);
+
+   /* Images are encoded once here, so that only decoding is measured */
+   for (i = 0; images[i].name; i++)
+     {
+        images[i].data = eet_data_image_encode(pixels, &images[i].size,
+                                               IMAGE_W, IMAGE_H, 1,
+                                               images[i].comp,
+                                               images[i].quality,
+                                               images[i].lossy);
+        if (!images[i].data)
+          fprintf(stderr, "Could not encode %s\n", images[i].name);
+        else
+          printf("%s: %i bytes encoded to %i bytes\n", images[i].name,
+                 IMAGE_W * IMAGE_H * 4, images[i].size);
+     }
+
+   eina_benchmark_register(bench, "decode-lossless-zlib", EINA_BENCHMARK(eet_bench_image_decode_zlib), 10, 200, 20);
+   eina_benchmark_register(bench, "decode-lossless-lz4hc", EINA_BENCHMARK(eet_bench_image_decode_lz4hc), 10, 200, 20);
+   eina_benchmark_register(bench, "decode-lossless-predicted", EINA_BENCHMARK(eet_bench_image_decode_predicted), 10, 200, 20);
+   eina_benchmark_register(bench, "decode-jpeg", EINA_BENCHMARK(eet_bench_image_decode_jpeg), 10, 200, 20);
+   eina_benchmark_register(bench, "decode-etc2", EINA_BENCHMARK(eet_bench_image_decode_etc2), 10, 200, 20);
+   eina_benchmark_register(bench, "encode-etc2", EINA_BENCHMARK(eet_bench_image_encode_etc2), 1, 5, 1);
+}
+
+void
+eet_bench_image_shutdown(void)
+{
+   unsigned int i;
+
+   for (i = 0; images[i].name; i++)
+     {
+        free(images[i].data);
+        images[i].data = NULL;
+     }
+   free(pixels);
+   pixels = NULL;
+}
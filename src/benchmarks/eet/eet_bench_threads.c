@@ -0,0 +1,153 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Eina.h>
+
+#include "Eet.h"
+#include "eet_bench.h"
+
+/* Many threads reading random entries out of the same file, like the
+ * thread pools decoding edje collections and images do. */
+#define ENTRY_COUNT 1024
+#define ENTRY_SIZE  2048
+#define THREAD_MAX  64
+
+typedef struct _Eet_Bench_Reader Eet_Bench_Reader;
+struct _Eet_Bench_Reader
+{
+   Eet_File *ef;
+   unsigned int seed;
+   int reads;
+};
+
+static Eina_Tmpstr *path = NULL;
+
+static Eina_Tmpstr *
+_file_create(void)
+{
+   Eina_Tmpstr *file;
+   Eet_File *ef;
+   char buffer[ENTRY_SIZE];
+   char key[64];
+   int fd;
+   int i, j;
+
+   fd = eina_file_mkstemp("eet_bench_XXXXXX.eet", &file);
+   if (fd < 0) return NULL;
+   close(fd);
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   if (!ef)
+     {
+        unlink(file);
+        eina_tmpstr_del(file);
+        return NULL;
+     }
+
+   for (i = 0; i < ENTRY_COUNT; i++)
+     {
+        snprintf(key, sizeof (key), "entries/%i", i);
+        for (j = 0; j < ENTRY_SIZE; j++)
+          buffer[j] = "the quick brown fox jumps over the lazy dog"[(i + j * 7) % 43];
+        eet_write(ef, key, buffer, sizeof (buffer), EET_COMPRESSION_SUPERFAST);
+     }
+   eet_close(ef);
+
+   return file;
+}
+
+static void *
+_reader(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Eet_Bench_Reader *r = data;
+   char key[64];
+   int i;
+
+   for (i = 0; i < r->reads; i++)
+     {
+        r->seed = r->seed * 1103515245 + 12345;
+        snprintf(key, sizeof (key), "entries/%u", (r->seed >> 16) % ENTRY_COUNT);
+        free(eet_read(r->ef, key, NULL));
+     }
+
+   return NULL;
+}
+
+static void
+_bench_read(int request, int threads)
+{
+   Eet_Bench_Reader readers[THREAD_MAX];
+   Eina_Thread tids[THREAD_MAX];
+   Eet_File *ef;
+   int created = 0;
+   int i;
+
+   if (!path) return;
+   if (threads < 0) threads = eina_cpu_count();
+   if (threads > THREAD_MAX) threads = THREAD_MAX;
+
+   ef = eet_open(path, EET_FILE_MODE_READ);
+   if (!ef) return;
+
+   /* The same amount of reads is spread over the threads */
+   for (i = 0; i < threads; i++)
+     {
+        readers[i].ef = ef;
+        readers[i].seed = i;
+        readers[i].reads = request * 256 / threads;
+     }
+
+   for (i = 1; i < threads; i++)
+     if (eina_thread_create(&tids[created], EINA_THREAD_NORMAL, -1,
+                            _reader, &readers[i]))
+       created++;
+   _reader(&readers[0], 0);
+   for (i = 0; i < created; i++)
+     eina_thread_join(tids[i]);
+
+   eet_close(ef);
+}
+
+static void
+eet_bench_threads_read_1(int request)
+{
+   _bench_read(request, 1);
+}
+
+static void
+eet_bench_threads_read_4(int request)
+{
+   _bench_read(request, 4);
+}
+
+static void
+eet_bench_threads_read_cpu(int request)
+{
+   _bench_read(request, -1);
+}
+
+void
+eet_bench_threads(Eina_Benchmark *bench)
+{
+   path = _file_create();
+
+   eina_benchmark_register(bench, "read-1-thread", EINA_BENCHMARK(eet_bench_threads_read_1), 10, 200, 20);
+   eina_benchmark_register(bench, "read-4-threads", EINA_BENCHMARK(eet_bench_threads_read_4), 10, 200, 20);
+   eina_benchmark_register(bench, "read-cpu-threads", EINA_BENCHMARK(eet_bench_threads_read_cpu), 10, 200, 20);
+}
+
+void
+eet_bench_threads_shutdown(void)
+{
+   if (!path) return;
+
+   unlink(path);
+   eina_tmpstr_del(path);
+   path = NULL;
+}
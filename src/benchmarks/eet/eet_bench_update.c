@@ -0,0 +1,121 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Eina.h>
+
+#include "Eet.h"
+#include "eet_bench.h"
+
+/* Cost of updating a few entries of a large file, by rewriting all of it
+ * or by appending the changes. The appended file grows over the runs and
+ * gets compacted from time to time, like it would in real use. */
+#define ENTRY_COUNT 2048
+#define ENTRY_SIZE  4096
+#define UPDATE_COUNT 4
+
+static Eina_Tmpstr *rewrite_path = NULL;
+static Eina_Tmpstr *append_path = NULL;
+
+static Eina_Tmpstr *
+_file_create(void)
+{
+   Eina_Tmpstr *path;
+   Eet_File *ef;
+   char buffer[ENTRY_SIZE];
+   char key[64];
+   int fd;
+   int i;
+
+   fd = eina_file_mkstemp("eet_bench_XXXXXX.eet", &path);
+   if (fd < 0) return NULL;
+   close(fd);
+
+   ef = eet_open(path, EET_FILE_MODE_WRITE);
+   if (!ef)
+     {
+        unlink(path);
+        eina_tmpstr_del(path);
+        return NULL;
+     }
+
+   for (i = 0; i < ENTRY_COUNT; i++)
+     {
+        snprintf(key, sizeof (key), "entries/%i", i);
+        memset(buffer, 'a' + (i % 26), sizeof (buffer));
+        eet_write(ef, key, buffer, sizeof (buffer), EET_COMPRESSION_NONE);
+     }
+   eet_close(ef);
+
+   return path;
+}
+
+static void
+_bench_update(int request, const char *path, Eina_Bool append)
+{
+   Eet_File *ef;
+   char buffer[ENTRY_SIZE];
+   char key[64];
+   int i, j;
+
+   if (!path) return;
+
+   for (i = 0; i < request; i++)
+     {
+        ef = eet_open(path, EET_FILE_MODE_READ_WRITE);
+        if (!ef) return;
+
+        eet_file_append_set(ef, append);
+        for (j = 0; j < UPDATE_COUNT; j++)
+          {
+             snprintf(key, sizeof (key), "entries/%i", (i * 97 + j * 13) % ENTRY_COUNT);
+             memset(buffer, 'A' + ((i + j) % 26), sizeof (buffer));
+             eet_write(ef, key, buffer, sizeof (buffer), EET_COMPRESSION_NONE);
+          }
+        eet_close(ef);
+     }
+}
+
+static void
+eet_bench_update_rewrite(int request)
+{
+   _bench_update(request, rewrite_path, EINA_FALSE);
+}
+
+static void
+eet_bench_update_append(int request)
+{
+   _bench_update(request, append_path, EINA_TRUE);
+}
+
+void
+eet_bench_update(Eina_Benchmark *bench)
+{
+   rewrite_path = _file_create();
+   append_path = _file_create();
+
+   eina_benchmark_register(bench, "update-rewrite", EINA_BENCHMARK(eet_bench_update_rewrite), 1, 20, 2);
+   eina_benchmark_register(bench, "update-append", EINA_BENCHMARK(eet_bench_update_append), 1, 20, 2);
+}
+
+void
+eet_bench_update_shutdown(void)
+{
+   if (rewrite_path)
+     {
+        unlink(rewrite_path);
+        eina_tmpstr_del(rewrite_path);
+        rewrite_path = NULL;
+     }
+   if (append_path)
+     {
+        unlink(append_path);
+        eina_tmpstr_del(append_path);
+        append_path = NULL;
+     }
+}
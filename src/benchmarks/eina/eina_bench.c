@@ -46,6 +46,7 @@ static const Eina_Benchmark_Case etc[] = {
    { "Sort", eina_bench_sort, EINA_TRUE },
    { "Mempool", eina_bench_mempool, EINA_TRUE },
    { "Rectangle_Pool", eina_bench_rectangle_pool, EINA_TRUE },
+   { "Simple_XML", eina_bench_simple_xml, EINA_TRUE },
    { "Render Loop", eina_bench_quadtree, EINA_FALSE },
    { NULL, NULL, EINA_FALSE }
 };
@@ -34,6 +34,7 @@ void eina_bench_sort(Eina_Benchmark *bench);
 void eina_bench_mempool(Eina_Benchmark *bench);
 void eina_bench_rectangle_pool(Eina_Benchmark *bench);
 void eina_bench_quadtree(Eina_Benchmark *bench);
+void eina_bench_simple_xml(Eina_Benchmark *bench);
 void eina_bench_promise(Eina_Benchmark *bench);
 
 /* Specific benchmark. */
@@ -0,0 +1,91 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "eina_bench.h"
+#include "eina_strbuf.h"
+#include "eina_simple_xml_parser.h"
+
+/* A document looking like the svg files of an icon theme: long tags with
+ * quoted attributes, styles and path data, a few comments and text. */
+static char *
+_xml_build(int count, unsigned int *len)
+{
+   Eina_Strbuf *buf;
+   char *xml;
+   int i;
+
+   buf = eina_strbuf_new();
+   eina_strbuf_append(buf, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                      "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"128\" height=\"128\">\n");
+   for (i = 0; i < count; i++)
+     {
+        eina_strbuf_append_printf(buf,
+           "  <!-- shape %i, drawn with a gradient -->\n"
+           "  <g id=\"layer%i\" transform=\"translate(%i.5,-%i.25)\">\n"
+           "    <path style=\"fill:#3465a4;fill-opacity:1;stroke:#204a87;stroke-width:1.5;"
+           "stroke-linecap:round;stroke-linejoin:round;stroke-miterlimit:4\"\n"
+           "          d=\"M %i.5,12.5 C 20.5,%i.5 44.25,36.5 64,64 L 118.5,%i.5 z\"\n"
+           "          id=\"path%i\" />\n"
+           "    <text x=\"10\" y=\"%i\">Label number %i</text>\n"
+           "  </g>\n",
+           i, i, i % 64, i % 32, i % 100, i % 90, i % 80, i, i % 128, i);
+     }
+   eina_strbuf_append(buf, "</svg>\n");
+
+   *len = eina_strbuf_length_get(buf);
+   xml = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+   return xml;
+}
+
+static Eina_Bool
+_xml_attr_cb(void *data, const char *key EINA_UNUSED, const char *value EINA_UNUSED)
+{
+   int *count = data;
+
+   (*count)++;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_xml_cb(void *data, Eina_Simple_XML_Type type, const char *content,
+        unsigned offset EINA_UNUSED, unsigned length)
+{
+   const char *attrs;
+
+   if ((type != EINA_SIMPLE_XML_OPEN) && (type != EINA_SIMPLE_XML_OPEN_EMPTY))
+     return EINA_TRUE;
+
+   attrs = eina_simple_xml_tag_attributes_find(content, length);
+   if (attrs)
+     eina_simple_xml_attributes_parse(attrs, length - (attrs - content),
+                                      _xml_attr_cb, data);
+   return EINA_TRUE;
+}
+
+/* Parses a document of about 400KB request times */
+static void
+eina_bench_simple_xml_parse(int request)
+{
+   unsigned int len;
+   char *xml;
+   int count = 0;
+   int i;
+
+   xml = _xml_build(1000, &len);
+   for (i = 0; i < request; i++)
+     eina_simple_xml_parse(xml, len, EINA_TRUE, _xml_cb, &count);
+   free(xml);
+}
+
+void eina_bench_simple_xml(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "parse",
+                           EINA_BENCHMARK(
+                              eina_bench_simple_xml_parse), 10, 200,
+                           10);
+}
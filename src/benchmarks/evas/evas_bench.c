@@ -21,6 +21,10 @@ struct _Evas_Benchmark_Case
 static const Evas_Benchmark_Case etc[] = {
    { "Loader", evas_bench_loader, EINA_TRUE },
    { "Saver", evas_bench_saver, EINA_TRUE },
+   { "Text", evas_bench_text, EINA_TRUE },
+   { "Filter", evas_bench_filter, EINA_TRUE },
+   { "Render", evas_bench_render, EINA_TRUE },
+   { "Vg", evas_bench_vg, EINA_TRUE },
    { NULL, NULL, EINA_FALSE }
 };
 
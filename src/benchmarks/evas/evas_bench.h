@@ -5,6 +5,10 @@
 
 void evas_bench_loader(Eina_Benchmark *bench);
 void evas_bench_saver(Eina_Benchmark *bench);
+void evas_bench_text(Eina_Benchmark *bench);
+void evas_bench_filter(Eina_Benchmark *bench);
+void evas_bench_render(Eina_Benchmark *bench);
+void evas_bench_vg(Eina_Benchmark *bench);
 
 #endif
 
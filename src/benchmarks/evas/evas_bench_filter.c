@@ -0,0 +1,191 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#define EFL_BETA_API_SUPPORT
+
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_bench.h"
+
+/* Common filter programs, as used by themes for text and image effects.
+ * Run with EVAS_SLICE_THREADS=1 to compare against single threaded filters. */
+static const char *shadow_code =
+   "blur { 3, ox = 1, oy = 1, color = '#0008' } blend {}";
+static const char *glow_code =
+   "a = buffer { 'alpha' } grow { 4, dst = a } blur { 6, src = a, color = '#3cf' } blend {}";
+static const char *blur_box_code =
+   "blur { 12, type = 'box' }";
+static const char *blur_gaussian_code =
+   "blur { 6, type = 'gaussian' }";
+static const char *curve_code =
+   "curve { '0:0-128:255-255:255', channel = 'rgb' }";
+
+static Evas *
+_setup_evas()
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+
+   evas = evas_new();
+
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_RGB32;
+   einfo->info.dest_buffer = malloc(sizeof (char) * 500 * 500 * 4);
+   einfo->info.dest_buffer_row_bytes = 500 * sizeof (char) * 4;
+
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+
+   evas_output_size_set(evas, 500, 500);
+   evas_output_viewport_set(evas, 0, 0, 500, 500);
+
+   return evas;
+}
+
+/* A screen of labels with a filter, their text changes every frame */
+static void
+_bench_filter_text(int request, const char *code)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *o[20];
+   Eina_List *l;
+   int i, j;
+
+   for (j = 0; j < 20; j++)
+     {
+        o[j] = evas_object_text_add(e);
+        evas_object_text_font_source_set(o[j], TESTS_SRC_DIR "/fonts/TestFont.eet");
+        evas_object_text_font_set(o[j], "DejaVuSans", 16);
+        efl_gfx_filter_program_set(o[j], code, "bench");
+        evas_object_move(o[j], 10, j * 25);
+        evas_object_show(o[j]);
+     }
+
+   for (i = 0; i < request; i++)
+     {
+        for (j = 0; j < 20; j++)
+          evas_object_text_text_set(o[j], (i + j) & 1 ?
+                                    "The quick brown fox jumps" :
+                                    "over the lazy dog, again");
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   for (j = 0; j < 20; j++)
+     evas_object_del(o[j]);
+   evas_free(e);
+}
+
+/* A scrolling list of labels with a shadow: the labels only move, so their
+ * filter output is drawn again as is. Compare with the text-shadow case,
+ * where every label changes every frame. */
+static void
+evas_bench_filter_text_scroll(int request)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *o[40];
+   Eina_List *l;
+   int i, j;
+
+   for (j = 0; j < 40; j++)
+     {
+        o[j] = evas_object_text_add(e);
+        evas_object_text_font_source_set(o[j], TESTS_SRC_DIR "/fonts/TestFont.eet");
+        evas_object_text_font_set(o[j], "DejaVuSans", 16);
+        evas_object_text_text_set(o[j], (j & 1) ?
+                                  "The quick brown fox jumps" :
+                                  "over the lazy dog, again");
+        efl_gfx_filter_program_set(o[j], shadow_code, "bench");
+        evas_object_show(o[j]);
+     }
+
+   for (i = 0; i < request; i++)
+     {
+        for (j = 0; j < 40; j++)
+          evas_object_move(o[j], 10, ((j * 25) - (i * 3)) % 1000 - 250);
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   for (j = 0; j < 40; j++)
+     evas_object_del(o[j]);
+   evas_free(e);
+}
+
+/* A single large image with a filter, its content changes every frame */
+static void
+_bench_filter_image(int request, const char *code)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *o;
+   Eina_List *l;
+   unsigned int *data;
+   int i, k;
+
+   o = evas_object_image_filled_add(e);
+   evas_object_image_size_set(o, 400, 400);
+   evas_object_image_alpha_set(o, EINA_TRUE);
+   data = evas_object_image_data_get(o, EINA_TRUE);
+   for (k = 0; k < 400 * 400; k++)
+     data[k] = ((k / 400) & 16) ^ (k & 16) ? 0xff3366cc : 0x80000000;
+   evas_object_image_data_set(o, data);
+   efl_gfx_filter_program_set(o, code, "bench");
+   evas_object_move(o, 50, 50);
+   evas_object_resize(o, 400, 400);
+   evas_object_show(o);
+
+   for (i = 0; i < request; i++)
+     {
+        evas_object_image_data_update_add(o, 0, 0, 400, 400);
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   evas_object_del(o);
+   evas_free(e);
+}
+
+static void
+evas_bench_filter_text_shadow(int request)
+{
+   _bench_filter_text(request, shadow_code);
+}
+
+static void
+evas_bench_filter_text_glow(int request)
+{
+   _bench_filter_text(request, glow_code);
+}
+
+static void
+evas_bench_filter_image_blur_box(int request)
+{
+   _bench_filter_image(request, blur_box_code);
+}
+
+static void
+evas_bench_filter_image_blur_gaussian(int request)
+{
+   _bench_filter_image(request, blur_gaussian_code);
+}
+
+static void
+evas_bench_filter_image_curve(int request)
+{
+   _bench_filter_image(request, curve_code);
+}
+
+void evas_bench_filter(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "text-shadow", EINA_BENCHMARK(evas_bench_filter_text_shadow), 10, 200, 20);
+   eina_benchmark_register(bench, "text-scroll", EINA_BENCHMARK(evas_bench_filter_text_scroll), 10, 200, 20);
+   eina_benchmark_register(bench, "text-glow", EINA_BENCHMARK(evas_bench_filter_text_glow), 10, 200, 20);
+   eina_benchmark_register(bench, "image-blur-box", EINA_BENCHMARK(evas_bench_filter_image_blur_box), 10, 100, 10);
+   eina_benchmark_register(bench, "image-blur-gaussian", EINA_BENCHMARK(evas_bench_filter_image_blur_gaussian), 10, 100, 10);
+   eina_benchmark_register(bench, "image-curve", EINA_BENCHMARK(evas_bench_filter_image_curve), 10, 100, 10);
+}
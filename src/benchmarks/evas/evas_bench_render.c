@@ -0,0 +1,400 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <math.h>
+
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_bench.h"
+
+/* A dashboard like canvas: a grid of clipped smart objects, each one holding
+ * a few dozen rectangles and a small image. Large enough for the object tree
+ * walk to show up next to the drawing.
+ * Run with EVAS_SLICE_THREADS=1 to compare against a single threaded walk. */
+#define TILES_X 32
+#define TILES_Y 16
+#define TILE_RECTS 24
+
+typedef struct _Bench_Tile Bench_Tile;
+struct _Bench_Tile
+{
+   Evas_Object *smart;
+   Evas_Object *rect;
+   Evas_Object *image;
+};
+
+static Evas *
+_setup_evas()
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+
+   evas = evas_new();
+
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_RGB32;
+   einfo->info.dest_buffer = malloc(sizeof (char) * 500 * 500 * 4);
+   einfo->info.dest_buffer_row_bytes = 500 * sizeof (char) * 4;
+
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+
+   evas_output_size_set(evas, 500, 500);
+   evas_output_viewport_set(evas, 0, 0, 500, 500);
+
+   return evas;
+}
+
+static Evas_Smart *
+_tile_smart_get(void)
+{
+   static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION("bench_tile");
+   static Evas_Smart *smart = NULL;
+
+   if (!smart)
+     {
+        evas_object_smart_clipped_smart_set(&sc);
+        smart = evas_smart_class_new(&sc);
+     }
+   return smart;
+}
+
+static Bench_Tile *
+_tiles_add(Evas *e)
+{
+   Bench_Tile *tiles;
+   Evas_Object *o;
+   int x, y, k;
+
+   tiles = calloc(TILES_X * TILES_Y, sizeof (Bench_Tile));
+   for (y = 0; y < TILES_Y; y++)
+     for (x = 0; x < TILES_X; x++)
+       {
+          Bench_Tile *t = &tiles[(y * TILES_X) + x];
+          Evas_Coord tx = x * 15, ty = y * 30;
+
+          t->smart = evas_object_smart_add(e, _tile_smart_get());
+          for (k = 0; k < TILE_RECTS; k++)
+            {
+               o = evas_object_rectangle_add(e);
+               evas_object_color_set(o, (k * 10) & 0xff, 64, 128, 255);
+               evas_object_move(o, tx + (k % 4) * 3, ty + (k / 4) * 4);
+               evas_object_resize(o, 3, 4);
+               evas_object_smart_member_add(o, t->smart);
+               evas_object_show(o);
+               if (!k) t->rect = o;
+            }
+
+          t->image = evas_object_image_filled_add(e);
+          evas_object_image_size_set(t->image, 8, 8);
+          evas_object_move(t->image, tx, ty + 24);
+          evas_object_resize(t->image, 8, 6);
+          evas_object_smart_member_add(t->image, t->smart);
+          evas_object_show(t->image);
+
+          evas_object_move(t->smart, tx, ty);
+          evas_object_resize(t->smart, 15, 30);
+          evas_object_show(t->smart);
+       }
+
+   return tiles;
+}
+
+static void
+_tiles_del(Bench_Tile *tiles)
+{
+   int k;
+
+   for (k = 0; k < TILES_X * TILES_Y; k++)
+     evas_object_del(tiles[k].smart);
+   free(tiles);
+}
+
+static void
+_tile_image_update(Bench_Tile *t, int i)
+{
+   unsigned int *data;
+   int k;
+
+   data = evas_object_image_data_get(t->image, EINA_TRUE);
+   for (k = 0; k < 8 * 8; k++)
+     data[k] = 0xff000000 | (i * 0x010203) | k;
+   evas_object_image_data_set(t->image, data);
+   evas_object_image_data_update_add(t->image, 0, 0, 8, 8);
+}
+
+/* Nothing moves, a single tile gets a new picture every frame */
+static void
+evas_bench_render_tree_idle(int request)
+{
+   Evas *e = _setup_evas();
+   Bench_Tile *tiles;
+   Eina_List *l;
+   int i;
+
+   tiles = _tiles_add(e);
+   for (i = 0; i < request; i++)
+     {
+        _tile_image_update(&tiles[(i * 7) % (TILES_X * TILES_Y)], i);
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   _tiles_del(tiles);
+   evas_free(e);
+}
+
+/* Every tile gets a new picture every frame, the geometry does not change */
+static void
+evas_bench_render_tree_content(int request)
+{
+   Evas *e = _setup_evas();
+   Bench_Tile *tiles;
+   Eina_List *l;
+   int i, k;
+
+   tiles = _tiles_add(e);
+   for (i = 0; i < request; i++)
+     {
+        for (k = 0; k < TILES_X * TILES_Y; k++)
+          _tile_image_update(&tiles[k], i + k);
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   _tiles_del(tiles);
+   evas_free(e);
+}
+
+/* One rectangle of every tile moves every frame */
+static void
+evas_bench_render_tree_move(int request)
+{
+   Evas *e = _setup_evas();
+   Bench_Tile *tiles;
+   Eina_List *l;
+   Evas_Coord x, y;
+   int i, k;
+
+   tiles = _tiles_add(e);
+   for (i = 0; i < request; i++)
+     {
+        for (k = 0; k < TILES_X * TILES_Y; k++)
+          {
+             evas_object_geometry_get(tiles[k].smart, &x, &y, NULL, NULL);
+             evas_object_move(tiles[k].rect, x + (i & 3), y);
+          }
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   _tiles_del(tiles);
+   evas_free(e);
+}
+
+/* Layered full screen pages, as with a stack of application views or a
+ * popup over a list: every page has an opaque background and a lot of
+ * widgets, only the top page is visible.
+ * Run with EVAS_RENDER_OCCLUSION=0 to draw the hidden pages anyway and
+ * EVAS_RENDER_OCCLUSION_STATS=1 to print the overdraw of each frame. */
+#define PAGES 6
+#define PAGE_WIDGETS 200
+
+static Evas_Object *
+_pages_add(Evas *e, Eina_List **objs)
+{
+   Evas_Object *o = NULL;
+   unsigned int *data;
+   int p, k, i;
+
+   for (p = 0; p < PAGES; p++)
+     {
+        o = evas_object_rectangle_add(e);
+        evas_object_color_set(o, 32 * p, 32, 64, 255);
+        evas_object_resize(o, 500, 500);
+        evas_object_show(o);
+        *objs = eina_list_append(*objs, o);
+
+        for (k = 0; k < PAGE_WIDGETS; k++)
+          {
+             if (k & 1)
+               {
+                  o = evas_object_image_filled_add(e);
+                  evas_object_image_size_set(o, 16, 16);
+                  evas_object_image_alpha_set(o, EINA_TRUE);
+                  data = evas_object_image_data_get(o, EINA_TRUE);
+                  for (i = 0; i < 16 * 16; i++)
+                    data[i] = (i & 1) ? 0x80402010 : 0xff204080;
+                  evas_object_image_data_set(o, data);
+               }
+             else
+               {
+                  o = evas_object_rectangle_add(e);
+                  evas_object_color_set(o, 128, 128, (k * 5) & 0xff, 128);
+               }
+             evas_object_move(o, (k % 10) * 50, (k / 10) * 25);
+             evas_object_resize(o, 45, 20);
+             evas_object_show(o);
+             *objs = eina_list_append(*objs, o);
+          }
+     }
+
+   // The last widget of the top page
+   return o;
+}
+
+/* The whole screen is redrawn every frame */
+static void
+evas_bench_render_layers_full(int request)
+{
+   Evas *e = _setup_evas();
+   Eina_List *objs = NULL, *l;
+   Evas_Object *o;
+   int i;
+
+   _pages_add(e, &objs);
+   for (i = 0; i < request; i++)
+     {
+        evas_damage_rectangle_add(e, 0, 0, 500, 500);
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   EINA_LIST_FREE(objs, o)
+     evas_object_del(o);
+   evas_free(e);
+}
+
+/* A single widget of the top page moves every frame */
+static void
+evas_bench_render_layers_anim(int request)
+{
+   Evas *e = _setup_evas();
+   Eina_List *objs = NULL, *l;
+   Evas_Object *o, *anim;
+   int i;
+
+   anim = _pages_add(e, &objs);
+   for (i = 0; i < request; i++)
+     {
+        evas_object_move(anim, (i * 7) % 450, 475 - ((i * 3) % 450));
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   EINA_LIST_FREE(objs, o)
+     evas_object_del(o);
+   evas_free(e);
+}
+
+/* A CPU heavy animation: smart objects lay their members out again at every
+ * frame, while the previous frame is drawn by the render thread.
+ * Run with EVAS_RENDER_PIPELINE=0 to evaluate each frame only once the
+ * previous one is done and EVAS_RENDER_FRAME_STATS=1 to print the latency
+ * of each frame. */
+#define ANIM_GROUPS 16
+#define ANIM_MEMBERS 64
+
+static int anim_phase = 0;
+
+static void
+_anim_calculate(Evas_Object *o)
+{
+   Evas_Coord x, y;
+   Eina_List *members, *l;
+   Evas_Object *m;
+   int k = 0;
+
+   evas_object_geometry_get(o, &x, &y, NULL, NULL);
+   members = evas_object_smart_members_get(o);
+   EINA_LIST_FOREACH(members, l, m)
+     {
+        double a = 0.0, r = 0.0;
+        int i;
+
+        // Some layout work, as a theme or a physics step would do
+        for (i = 0; i < 200; i++)
+          {
+             a += sin((anim_phase + k + i) * 0.01);
+             r += cos((anim_phase - k + i) * 0.02);
+          }
+        evas_object_move(m, x + 30 + (int)(a * 0.1), y + 30 + (int)(r * 0.1));
+        k++;
+     }
+   eina_list_free(members);
+}
+
+static Evas_Smart *
+_anim_smart_get(void)
+{
+   static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION("bench_anim");
+   static Evas_Smart *smart = NULL;
+
+   if (!smart)
+     {
+        evas_object_smart_clipped_smart_set(&sc);
+        sc.calculate = _anim_calculate;
+        smart = evas_smart_class_new(&sc);
+     }
+   return smart;
+}
+
+static void
+evas_bench_render_pipeline(int request)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *groups[ANIM_GROUPS], *o;
+   int i, k;
+
+   for (k = 0; k < ANIM_GROUPS; k++)
+     {
+        groups[k] = evas_object_smart_add(e, _anim_smart_get());
+        for (i = 0; i < ANIM_MEMBERS; i++)
+          {
+             o = evas_object_rectangle_add(e);
+             evas_object_color_set(o, (i * 4) & 0xff, 64, 128, 255);
+             evas_object_resize(o, 20, 20);
+             evas_object_smart_member_add(o, groups[k]);
+             evas_object_show(o);
+          }
+        evas_object_move(groups[k], (k % 4) * 120, (k / 4) * 120);
+        evas_object_resize(groups[k], 120, 120);
+        evas_object_show(groups[k]);
+     }
+
+   for (i = 0; i < request; i++)
+     {
+        anim_phase = i;
+        for (k = 0; k < ANIM_GROUPS; k++)
+          evas_object_smart_changed(groups[k]);
+
+        if (!evas_render_async(e))
+          {
+             // The previous frame is still drawn, this one was evaluated
+             evas_sync(e);
+             evas_render_async(e);
+          }
+     }
+   evas_sync(e);
+
+   for (k = 0; k < ANIM_GROUPS; k++)
+     evas_object_del(groups[k]);
+   evas_free(e);
+}
+
+void evas_bench_render(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "tree-idle", EINA_BENCHMARK(evas_bench_render_tree_idle), 10, 200, 20);
+   eina_benchmark_register(bench, "tree-content", EINA_BENCHMARK(evas_bench_render_tree_content), 10, 100, 10);
+   eina_benchmark_register(bench, "tree-move", EINA_BENCHMARK(evas_bench_render_tree_move), 10, 100, 10);
+   eina_benchmark_register(bench, "layers-full", EINA_BENCHMARK(evas_bench_render_layers_full), 10, 100, 10);
+   eina_benchmark_register(bench, "layers-anim", EINA_BENCHMARK(evas_bench_render_layers_anim), 10, 200, 20);
+   eina_benchmark_register(bench, "pipeline", EINA_BENCHMARK(evas_bench_render_pipeline), 10, 100, 10);
+}
@@ -0,0 +1,250 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_bench.h"
+
+#define BENCH_FONT "font=DejaVuSans font_source=" TESTS_SRC_DIR "/fonts/TestFont.eet"
+
+static const char *style_buf =
+   "DEFAULT='" BENCH_FONT " font_size=10 color=#000 wrap=word'"
+   "newline='br'"
+   "b='+ font_weight=bold'";
+
+static const char *paragraph =
+   "Lorem ipsum dolor sit amet, <b>consectetur</b> adipiscing elit, sed do "
+   "eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad "
+   "minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip "
+   "ex ea commodo consequat.<br/>";
+
+static Evas *
+_setup_evas()
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+
+   evas = evas_new();
+
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_RGB32;
+   einfo->info.dest_buffer = malloc(sizeof (char) * 500 * 500 * 4);
+   einfo->info.dest_buffer_row_bytes = 500 * sizeof (char) * 4;
+
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+
+   evas_output_size_set(evas, 500, 500);
+   evas_output_viewport_set(evas, 0, 0, 500, 500);
+
+   return evas;
+}
+
+static Evas_Object *
+_textblock_add(Evas *e, Evas_Textblock_Style *st, int paragraphs)
+{
+   Eina_Strbuf *buf;
+   Evas_Object *o;
+   int i;
+
+   buf = eina_strbuf_new();
+   for (i = 0; i < paragraphs; i++)
+     eina_strbuf_append(buf, paragraph);
+
+   o = evas_object_textblock_add(e);
+   evas_object_textblock_style_set(o, st);
+   evas_object_textblock_text_markup_set(o, eina_strbuf_string_get(buf));
+   evas_object_move(o, 0, 0);
+   evas_object_resize(o, 500, 500);
+   evas_object_show(o);
+
+   eina_strbuf_free(buf);
+   return o;
+}
+
+/* Render a long document, scrolling it through the viewport so every
+ * frame draws a full screen of (mostly already cached) glyphs. */
+static void
+evas_bench_text_textblock_render(int request)
+{
+   Evas *e = _setup_evas();
+   Evas_Textblock_Style *st;
+   Evas_Object *o;
+   Eina_List *l;
+   Evas_Coord h;
+   int i;
+
+   st = evas_textblock_style_new();
+   evas_textblock_style_set(st, style_buf);
+   o = _textblock_add(e, st, 200);
+   evas_object_textblock_size_formatted_get(o, NULL, &h);
+   evas_object_resize(o, 500, h);
+
+   for (i = 0; i < request; i++)
+     {
+        evas_object_move(o, 0, -((i * 17) % (h > 500 ? h - 500 : 1)));
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   evas_object_del(o);
+   evas_textblock_style_free(st);
+   evas_free(e);
+}
+
+/* A list like scene: a screen of labels that keep getting new (but mostly
+ * repeated) strings, as a genlist does while scrolling. Run with
+ * EVAS_FONT_SHAPE_CACHE=0 to compare against shaping every run. */
+static void
+evas_bench_text_labels(int request)
+{
+   static const char *labels[] = {
+      "Inbox", "Drafts", "Sent items", "Deleted items", "Junk e-mail",
+      "Archive", "Notes", "Outbox", "Conversation history", "RSS feeds"
+   };
+   Evas *e = _setup_evas();
+   Evas_Object *o[25];
+   Eina_List *l;
+   unsigned int n = sizeof(labels) / sizeof(labels[0]);
+   int i, j;
+
+   for (j = 0; j < 25; j++)
+     {
+        o[j] = evas_object_text_add(e);
+        evas_object_text_font_source_set(o[j], TESTS_SRC_DIR "/fonts/TestFont.eet");
+        evas_object_text_font_set(o[j], "DejaVuSans", 14);
+        evas_object_move(o[j], 0, j * 20);
+        evas_object_show(o[j]);
+     }
+
+   for (i = 0; i < request; i++)
+     {
+        for (j = 0; j < 25; j++)
+          evas_object_text_text_set(o[j], labels[(i + j) % n]);
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   for (j = 0; j < 25; j++)
+     evas_object_del(o[j]);
+   evas_free(e);
+}
+
+/* Relayout of a long document on width changes re-shapes every run */
+static void
+evas_bench_text_textblock_relayout(int request)
+{
+   Evas *e = _setup_evas();
+   Evas_Textblock_Style *st;
+   Evas_Object *o;
+   Evas_Coord h;
+   int i;
+
+   st = evas_textblock_style_new();
+   evas_textblock_style_set(st, style_buf);
+   o = _textblock_add(e, st, 50);
+
+   for (i = 0; i < request; i++)
+     {
+        evas_object_resize(o, 300 + ((i * 7) % 200), 500);
+        evas_object_textblock_size_formatted_get(o, NULL, &h);
+     }
+
+   evas_object_del(o);
+   evas_textblock_style_free(st);
+   evas_free(e);
+}
+
+static Evas_Object *
+_textblock_lines_add(Evas *e, Evas_Textblock_Style *st, int lines)
+{
+   Eina_Strbuf *buf;
+   Evas_Object *o;
+   int i;
+
+   buf = eina_strbuf_new();
+   for (i = 0; i < lines; i++)
+     eina_strbuf_append_printf(buf, "Line %i of a long source file;<ps/>", i);
+
+   o = evas_object_textblock_add(e);
+   evas_object_textblock_style_set(o, st);
+   evas_object_textblock_text_markup_set(o, eina_strbuf_string_get(buf));
+   evas_object_resize(o, 500, 500);
+   evas_object_show(o);
+
+   eina_strbuf_free(buf);
+   return o;
+}
+
+/* Insert-char latency in the middle of a large document, as when typing
+ * in an entry: one paragraph changes, all the others are kept. */
+static void
+evas_bench_text_textblock_insert(int request)
+{
+   Evas *e = _setup_evas();
+   Evas_Textblock_Style *st;
+   Evas_Textblock_Cursor *cur;
+   Evas_Object *o;
+   Evas_Coord h;
+   int i;
+
+   st = evas_textblock_style_new();
+   evas_textblock_style_set(st, style_buf);
+   o = _textblock_lines_add(e, st, 10000);
+   evas_object_textblock_size_formatted_get(o, NULL, &h);
+
+   cur = evas_object_textblock_cursor_new(o);
+   evas_textblock_cursor_paragraph_first(cur);
+   for (i = 0; i < 5000; i++)
+     evas_textblock_cursor_paragraph_next(cur);
+
+   for (i = 0; i < request; i++)
+     {
+        evas_textblock_cursor_text_append(cur, "x");
+        evas_object_textblock_size_formatted_get(o, NULL, &h);
+     }
+
+   evas_textblock_cursor_free(cur);
+   evas_object_del(o);
+   evas_textblock_style_free(st);
+   evas_free(e);
+}
+
+/* Width changes on a large document of short lines: none of the lines has
+ * to wrap at either width, so no paragraph needs to be laid out again. */
+static void
+evas_bench_text_textblock_resize(int request)
+{
+   Evas *e = _setup_evas();
+   Evas_Textblock_Style *st;
+   Evas_Object *o;
+   Evas_Coord h;
+   int i;
+
+   st = evas_textblock_style_new();
+   evas_textblock_style_set(st, style_buf);
+   o = _textblock_lines_add(e, st, 10000);
+
+   for (i = 0; i < request; i++)
+     {
+        evas_object_resize(o, 400 + ((i * 7) % 100), 500);
+        evas_object_textblock_size_formatted_get(o, NULL, &h);
+     }
+
+   evas_object_del(o);
+   evas_textblock_style_free(st);
+   evas_free(e);
+}
+
+void evas_bench_text(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "textblock-render", EINA_BENCHMARK(evas_bench_text_textblock_render), 10, 500, 50);
+   eina_benchmark_register(bench, "text-labels", EINA_BENCHMARK(evas_bench_text_labels), 100, 5000, 500);
+   eina_benchmark_register(bench, "textblock-relayout", EINA_BENCHMARK(evas_bench_text_textblock_relayout), 10, 200, 20);
+   eina_benchmark_register(bench, "textblock-insert", EINA_BENCHMARK(evas_bench_text_textblock_insert), 10, 500, 50);
+   eina_benchmark_register(bench, "textblock-resize", EINA_BENCHMARK(evas_bench_text_textblock_resize), 10, 200, 20);
+}
@@ -0,0 +1,184 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#define EFL_BETA_API_SUPPORT
+
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_bench.h"
+
+/* Lottie animations drawn by the software vector rasterizer, a frame per
+ * render. The 60 frames sample comes from the elementary tests. */
+#define LOTTIE_FILE TESTS_SRC_DIR "/../elementary/emoji_wink.json"
+
+/* The svg icon theme shipped with elementary */
+#define ICON_THEME_DIR TESTS_SRC_DIR "/../../../data/elementary/themes/fdo"
+
+static Evas *
+_setup_evas()
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+
+   evas = evas_new();
+
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_RGB32;
+   einfo->info.dest_buffer = malloc(sizeof (char) * 500 * 500 * 4);
+   einfo->info.dest_buffer_row_bytes = 500 * sizeof (char) * 4;
+
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+
+   evas_output_size_set(evas, 500, 500);
+   evas_output_viewport_set(evas, 0, 0, 500, 500);
+
+   return evas;
+}
+
+static void
+_bench_vg_lottie(int request, int count, Efl_Canvas_Vg_Frame_Cache_Mode mode)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *o[16];
+   Eina_List *l;
+   int i, j, frames, side;
+
+   side = (count > 1) ? 125 : 500;
+   for (j = 0; j < count; j++)
+     {
+        o[j] = evas_object_vg_add(e);
+        evas_object_vg_file_set(o[j], LOTTIE_FILE, NULL);
+        efl_canvas_vg_object_frame_cache_mode_set(o[j], mode);
+        evas_object_move(o[j], (j % 4) * side, (j / 4) * side);
+        evas_object_resize(o[j], side, side);
+        evas_object_show(o[j]);
+     }
+   frames = evas_object_vg_animated_frame_count_get(o[0]);
+   if (frames < 1) frames = 1;
+
+   for (i = 0; i < request; i++)
+     {
+        for (j = 0; j < count; j++)
+          evas_object_vg_animated_frame_set(o[j], (i + j * 7) % frames);
+
+        l = evas_render_updates(e);
+        evas_render_updates_free(l);
+     }
+
+   for (j = 0; j < count; j++)
+     evas_object_del(o[j]);
+   evas_free(e);
+}
+
+/* One large animation */
+static void
+evas_bench_vg_lottie_large(int request)
+{
+   _bench_vg_lottie(request, 1, EFL_CANVAS_VG_FRAME_CACHE_MODE_EDGES);
+}
+
+/* A grid of small animations, each one at a different frame */
+static void
+evas_bench_vg_lottie_grid(int request)
+{
+   _bench_vg_lottie(request, 16, EFL_CANVAS_VG_FRAME_CACHE_MODE_EDGES);
+}
+
+/* The same animations looping with all their frames kept compressed: only
+ * the first loop renders them. There is no main loop here, so no frame is
+ * rendered ahead while idle. Compare with lottie-large and lottie-grid. */
+static void
+evas_bench_vg_lottie_large_cached(int request)
+{
+   _bench_vg_lottie(request, 1, EFL_CANVAS_VG_FRAME_CACHE_MODE_ALL);
+}
+
+static void
+evas_bench_vg_lottie_grid_cached(int request)
+{
+   _bench_vg_lottie(request, 16, EFL_CANVAS_VG_FRAME_CACHE_MODE_ALL);
+}
+
+/* Loading an animation and showing its first frame and a few frames from
+ * the rest of it, as a launcher does. Run under /usr/bin/time -v for the
+ * peak memory. */
+static void
+evas_bench_vg_lottie_load(int request)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *o;
+   Eina_List *l;
+   int i, j, frames;
+
+   for (i = 0; i < request; i++)
+     {
+        o = evas_object_vg_add(e);
+        evas_object_vg_file_set(o, LOTTIE_FILE, NULL);
+        evas_object_resize(o, 500, 500);
+        evas_object_show(o);
+
+        frames = evas_object_vg_animated_frame_count_get(o);
+        for (j = 0; j < 4; j++)
+          {
+             evas_object_vg_animated_frame_set(o, j * frames / 4);
+
+             l = evas_render_updates(e);
+             evas_render_updates_free(l);
+          }
+
+        evas_object_del(o);
+     }
+
+   evas_free(e);
+}
+
+static void
+_svg_list(const char *name, const char *path, void *data)
+{
+   Eina_List **files = data;
+   char buf[PATH_MAX];
+
+   snprintf(buf, sizeof(buf), "%s/%s", path, name);
+   if (eina_str_has_extension(name, ".svg"))
+     *files = eina_list_append(*files, eina_stringshare_add(buf));
+   else if (!strchr(name, '.'))
+     eina_file_dir_list(buf, EINA_FALSE, _svg_list, files);
+}
+
+/* Loading every icon of a theme once, as done at startup. */
+static void
+evas_bench_vg_svg_theme(int request)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *o;
+   Eina_List *files = NULL, *l;
+   const char *file;
+   int i;
+
+   eina_file_dir_list(ICON_THEME_DIR, EINA_FALSE, _svg_list, &files);
+
+   for (i = 0; i < request; i++)
+     EINA_LIST_FOREACH(files, l, file)
+       {
+          o = evas_object_vg_add(e);
+          evas_object_vg_file_set(o, file, NULL);
+          evas_object_del(o);
+       }
+
+   EINA_LIST_FREE(files, file)
+     eina_stringshare_del(file);
+   evas_free(e);
+}
+
+void evas_bench_vg(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "lottie-large", EINA_BENCHMARK(evas_bench_vg_lottie_large), 10, 120, 10);
+   eina_benchmark_register(bench, "lottie-grid", EINA_BENCHMARK(evas_bench_vg_lottie_grid), 10, 120, 10);
+   eina_benchmark_register(bench, "svg-theme", EINA_BENCHMARK(evas_bench_vg_svg_theme), 1, 5, 1);
+   eina_benchmark_register(bench, "lottie-load", EINA_BENCHMARK(evas_bench_vg_lottie_load), 10, 100, 10);
+   eina_benchmark_register(bench, "lottie-large-cached", EINA_BENCHMARK(evas_bench_vg_lottie_large_cached), 60, 600, 60);
+   eina_benchmark_register(bench, "lottie-grid-cached", EINA_BENCHMARK(evas_bench_vg_lottie_grid_cached), 60, 600, 60);
+}
@@ -133,6 +133,7 @@ main_help(void)
       "-Ddefine_val=to          CPP style define to define input macro definitions to the .edc source\n"
       "-fastcomp                Use a faster compression algorithm (LZ4) (mutually exclusive with -fastdecomp)\n"
       "-fastdecomp              Use a faster decompression algorithm (LZ4HC) (mutually exclusive with -fastcomp)\n"
+      "-zstd                    Use a dictionary trained on the file with Zstandard, best ratio with a fast decompression\n"
       "-threads                 Compile the edje file using multiple parallel threads (by default)\n"
       "-nothreads               Compile the edje file using only the main loop\n"
       "-N                       Use the first segment of each group name as a namespace to verify parts/signals\n"
@@ -296,6 +297,10 @@ main(int argc, char **argv)
           {
              compress_mode = EET_COMPRESSION_VERYFAST;
           }
+        else if (!strcmp(argv[i], "-zstd"))
+          {
+             compress_mode = EET_COMPRESSION_ZSTD;
+          }
         else if (!strcmp(argv[i], "-threads"))
           {
              threads = 1;
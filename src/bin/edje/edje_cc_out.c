@@ -26,6 +26,9 @@
 #include <lua.h>
 #include <lauxlib.h>
 
+/* Same as the zstd default, a bigger one does not help small themes */
+#define EDJE_CC_DICTIONARY_SIZE (110 * 1024)
+
 typedef struct _External_Lookup External_Lookup;
 typedef struct _Part_Lookup     Part_Lookup;
 typedef struct _Part_Lookup_Key Part_Lookup_Key;
@@ -2857,6 +2860,14 @@ data_write(void)
         exit(-1);
      }
 
+   /* Collections, scripts and sources all look alike, share a dictionary */
+   if (compress_mode == EET_COMPRESSION_ZSTD)
+     eet_compression_dictionary_train(ef, EDJE_CC_DICTIONARY_SIZE);
+   if (threads)
+     eet_compression_threads_set(ef, -1);
+   /* Themes are opened by every application, let them skip the directory */
+   eet_directory_index_set(ef, EINA_TRUE);
+
    if ((edje_file->efl_version.major <= 1) && (edje_file->efl_version.minor <= 18)
        && edje_file->has_textblock_min_max)
      {
@@ -373,6 +373,59 @@ do_eet_remove(const char *file,
    eet_close(ef);
 } /* do_eet_remove */
 
+static void
+do_eet_zstd(const char  *file,
+            unsigned int dictionary_size)
+{
+   Eet_File *ef;
+   Eina_Iterator *it;
+   Eet_Entry *entry;
+   Eina_List *keys = NULL;
+   char *key;
+   void *data;
+   int size;
+
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   if (!ef)
+     {
+        ERR("cannot open for read+write: %s", file);
+        exit(-1);
+     }
+
+   /* ciphered entries can't be read back without their key */
+   it = eet_list_entries(ef);
+   EINA_ITERATOR_FOREACH(it, entry)
+     {
+        if (entry->compression && !entry->ciphered && !entry->alias)
+          keys = eina_list_append(keys, strdup(entry->name));
+     }
+   eina_iterator_free(it);
+
+   eet_compression_dictionary_train(ef, dictionary_size);
+   EINA_LIST_FREE(keys, key)
+     {
+        data = eet_read(ef, key, &size);
+        if (data)
+          {
+             eet_write(ef, key, data, size, EET_COMPRESSION_ZSTD);
+             free(data);
+          }
+        else
+          ERR("cannot read key %s", key);
+        free(key);
+     }
+
+   eet_close(ef);
+} /* do_eet_zstd */
+
+static int
+_eet_compression_get(const char *compress)
+{
+   if (!strcmp(compress, "zstd"))
+     return EET_COMPRESSION_ZSTD;
+   return atoi(compress);
+}
+
 static void
 do_eet_check(const char *file)
 {
@@ -459,9 +512,10 @@ help:
           "  eet -l [-v] FILE.EET                               list all keys in FILE.EET\n"
           "  eet -x FILE.EET KEY [OUT-FILE] [CRYPTO_KEY]        extract data stored in KEY in FILE.EET and write to OUT-FILE or standard output\n"
           "  eet -d FILE.EET KEY [OUT-FILE] [CRYPTO_KEY]        extract and decode data stored in KEY in FILE.EET and write to OUT-FILE or standard output\n"
-          "  eet -i FILE.EET KEY IN-FILE COMPRESS [CRYPTO_KEY]  insert data to KEY in FILE.EET from IN-FILE and if COMPRESS is 1, compress it\n"
-          "  eet -e FILE.EET KEY IN-FILE COMPRESS [CRYPTO_KEY]  insert and encode to KEY in FILE.EET from IN-FILE and if COMPRESS is 1, compress it\n"
+          "  eet -i FILE.EET KEY IN-FILE COMPRESS [CRYPTO_KEY]  insert data to KEY in FILE.EET from IN-FILE and if COMPRESS is 1 or zstd, compress it\n"
+          "  eet -e FILE.EET KEY IN-FILE COMPRESS [CRYPTO_KEY]  insert and encode to KEY in FILE.EET from IN-FILE and if COMPRESS is 1 or zstd, compress it\n"
           "  eet -r FILE.EET KEY                                remove KEY in FILE.EET\n"
+          "  eet -z FILE.EET [DICTIONARY_SIZE]                  recompress FILE.EET with zstd and a dictionary trained on its entries\n"
           "  eet -c FILE.EET                                    report and check the signature information of an eet file\n"
           "  eet -s FILE.EET PRIVATE_KEY PUBLIC_KEY             sign FILE.EET with PRIVATE_KEY and attach PUBLIC_KEY as it's certificate\n"
           "  eet -t FILE.EET                                    give some statistic about a file\n"
@@ -530,19 +584,26 @@ help:
    else if ((!strcmp(argv[1], "-i")) && (argc > 5))
      {
         if (argc > 6)
-          do_eet_insert(argv[2], argv[3], argv[4], atoi(argv[5]), argv[6]);
+          do_eet_insert(argv[2], argv[3], argv[4], _eet_compression_get(argv[5]), argv[6]);
         else
-          do_eet_insert(argv[2], argv[3], argv[4], atoi(argv[5]), NULL);
+          do_eet_insert(argv[2], argv[3], argv[4], _eet_compression_get(argv[5]), NULL);
      }
    else if ((!strcmp(argv[1], "-e")) && (argc > 5))
      {
         if (argc > 6)
-          do_eet_encode(argv[2], argv[3], argv[4], atoi(argv[5]), argv[6]);
+          do_eet_encode(argv[2], argv[3], argv[4], _eet_compression_get(argv[5]), argv[6]);
         else
-          do_eet_encode(argv[2], argv[3], argv[4], atoi(argv[5]), NULL);
+          do_eet_encode(argv[2], argv[3], argv[4], _eet_compression_get(argv[5]), NULL);
      }
    else if ((!strcmp(argv[1], "-r")) && (argc > 3))
      do_eet_remove(argv[2], argv[3]);
+   else if ((!strcmp(argv[1], "-z")) && (argc > 2))
+     {
+        if (argc > 3)
+          do_eet_zstd(argv[2], atoi(argv[3]));
+        else
+          do_eet_zstd(argv[2], 110 * 1024);
+     }
    else if ((!strcmp(argv[1], "-c")) && (argc > 2))
      do_eet_check(argv[2]);
    else if ((!strcmp(argv[1], "-s")) && (argc > 4))
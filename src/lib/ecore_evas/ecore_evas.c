@@ -159,7 +159,8 @@ ecore_evas_render(Ecore_Evas *ee)
 
    if (ee->in_async_render)
      {
-        DBG("ee=%p is rendering, skip.", ee);
+        DBG("ee=%p is rendering, evaluate the next frame.", ee);
+        evas_render_async(ee->evas);
         return EINA_FALSE;
      }
 
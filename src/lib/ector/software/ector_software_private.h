@@ -155,6 +155,14 @@ typedef void (*Ector_Thread_Worker_Cb)(void *data, Ector_Software_Thread *thread
 void ector_software_wait(Ector_Thread_Worker_Cb cb, Eina_Free_Cb done, void *data);
 void ector_software_schedule(Ector_Thread_Worker_Cb cb, Eina_Free_Cb done, void *data);
 
+typedef void (*Ector_Software_Slice_Cb)(void *data, int slice);
+
+int  ector_software_slices_count_get(void);
+void ector_software_slices_run(Ector_Software_Slice_Cb cb, void *data, int count);
+
+// Composition of src over dst through the alpha of a matte
+typedef void (*Ector_Comp_Matte_Func)(uint32_t *dst, uint32_t *src, const uint32_t *matte, int len, Eina_Bool inverse);
+
 void ector_software_gradient_color_update(Ector_Renderer_Software_Gradient_Data *gdata);
 
 #endif
@@ -11,6 +11,29 @@
 
 #include "draw.h"
 
+#ifdef BUILD_SSE3
+void _comp_matte_sse3(uint32_t *dst, uint32_t *src, const uint32_t *matte, int len, Eina_Bool inverse);
+#endif
+
+static void
+_comp_matte_generic(uint32_t *dst, uint32_t *src, const uint32_t *matte, int len, Eina_Bool inverse)
+{
+   for (int i = 0; i < len; i++)
+     {
+        if (!inverse)
+          *src = draw_mul_256(((*matte)>>24), *src);
+        else if (*matte)
+          *src = draw_mul_256((255 - ((*matte)>>24)), *src);
+        int alpha = 255 - ((*src) >> 24);
+        *dst = *src + draw_mul_256(alpha, *dst);
+        ++src;
+        ++matte;
+        ++dst;
+     }
+}
+
+static Ector_Comp_Matte_Func _ector_comp_matte = _comp_matte_generic;
+
 static void
 _blend_argb(int count, const SW_FT_Span *spans, void *user_data)
 {
@@ -60,20 +83,11 @@ _comp_matte_alpha(int count, const SW_FT_Span *spans, void *user_data)
         uint32_t *target = buffer + ((pix_stride * spans->y) + spans->x);
         uint32_t *mtarget =
               mbuffer + ((comp_stride * spans->y) + spans->x);
-        uint32_t *temp = tbuffer;
-        memset(temp, 0x00, sizeof(uint32_t) * spans->len);
-        comp_func(temp, spans->len, color, spans->coverage);
+        memset(tbuffer, 0x00, sizeof(uint32_t) * spans->len);
+        comp_func(tbuffer, spans->len, color, spans->coverage);
 
         //composite
-        for (int i = 0; i < spans->len; i++)
-          {
-             *temp = draw_mul_256(((*mtarget)>>24), *temp);
-             int alpha = 255 - ((*temp) >> 24);
-             *target = *temp + draw_mul_256(alpha, *target);
-             ++temp;
-             ++mtarget;
-             ++target;
-          }
+        _ector_comp_matte(target, tbuffer, mtarget, spans->len, EINA_FALSE);
         ++spans;
      }
 }
@@ -105,21 +119,11 @@ _comp_matte_alpha_inv(int count, const SW_FT_Span *spans, void *user_data)
         uint32_t *target = buffer + ((pix_stride * spans->y) + spans->x);
         uint32_t *mtarget =
               mbuffer + ((comp_stride * spans->y) + spans->x);
-        uint32_t *temp = tbuffer;
-        memset(temp, 0x00, sizeof(uint32_t) * spans->len);
-        comp_func(temp, spans->len, color, spans->coverage);
+        memset(tbuffer, 0x00, sizeof(uint32_t) * spans->len);
+        comp_func(tbuffer, spans->len, color, spans->coverage);
 
         //composite
-        for (int i = 0; i < spans->len; i++)
-          {
-             if (*mtarget)
-                *temp = draw_mul_256((255 - ((*mtarget)>>24)), *temp);
-             int alpha = 255 - ((*temp) >> 24);
-             *target = *temp + draw_mul_256(alpha, *target);
-             ++temp;
-             ++mtarget;
-             ++target;
-          }
+        _ector_comp_matte(target, tbuffer, mtarget, spans->len, EINA_TRUE);
         ++spans;
      }
 }
@@ -318,17 +322,9 @@ _blend_gradient_alpha(int count, const SW_FT_Span *spans, void *user_data)
              int l = MIN(length, BLEND_GRADIENT_BUFFER_SIZE);
              //FIXME: span->x must have adding an offset as much as subtracted length...
              fetchfunc(gbuffer, sd, spans->y, spans->x, l);
-             uint32_t *temp = gbuffer;
-
-             for (int i = 0; i < l; i++)
-               {
-                  *temp = draw_mul_256(((*mtarget)>>24), *temp);
-                  int alpha = 255 - ((*temp) >> 24);
-                  *target = *temp + draw_mul_256(alpha, *target);
-                  ++temp;
-                  ++mtarget;
-                  ++target;
-               }
+             _ector_comp_matte(target, gbuffer, mtarget, l, EINA_FALSE);
+             target += l;
+             mtarget += l;
              length -= l;
           }
         ++spans;
@@ -368,18 +364,9 @@ _blend_gradient_alpha_inv(int count, const SW_FT_Span *spans, void *user_data)
              int l = MIN(length, BLEND_GRADIENT_BUFFER_SIZE);
              //FIXME: span->x must have adding an offset as much as subtracted length...
              fetchfunc(gbuffer, sd, spans->y, spans->x, l);
-             uint32_t *temp = gbuffer;
-
-             for (int i = 0; i < l; i++)
-               {
-                  if (*mtarget)
-                    *temp = draw_mul_256((255 - ((*mtarget)>>24)), *temp);
-                  int alpha = 255 - ((*temp) >> 24);
-                  *target = *temp + draw_mul_256(alpha, *target);
-                  ++temp;
-                  ++mtarget;
-                  ++target;
-               }
+             _ector_comp_matte(target, gbuffer, mtarget, l, EINA_TRUE);
+             target += l;
+             mtarget += l;
              length -= l;
           }
         ++spans;
@@ -688,6 +675,10 @@ void ector_software_rasterizer_init(Software_Rasterizer *rasterizer)
    rasterizer->fill_data.blend = 0;
    efl_draw_init();
    ector_software_gradient_init();
+#ifdef BUILD_SSE3
+   if (eina_cpu_features_get() & EINA_CPU_SSE3)
+     _ector_comp_matte = _comp_matte_sse3;
+#endif
 }
 
 void ector_software_thread_shutdown(Ector_Software_Thread *thread)
@@ -920,6 +911,64 @@ ector_software_rasterizer_radial_gradient_set(Software_Rasterizer *rasterizer,
    rasterizer->fill_data.type = RadialGradient;
 }
 
+/* Large shapes are blended in horizontal bands, in parallel. Bands are cut
+ * between rows so they never touch the same pixels. */
+#define BANDS_MAX 32
+#define BAND_SPANS_MIN 512
+
+typedef struct _Span_Bands
+{
+   Span_Data        *fill_data;
+   const SW_FT_Span *spans;
+   int               first[BANDS_MAX + 1]; //first span of each band
+} Span_Bands;
+
+static void
+_blend_band(void *data, int band)
+{
+   Span_Bands *bands = data;
+   int start = bands->first[band];
+   int end = bands->first[band + 1];
+
+   bands->fill_data->blend(end - start, bands->spans + start, bands->fill_data);
+}
+
+static Eina_Bool
+_blend_bands(Span_Data *fill_data, const Shape_Rle_Data *rle)
+{
+   Span_Bands bands;
+   int count, i, band = 0;
+
+   // Compositions read and write a whole matte or mask buffer
+   if (fill_data->comp) return EINA_FALSE;
+
+   // Two bands per thread to balance uneven rows a bit
+   count = ector_software_slices_count_get() * 2;
+   if (count > BANDS_MAX) count = BANDS_MAX;
+   if (count > rle->size / BAND_SPANS_MIN) count = rle->size / BAND_SPANS_MIN;
+   if (count < 2) return EINA_FALSE;
+
+   bands.fill_data = fill_data;
+   bands.spans = rle->spans;
+   bands.first[0] = 0;
+   for (i = 1; i < count; i++)
+     {
+        int s = (rle->size * i) / count;
+
+        // spans are sorted on y
+        while ((s < rle->size) && (rle->spans[s].y == rle->spans[s - 1].y))
+          s++;
+        if (s >= rle->size) break;
+        if (s > bands.first[band])
+          bands.first[++band] = s;
+     }
+   bands.first[++band] = rle->size;
+   if (band < 2) return EINA_FALSE;
+
+   ector_software_slices_run(_blend_band, &bands, band);
+   return EINA_TRUE;
+}
+
 void
 ector_software_rasterizer_draw_rle_data(Software_Rasterizer *rasterizer,
                                         int x, int y, uint32_t mul_col,
@@ -941,6 +990,7 @@ ector_software_rasterizer_draw_rle_data(Software_Rasterizer *rasterizer,
    _setup_span_fill_matrix(rasterizer);
    _adjust_span_fill_methods(&rasterizer->fill_data);
 
-   if (rasterizer->fill_data.blend)
+   if (rasterizer->fill_data.blend &&
+       !_blend_bands(&rasterizer->fill_data, rle))
      rasterizer->fill_data.blend(rle->size, rle->spans, &rasterizer->fill_data);
 }
@@ -0,0 +1,84 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Eina.h>
+#include <Ector.h>
+#include <software/Ector_Software.h>
+
+#include "ector_private.h"
+#include "ector_software_private.h"
+
+#ifdef BUILD_SSE3
+#include <immintrin.h>
+
+// Same as draw_mul_256(), each 32bits components of a must be 0x00AA00AA
+static inline __m128i
+v4_mul_256_sse2(__m128i c, __m128i a)
+{
+   const __m128i ag_mask = _mm_set1_epi32(0xFF00FF00);
+   const __m128i rb_mask = _mm_set1_epi32(0x00FF00FF);
+
+   __m128i v_ag = _mm_srli_epi32(_mm_and_si128(ag_mask, c), 8);
+   v_ag = _mm_and_si128(ag_mask, _mm_mullo_epi16(a, v_ag));
+
+   __m128i v_rb = _mm_mullo_epi16(a, _mm_and_si128(rb_mask, c));
+   v_rb = _mm_and_si128(rb_mask, _mm_srli_epi32(v_rb, 8));
+
+   return _mm_add_epi32(v_ag, v_rb);
+}
+
+static inline __m128i
+v4_alpha_sse2(__m128i c)
+{
+   __m128i a = _mm_srli_epi32(c, 24);
+
+   return _mm_or_si128(a, _mm_slli_epi32(a, 16));
+}
+
+// Gives exactly the same results as _comp_matte_generic()
+void
+_comp_matte_sse3(uint32_t *dst, uint32_t *src, const uint32_t *matte, int len, Eina_Bool inverse)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i v_255 = _mm_set1_epi32(0x00FF00FF);
+   const __m128i v_256 = _mm_set1_epi32(0x01000100);
+   int i;
+
+   for (i = 0; i + 4 <= len; i += 4)
+     {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i m = _mm_loadu_si128((const __m128i *)(matte + i));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i a = v4_alpha_sse2(m);
+
+        if (inverse)
+          {
+             // a fully transparent matte keeps the source as is
+             __m128i keep = _mm_cmpeq_epi32(m, zero);
+
+             a = _mm_sub_epi16(v_255, a);
+             a = _mm_or_si128(_mm_and_si128(keep, v_256),
+                              _mm_andnot_si128(keep, a));
+          }
+        s = v4_mul_256_sse2(s, a);
+        a = _mm_sub_epi16(v_255, v4_alpha_sse2(s));
+        d = _mm_add_epi32(s, v4_mul_256_sse2(d, a));
+        _mm_storeu_si128((__m128i *)(dst + i), d);
+     }
+
+   for (; i < len; i++)
+     {
+        uint32_t s = src[i];
+        int alpha;
+
+        if (!inverse)
+          s = draw_mul_256(matte[i] >> 24, s);
+        else if (matte[i])
+          s = draw_mul_256(255 - (matte[i] >> 24), s);
+        alpha = 255 - (s >> 24);
+        dst[i] = s + draw_mul_256(alpha, dst[i]);
+     }
+}
+
+#endif
@@ -52,6 +52,9 @@ _prepare_process(void *data, Eina_Thread t)
 
         todo.cb(todo.data, th);
 
+        // Slices of a job do not report back to the render queue
+        if (!todo.done) continue;
+
         task = eina_thread_queue_send(render_queue, sizeof (Ector_Software_Task), &ref);
         task->cb = todo.cb;
         task->data = todo.data;
@@ -197,6 +200,132 @@ ector_software_wait(Ector_Thread_Worker_Cb cb, Eina_Free_Cb done, void *data)
           covering.data != data);
 }
 
+/* Data parallel jobs: the slices are shared between the calling thread and
+ * the preparing threads. The calling thread always works too, so a job
+ * completes even if all the preparing threads are busy. Late threads find
+ * nothing left to do, the job is freed by the last one to leave it. */
+typedef struct _Ector_Software_Slices Ector_Software_Slices;
+
+struct _Ector_Software_Slices
+{
+   Ector_Software_Slice_Cb cb;
+   void *data;
+   Eina_Lock lock;
+   Eina_Condition cond;
+   int count;
+   int next;
+   int done;
+   int refs;
+};
+
+/* Called and returns with the job lock held */
+static void
+_ector_software_slices_work(Ector_Software_Slices *job)
+{
+   while (job->next < job->count)
+     {
+        int slice = job->next++;
+
+        eina_lock_release(&job->lock);
+        job->cb(job->data, slice);
+        eina_lock_take(&job->lock);
+
+        if (++job->done == job->count)
+          eina_condition_broadcast(&job->cond);
+     }
+}
+
+/* Called with the job lock held */
+static void
+_ector_software_slices_release(Ector_Software_Slices *job)
+{
+   Eina_Bool last;
+
+   last = (--job->refs == 0);
+   eina_lock_release(&job->lock);
+   if (!last) return;
+
+   eina_condition_free(&job->cond);
+   eina_lock_free(&job->lock);
+   free(job);
+}
+
+static void
+_ector_software_slices_worker(void *data, Ector_Software_Thread *thread EINA_UNUSED)
+{
+   Ector_Software_Slices *job = data;
+
+   eina_lock_take(&job->lock);
+   _ector_software_slices_work(job);
+   _ector_software_slices_release(job);
+}
+
+int
+ector_software_slices_count_get(void)
+{
+   if (!ths) return 1;
+   return cpu_core + 1;
+}
+
+void
+ector_software_slices_run(Ector_Software_Slice_Cb cb, void *data, int count)
+{
+   Ector_Software_Slices *job = NULL;
+   unsigned int i, helpers;
+   int slice;
+
+   if (count <= 0) return;
+
+   helpers = (unsigned int) count - 1;
+   if (helpers > cpu_core) helpers = cpu_core;
+   if (ths && helpers)
+     job = calloc(1, sizeof (Ector_Software_Slices));
+   if (job && !eina_lock_new(&job->lock))
+     {
+        free(job);
+        job = NULL;
+     }
+   if (job && !eina_condition_new(&job->cond, &job->lock))
+     {
+        eina_lock_free(&job->lock);
+        free(job);
+        job = NULL;
+     }
+   if (!job)
+     {
+        for (slice = 0; slice < count; slice++)
+          cb(data, slice);
+        return ;
+     }
+
+   job->cb = cb;
+   job->data = data;
+   job->count = count;
+   job->refs = helpers + 1;
+
+   for (i = 0; i < helpers; i++)
+     {
+        Ector_Software_Thread *t;
+        Ector_Software_Task *task;
+        void *ref;
+
+        t = &ths[current];
+        current = (current + 1) % cpu_core;
+
+        task = eina_thread_queue_send(t->queue, sizeof (Ector_Software_Task), &ref);
+        task->cb = _ector_software_slices_worker;
+        task->done = NULL;
+        task->data = job;
+        eina_thread_queue_send_done(t->queue, ref);
+     }
+
+   eina_lock_take(&job->lock);
+   _ector_software_slices_work(job);
+   while (job->done < job->count)
+     eina_condition_wait(&job->cond);
+   _ector_software_slices_release(job);
+}
+
 static Ector_Renderer *
 _ector_software_surface_ector_surface_renderer_factory_new(Eo *obj,
                                                            Ector_Software_Surface_Data *pd EINA_UNUSED,
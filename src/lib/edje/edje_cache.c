@@ -350,6 +350,7 @@ _edje_file_coll_open(Edje_File *edf, const char *coll)
    ce->ref = edc;
 
    _edje_programs_patterns_init(edc);
+   _edje_part_dependencies_build(edc);
 
    n = edc->programs.fnmatch_count +
      edc->programs.strcmp_count +
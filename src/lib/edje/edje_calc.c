@@ -142,6 +142,20 @@ _edje_calc_handle_state_clip(Edje *ed, Edje_Real_Part *ep, Edje_Calc_Params *pf)
    evas_object_clip_set(_edje_calc_get_part_object(ep), clip_obj);
 }
 
+/* Only ep changed, the next recalc can skip the parts that do not depend
+ * on it instead of going through the whole table. */
+static inline void
+_edje_part_dirty(Edje *ed, Edje_Real_Part *ep)
+{
+#ifdef EDJE_CALC_CACHE
+   ep->invalidate = EINA_TRUE;
+   ed->dirty_parts = EINA_TRUE;
+#else
+   (void)ep;
+   ed->dirty = EINA_TRUE;
+#endif
+}
+
 void
 _edje_part_pos_set(Edje *ed, Edje_Real_Part *ep, int mode, FLOAT_T pos, FLOAT_T v1, FLOAT_T v2, FLOAT_T v3, FLOAT_T v4)
 {
@@ -271,11 +285,8 @@ _edje_part_pos_set(Edje *ed, Edje_Real_Part *ep, int mode, FLOAT_T pos, FLOAT_T
 
    ep->description_pos = npos;
 
-   ed->dirty = EINA_TRUE;
+   _edje_part_dirty(ed, ep);
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   ep->invalidate = EINA_TRUE;
-#endif
 }
 
 /**
@@ -932,11 +943,8 @@ _edje_part_description_apply(Edje *ed, Edje_Real_Part *ep, const char *d1, doubl
      }
 
    ed->recalc_hints = EINA_TRUE;
-   ed->dirty = EINA_TRUE;
+   _edje_part_dirty(ed, ep);
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   ep->invalidate = EINA_TRUE;
-#endif
 }
 
 void
@@ -963,6 +971,209 @@ _edje_recalc(Edje *ed)
    evas_object_smart_changed(ed->obj);
 }
 
+static void
+_edje_part_dependency_add(Edje_Part_Collection *edc, unsigned int *mark,
+                          unsigned int *cursor, unsigned int part, int id)
+{
+   if ((id < 0) || ((unsigned int)id >= edc->parts_count) ||
+       ((unsigned int)id == part) || (mark[id] == part + 1))
+     return;
+   mark[id] = part + 1;
+
+   /* The first pass only counts, the second one fills */
+   if (edc->dependencies.dependents)
+     edc->dependencies.dependents[cursor[id]++] = part;
+   else
+     edc->dependencies.offsets[id + 1]++;
+}
+
+static void
+_edje_part_dependencies_desc_add(Edje_Part_Collection *edc, unsigned int *mark,
+                                 unsigned int *cursor, unsigned int part,
+                                 Edje_Part *ep, Edje_Part_Description_Common *desc)
+{
+   if (!desc) return;
+
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->rel1.id_x);
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->rel1.id_y);
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->rel2.id_x);
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->rel2.id_y);
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->clip_to_id);
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->map.id_persp);
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->map.id_light);
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->map.rot.id_center);
+   _edje_part_dependency_add(edc, mark, cursor, part, desc->map.zoom.id_center);
+
+   switch (ep->type)
+     {
+      case EDJE_PART_TYPE_PROXY:
+        _edje_part_dependency_add(edc, mark, cursor, part,
+                                  ((Edje_Part_Description_Proxy *)desc)->proxy.id);
+        break;
+
+      case EDJE_PART_TYPE_TEXT:
+      case EDJE_PART_TYPE_TEXTBLOCK:
+        _edje_part_dependency_add(edc, mark, cursor, part,
+                                  ((Edje_Part_Description_Text *)desc)->text.id_source);
+        _edje_part_dependency_add(edc, mark, cursor, part,
+                                  ((Edje_Part_Description_Text *)desc)->text.id_text_source);
+        break;
+
+      default:
+        break;
+     }
+}
+
+/*
+ * For each part, the parts that read its geometry in any of their states:
+ * relative positioning, clipping, dragging, maps, proxies and text sources.
+ * When a recalc is only caused by parts changing state, position or drag
+ * value, going through what can be reached from them in this graph gives
+ * the same result as a full pass.
+ */
+void
+_edje_part_dependencies_build(Edje_Part_Collection *edc)
+{
+   unsigned int *mark = NULL;
+   unsigned int *cursor = NULL;
+   unsigned int i, j, count;
+   int pass;
+
+   if ((!edc->parts_count) || (edc->parts_count > USHRT_MAX)) return;
+
+   mark = calloc(edc->parts_count, sizeof (unsigned int));
+   edc->dependencies.offsets = calloc(edc->parts_count + 1, sizeof (unsigned int));
+   edc->dependencies.always = malloc(edc->parts_count * sizeof (unsigned short));
+   if ((!mark) || (!edc->dependencies.offsets) || (!edc->dependencies.always))
+     goto on_error;
+
+   for (pass = 0; pass < 2; pass++)
+     {
+        for (i = 0; i < edc->parts_count; i++)
+          {
+             Edje_Part *ep = edc->parts[i];
+
+             _edje_part_dependency_add(edc, mark, cursor, i, ep->clip_to_id);
+             _edje_part_dependency_add(edc, mark, cursor, i, ep->dragable.confine_id);
+             _edje_part_dependency_add(edc, mark, cursor, i, ep->dragable.threshold_id);
+             _edje_part_dependencies_desc_add(edc, mark, cursor, i, ep, ep->default_desc);
+             for (j = 0; j < ep->other.desc_count; j++)
+               _edje_part_dependencies_desc_add(edc, mark, cursor, i, ep, ep->other.desc[j]);
+          }
+        if (pass) break;
+
+        for (i = 0; i < edc->parts_count; i++)
+          edc->dependencies.offsets[i + 1] += edc->dependencies.offsets[i];
+        count = edc->dependencies.offsets[edc->parts_count];
+
+        edc->dependencies.dependents = malloc((count ? count : 1) * sizeof (unsigned short));
+        cursor = malloc(edc->parts_count * sizeof (unsigned int));
+        if ((!edc->dependencies.dependents) || (!cursor)) goto on_error;
+        memcpy(cursor, edc->dependencies.offsets, edc->parts_count * sizeof (unsigned int));
+        memset(mark, 0, edc->parts_count * sizeof (unsigned int));
+     }
+
+   /* 3D nodes and physics bodies are updated from outside the graph */
+   for (i = 0; i < edc->parts_count; i++)
+     {
+        Edje_Part *ep = edc->parts[i];
+
+        if ((ep->type == EDJE_PART_TYPE_MESH_NODE) ||
+            (ep->type == EDJE_PART_TYPE_LIGHT) ||
+            (ep->type == EDJE_PART_TYPE_CAMERA)
+#ifdef HAVE_EPHYSICS
+            || (ep->physics_body)
+#endif
+           )
+          edc->dependencies.always[edc->dependencies.always_count++] = i;
+     }
+   edc->dependencies.parts_count = edc->parts_count;
+
+   free(cursor);
+   free(mark);
+   return;
+
+on_error:
+   free(cursor);
+   free(mark);
+   _edje_part_dependencies_free(edc);
+}
+
+void
+_edje_part_dependencies_free(Edje_Part_Collection *edc)
+{
+   free(edc->dependencies.offsets);
+   free(edc->dependencies.dependents);
+   free(edc->dependencies.always);
+   memset(&edc->dependencies, 0, sizeof (edc->dependencies));
+}
+
+#ifdef EDJE_CALC_CACHE
+/* Recalc the invalidated parts and everything depending on them, the others
+ * keep what they got from the previous pass. Returns EINA_FALSE when a full
+ * pass is needed instead. */
+static Eina_Bool
+_edje_recalc_dirty_parts(Edje *ed)
+{
+   Edje_Part_Collection *edc = ed->collection;
+   Edje_Real_Part *ep;
+   unsigned short *queue;
+   unsigned int head = 0, tail = 0;
+   unsigned int i, j;
+
+   if ((!edc) || (!edc->dependencies.offsets) ||
+       (edc->dependencies.parts_count != ed->table_parts_size) ||
+       (ed->all_part_change) || (ed->text_part_change) ||
+       (ed->need_map_update) || (ed->calc_only))
+     return EINA_FALSE;
+
+   queue = alloca(ed->table_parts_size * sizeof (unsigned short));
+
+   /* Custom states can point anywhere, the graph does not know about them */
+   for (i = 0; i < ed->table_parts_size; i++)
+     {
+        ep = ed->table_parts[i];
+        ep->calculating = FLAG_NONE;
+        if ((ep->invalidate) || (ep->custom))
+          {
+             ep->calculated = FLAG_NONE;
+             queue[tail++] = i;
+          }
+        else
+          ep->calculated = FLAG_XY;
+     }
+   for (i = 0; i < edc->dependencies.always_count; i++)
+     {
+        ep = ed->table_parts[edc->dependencies.always[i]];
+        if (ep->calculated == FLAG_NONE) continue;
+        ep->calculated = FLAG_NONE;
+        queue[tail++] = edc->dependencies.always[i];
+     }
+
+   while (head < tail)
+     {
+        i = queue[head++];
+        for (j = edc->dependencies.offsets[i]; j < edc->dependencies.offsets[i + 1]; j++)
+          {
+             ep = ed->table_parts[edc->dependencies.dependents[j]];
+             if (ep->calculated == FLAG_NONE) continue;
+             ep->calculated = FLAG_NONE;
+             queue[tail++] = edc->dependencies.dependents[j];
+          }
+     }
+
+   for (i = 0; i < tail; i++)
+     {
+        ep = ed->table_parts[queue[i]];
+        if (ep->calculated != FLAG_XY)
+          _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
+     }
+   ed->recalc_count = tail;
+
+   return EINA_TRUE;
+}
+#endif
+
 static
 #ifdef EDJE_CALC_CACHE
 Eina_Bool
@@ -999,6 +1210,7 @@ _edje_recalc_table_parts(Edje *ed
         if (ep->calculated != FLAG_XY) // FIXME: this is always true (see for above)
           _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
      }
+   ed->recalc_count = ed->table_parts_size;
 #ifdef EDJE_CALC_CACHE
    return need_reinit_state;
 #endif
@@ -1011,13 +1223,20 @@ _edje_recalc_do(Edje *ed)
    Eina_Bool need_calc;
 #ifdef EDJE_CALC_CACHE
    Eina_Bool need_reinit_state = EINA_FALSE;
+   Eina_Bool partial;
 #endif
 
    ed->has_size = EINA_TRUE;
 
    need_calc = evas_object_smart_need_recalculate_get(ed->obj);
    evas_object_smart_need_recalculate_set(ed->obj, 0);
+#ifdef EDJE_CALC_CACHE
+   if ((!ed->dirty) && (!ed->dirty_parts)) return;
+   partial = !ed->dirty;
+   ed->dirty_parts = EINA_FALSE;
+#else
    if (!ed->dirty) return;
+#endif
    ed->dirty = EINA_FALSE;
    ed->state++;
 
@@ -1031,14 +1250,16 @@ _edje_recalc_do(Edje *ed)
      }
 
    if (EINA_LIKELY(ed->table_parts_size > 0))
+     {
 #ifdef EDJE_CALC_CACHE
-     need_reinit_state =
-#endif
-       _edje_recalc_table_parts(ed
-#ifdef EDJE_CALC_CACHE
-                                , need_reinit_state
+        if ((!partial) || (need_reinit_state) ||
+            (!_edje_recalc_dirty_parts(ed)))
+          need_reinit_state =
+            _edje_recalc_table_parts(ed, need_reinit_state);
+#else
+        _edje_recalc_table_parts(ed);
 #endif
-                               );
+     }
 
    if (!ed->calc_only) ed->recalc = EINA_FALSE;
 #ifdef EDJE_CALC_CACHE
@@ -1210,7 +1431,7 @@ _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y)
         ep->drag->x = x;
         ep->drag->tmp.x = 0;
         ep->drag->need_reset = 0;
-        ed->dirty = EINA_TRUE;
+        _edje_part_dirty(ed, ep);
         ed->recalc_call = EINA_TRUE;
      }
 
@@ -1219,7 +1440,7 @@ _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y)
         ep->drag->y = y;
         ep->drag->tmp.y = 0;
         ep->drag->need_reset = 0;
-        ed->dirty = EINA_TRUE;
+        _edje_part_dirty(ed, ep);
         ed->recalc_call = EINA_TRUE;
      }
 
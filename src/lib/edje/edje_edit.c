@@ -249,6 +249,10 @@ _edje_edit_efl_file_load(Eo *obj, Edje_Edit *eed)
 
    err = efl_file_load(efl_super(obj, MY_CLASS));
    if (err) return err;
+   /* Parts and their relations are about to change under the cached
+    * collection, so recalcs of this group can no longer be partial. */
+   if (eed->base->collection)
+     _edje_part_dependencies_free(eed->base->collection);
    /* TODO and maybes:
     *  * The whole point of this thing is keep track of stuff such as
     *    strings to free and who knows what, so we need to take care
@@ -2424,6 +2424,7 @@ _edje_collection_free(Edje_File *edf, Edje_Part_Collection *ec, Edje_Part_Collec
    if (ec->patterns.table_programs) free(ec->patterns.table_programs);
    ec->patterns.table_programs = NULL;
    ec->patterns.table_programs_size = 0;
+   _edje_part_dependencies_free(ec);
 
    if (ec->script) embryo_program_free(ec->script);
    _edje_lua2_script_unload(ec);
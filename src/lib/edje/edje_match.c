@@ -16,6 +16,38 @@ struct _Edje_States
    Eina_Bool   *has;
 };
 
+/* Patterns are matched by a DFA built while matching: a DFA state is the
+ * sorted set of NFA states reached so far, and its transition on a byte
+ * is computed by stepping that set the first time the byte is seen from
+ * it. Bytes that no pattern can tell apart share a class, so that each
+ * state only has a transition per class. */
+#define EDJE_MATCH_DFA_STATES_MAX 1024
+
+#define EDJE_MATCH_DFA_DEAD  0
+#define EDJE_MATCH_DFA_ERROR 1
+#define EDJE_MATCH_DFA_START 2
+
+typedef struct _Edje_Match_Dfa_State Edje_Match_Dfa_State;
+struct _Edje_Match_Dfa_State
+{
+   unsigned int *next; /* by class, 0 when not computed yet or id + 1 */
+   Edje_State   *states;
+   unsigned int *matches; /* patterns accepting here, sorted */
+   unsigned int  states_count;
+   unsigned int  matches_count;
+   unsigned int  id;
+   Eina_Bool     error : 1;
+};
+
+struct _Edje_Match_Dfa
+{
+   Eina_Hash    *sets;
+   Eina_Array    states;
+   unsigned int  classes_count;
+   unsigned char classes[256];
+   char          bytes[256]; /* one byte of each class */
+};
+
 static void
 _edje_match_states_free(Edje_States *states,
                         unsigned int states_size)
@@ -97,27 +129,38 @@ _edje_match_states_insert(Edje_States *list,
 
    i = (idx * (patterns_max_length + 1)) + pos;
 
-   if (i < list->size)
-     {
-        if (list->has[i]) return;
-     }
+   if (list->has[i]) return;
    list->has[i] = 1;
 
    i = list->size;
    list->states[i].idx = idx;
    list->states[i].pos = pos;
-   list->has[i] = 0;
    list->size++;
 }
 
 static void
 _edje_match_states_clear(Edje_States *list,
-                         unsigned int patterns_size EINA_UNUSED,
-                         unsigned int patterns_max_length EINA_UNUSED)
+                         unsigned int patterns_max_length)
 {
+   unsigned int i;
+
+   for (i = 0; i < list->size; ++i)
+     list->has[(list->states[i].idx * (patterns_max_length + 1))
+               + list->states[i].pos] = 0;
    list->size = 0;
 }
 
+static int
+_edje_match_states_cmp(const void *a, const void *b)
+{
+   const Edje_State *s1 = a;
+   const Edje_State *s2 = b;
+
+   if (s1->idx != s2->idx) return s1->idx < s2->idx ? -1 : 1;
+   if (s1->pos != s2->pos) return s1->pos < s2->pos ? -1 : 1;
+   return 0;
+}
+
 /* Token manipulation. */
 
 enum status
@@ -228,21 +271,367 @@ _edje_match_patterns_exec_token(const char *tok,
      }
 }
 
+/* DFA construction. */
+
+static void
+_edje_match_dfa_class_mark(Eina_Bool *boundaries, char lo, char hi)
+{
+   boundaries[(unsigned char)lo] = EINA_TRUE;
+   boundaries[(unsigned char)hi + 1] = EINA_TRUE;
+}
+
+/* Walk the tokens of a pattern the way _edje_match_patterns_exec_token
+ * does, and split the bytes wherever one of them compares differently. */
+static Eina_Bool
+_edje_match_dfa_classes_add(Eina_Bool *boundaries, const char *str)
+{
+   unsigned int pos = 0;
+
+   while (str[pos])
+     {
+        switch (str[pos])
+          {
+           case '*':
+           case '?':
+             pos++;
+             break;
+
+           case '\\':
+             /* A syntax error whatever the byte */
+             if (!str[pos + 1]) return EINA_TRUE;
+             _edje_match_dfa_class_mark(boundaries, str[pos + 1], str[pos + 1]);
+             pos += 2;
+             break;
+
+           case '[':
+             {
+                unsigned int i = pos + 1;
+
+                if (str[i] == '!') i++;
+                do
+                  {
+                     if (!str[i]) return EINA_TRUE;
+                     if (str[i + 1] == '-' && str[i + 2] != ']')
+                       {
+                          /* Matching reads past the end of this one */
+                          if (!str[i + 2]) return EINA_FALSE;
+                          _edje_match_dfa_class_mark(boundaries, str[i], str[i + 2]);
+                          i += 3;
+                       }
+                     else
+                       {
+                          _edje_match_dfa_class_mark(boundaries, str[i], str[i]);
+                          i++;
+                       }
+                  }
+                while (str[i] && str[i] != ']');
+                if (!str[i]) return EINA_TRUE;
+                pos = i + 1;
+             }
+             break;
+
+           default:
+             _edje_match_dfa_class_mark(boundaries, str[pos], str[pos]);
+             pos++;
+             break;
+          }
+     }
+
+   return EINA_TRUE;
+}
+
+static unsigned int
+_edje_match_dfa_key_length(const void *key EINA_UNUSED)
+{
+   return sizeof (Edje_Match_Dfa_State);
+}
+
+static int
+_edje_match_dfa_key_cmp(const void *key1, int key1_length EINA_UNUSED,
+                        const void *key2, int key2_length EINA_UNUSED)
+{
+   const Edje_Match_Dfa_State *a = key1;
+   const Edje_Match_Dfa_State *b = key2;
+
+   if (a->states_count != b->states_count)
+     return a->states_count < b->states_count ? -1 : 1;
+   return memcmp(a->states, b->states, a->states_count * sizeof (Edje_State));
+}
+
+static int
+_edje_match_dfa_key_hash(const void *key, int key_length EINA_UNUSED)
+{
+   const Edje_Match_Dfa_State *a = key;
+
+   return eina_hash_superfast((const char *)a->states,
+                              a->states_count * sizeof (Edje_State));
+}
+
+static Edje_Match_Dfa_State *
+_edje_match_dfa_state_add(const Edje_Patterns *ppat,
+                          const Edje_State *states,
+                          unsigned int count)
+{
+   Edje_Match_Dfa *dfa = ppat->dfa;
+   Edje_Match_Dfa_State *st;
+   unsigned int matches = 0;
+   unsigned int last = (unsigned int)-1;
+   unsigned int i;
+
+   /* States are sorted, a pattern accepting at two positions is seen once */
+   for (i = 0; i < count; ++i)
+     if (states[i].pos >= ppat->finals[states[i].idx] && states[i].idx != last)
+       {
+          last = states[i].idx;
+          matches++;
+       }
+
+   st = malloc(sizeof (Edje_Match_Dfa_State)
+               + dfa->classes_count * sizeof (unsigned int)
+               + count * sizeof (Edje_State)
+               + matches * sizeof (unsigned int));
+   if (!st) return NULL;
+
+   st->next = (unsigned int *)(st + 1);
+   st->states = (Edje_State *)(st->next + dfa->classes_count);
+   st->matches = (unsigned int *)(st->states + count);
+   st->states_count = count;
+   st->matches_count = 0;
+   st->id = eina_array_count(&dfa->states);
+   st->error = EINA_FALSE;
+
+   memset(st->next, 0, dfa->classes_count * sizeof (unsigned int));
+   if (count) memcpy(st->states, states, count * sizeof (Edje_State));
+
+   last = (unsigned int)-1;
+   for (i = 0; i < count; ++i)
+     if (states[i].pos >= ppat->finals[states[i].idx] && states[i].idx != last)
+       {
+          last = states[i].idx;
+          st->matches[st->matches_count++] = last;
+       }
+
+   if (!eina_array_push(&dfa->states, st))
+     {
+        free(st);
+        return NULL;
+     }
+   if (count) eina_hash_direct_add(dfa->sets, st, st);
+
+   return st;
+}
+
+static void
+_edje_match_dfa_states_free(Edje_Match_Dfa *dfa)
+{
+   Edje_Match_Dfa_State *st;
+   Eina_Array_Iterator iterator;
+   unsigned int i;
+
+   eina_hash_free_buckets(dfa->sets);
+   EINA_ARRAY_ITER_NEXT(&dfa->states, i, st, iterator)
+     free(st);
+   eina_array_clean(&dfa->states);
+}
+
+/* Drop every state and start over from the initial one */
+static Eina_Bool
+_edje_match_dfa_reset(const Edje_Patterns *ppat)
+{
+   Edje_Match_Dfa *dfa = ppat->dfa;
+   Edje_Match_Dfa_State *st;
+   Edje_State *start;
+   unsigned int i;
+
+   _edje_match_dfa_states_free(dfa);
+
+   if (!_edje_match_dfa_state_add(ppat, NULL, 0)) goto on_error;
+   st = _edje_match_dfa_state_add(ppat, NULL, 0);
+   if (!st) goto on_error;
+   st->error = EINA_TRUE;
+
+   /* The first list is free outside of a step */
+   start = ppat->states->states;
+   for (i = 0; i < ppat->patterns_size; ++i)
+     {
+        start[i].idx = i;
+        start[i].pos = 0;
+     }
+   if (!_edje_match_dfa_state_add(ppat, start, ppat->patterns_size))
+     goto on_error;
+
+   return EINA_TRUE;
+
+ on_error:
+   _edje_match_dfa_states_free(dfa);
+   return EINA_FALSE;
+}
+
+static Eina_Bool
+_edje_match_dfa_alloc(Edje_Patterns *ppat)
+{
+   Edje_Match_Dfa *dfa;
+   Eina_Bool boundaries[257];
+   unsigned int i;
+   unsigned int cl;
+
+   dfa = calloc(1, sizeof (Edje_Match_Dfa));
+   if (!dfa) return EINA_FALSE;
+
+   dfa->sets = eina_hash_new(EINA_KEY_LENGTH(_edje_match_dfa_key_length),
+                             EINA_KEY_CMP(_edje_match_dfa_key_cmp),
+                             EINA_KEY_HASH(_edje_match_dfa_key_hash),
+                             NULL,
+                             4);
+   if (!dfa->sets)
+     {
+        free(dfa);
+        return EINA_FALSE;
+     }
+   eina_array_step_set(&dfa->states, sizeof (Eina_Array), 16);
+
+   /* Signed and unsigned char order differ on the upper half */
+   memset(boundaries, 0, sizeof (boundaries));
+   boundaries[0x80] = EINA_TRUE;
+   for (i = 0; i < ppat->patterns_size; ++i)
+     if (!_edje_match_dfa_classes_add(boundaries, ppat->patterns[i]))
+       {
+          memset(boundaries, 1, sizeof (boundaries));
+          break;
+       }
+
+   for (i = 0, cl = 0; i < 256; ++i)
+     {
+        if (i && boundaries[i]) cl++;
+        if (!i || boundaries[i]) dfa->bytes[cl] = i;
+        dfa->classes[i] = cl;
+     }
+   dfa->classes_count = cl + 1;
+
+   ppat->dfa = dfa;
+   return EINA_TRUE;
+}
+
 static void
-_edje_match_patterns_exec_init_states(Edje_States *states,
-                                      unsigned int patterns_size,
-                                      unsigned int patterns_max_length)
+_edje_match_dfa_free(Edje_Match_Dfa *dfa)
 {
+   if (!dfa) return;
+
+   _edje_match_dfa_states_free(dfa);
+   eina_array_flush(&dfa->states);
+   eina_hash_free(dfa->sets);
+   free(dfa);
+}
+
+static Edje_Match_Dfa_State *
+_edje_match_dfa_step(const Edje_Patterns *ppat,
+                     Edje_Match_Dfa_State *from,
+                     unsigned int cl)
+{
+   Edje_Match_Dfa *dfa = ppat->dfa;
+   Edje_States *states = ppat->states;
+   Edje_States *new_states = ppat->states + 1;
+   Edje_Match_Dfa_State lookup;
+   Edje_Match_Dfa_State *to;
+   const char c = dfa->bytes[cl];
+   Eina_Bool error = EINA_FALSE;
    unsigned int i;
 
-   states->size = patterns_size;
+   for (i = 0; i < from->states_count; ++i)
+     _edje_match_states_insert(states, ppat->max_length,
+                               from->states[i].idx, from->states[i].pos);
+
+   /* What a '*' can skip to is appended to the list being walked */
+   for (i = 0; i < states->size; ++i)
+     {
+        const unsigned int idx = states->states[i].idx;
+        const unsigned int pos = states->states[i].pos;
+
+        if (!ppat->patterns[idx][pos])
+          continue;
+        else if (ppat->patterns[idx][pos] == '*')
+          {
+             _edje_match_states_insert(states, ppat->max_length, idx, pos + 1);
+             _edje_match_states_insert(new_states, ppat->max_length, idx, pos);
+          }
+        else
+          {
+             unsigned int m;
+
+             if (_edje_match_patterns_exec_token(ppat->patterns[idx] + pos,
+                                                 c,
+                                                 &m) != EDJE_MATCH_OK)
+               {
+                  error = EINA_TRUE;
+                  break;
+               }
+
+             if (m)
+               _edje_match_states_insert(new_states, ppat->max_length, idx, pos + m);
+          }
+     }
+   _edje_match_states_clear(states, ppat->max_length);
+
+   if (error)
+     to = eina_array_data_get(&dfa->states, EDJE_MATCH_DFA_ERROR);
+   else if (!new_states->size)
+     to = eina_array_data_get(&dfa->states, EDJE_MATCH_DFA_DEAD);
+   else
+     {
+        qsort(new_states->states, new_states->size, sizeof (Edje_State),
+              _edje_match_states_cmp);
+
+        lookup.states = new_states->states;
+        lookup.states_count = new_states->size;
+        to = eina_hash_find(dfa->sets, &lookup);
+        if (!to)
+          {
+             /* Signals carrying ids or names would otherwise grow it
+              * forever */
+             if (eina_array_count(&dfa->states) >= EDJE_MATCH_DFA_STATES_MAX)
+               {
+                  from = NULL;
+                  if (_edje_match_dfa_reset(ppat))
+                    to = eina_hash_find(dfa->sets, &lookup);
+               }
+             if (!to && eina_array_count(&dfa->states))
+               to = _edje_match_dfa_state_add(ppat, new_states->states,
+                                              new_states->size);
+          }
+     }
+   _edje_match_states_clear(new_states, ppat->max_length);
+
+   if (from && to) from->next[cl] = to->id + 1;
+   return to;
+}
 
-   for (i = 0; i < patterns_size; ++i)
+static const Edje_Match_Dfa_State *
+_edje_match_dfa_exec(const Edje_Patterns *ppat,
+                     const char *string)
+{
+   Edje_Match_Dfa *dfa = ppat->dfa;
+   Edje_Match_Dfa_State *st;
+   const unsigned char *c;
+
+   if (!eina_array_count(&dfa->states) && !_edje_match_dfa_reset(ppat))
+     return NULL;
+
+   st = eina_array_data_get(&dfa->states, EDJE_MATCH_DFA_START);
+   for (c = (const unsigned char *)string; *c && st->states_count; ++c)
      {
-        states->states[i].idx = i;
-        states->states[i].pos = 0;
-        states->has[i * (patterns_max_length + 1)] = 1;
+        const unsigned int cl = dfa->classes[*c];
+
+        if (st->next[cl])
+          st = eina_array_data_get(&dfa->states, st->next[cl] - 1);
+        else
+          {
+             st = _edje_match_dfa_step(ppat, st, cl);
+             if (!st) return NULL;
+          }
      }
+
+   if (st->error) return NULL;
+   return st;
 }
 
 /* Exported function. */
@@ -309,6 +698,12 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
        {                                                            \
           free(r);                                                  \
           return NULL;                                              \
+       }                                                            \
+     if (!_edje_match_dfa_alloc(r))                                 \
+       {                                                            \
+          _edje_match_states_free(r->states, 2);                    \
+          free(r);                                                  \
+          return NULL;                                              \
        }                                                            \
                                                                     \
      return r;                                                      \
@@ -372,6 +767,12 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
        {                                                            \
           free(r);                                                  \
           return NULL;                                              \
+       }                                                            \
+     if (!_edje_match_dfa_alloc(r))                                 \
+       {                                                            \
+          _edje_match_states_free(r->states, 2);                    \
+          free(r);                                                  \
+          return NULL;                                              \
        }                                                            \
                                                                     \
      return r;                                                      \
@@ -432,6 +833,12 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
        {                                                                       \
           free(r);                                                             \
           return NULL;                                                         \
+       }                                                                       \
+     if (!_edje_match_dfa_alloc(r))                                            \
+       {                                                                       \
+          _edje_match_states_free(r->states, 2);                               \
+          free(r);                                                             \
+          return NULL;                                                         \
        }                                                                       \
                                                                                \
      return r;                                                                 \
@@ -452,54 +859,37 @@ EDJE_MATCH_INIT_INARRAY(edje_match_callback_source_init,
                         source, 0);
 
 static Eina_Bool
-_edje_match_collection_dir_exec_finals(const unsigned int *finals,
-                                       const Edje_States *states)
-{
-   unsigned int i;
-
-   for (i = 0; i < states->size; ++i)
-     {
-        if (states->states[i].pos >= finals[states->states[i].idx])
-          return EINA_TRUE;
-     }
-   return EINA_FALSE;
-}
-
-static Eina_Bool
-edje_match_programs_exec_check_finals(const unsigned int *signal_finals,
-                                      const unsigned int *source_finals,
-                                      const Edje_States *signal_states,
-                                      const Edje_States *source_states,
+edje_match_programs_exec_check_finals(const Edje_Match_Dfa_State *signal_state,
+                                      const Edje_Match_Dfa_State *source_state,
                                       Edje_Program **programs,
                                       Eina_Bool (*func)(Edje_Program *pr, void *data),
                                       void *data,
                                       Eina_Bool prop EINA_UNUSED)
 {
-   unsigned int i;
-   unsigned int j;
-
-   /* when not enought memory, they could be NULL */
-   if (!signal_finals || !source_finals) return EINA_TRUE;
+   unsigned int i = 0;
+   unsigned int j = 0;
 
-   for (i = 0; i < signal_states->size; ++i)
+   /* Both are sorted, a program matches if it is in both */
+   while (i < signal_state->matches_count && j < source_state->matches_count)
      {
-        if (signal_states->states[i].pos >= signal_finals[signal_states->states[i].idx])
+        const unsigned int idx = signal_state->matches[i];
+
+        if (idx < source_state->matches[j])
+          i++;
+        else if (idx > source_state->matches[j])
+          j++;
+        else
           {
-             for (j = 0; j < source_states->size; ++j)
+             Edje_Program *pr;
+
+             pr = programs[idx];
+             if (pr)
                {
-                  if (signal_states->states[i].idx == source_states->states[j].idx
-                      && source_states->states[j].pos >= source_finals[source_states->states[j].idx])
-                    {
-                       Edje_Program *pr;
-
-                       pr = programs[signal_states->states[i].idx];
-                       if (pr)
-                         {
-                            if (func(pr, data))
-                              return EINA_FALSE;
-                         }
-                    }
+                  if (func(pr, data))
+                    return EINA_FALSE;
                }
+             i++;
+             j++;
           }
      }
 
@@ -509,8 +899,8 @@ edje_match_programs_exec_check_finals(const unsigned int *signal_finals,
 static int
 edje_match_callback_exec_check_finals(const Edje_Signals_Sources_Patterns *ssp,
                                       const Edje_Signal_Callback_Match *matches,
-                                      const Edje_States *signal_states,
-                                      const Edje_States *source_states,
+                                      const Edje_Match_Dfa_State *signal_state,
+                                      const Edje_Match_Dfa_State *source_state,
                                       const char *sig,
                                       const char *source,
                                       Edje *ed,
@@ -518,34 +908,41 @@ edje_match_callback_exec_check_finals(const Edje_Signals_Sources_Patterns *ssp,
 {
    const Edje_Signal_Callback_Match *cb;
    Eina_Array run;
-   unsigned int i;
-   unsigned int j;
+   unsigned int i = 0;
+   unsigned int j = 0;
    int r = 1;
 
    eina_array_step_set(&run, sizeof (Eina_Array), 4);
 
-   for (i = 0; i < signal_states->size; ++i)
-     if (signal_states->states[i].pos >= ssp->signals_patterns->finals[signal_states->states[i].idx])
-       {
-          for (j = 0; j < source_states->size; ++j)
-            {
-               if (signal_states->states[i].idx == source_states->states[j].idx
-                   && source_states->states[j].pos >= ssp->sources_patterns->finals[source_states->states[j].idx])
-                 {
-                    int *e;
-
-                    e = eina_inarray_nth(&ssp->u.callbacks.globing, signal_states->states[i].idx);
-
-                    cb = &matches[*e];
-                    if (cb)
-                      {
-                         if ((prop) && ed->callbacks->flags[*e].propagate) continue;
-                         eina_array_push(&run, cb);
-                         r = 2;
-                      }
-                 }
-            }
-       }
+   /* Collect them all first, a callback can emit and step the DFA */
+   while (i < signal_state->matches_count && j < source_state->matches_count)
+     {
+        const unsigned int idx = signal_state->matches[i];
+        int *e;
+
+        if (idx < source_state->matches[j])
+          {
+             i++;
+             continue;
+          }
+        if (idx > source_state->matches[j])
+          {
+             j++;
+             continue;
+          }
+        i++;
+        j++;
+
+        e = eina_inarray_nth(&ssp->u.callbacks.globing, idx);
+
+        cb = &matches[*e];
+        if (cb)
+          {
+             if ((prop) && ed->callbacks->flags[*e].propagate) continue;
+             eina_array_push(&run, cb);
+             r = 2;
+          }
+     }
 
    while ((cb = eina_array_pop(&run)))
      {
@@ -574,72 +971,20 @@ edje_match_callback_exec_check_finals(const Edje_Signals_Sources_Patterns *ssp,
    return r;
 }
 
-static Edje_States *
-_edje_match_fn(const Edje_Patterns *ppat,
-               const char *string,
-               Edje_States *states)
-{
-   Edje_States *new_states = states + 1;
-   const char *c;
-
-   for (c = string; *c && states->size; ++c)
-     {
-        unsigned int i;
-
-        _edje_match_states_clear(new_states, ppat->patterns_size, ppat->max_length);
-
-        for (i = 0; i < states->size; ++i)
-          {
-             const unsigned int idx = states->states[i].idx;
-             const unsigned int pos = states->states[i].pos;
-
-             if (!ppat->patterns[idx][pos])
-               continue;
-             else if (ppat->patterns[idx][pos] == '*')
-               {
-                  _edje_match_states_insert(states, ppat->max_length, idx, pos + 1);
-                  _edje_match_states_insert(new_states, ppat->max_length, idx, pos);
-               }
-             else
-               {
-                  unsigned int m;
-
-                  if (_edje_match_patterns_exec_token(ppat->patterns[idx] + pos,
-                                                      *c,
-                                                      &m) != EDJE_MATCH_OK)
-                    return NULL;
-
-                  if (m)
-                    _edje_match_states_insert(new_states, ppat->max_length, idx, pos + m);
-               }
-          }
-        {
-           Edje_States *tmp = states;
-
-           states = new_states;
-           new_states = tmp;
-        }
-     }
-
-   return states;
-}
-
 Eina_Bool
 edje_match_collection_dir_exec(const Edje_Patterns *ppat,
                                const char *string)
 {
-   Edje_States *result;
+   const Edje_Match_Dfa_State *result;
    Eina_Bool r = EINA_FALSE;
 
    /* under high memory presure, it could be NULL */
    if (!ppat) return EINA_FALSE;
 
-   _edje_match_patterns_exec_init_states(ppat->states, ppat->patterns_size, ppat->max_length);
-
-   result = _edje_match_fn(ppat, string, ppat->states);
+   result = _edje_match_dfa_exec(ppat, string);
 
    if (result)
-     r = _edje_match_collection_dir_exec_finals(ppat->finals, result);
+     r = result->matches_count > 0;
 
    return r;
 }
@@ -654,27 +999,18 @@ edje_match_programs_exec(const Edje_Patterns *ppat_signal,
                          void *data,
                          Eina_Bool prop)
 {
-   Edje_States *signal_result;
-   Edje_States *source_result;
+   const Edje_Match_Dfa_State *signal_result;
+   const Edje_Match_Dfa_State *source_result;
    Eina_Bool r = EINA_FALSE;
 
    /* under high memory presure, they could be NULL */
    if (!ppat_source || !ppat_signal) return EINA_FALSE;
 
-   _edje_match_patterns_exec_init_states(ppat_signal->states,
-                                         ppat_signal->patterns_size,
-                                         ppat_signal->max_length);
-   _edje_match_patterns_exec_init_states(ppat_source->states,
-                                         ppat_source->patterns_size,
-                                         ppat_source->max_length);
-
-   signal_result = _edje_match_fn(ppat_signal, sig, ppat_signal->states);
-   source_result = _edje_match_fn(ppat_source, source, ppat_source->states);
+   signal_result = _edje_match_dfa_exec(ppat_signal, sig);
+   source_result = _edje_match_dfa_exec(ppat_source, source);
 
    if (signal_result && source_result)
-     r = edje_match_programs_exec_check_finals(ppat_signal->finals,
-                                               ppat_source->finals,
-                                               signal_result,
+     r = edje_match_programs_exec_check_finals(signal_result,
                                                source_result,
                                                programs,
                                                func,
@@ -691,8 +1027,8 @@ edje_match_callback_exec(const Edje_Signals_Sources_Patterns *ssp,
                          Edje *ed,
                          Eina_Bool prop)
 {
-   Edje_States *signal_result;
-   Edje_States *source_result;
+   const Edje_Match_Dfa_State *signal_result;
+   const Edje_Match_Dfa_State *source_result;
    int r = 0;
 
    /* under high memory presure, they could be NULL */
@@ -700,15 +1036,9 @@ edje_match_callback_exec(const Edje_Signals_Sources_Patterns *ssp,
 
    ssp->signals_patterns->ref++;
    ssp->sources_patterns->ref++;
-   _edje_match_patterns_exec_init_states(ssp->signals_patterns->states,
-                                         ssp->signals_patterns->patterns_size,
-                                         ssp->signals_patterns->max_length);
-   _edje_match_patterns_exec_init_states(ssp->sources_patterns->states,
-                                         ssp->sources_patterns->patterns_size,
-                                         ssp->sources_patterns->max_length);
 
-   signal_result = _edje_match_fn(ssp->signals_patterns, sig, ssp->signals_patterns->states);
-   source_result = _edje_match_fn(ssp->sources_patterns, source, ssp->sources_patterns->states);
+   signal_result = _edje_match_dfa_exec(ssp->signals_patterns, sig);
+   source_result = _edje_match_dfa_exec(ssp->sources_patterns, source);
 
    if (signal_result && source_result)
      r = edje_match_callback_exec_check_finals(ssp,
@@ -734,6 +1064,7 @@ edje_match_patterns_free(Edje_Patterns *ppat)
    ppat->delete_me = EINA_TRUE;
    ppat->ref--;
    if (ppat->ref > 0) return;
+   _edje_match_dfa_free(ppat->dfa);
    _edje_match_states_free(ppat->states, 2);
    free(ppat);
 }
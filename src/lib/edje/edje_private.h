@@ -1174,6 +1174,14 @@ struct _Edje_Part_Collection
       Edje_Program **table_programs;
       int            table_programs_size;
    } patterns;
+
+   struct { /* parts to recalc when a part changes, see edje_calc.c */
+      unsigned int   *offsets; /* parts_count + 1 entries into dependents */
+      unsigned short *dependents;
+      unsigned short *always; /* parts recalculated on every pass */
+      unsigned int    always_count;
+      unsigned int    parts_count;
+   } dependencies;
    /* *** *** */
 
    struct {
@@ -1788,6 +1796,7 @@ struct _Edje
 
    unsigned short        block;
    unsigned short        state;
+   unsigned short        recalc_count; /* parts calculated by the last recalc */
 
    unsigned short        seats_count;
 
@@ -1824,6 +1833,7 @@ struct _Edje
 #ifdef EDJE_CALC_CACHE
    Eina_Bool          text_part_change : 1;
    Eina_Bool          all_part_change : 1;
+   Eina_Bool          dirty_parts : 1; /* only invalidated parts need a recalc */
 #endif
    Eina_Bool          has_size : 1;
 };
@@ -2297,11 +2307,13 @@ typedef enum _Edje_Match_Error
 } Edje_Match_Error;
 
 typedef struct _Edje_States     Edje_States;
+typedef struct _Edje_Match_Dfa  Edje_Match_Dfa;
 struct _Edje_Patterns
 {
    const char    **patterns;
 
    Edje_States    *states;
+   Edje_Match_Dfa *dfa; /* states are built while matching */
 
    int             ref;
    Eina_Bool       delete_me : 1;
@@ -2597,6 +2609,8 @@ Edje_Part_Description_Common *_edje_part_description_find(Edje *ed,
 void  _edje_part_description_apply(Edje *ed, Edje_Real_Part *ep, const char  *d1, double v1, const char *d2, double v2);
 void  _edje_recalc(Edje *ed);
 void  _edje_recalc_do(Edje *ed);
+void  _edje_part_dependencies_build(Edje_Part_Collection *edc);
+void  _edje_part_dependencies_free(Edje_Part_Collection *edc);
 int   _edje_part_dragable_calc(Edje *ed, Edje_Real_Part *ep, FLOAT_T *x, FLOAT_T *y);
 void  _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y);
 
@@ -242,6 +242,7 @@ typedef enum _Eet_Compression
    EET_COMPRESSION_HI        = 9,  /**< Slow but high compression level (Zlib) @since 1.7 */
    EET_COMPRESSION_VERYFAST  = 10, /**< Very fast, but lower compression ratio (LZ4HC) @since 1.7 */
    EET_COMPRESSION_SUPERFAST = 11, /**< Very fast, but lower compression ratio (faster to compress than EET_COMPRESSION_VERYFAST)  (LZ4) @since 1.7 */
+   EET_COMPRESSION_ZSTD      = 12, /**< High compression ratio and fast to decompress, can use a dictionary (Zstandard, needs eet built with libzstd) @since 1.24 */
 
    EET_COMPRESSION_LOW2      = 3,  /**< Space filler for compatibility. Don't use it @since 1.7 */
    EET_COMPRESSION_MED1      = 4,  /**< Space filler for compatibility. Don't use it @since 1.7 */
@@ -490,6 +491,7 @@ typedef Emile_Image_Encoding Eet_Image_Encoding;
 #define EET_IMAGE_ETC2_RGB   EMILE_IMAGE_ETC2_RGB
 #define EET_IMAGE_ETC2_RGBA  EMILE_IMAGE_ETC2_RGBA
 #define EET_IMAGE_ETC1_ALPHA EMILE_IMAGE_ETC1_ALPHA
+#define EET_IMAGE_LOSSLESS_PREDICTED EMILE_IMAGE_LOSSLESS_PREDICTED /**< @since 1.24 */
 
 /**
  * @typedef Eet_Colorspace
@@ -865,6 +867,118 @@ eet_alias(Eet_File *ef,
           const char *destination,
           int compress);
 
+/**
+ * @ingroup Eet_File_Group
+ * @brief Trains a compression dictionary shared by the entries of a file.
+ * @param ef A valid eet file handle opened for writing.
+ * @param size Maximum size of the dictionary in bytes, 0 to disable it.
+ * @return EINA_TRUE on success, EINA_FALSE on failure.
+ *
+ * Entries written after this call with #EET_COMPRESSION_ZSTD are kept
+ * uncompressed in memory until the file is flushed. A dictionary is then
+ * trained out of all of them, stored inside the file and used to compress
+ * each of them. This gives a much better ratio on files made of many
+ * small entries looking alike, like edje themes. If the file already
+ * carries a dictionary, that one is used as is.
+ *
+ * Ciphered entries are always compressed right away, without dictionary.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Bool
+eet_compression_dictionary_train(Eet_File *ef,
+                                 unsigned int size);
+
+/**
+ * @ingroup Eet_File_Group
+ * @brief Compresses the entries of a file in parallel when it is flushed.
+ * @param ef A valid eet file handle opened for writing.
+ * @param threads Number of threads to use, -1 for one per cpu and 0 or 1
+ *        to compress each entry as it is written (the default).
+ * @return EINA_TRUE on success, EINA_FALSE on failure.
+ *
+ * With more than one thread, the compressed entries written afterward are
+ * kept uncompressed in memory and only compressed by a pool of threads
+ * when the file is synced or closed. Entries are compressed with the very
+ * same settings, so the resulting file is byte for byte the same as when
+ * they are compressed one after the other. eet_write() then returns the
+ * uncompressed size of the entry.
+ *
+ * Ciphered entries are always compressed and ciphered right away.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Bool
+eet_compression_threads_set(Eet_File *ef,
+                            int threads);
+
+/**
+ * @ingroup Eet_File_Group
+ * @brief Only writes what changed when a file opened for read-write is synced.
+ * @param ef A valid eet file handle opened with #EET_FILE_MODE_READ_WRITE.
+ * @param append EINA_TRUE to append changes, EINA_FALSE to rewrite the whole
+ *        file on each sync (the default).
+ * @return EINA_TRUE on success, EINA_FALSE on failure.
+ *
+ * In append mode, eet_sync() and eet_close() write the new and changed
+ * entries at the end of the file, followed by a new directory, and only
+ * then switch the file header to that directory. Updating a few entries of
+ * a large file is then much cheaper, and the file stays readable with
+ * either its old or its new content if the process dies while writing.
+ *
+ * The space of the replaced entries and directories is not reused. The
+ * file is rewritten as a whole once more than half of it is unused, or on
+ * request with eet_compact(). Signed files are always rewritten.
+ *
+ * @see eet_compact()
+ *
+ * @since 1.24
+ */
+EAPI Eina_Bool
+eet_file_append_set(Eet_File *ef,
+                    Eina_Bool append);
+
+/**
+ * @ingroup Eet_File_Group
+ * @brief Stores an index of the entry names in the file when it is written.
+ * @param ef A valid eet file handle opened for writing.
+ * @param index EINA_TRUE to write an index, EINA_FALSE to not add one (the
+ *        default).
+ * @return EINA_TRUE on success, EINA_FALSE on failure.
+ *
+ * The index is a minimal perfect hash of the entry names, stored as an
+ * entry named "eet/directory/index". A file carrying one and opened with
+ * #EET_FILE_MODE_READ doesn't parse its directory: eet_open() only checks
+ * the index, and each lookup then costs two hashes and a single string
+ * compare, whatever the number of entries. This is worth it for files with
+ * thousands of entries, like large themes.
+ *
+ * Once a file has an index, it is kept up to date each time the file is
+ * written, until the index entry is deleted. Files written by versions of
+ * eet not knowing about it are read as before, and so are indexed files
+ * by those versions.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Bool
+eet_directory_index_set(Eet_File *ef,
+                        Eina_Bool index);
+
+/**
+ * @ingroup Eet_File_Group
+ * @brief Rewrites a whole file, dropping the space left by appended updates.
+ * @param ef A valid eet file handle opened for writing.
+ * @return EET_ERROR_NONE on success, or an error code.
+ *
+ * The pending changes are written too, as eet_sync() would.
+ *
+ * @see eet_file_append_set()
+ *
+ * @since 1.24
+ */
+EAPI Eet_Error
+eet_compact(Eet_File *ef);
+
 /**
  * @ingroup Eet_File_Group
  * @brief Retrieves the filename of an Eet_File.
@@ -1229,6 +1343,11 @@ eet_data_image_read_to_surface(Eet_File *ef,
  * can be 0 or 1. 0 means encode losslessly and 1 means to encode with
  * image quality loss (but then have a much smaller encoding).
  *
+ * #EET_IMAGE_LOSSLESS_PREDICTED is lossless too, but stores each pixel as
+ * its difference with its neighbours before compressing them, with lz4 if
+ * no compression is given. It is smaller for most artwork and decodes a
+ * lot faster than PNG, but older versions of eet can not read it.
+ *
  * On success this function returns the number of bytes that were required
  * to encode the image data, or on failure it returns 0.
  *
@@ -2626,6 +2745,16 @@ eet_identity_certificate_print(const unsigned char *certificate,
  */
 typedef struct _Eet_Data_Descriptor Eet_Data_Descriptor;
 
+/**
+ * @typedef Eet_Data_Arena
+ * Opaque handle owning everything decoded by eet_data_read_arena().
+ *
+ * @see eet_data_read_arena()
+ * @see eet_data_arena_free()
+ * @since 1.24
+ */
+typedef struct _Eet_Data_Arena Eet_Data_Arena;
+
 /**
  * @def EET_DATA_DESCRIPTOR_CLASS_VERSION
  * The version of #Eet_Data_Descriptor_Class at the time of the
@@ -3164,6 +3293,54 @@ eet_data_read(Eet_File *ef,
               Eet_Data_Descriptor *edd,
               const char *name);
 
+/**
+ * @ingroup Eet_Data_Group
+ * @brief Reads a data structure from an eet file into a single arena.
+ * @param ef The eet file handle to read from.
+ * @param edd The data descriptor handle to use when decoding.
+ * @param name The key the data is stored under in the eet file.
+ * @param arena Where to return the arena owning the decoded data.
+ * @return A pointer to the decoded data structure.
+ *
+ * This works like eet_data_read(), except that every structure and array
+ * of the decoded graph is carved out of a few large blocks instead of
+ * being allocated one by one. Strings are not copied, they point to the
+ * dictionary of @p ef, which the arena keeps open. Lists, hashes and
+ * values are still built with the callbacks of @p edd, and are released
+ * with it too.
+ *
+ * The whole graph is released at once with eet_data_arena_free(), none of
+ * it must be freed any other way. The mem_alloc, array_alloc and str_alloc
+ * callbacks of @p edd are not used.
+ *
+ * @warning When @p ef has a dictionary, the arena holds a reference on
+ * @p ef until eet_data_arena_free(). A file opened with
+ * #EET_FILE_MODE_READ_WRITE or #EET_FILE_MODE_WRITE is then neither
+ * written nor closed by eet_close() before the arena is freed.
+ *
+ * @see eet_data_arena_free()
+ *
+ * @since 1.24
+ */
+EAPI void *
+eet_data_read_arena(Eet_File *ef,
+                    Eet_Data_Descriptor *edd,
+                    const char *name,
+                    Eet_Data_Arena **arena);
+
+/**
+ * @ingroup Eet_Data_Group
+ * @brief Releases everything decoded by eet_data_read_arena().
+ * @param arena The arena to free, may be @c NULL.
+ *
+ * This also drops the reference the arena held on its file, which is
+ * written and closed here if eet_close() was already called on it.
+ *
+ * @since 1.24
+ */
+EAPI void
+eet_data_arena_free(Eet_Data_Arena *arena);
+
 /**
  * @ingroup Eet_Data_Group
  * @brief Writes a data structure from memory and store in an eet file.
@@ -4811,6 +4988,16 @@ typedef Eina_Bool Eet_Read_Cb (const void *eet_data, size_t size, void *user_dat
  */
 typedef Eina_Bool Eet_Write_Cb (const void *data, size_t size, void *user_data);
 
+/**
+ * @ingroup Eet_Connection_Group
+ * @typedef Eet_Writev_Cb
+ * Called back with the pieces of a packet, in order, when it is ready to be
+ * send. They are to be written together, with writev() for example.
+ *
+ * @since 1.24
+ */
+typedef Eina_Bool Eet_Writev_Cb (const Eina_Slice *slices, unsigned int count, void *user_data);
+
 /**
  * @ingroup Eet_Connection_Group
  * @brief Instanciates a new connection to track.
@@ -4905,6 +5092,81 @@ eet_connection_node_send(Eet_Connection *conn,
                          Eet_Node *node,
                          const char *cipher_key);
 
+/**
+ * @ingroup Eet_Connection_Group
+ * @brief Coalesces the messages sent into bigger packets.
+ * @param conn Connection handler to change.
+ * @param size Amount of data to accumulate before writing, @c 0 to
+ *        write each message as soon as it is sent (the default).
+ * @param delay Longest time in seconds a message waits, @c 0 for no limit.
+ *
+ * Messages sent are kept until @p size bytes or @p delay seconds are
+ * reached and are then given in one go to the write callback, which saves
+ * a lot of small writes. The delay is only checked when sending, so
+ * eet_connection_flush() must be called once there is nothing more to
+ * send, typically when the main loop goes idle.
+ *
+ * Batches are received just like separate messages, only the sending side
+ * has to be told about it.
+ *
+ * @see eet_connection_flush()
+ *
+ * @since 1.24
+ */
+EAPI void
+eet_connection_batch_set(Eet_Connection *conn,
+                         size_t size,
+                         double delay);
+
+/**
+ * @ingroup Eet_Connection_Group
+ * @brief Writes the messages still waiting in a batch.
+ * @param conn Connection handler to flush.
+ * @return @c EINA_FALSE if the write callback failed, @c EINA_TRUE otherwise.
+ *
+ * @see eet_connection_batch_set()
+ *
+ * @since 1.24
+ */
+EAPI Eina_Bool
+eet_connection_flush(Eet_Connection *conn);
+
+/**
+ * @ingroup Eet_Connection_Group
+ * @brief Gives the packets to write in pieces instead of as one buffer.
+ * @param conn Connection handler to change.
+ * @param eet_writev_cb Function to call instead of the Eet_Write_Cb given
+ *        to eet_connection_new(), @c NULL to go back to it.
+ *
+ * It spares copying every message and its header into a new buffer before
+ * writing it. As with Eet_Write_Cb, the pieces vanish just after the return
+ * of the callback.
+ *
+ * @since 1.24
+ */
+EAPI void
+eet_connection_writev_set(Eet_Connection *conn,
+                          Eet_Writev_Cb *eet_writev_cb);
+
+/**
+ * @ingroup Eet_Connection_Group
+ * @brief Compresses what is sent over the connection.
+ * @param conn Connection handler to change.
+ * @param compress @c EINA_TRUE to compress the packets with lz4.
+ *
+ * Each packet, or each batch when they are enabled, is compressed with what
+ * was sent before as a dictionary, so that the many small messages looking
+ * alike of a connection still compress well. The other end must run at
+ * least this version of eet to receive them, but it needs no setup.
+ *
+ * @see eet_connection_batch_set()
+ *
+ * @since 1.24
+ */
+EAPI void
+eet_connection_compression_set(Eet_Connection *conn,
+                               Eina_Bool compress);
+
 /**
  * @ingroup Eet_Connection_Group
  * @brief Closes a connection and lost its track.
@@ -4912,6 +5174,9 @@ eet_connection_node_send(Eet_Connection *conn,
  * @param on_going Signal if a partial packet wasn't completed.
  * @return the user_data passed to both callback.
  *
+ * Messages still waiting in a batch are dropped, call
+ * eet_connection_flush() first to send them.
+ *
  * @since 1.2.4
  */
 EAPI void *
@@ -41,6 +41,7 @@ struct _Eet_Dictionary
    unsigned char *all_allocated;
 
    Eina_Hash     *converts;
+   Eina_Spinlock  converts_lock;
    Eina_RWLock    rwlock;
 
    int         size;
@@ -53,6 +54,8 @@ struct _Eet_Dictionary
 
    const char *start;
    const char *end;
+
+   unsigned char readonly : 1; /* loaded from a read only file, never locked */
 };
 
 struct _Eet_Node
@@ -93,11 +96,22 @@ struct _Eet_File
    unsigned int         signature_length;
    int                  sha1_length;
 
+   Eina_Binbuf         *compression_dictionary;
+   Emile_Compressor_Dictionary *compression_expander; /* the dictionary ready to expand */
+   unsigned int         compression_dictionary_size;
+   unsigned int         compression_threads;
+   int                  disk_head[3]; /* header of the file as last read or written */
+   off_t                disk_size; /* and its size, inode and time, 0 if unknown */
+   ino_t                disk_ino;
+   time_t               disk_mtime;
+
    Eina_Lock            file_lock;
 
    unsigned char        writes_pending : 1;
    unsigned char        delete_me_now : 1;
    unsigned char        readfp_owned : 1;
+   unsigned char        append : 1;
+   unsigned char        directory_index : 1;
 };
 
 struct _Eet_File_Header
@@ -111,6 +125,18 @@ struct _Eet_File_Directory
    int             size;
    Eet_File_Node **nodes;
    unsigned int free_count;
+
+   /* Read only files with a directory index don't parse their directory
+    * when opened. Entries are only read out of the mapping when looked up,
+    * or all at once when listed. */
+   const int      *index;
+   const int      *entries;
+   Eet_File_Node  *loaded;
+   unsigned int    count;
+   unsigned long int base;
+   unsigned long int end;
+   Eina_Spinlock   lock;
+   Eina_Bool       complete;
 };
 
 struct _Eet_File_Node
@@ -130,6 +156,8 @@ struct _Eet_File_Node
    unsigned char     compression : 1;
    unsigned char     ciphered : 1;
    unsigned char     alias : 1;
+   unsigned char     compression_pending : 1;
+   unsigned char     dirty : 1; /* data not saved at offset yet */
 };
 
 #if 0
@@ -169,6 +197,8 @@ struct
                  bit 0 => compresion on/off
                  bit 1 => ciphered on/off
                  bit 2 => alias
+                 bits 3-10 => compression type
+                 bit 11 => directory index, only on the first entry
                */
 } directory[num_directory_entries];
 struct
@@ -186,6 +216,17 @@ int signature_length; /* Signature length. */
 int x509_length; /* Public certificate that signed the file. */
 char signature[signature_length]; /* The signature. */
 char x509[x509_length]; /* The public certificate. */
+
+/* Optional directory index, the data of an entry named
+ * "eet/directory/index". It is trusted only when it is the first entry of
+ * the directory and has bit 11 of its flags set, which writers not knowing
+ * about it don't keep. A minimal perfect hash of the entry names: */
+int magic; /* magic number ie 0x1ee70f44 */
+int count; /* number of directory entries, the index included */
+int data_end; /* end of the data stream, 0 for appended files */
+int displace[count]; /* per bucket, seed of the second hash if >= 0,
+                        or -(slot + 1) for buckets of a single name */
+int entry[count]; /* per slot, position in the directory */
 #endif /* if 0 */
 
 /*
@@ -327,6 +368,16 @@ Eet_Node *
 void
  eet_node_free(Eet_Node *node);
 
+Eet_File *
+ eet_file_ref(Eet_File *ef);
+
+/* Entries compressed with the dictionary stored in the file itself. This
+ * only lives on disk, users still ask for EET_COMPRESSION_ZSTD. */
+#define EET_COMPRESSION_ZSTD_DICTIONARY 13
+#define EET_COMPRESSION_DICTIONARY_KEY "eet/compression/dictionary"
+#define EET_COMPRESSION_THREADS_MAX 64
+#define EET_DIRECTORY_INDEX_KEY "eet/directory/index"
+
 static inline Emile_Compressor_Type
 eet_2_emile_compressor(int comp)
 {
@@ -334,6 +385,8 @@ eet_2_emile_compressor(int comp)
      {
       case EET_COMPRESSION_VERYFAST: return EMILE_LZ4HC;
       case EET_COMPRESSION_SUPERFAST: return EMILE_LZ4;
+      case EET_COMPRESSION_ZSTD:
+      case EET_COMPRESSION_ZSTD_DICTIONARY: return EMILE_ZSTD;
       default: return EMILE_ZLIB;
      }
 }
@@ -4,8 +4,11 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
 
 #include <Eina.h>
+#include <Emile.h>
 
 #include "Eet.h"
 #include "Eet_private.h"
@@ -13,20 +16,150 @@
 /* max message size: 1Gb - raised from original 64Kb */
 #define MAX_MSG_SIZE (1024 * 1024 * 1024)
 #define MAGIC_EET_DATA_PACKET 0x4270ACE1
+/* A batch of packets compressed with lz4, prefixed by its expanded size */
+#define MAGIC_EET_LZ4_PACKET 0x4270ACE2
+/* How much of the previous batches lz4 can refer to */
+#define HISTORY_SIZE (64 * 1024)
+
+typedef struct _Eet_Connection_Message Eet_Connection_Message;
+
+struct _Eet_Connection_Message
+{
+   int   header[2];
+   void *data;
+   int   size;
+};
 
 struct _Eet_Connection
 {
-   Eet_Read_Cb  *eet_read_cb;
-   Eet_Write_Cb *eet_write_cb;
-   void         *user_data;
+   Eet_Read_Cb   *eet_read_cb;
+   Eet_Write_Cb  *eet_write_cb;
+   Eet_Writev_Cb *eet_writev_cb;
+   void          *user_data;
+
+   size_t         allocated;
+   size_t         size;
+   size_t         received;
+
+   void          *buffer;
 
-   size_t        allocated;
-   size_t        size;
-   size_t        received;
+   /* Messages waiting to be written */
+   Eet_Connection_Message *pending;
+   unsigned int   pending_count;
+   unsigned int   pending_allocated;
+   size_t         pending_size;
+   double         pending_since;
 
-   void         *buffer;
+   size_t         batch_size;
+   double         batch_delay;
+
+   /* The last HISTORY_SIZE bytes sent and received compressed */
+   Eina_Binbuf   *send_history;
+   Eina_Binbuf   *recv_history;
+
+   Eina_Bool      compress : 1;
+   Eina_Bool      lz4 : 1; /* the packet being received is compressed */
 };
 
+static double
+_eet_connection_time_get(void)
+{
+#ifdef HAVE_CLOCK_GETTIME
+   struct timespec t;
+
+   if (!clock_gettime(CLOCK_MONOTONIC, &t))
+     return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+#endif
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+}
+
+static void
+_eet_connection_history_update(Eina_Binbuf  **history,
+                               const void    *data,
+                               size_t         size)
+{
+   size_t length;
+
+   if (size >= HISTORY_SIZE)
+     {
+        data = (const char *)data + size - HISTORY_SIZE;
+        size = HISTORY_SIZE;
+        if (*history) eina_binbuf_reset(*history);
+     }
+
+   if (!*history) *history = eina_binbuf_new();
+   if (!*history) return;
+
+   eina_binbuf_append_length(*history, data, size);
+   length = eina_binbuf_length_get(*history);
+   if (length > HISTORY_SIZE)
+     eina_binbuf_remove(*history, 0, length - HISTORY_SIZE);
+}
+
+/* Hands over one packet, expanding it first if it is a compressed batch */
+static Eina_Bool
+_eet_connection_packet(Eet_Connection *conn,
+                       Eina_Bool       lz4,
+                       const void     *data,
+                       size_t          size)
+{
+   Eina_Binbuf *in, *out;
+   const unsigned char *p;
+   size_t expanded;
+   Eina_Bool ret = EINA_TRUE;
+
+   if (!lz4) return conn->eet_read_cb(data, size, conn->user_data);
+
+   if (size < sizeof(int)) return EINA_FALSE;
+   expanded = eina_ntohl(*(const int *)data);
+   if (expanded > MAX_MSG_SIZE) return EINA_FALSE;
+
+   in = eina_binbuf_manage_new((const unsigned char *)data + sizeof(int),
+                               size - sizeof(int), EINA_TRUE);
+   if (!in) return EINA_FALSE;
+   out = emile_decompress_dictionary(in, EMILE_LZ4, expanded,
+                                     conn->recv_history);
+   eina_binbuf_free(in);
+   if (!out) return EINA_FALSE;
+
+   p = eina_binbuf_string_get(out);
+   _eet_connection_history_update(&conn->recv_history, p, expanded);
+
+   /* A batch only ever contains complete packets */
+   while (expanded > 0)
+     {
+        const int *msg = (const int *)p;
+        size_t packet_size;
+
+        if (expanded < (sizeof(int) * 2) ||
+            eina_ntohl(msg[0]) != MAGIC_EET_DATA_PACKET)
+          {
+             ret = EINA_FALSE;
+             break;
+          }
+        packet_size = eina_ntohl(msg[1]);
+        if (packet_size > expanded - sizeof(int) * 2)
+          {
+             ret = EINA_FALSE;
+             break;
+          }
+
+        if (!conn->eet_read_cb(msg + 2, packet_size, conn->user_data))
+          {
+             ret = EINA_FALSE;
+             break;
+          }
+        p += packet_size + sizeof(int) * 2;
+        expanded -= packet_size + sizeof(int) * 2;
+     }
+
+   eina_binbuf_free(out);
+   return ret;
+}
+
 EAPI Eet_Connection *
 eet_connection_new(Eet_Read_Cb  *eet_read_cb,
                    Eet_Write_Cb *eet_write_cb,
@@ -58,12 +191,16 @@ eet_connection_received(Eet_Connection *conn,
           {
              const int *msg;
              size_t packet_size;
+             int magic;
              
              if (size < (sizeof(int) * 2)) break;
 
              msg = data;
              /* Check the magic */
-             if (eina_ntohl(msg[0]) != MAGIC_EET_DATA_PACKET) break;
+             magic = eina_ntohl(msg[0]);
+             if ((magic != MAGIC_EET_DATA_PACKET) &&
+                 (magic != MAGIC_EET_LZ4_PACKET)) break;
+             conn->lz4 = magic == MAGIC_EET_LZ4_PACKET;
 
              packet_size = eina_ntohl(msg[1]);
              /* Message should always be under MAX_MSG_SIZE */
@@ -74,7 +211,8 @@ eet_connection_received(Eet_Connection *conn,
              if ((size_t)packet_size <= size)
                {
                   /* Not a partial receive, go the quick way. */
-                  if (!conn->eet_read_cb(data, packet_size, conn->user_data))
+                  if (!_eet_connection_packet(conn, conn->lz4,
+                                              data, packet_size))
                     break;
                   
                   data = (void *)((char *)data + packet_size);
@@ -112,7 +250,8 @@ eet_connection_received(Eet_Connection *conn,
              conn->size = 0;
              conn->received = 0;
              /* Completed a packet. */
-             if (!conn->eet_read_cb(conn->buffer, data_size, conn->user_data))
+             if (!_eet_connection_packet(conn, conn->lz4,
+                                         conn->buffer, data_size))
                {
                   /* Something goes wrong. Stop now. */
                   size += data_size;
@@ -125,24 +264,140 @@ eet_connection_received(Eet_Connection *conn,
    return size;
 }
 
+/* Writes out slices as one packet, through the scatter/gather callback
+ * when there is one */
+static Eina_Bool
+_eet_connection_write(Eet_Connection   *conn,
+                      const Eina_Slice *slices,
+                      unsigned int      count)
+{
+   unsigned char *buffer, *p;
+   unsigned int i;
+   size_t size = 0;
+   Eina_Bool ret;
+
+   if (conn->eet_writev_cb)
+     return conn->eet_writev_cb(slices, count, conn->user_data);
+   if (count == 1)
+     return conn->eet_write_cb(slices[0].mem, slices[0].len, conn->user_data);
+
+   for (i = 0; i < count; i++)
+     size += slices[i].len;
+   buffer = malloc(size);
+   if (!buffer) return EINA_FALSE;
+   for (i = 0, p = buffer; i < count; p += slices[i].len, i++)
+     memcpy(p, slices[i].mem, slices[i].len);
+
+   ret = conn->eet_write_cb(buffer, size, conn->user_data);
+   free(buffer);
+   return ret;
+}
+
+static Eina_Bool
+_eet_connection_compressed_write(Eet_Connection         *conn,
+                                 Eet_Connection_Message *pending,
+                                 unsigned int            count,
+                                 size_t                  size)
+{
+   Eina_Binbuf *raw, *packed;
+   Eina_Slice slices[2];
+   unsigned char *buffer, *p;
+   unsigned int i;
+   int header[3];
+   Eina_Bool ret;
+
+   buffer = malloc(size);
+   if (!buffer) return EINA_FALSE;
+   for (i = 0, p = buffer; i < count; i++)
+     {
+        memcpy(p, pending[i].header, sizeof(pending[i].header));
+        p += sizeof(pending[i].header);
+        memcpy(p, pending[i].data, pending[i].size);
+        p += pending[i].size;
+     }
+
+   raw = eina_binbuf_manage_new(buffer, size, EINA_TRUE);
+   packed = raw ? emile_compress_dictionary(raw, EMILE_LZ4, EMILE_COMPRESSOR_FAST,
+                                            conn->send_history) : NULL;
+   eina_binbuf_free(raw);
+
+   /* Send as is what does not compress, it does not go in the history */
+   if (!packed ||
+       eina_binbuf_length_get(packed) + sizeof(int) >= size ||
+       eina_binbuf_length_get(packed) + sizeof(int) > MAX_MSG_SIZE)
+     {
+        slices[0].mem = buffer;
+        slices[0].len = size;
+        ret = _eet_connection_write(conn, slices, 1);
+        goto end;
+     }
+
+   _eet_connection_history_update(&conn->send_history, buffer, size);
+
+   header[0] = eina_htonl(MAGIC_EET_LZ4_PACKET);
+   header[1] = eina_htonl(eina_binbuf_length_get(packed) + sizeof(int));
+   header[2] = eina_htonl(size);
+   slices[0].mem = header;
+   slices[0].len = sizeof(header);
+   slices[1].mem = eina_binbuf_string_get(packed);
+   slices[1].len = eina_binbuf_length_get(packed);
+   ret = _eet_connection_write(conn, slices, 2);
+
+ end:
+   if (packed) eina_binbuf_free(packed);
+   free(buffer);
+   return ret;
+}
+
 static Eina_Bool
 _eet_connection_raw_send(Eet_Connection *conn,
                          void           *data,
                          int             data_size)
 {
-   int *message;
+   Eet_Connection_Message *msg;
 
    /* Message should always be under MAX_MSG_SIZE */
-   if (data_size > MAX_MSG_SIZE) return EINA_FALSE;
-   message = malloc(data_size + (sizeof(int) * 2));
-   message[0] = eina_htonl(MAGIC_EET_DATA_PACKET);
-   message[1] = eina_htonl(data_size);
-   memcpy(message + 2, data, data_size);
-   conn->eet_write_cb(message,
-                      data_size + (sizeof(int) * 2),
-                      conn->user_data);
-
-   free(message);
+   if (data_size > MAX_MSG_SIZE)
+     {
+        free(data);
+        return EINA_FALSE;
+     }
+
+   if (conn->pending_count == conn->pending_allocated)
+     {
+        Eet_Connection_Message *tmp;
+        unsigned int allocated;
+
+        allocated = conn->pending_allocated ? conn->pending_allocated * 2 : 4;
+        tmp = realloc(conn->pending, allocated * sizeof (Eet_Connection_Message));
+        if (!tmp)
+          {
+             free(data);
+             return EINA_FALSE;
+          }
+        conn->pending = tmp;
+        conn->pending_allocated = allocated;
+     }
+
+   if (!conn->pending_count)
+     conn->pending_since = conn->batch_delay > 0.0 ?
+       _eet_connection_time_get() : 0.0;
+
+   msg = conn->pending + conn->pending_count++;
+   msg->header[0] = eina_htonl(MAGIC_EET_DATA_PACKET);
+   msg->header[1] = eina_htonl(data_size);
+   msg->data = data;
+   msg->size = data_size;
+   conn->pending_size += data_size + sizeof(msg->header);
+
+   if (conn->batch_size &&
+       conn->pending_size < conn->batch_size &&
+       (conn->batch_delay <= 0.0 ||
+        _eet_connection_time_get() - conn->pending_since < conn->batch_delay))
+     return EINA_TRUE;
+
+   /* What the write callback returns never failed a send */
+   eet_connection_flush(conn);
    return EINA_TRUE;
 }
 
@@ -161,7 +416,6 @@ eet_connection_send(Eet_Connection      *conn,
 {
    void *flat_data;
    int data_size;
-   Eina_Bool ret = EINA_FALSE;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(conn, EINA_FALSE);
 
@@ -170,9 +424,7 @@ eet_connection_send(Eet_Connection      *conn,
                                                  cipher_key,
                                                  &data_size);
    if (!flat_data) return EINA_FALSE;
-   if (_eet_connection_raw_send(conn, flat_data, data_size)) ret = EINA_TRUE;
-   free(flat_data);
-   return ret;
+   return _eet_connection_raw_send(conn, flat_data, data_size);
 }
 
 EAPI Eina_Bool
@@ -182,18 +434,93 @@ eet_connection_node_send(Eet_Connection *conn,
 {
    void *data;
    int data_size;
-   Eina_Bool ret = EINA_FALSE;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(conn, EINA_FALSE);
 
    data = eet_data_node_encode_cipher(node, cipher_key, &data_size);
    if (!data) return EINA_FALSE;
-   if (_eet_connection_raw_send(conn, data, data_size))
-     ret = EINA_TRUE;
-   free(data);
+   return _eet_connection_raw_send(conn, data, data_size);
+}
+
+EAPI Eina_Bool
+eet_connection_flush(Eet_Connection *conn)
+{
+   Eet_Connection_Message *pending;
+   Eina_Slice *slices;
+   unsigned int count, i;
+   size_t size;
+   Eina_Bool ret = EINA_FALSE;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(conn, EINA_FALSE);
+   if (!conn->pending_count) return EINA_TRUE;
+
+   /* The write callback may very well send more, start a new batch */
+   pending = conn->pending;
+   count = conn->pending_count;
+   size = conn->pending_size;
+   conn->pending = NULL;
+   conn->pending_count = 0;
+   conn->pending_allocated = 0;
+   conn->pending_size = 0;
+
+   if (conn->compress)
+     {
+        ret = _eet_connection_compressed_write(conn, pending, count, size);
+     }
+   else
+     {
+        slices = malloc(count * 2 * sizeof (Eina_Slice));
+        if (slices)
+          {
+             for (i = 0; i < count; i++)
+               {
+                  slices[i * 2].mem = pending[i].header;
+                  slices[i * 2].len = sizeof(pending[i].header);
+                  slices[i * 2 + 1].mem = pending[i].data;
+                  slices[i * 2 + 1].len = pending[i].size;
+               }
+             ret = _eet_connection_write(conn, slices, count * 2);
+             free(slices);
+          }
+     }
+
+   for (i = 0; i < count; i++)
+     free(pending[i].data);
+   free(pending);
+
    return ret;
 }
 
+EAPI void
+eet_connection_batch_set(Eet_Connection *conn,
+                         size_t          size,
+                         double          delay)
+{
+   EINA_SAFETY_ON_NULL_RETURN(conn);
+
+   conn->batch_size = size;
+   conn->batch_delay = delay;
+   if (!size) eet_connection_flush(conn);
+}
+
+EAPI void
+eet_connection_writev_set(Eet_Connection *conn,
+                          Eet_Writev_Cb  *eet_writev_cb)
+{
+   EINA_SAFETY_ON_NULL_RETURN(conn);
+
+   conn->eet_writev_cb = eet_writev_cb;
+}
+
+EAPI void
+eet_connection_compression_set(Eet_Connection *conn,
+                               Eina_Bool       compress)
+{
+   EINA_SAFETY_ON_NULL_RETURN(conn);
+
+   conn->compress = !!compress;
+}
+
 EAPI void *
 eet_connection_close(Eet_Connection *conn,
                      Eina_Bool      *on_going)
@@ -203,6 +530,11 @@ eet_connection_close(Eet_Connection *conn,
    if (!conn) return NULL;
    if (on_going) *on_going = conn->received == 0 ? EINA_FALSE : EINA_TRUE;
    user_data = conn->user_data;
+   while (conn->pending_count)
+     free(conn->pending[--conn->pending_count].data);
+   free(conn->pending);
+   if (conn->send_history) eina_binbuf_free(conn->send_history);
+   if (conn->recv_history) eina_binbuf_free(conn->recv_history);
    free(conn->buffer);
    free(conn);
    return user_data;
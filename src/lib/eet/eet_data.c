@@ -63,6 +63,8 @@ typedef struct _Eet_Data_Encode_Hash_Info Eet_Data_Encode_Hash_Info;
 typedef struct _Eet_Free                  Eet_Free;
 typedef struct _Eet_Free_Context          Eet_Free_Context;
 typedef struct _Eet_Variant_Unknow        Eet_Variant_Unknow;
+typedef struct _Eet_Data_Arena_Block      Eet_Data_Arena_Block;
+typedef struct _Eet_Data_Arena_Cleanup    Eet_Data_Arena_Cleanup;
 
 /*---*/
 
@@ -207,6 +209,30 @@ struct _Eet_Free_Context
    Eet_Free freelist_hash;
    Eet_Free freelist_str;
    Eet_Free freelist_direct_str;
+   Eet_Data_Arena *arena;
+};
+
+struct _Eet_Data_Arena_Block
+{
+   Eet_Data_Arena_Block *next;
+   size_t                size;
+   size_t                used;
+};
+
+struct _Eet_Data_Arena_Cleanup
+{
+   Eet_Data_Arena_Cleanup *next;
+   Eet_Data_Descriptor    *edd;
+   void                   *data;  /* the list field, the hash or the value */
+   int                     type;  /* EET_G_LIST, EET_G_HASH or EET_T_VALUE */
+};
+
+struct _Eet_Data_Arena
+{
+   Eet_File               *ef;  /* strings point into its dictionary */
+   Eet_Data_Arena_Block   *blocks;
+   Eet_Data_Arena_Cleanup *cleanups;
+   size_t                  block_size;
 };
 
 struct _Eet_Variant_Unknow
@@ -1836,6 +1862,36 @@ _eet_descriptor_hash_find(Eet_Data_Descriptor *edd,
    return NULL;
 }
 
+/*
+ * Elements are encoded in the order they were added to the descriptor, so
+ * the one following the last element found is checked first. With a
+ * dictionary, that check is a pointer compare and skips the hash entirely.
+ */
+static inline Eet_Data_Element *
+_eet_descriptor_element_find(Eet_Data_Descriptor  *edd,
+                             const Eet_Dictionary *ed,
+                             const Eet_Data_Chunk *chnk,
+                             int                  *next)
+{
+   Eet_Data_Element *ede;
+
+   if (*next < edd->elements.num)
+     {
+        ede = &(edd->elements.set[*next]);
+        if (ed ? (ede->directory_name_ptr == chnk->name) :
+            (!strcmp(ede->name, chnk->name)))
+          {
+             (*next)++;
+             return ede;
+          }
+     }
+
+   ede = _eet_descriptor_hash_find(edd, chnk->name, chnk->hash);
+   if (ede)
+     *next = (ede - edd->elements.set) + 1;
+   return ede;
+}
+
 static void *
 _eet_mem_alloc(size_t size)
 {
@@ -2256,6 +2312,98 @@ eet_data_descriptor_element_add(Eet_Data_Descriptor *edd,
    ede->subtype = subtype;
 }
 
+/*
+ * Arena used by eet_data_read_arena(). Blocks are only ever appended to
+ * and all go away together, lists, hashes and values built by callbacks
+ * are remembered so that they can be released first.
+ */
+#define EET_DATA_ARENA_ALIGN      8
+#define EET_DATA_ARENA_HEADER     ((sizeof (Eet_Data_Arena_Block) + EET_DATA_ARENA_ALIGN - 1) & ~(EET_DATA_ARENA_ALIGN - 1))
+#define EET_DATA_ARENA_BLOCK_MIN  4096
+#define EET_DATA_ARENA_BLOCK_MAX  (1024 * 1024)
+
+static void *
+_eet_data_arena_alloc(Eet_Data_Arena *arena,
+                      size_t          size)
+{
+   Eet_Data_Arena_Block *block = arena->blocks;
+   void *r;
+
+   size = (size + EET_DATA_ARENA_ALIGN - 1) & ~(EET_DATA_ARENA_ALIGN - 1);
+   if (!size) size = EET_DATA_ARENA_ALIGN;
+
+   if ((!block) || (block->used + size > block->size))
+     {
+        size_t block_size = arena->block_size;
+
+        if (block_size < size) block_size = size;
+        block = calloc(1, EET_DATA_ARENA_HEADER + block_size);
+        if (!block) return NULL;
+
+        block->size = block_size;
+        block->next = arena->blocks;
+        arena->blocks = block;
+        if (arena->block_size < EET_DATA_ARENA_BLOCK_MAX)
+          arena->block_size *= 2;
+     }
+
+   r = (char *)block + EET_DATA_ARENA_HEADER + block->used;
+   block->used += size;
+   return r;
+}
+
+static char *
+_eet_data_arena_strdup(Eet_Data_Arena *arena,
+                       const char     *str)
+{
+   size_t len = strlen(str) + 1;
+   char *r;
+
+   r = _eet_data_arena_alloc(arena, len);
+   if (r) memcpy(r, str, len);
+   return r;
+}
+
+static void
+_eet_data_arena_cleanup_add(Eet_Data_Arena      *arena,
+                            Eet_Data_Descriptor *edd,
+                            void                *data,
+                            int                  type)
+{
+   Eet_Data_Arena_Cleanup *cleanup;
+
+   cleanup = _eet_data_arena_alloc(arena, sizeof (Eet_Data_Arena_Cleanup));
+   if (!cleanup) return;
+
+   cleanup->edd = edd;
+   cleanup->data = data;
+   cleanup->type = type;
+   cleanup->next = arena->cleanups;
+   arena->cleanups = cleanup;
+}
+
+static inline void *
+_eet_data_mem_alloc(Eet_Free_Context    *context,
+                    Eet_Data_Descriptor *edd,
+                    size_t               size)
+{
+   if (context->arena)
+     return _eet_data_arena_alloc(context->arena, size);
+   return edd->func.mem_alloc(size);
+}
+
+static inline void *
+_eet_data_array_alloc(Eet_Free_Context    *context,
+                      Eet_Data_Descriptor *edd,
+                      size_t               size)
+{
+   if (context->arena)
+     return _eet_data_arena_alloc(context->arena, size);
+   if (edd->func.array_alloc)
+     return edd->func.array_alloc(size);
+   return edd->func.mem_alloc(size);
+}
+
 EAPI void *
 eet_data_read_cipher(Eet_File            *ef,
                      Eet_Data_Descriptor *edd,
@@ -2381,6 +2529,104 @@ eet_data_read(Eet_File            *ef,
    return eet_data_read_cipher(ef, edd, name, NULL);
 }
 
+EAPI void *
+eet_data_read_arena(Eet_File            *ef,
+                    Eet_Data_Descriptor *edd,
+                    const char          *name,
+                    Eet_Data_Arena     **arena)
+{
+   const Eet_Dictionary *ed = NULL;
+   const void *data = NULL;
+   void *data_dec = NULL;
+   Eet_Data_Arena *a;
+   Eet_Free_Context context;
+   int required_free = 0;
+   int size;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(edd, NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(arena, NULL);
+   *arena = NULL;
+   ed = eet_dictionary_get(ef);
+
+   data = eet_read_direct(ef, name, &size);
+   if (!data)
+     {
+        required_free = 1;
+        data = eet_read(ef, name, &size);
+        if (!data)
+          return NULL;
+     }
+
+   a = calloc(1, sizeof (Eet_Data_Arena));
+   if (!a) goto on_error;
+
+   /* Decoded structures usually take a third of their encoding, as field
+    * names and chunk headers do not survive decoding. Start small and let
+    * blocks double, so that little of the last one is left unused. */
+   a->block_size = size / 8;
+   if (a->block_size < EET_DATA_ARENA_BLOCK_MIN)
+     a->block_size = EET_DATA_ARENA_BLOCK_MIN;
+   else if (a->block_size > EET_DATA_ARENA_BLOCK_MAX)
+     a->block_size = EET_DATA_ARENA_BLOCK_MAX;
+   if (ed) a->ef = eet_file_ref(ef);
+
+   if (ed) eet_dictionary_lock_read(ed); // XXX: get manual eet_dictionary lock
+   eet_free_context_init(&context);
+   context.arena = a;
+   data_dec = _eet_data_descriptor_decode(&context, ed, edd, data, size, NULL, 0);
+   eet_free_context_shutdown(&context);
+   if (ed) eet_dictionary_unlock(ed); // XXX: release manual eet_dictionary lock
+
+   if (data_dec)
+     *arena = a;
+   else
+     eet_data_arena_free(a);
+
+on_error:
+   if (required_free)
+     free((void *)data);
+
+   return data_dec;
+}
+
+EAPI void
+eet_data_arena_free(Eet_Data_Arena *arena)
+{
+   Eet_Data_Arena_Cleanup *cleanup;
+   Eet_Data_Arena_Block *block;
+
+   if (!arena) return;
+
+   for (cleanup = arena->cleanups; cleanup; cleanup = cleanup->next)
+     {
+        switch (cleanup->type)
+          {
+           case EET_G_LIST:
+             if (*(void **)cleanup->data)
+               cleanup->edd->func.list_free(*(void **)cleanup->data);
+             break;
+
+           case EET_G_HASH:
+             cleanup->edd->func.hash_free(cleanup->data);
+             break;
+
+           case EET_T_VALUE:
+             eina_value_free(cleanup->data);
+             break;
+          }
+     }
+
+   while (arena->blocks)
+     {
+        block = arena->blocks;
+        arena->blocks = block->next;
+        free(block);
+     }
+
+   if (arena->ef) eet_close(arena->ef);
+   free(arena);
+}
+
 EAPI int
 eet_data_write_cipher(Eet_File            *ef,
                       Eet_Data_Descriptor *edd,
@@ -2500,6 +2746,13 @@ _eet_freelist_free(Eet_Free_Context    *context,
    if (context->freelist.ref > 0)
      return;
 
+   /* Everything goes away with the arena */
+   if (context->arena)
+     {
+        _eet_free_reset(&context->freelist);
+        return;
+     }
+
    EINA_ARRAY_ITER_NEXT(&context->freelist.list, i, track, it)
      if (track)
        {
@@ -2527,6 +2780,12 @@ _eet_freelist_array_free(Eet_Free_Context    *context,
    if (context->freelist_array.ref > 0)
      return;
 
+   if (context->arena)
+     {
+        _eet_free_reset(&context->freelist_array);
+        return;
+     }
+
    EINA_ARRAY_ITER_NEXT(&context->freelist_array.list, i, track, it)
      if (track)
        {
@@ -3478,6 +3737,7 @@ _eet_data_descriptor_decode(Eet_Free_Context     *context,
    int size, i;
    Eet_Data_Chunk chnk;
    Eina_Bool need_free = EINA_FALSE;
+   int next = 0;
 
    if (_eet_data_words_bigendian == -1)
      {
@@ -3499,8 +3759,8 @@ _eet_data_descriptor_decode(Eet_Free_Context     *context,
           }
         else
           {
-             data = edd->func.mem_alloc(edd->size);
-             need_free = EINA_TRUE;
+             data = _eet_data_mem_alloc(context, edd, edd->size);
+             need_free = !context->arena;
           }
 
         if (!data)
@@ -3587,7 +3847,7 @@ _eet_data_descriptor_decode(Eet_Free_Context     *context,
 
         if (edd)
           {
-             ede = _eet_descriptor_hash_find(edd, echnk.name, echnk.hash);
+             ede = _eet_descriptor_element_find(edd, ed, &echnk, &next);
              if (ede)
                {
                   group_type = ede->group_type;
@@ -3637,6 +3897,17 @@ _eet_data_descriptor_decode(Eet_Free_Context     *context,
 
              eet_node_struct_append(result, echnk.name, child);
           }
+        else if (ede && group_type == EET_G_UNKNOWN &&
+                 IS_SIMPLE_TYPE(type) && !IS_POINTER_TYPE(type))
+          {
+             /* Plain numbers go straight to their field */
+             ret = eet_data_get_type(ed,
+                                     type,
+                                     echnk.data,
+                                     ((char *)echnk.data) + echnk.size,
+                                     ((char *)data) + ede->offset);
+             EINA_SAFETY_ON_TRUE_GOTO(ret <= 0, error);
+          }
         else
           {
              ret = eet_group_codec[group_type - 100].get(
@@ -3761,7 +4032,17 @@ eet_data_get_list(Eet_Free_Context     *context,
         list = edd->func.list_append(list, data_ret);
         *ptr = list;
         if (oldlist != list)
-          _eet_freelist_list_add(context, ptr);
+          {
+             /* The field is freed through ptr, whatever its head became,
+              * so it is only remembered on the first insertion */
+             if (context->arena)
+               {
+                  if (!oldlist)
+                    _eet_data_arena_cleanup_add(context->arena, edd, ptr, EET_G_LIST);
+               }
+             else
+               _eet_freelist_list_add(context, ptr);
+          }
      }
    else
      eet_node_list_append(*((Eet_Node **)data), echnk->name, data_ret);
@@ -3853,7 +4134,12 @@ eet_data_get_hash(Eet_Free_Context     *context,
         hash = edd->func.hash_add(hash, key, data_ret);
         *ptr = hash;
         if (oldhash != hash)
-          _eet_freelist_hash_add(context, hash);
+          {
+             if (context->arena)
+               _eet_data_arena_cleanup_add(context->arena, edd, hash, EET_G_HASH);
+             else
+               _eet_freelist_hash_add(context, hash);
+          }
      }
    else
      eet_node_hash_add(*((Eet_Node **)data), echnk->name, key, data_ret);
@@ -3922,10 +4208,7 @@ eet_data_get_array(Eet_Free_Context     *context,
               * on the counter offset */
                *(int *)(((char *)data) + ede->count - ede->offset) = count;
      /* allocate space for the array of elements */
-               if (edd->func.array_alloc)
-                 *(void **)ptr = edd->func.array_alloc(count * subsize);
-               else
-                 *(void **)ptr = edd->func.mem_alloc(count * subsize);
+               *(void **)ptr = _eet_data_array_alloc(context, edd, count * subsize);
 
                if (!*(void **)ptr)
                  return 0;
@@ -4171,7 +4454,10 @@ eet_data_get_union(Eet_Free_Context     *context,
                }
 
                /* Set union type. */
-               if ((!ed) || (!ede->subtype->func.str_direct_alloc))
+               if (context->arena)
+                 ut = ed ? (char *)union_type :
+                   _eet_data_arena_strdup(context->arena, union_type);
+               else if ((!ed) || (!ede->subtype->func.str_direct_alloc))
                  {
                     ut = ede->subtype->func.str_alloc(union_type);
                     _eet_freelist_str_add(context, ut);
@@ -4364,7 +4650,10 @@ eet_data_get_variant(Eet_Free_Context     *context,
 
         EET_ASSERT(ede->subtype, ERR("ERROR!"); goto on_error);
 
-        if ((!ed) || (!ede->subtype->func.str_direct_alloc))
+        if (context->arena)
+          ut = ed ? (char *)union_type :
+            _eet_data_arena_strdup(context->arena, union_type);
+        else if ((!ed) || (!ede->subtype->func.str_direct_alloc))
           {
              ut = ede->subtype->func.str_alloc(union_type);
              _eet_freelist_str_add(context, ut);
@@ -4443,7 +4732,11 @@ eet_data_get_variant(Eet_Free_Context     *context,
           {
              Eet_Variant_Unknow *evu;
 
-             evu = calloc(1, sizeof (Eet_Variant_Unknow) + echnk->size - 1);
+             if (context->arena)
+               evu = _eet_data_arena_alloc(context->arena,
+                                           sizeof (Eet_Variant_Unknow) + echnk->size - 1);
+             else
+               evu = calloc(1, sizeof (Eet_Variant_Unknow) + echnk->size - 1);
              EINA_SAFETY_ON_NULL_GOTO(evu, on_error);
 
              evu->size = echnk->size;
@@ -4562,7 +4855,13 @@ eet_data_get_unknown(Eet_Free_Context     *context,
 
                   if (*str)
                     {
-                       if ((!ed) || (!edd->func.str_direct_alloc))
+                       /* Dictionary strings live as long as the arena */
+                       if (context->arena)
+                         {
+                            if (!ed)
+                              *str = _eet_data_arena_strdup(context->arena, *str);
+                         }
+                       else if ((!ed) || (!edd->func.str_direct_alloc))
                          {
                             *str = edd->func.str_alloc(*str);
                             _eet_freelist_str_add(context, *str);
@@ -4580,10 +4879,22 @@ eet_data_get_unknown(Eet_Free_Context     *context,
 
                   if (*str)
                     {
-                       *str = edd->func.str_alloc(*str);
-                       _eet_freelist_str_add(context, *str);
+                       if (context->arena)
+                         *str = _eet_data_arena_strdup(context->arena, *str);
+                       else
+                         {
+                            *str = edd->func.str_alloc(*str);
+                            _eet_freelist_str_add(context, *str);
+                         }
                     }
                }
+             else if (type == EET_T_VALUE && context->arena)
+               {
+                  Eina_Value **value = data;
+
+                  if (*value)
+                    _eet_data_arena_cleanup_add(context->arena, edd, *value, EET_T_VALUE);
+               }
           }
      }
    else
@@ -4611,7 +4922,7 @@ eet_data_get_unknown(Eet_Free_Context     *context,
                   if (subtype && ede->group_type == EET_G_UNKNOWN_NESTED)
                     {
                        memcpy(data, data_ret, subtype->size);
-                       free(data_ret);
+                       if (!context->arena) free(data_ret);
                     }
                   else 
                     {
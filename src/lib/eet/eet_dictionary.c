@@ -20,6 +20,7 @@ eet_dictionary_add(void)
    if (!ed) return NULL;
    memset(ed->hash, -1, sizeof(int) * 256);
    eina_rwlock_new(&ed->rwlock);
+   eina_spinlock_new(&ed->converts_lock);
    return ed;
 }
 
@@ -30,6 +31,7 @@ eet_dictionary_free(Eet_Dictionary *ed)
 
    if (!ed) return;
    eina_rwlock_free(&ed->rwlock);
+   eina_spinlock_free(&ed->converts_lock);
 
    for (i = 0; i < ed->count; i++)
      {
@@ -72,9 +74,12 @@ _eet_dictionary_lookup(Eet_Dictionary *ed,
    return current;
 }
 
+/* Dictionaries of files opened read only never change once loaded, any
+ * thread can read them without locking. */
 void
 eet_dictionary_lock_read(const Eet_Dictionary *ed)
 {
+   if (ed->readonly) return;
    eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
 }
 
@@ -87,6 +92,7 @@ eet_dictionary_lock_write(Eet_Dictionary *ed)
 void
 eet_dictionary_unlock(const Eet_Dictionary *ed)
 {
+   if (ed->readonly) return;
    eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
 }
 
@@ -99,6 +105,8 @@ eet_dictionary_string_add(Eet_Dictionary *ed,
    int hash, idx, pidx, len, cnt;
 
    if (!ed) return -1;
+   /* shared by readers that do not lock it */
+   if (ed->readonly) return -1;
 
    hash = _eet_hash_gen(string, 8);
    len = strlen(string) + 1;
@@ -180,9 +188,9 @@ eet_dictionary_string_get_size(const Eet_Dictionary *ed,
 {
    int length;
 
-   eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_lock_read(ed);
    length = eet_dictionary_string_get_size_unlocked(ed, idx);
-   eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_unlock(ed);
    return length;
 }
 
@@ -193,9 +201,9 @@ eet_dictionary_count(const Eet_Dictionary *ed)
 
    if (!ed) return 0;
 
-   eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_lock_read(ed);
    cnt = ed->count;
-   eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_unlock(ed);
    return cnt;
 }
 
@@ -219,9 +227,9 @@ eet_dictionary_string_get_hash(const Eet_Dictionary *ed,
 {
    int hash;
 
-   eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_lock_read(ed);
    hash = eet_dictionary_string_get_hash_unlocked(ed, idx);
-   eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_unlock(ed);
    return hash;
 }
 
@@ -256,9 +264,9 @@ eet_dictionary_string_get_char(const Eet_Dictionary *ed,
 {
    const char *s = NULL;
 
-   eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_lock_read(ed);
    s = eet_dictionary_string_get_char_unlocked(ed, idx);
-   eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_unlock(ed);
    return s;
 }
 
@@ -326,6 +334,20 @@ done:
    return limit;
 }
 
+/* The conversion cache is shared by all the readers of a dictionary, it has
+ * its own lock as readers do not take the dictionary one exclusively. */
+static inline void
+eet_dictionary_convert_lock(const Eet_Dictionary *ed)
+{
+   eina_spinlock_take((Eina_Spinlock *)&ed->converts_lock);
+}
+
+static inline void
+eet_dictionary_convert_unlock(const Eet_Dictionary *ed)
+{
+   eina_spinlock_release((Eina_Spinlock *)&ed->converts_lock);
+}
+
 static Eet_Convert *
 eet_dictionary_convert_get_unlocked(const Eet_Dictionary *ed,
                                     int                   idx,
@@ -361,28 +383,35 @@ eet_dictionary_string_get_float_unlocked(const Eet_Dictionary *ed,
 
    if (!_eet_dictionary_test_unlocked(ed, idx, result)) return EINA_FALSE;
 
+   if (_eet_dictionary_string_get_float_cache(ed->all[idx].str,
+                                              ed->all[idx].len, result))
+     return EINA_TRUE;
+
+   eet_dictionary_convert_lock(ed);
+
    convert = eet_dictionary_convert_get_unlocked(ed, idx, &str);
-   if (!convert) return EINA_FALSE;
+   if (!convert) goto on_error;
 
    if (!(convert->type & EET_D_FLOAT))
      {
-        if (!_eet_dictionary_string_get_float_cache(str, ed->all[idx].len,
-                                                    &convert->f))
-          {
-             long long mantisse = 0;
-             long exponent = 0;
+        long long mantisse = 0;
+        long exponent = 0;
 
-             if (eina_convert_atod(str, ed->all[idx].len, &mantisse,
-                                   &exponent) == EINA_FALSE)
-               {
-                  return EINA_FALSE;
-               }
-             convert->f = ldexpf((float)mantisse, exponent);
-          }
+        if (eina_convert_atod(str, ed->all[idx].len, &mantisse,
+                              &exponent) == EINA_FALSE)
+          goto on_error;
+
+        convert->f = ldexpf((float)mantisse, exponent);
         convert->type |= EET_D_FLOAT;
      }
    *result = convert->f;
+
+   eet_dictionary_convert_unlock(ed);
    return EINA_TRUE;
+
+on_error:
+   eet_dictionary_convert_unlock(ed);
+   return EINA_FALSE;
 }
 
 Eina_Bool
@@ -392,9 +421,9 @@ eet_dictionary_string_get_float(const Eet_Dictionary *ed,
 {
    Eina_Bool ret;
 
-   eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_lock_read(ed);
    ret = eet_dictionary_string_get_float_unlocked(ed, idx, result);
-   eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_unlock(ed);
    return ret;
 }
 
@@ -408,29 +437,35 @@ eet_dictionary_string_get_double_unlocked(const Eet_Dictionary *ed,
 
    if (!_eet_dictionary_test_unlocked(ed, idx, result)) return EINA_FALSE;
 
+   if (_eet_dictionary_string_get_double_cache(ed->all[idx].str,
+                                               ed->all[idx].len, result))
+     return EINA_TRUE;
+
+   eet_dictionary_convert_lock(ed);
+
    convert = eet_dictionary_convert_get_unlocked(ed, idx, &str);
-   if (!convert) return EINA_FALSE;
+   if (!convert) goto on_error;
 
    if (!(convert->type & EET_D_DOUBLE))
      {
-        if (!_eet_dictionary_string_get_double_cache(str, ed->all[idx].len,
-                                                     &convert->d))
-          {
-             long long mantisse = 0;
-             long exponent = 0;
+        long long mantisse = 0;
+        long exponent = 0;
 
-             if (eina_convert_atod(str, ed->all[idx].len, &mantisse,
-                                   &exponent) == EINA_FALSE)
-               {
-                  return EINA_FALSE;
-               }
-             convert->d = ldexp((double)mantisse, exponent);
-          }
+        if (eina_convert_atod(str, ed->all[idx].len, &mantisse,
+                              &exponent) == EINA_FALSE)
+          goto on_error;
+
+        convert->d = ldexp((double)mantisse, exponent);
         convert->type |= EET_D_DOUBLE;
      }
-
    *result = convert->d;
+
+   eet_dictionary_convert_unlock(ed);
    return EINA_TRUE;
+
+on_error:
+   eet_dictionary_convert_unlock(ed);
+   return EINA_FALSE;
 }
 
 Eina_Bool
@@ -440,9 +475,9 @@ eet_dictionary_string_get_double(const Eet_Dictionary *ed,
 {
    Eina_Bool ret;
 
-   eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_lock_read(ed);
    ret = eet_dictionary_string_get_double_unlocked(ed, idx, result);
-   eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_unlock(ed);
    return ret;
 }
 
@@ -456,24 +491,29 @@ eet_dictionary_string_get_fp_unlocked(const Eet_Dictionary *ed,
 
    if (!_eet_dictionary_test_unlocked(ed, idx, result)) return EINA_FALSE;
 
+   eet_dictionary_convert_lock(ed);
+
    convert = eet_dictionary_convert_get_unlocked(ed, idx, &str);
-   if (!convert) return EINA_FALSE;
+   if (!convert) goto on_error;
 
    if (!(convert->type & EET_D_FIXED_POINT))
      {
         Eina_F32p32 fp;
 
         if (!eina_convert_atofp(str, ed->all[idx].len, &fp))
-          {
-             return EINA_FALSE;
-          }
+          goto on_error;
 
         convert->fp = fp;
         convert->type |= EET_D_FIXED_POINT;
      }
-
    *result = convert->fp;
+
+   eet_dictionary_convert_unlock(ed);
    return EINA_TRUE;
+
+on_error:
+   eet_dictionary_convert_unlock(ed);
+   return EINA_FALSE;
 }
 
 Eina_Bool
@@ -483,9 +523,9 @@ eet_dictionary_string_get_fp(const Eet_Dictionary *ed,
 {
    Eina_Bool ret;
 
-   eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_lock_read(ed);
    ret = eet_dictionary_string_get_fp_unlocked(ed, idx, result);
-   eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_unlock(ed);
    return ret;
 }
 
@@ -497,7 +537,7 @@ eet_dictionary_string_check(Eet_Dictionary *ed,
 
    if ((!ed) || (!string)) return 0;
 
-   eina_rwlock_take_read((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_lock_read(ed);
    if ((ed->start <= string) && (string < ed->end)) res = 1;
 
    if (!res)
@@ -511,7 +551,7 @@ eet_dictionary_string_check(Eet_Dictionary *ed,
                }
           }
      }
-   eina_rwlock_release((Eina_RWLock *)&ed->rwlock);
+   eet_dictionary_unlock(ed);
    return res;
 }
 
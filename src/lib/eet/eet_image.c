@@ -20,6 +20,11 @@
 #include <arm_neon.h>
 #endif
 
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+# include <emmintrin.h>
+# define EET_IMAGE_SSE2 1
+#endif
+
 #ifndef WORDS_BIGENDIAN
 /* x86 */
 #define A_VAL(p) (((uint8_t *)(p))[3])
@@ -193,7 +198,8 @@ eet_data_image_lossless_compressed_convert(int         *size,
                                            unsigned int w,
                                            unsigned int h,
                                            int          alpha,
-                                           int          compression);
+                                           int          compression,
+                                           Eina_Bool    predict);
 static void *
 eet_data_image_jpeg_convert(int         *size,
                             const void  *data,
@@ -266,6 +272,212 @@ _eet_image_endian_swap(void *data, unsigned int length)
 
 /*---*/
 
+/* Pixel kernels shared by the codecs. The SSE2 versions give exactly the
+ * same results as the plain C loops finishing their job. */
+
+/* Adds or subtracts the four bytes of a word independently */
+static inline uint32_t
+_eet_image_bytes_add(uint32_t a, uint32_t b)
+{
+   return ((a & 0x7f7f7f7f) + (b & 0x7f7f7f7f)) ^ ((a ^ b) & 0x80808080);
+}
+
+static inline uint32_t
+_eet_image_bytes_sub(uint32_t a, uint32_t b)
+{
+   return ((a | 0x80808080) - (b & 0x7f7f7f7f)) ^ ((a ^ ~b) & 0x80808080);
+}
+
+/* Alpha plane of ARGB pixels, as encoded by the JPEG alpha codec */
+static void
+_eet_image_alpha_extract(unsigned char *dst, const uint32_t *src,
+                         unsigned int len)
+{
+   unsigned int i = 0;
+
+#ifdef EET_IMAGE_SSE2
+   for (; i + 16 <= len; i += 16)
+     {
+        __m128i a0 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i)), 24);
+        __m128i a1 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i + 4)), 24);
+        __m128i a2 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i + 8)), 24);
+        __m128i a3 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i + 12)), 24);
+
+        _mm_storeu_si128((__m128i *)(dst + i),
+                         _mm_packus_epi16(_mm_packs_epi32(a0, a1),
+                                          _mm_packs_epi32(a2, a3)));
+     }
+#endif
+   for (; i < len; i++)
+     dst[i] = src[i] >> 24;
+}
+
+/* Puts an alpha plane back into ARGB or AGRY pixels */
+static void
+_eet_image_alpha_merge(uint32_t *dst, const unsigned char *alpha,
+                       unsigned int len)
+{
+   unsigned int i = 0;
+
+#ifdef EET_IMAGE_SSE2
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i rgb = _mm_set1_epi32(0x00ffffff);
+
+   for (; i + 16 <= len; i += 16)
+     {
+        __m128i a = _mm_loadu_si128((const __m128i *)(alpha + i));
+        __m128i lo = _mm_unpacklo_epi8(zero, a);
+        __m128i hi = _mm_unpackhi_epi8(zero, a);
+        __m128i *d = (__m128i *)(dst + i);
+
+        _mm_storeu_si128(d, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(d), rgb),
+                                         _mm_unpacklo_epi16(zero, lo)));
+        _mm_storeu_si128(d + 1, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(d + 1), rgb),
+                                             _mm_unpackhi_epi16(zero, lo)));
+        _mm_storeu_si128(d + 2, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(d + 2), rgb),
+                                             _mm_unpacklo_epi16(zero, hi)));
+        _mm_storeu_si128(d + 3, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(d + 3), rgb),
+                                             _mm_unpackhi_epi16(zero, hi)));
+     }
+#endif
+   for (; i < len; i++)
+     dst[i] = (dst[i] & 0x00ffffff) | (alpha[i] << 24);
+}
+
+static void
+_eet_image_alpha_merge_agry88(uint16_t *dst, const unsigned char *alpha,
+                              unsigned int len)
+{
+   unsigned int i = 0;
+
+#ifdef EET_IMAGE_SSE2
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i grey = _mm_set1_epi16(0x00ff);
+
+   for (; i + 16 <= len; i += 16)
+     {
+        __m128i a = _mm_loadu_si128((const __m128i *)(alpha + i));
+        __m128i *d = (__m128i *)(dst + i);
+
+        _mm_storeu_si128(d, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(d), grey),
+                                         _mm_unpacklo_epi8(zero, a)));
+        _mm_storeu_si128(d + 1, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(d + 1), grey),
+                                             _mm_unpackhi_epi8(zero, a)));
+     }
+#endif
+   for (; i < len; i++)
+     dst[i] = (dst[i] & 0x00ff) | (alpha[i] << 8);
+}
+
+/* Copies pixels as long as they are grey, returns how many were */
+static unsigned int
+_eet_image_grey_get(unsigned int *grey, const unsigned int *pixels,
+                    unsigned int len)
+{
+   unsigned int i = 0;
+
+#ifdef EET_IMAGE_SSE2
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i gb = _mm_set1_epi32(0x0000ffff);
+   const __m128i r = _mm_set1_epi32(0xff000000);
+
+   for (; i + 4 <= len; i += 4)
+     {
+        __m128i p = _mm_loadu_si128((const __m128i *)(pixels + i));
+        /* r == g and g == b when xoring each with the next is zero */
+        __m128i diff = _mm_and_si128(_mm_xor_si128(p, _mm_srli_epi32(p, 8)), gb);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(diff, zero)) != 0xffff)
+          break;
+        _mm_storeu_si128((__m128i *)(grey + i),
+                         _mm_and_si128(_mm_slli_epi32(p, 8), r));
+     }
+#endif
+   for (; i < len; i++)
+     {
+        uint8_t r, g, b;
+
+        r = R_VAL(&pixels[i]);
+        g = G_VAL(&pixels[i]);
+        b = B_VAL(&pixels[i]);
+        if (!(r == g && g == b))
+          break ;
+        grey[i] = r << 24;
+     }
+
+   return i;
+}
+
+/* The lossless predictor: each byte is stored minus the one on its left,
+ * minus the one above, plus the one above on the left. Flat areas and
+ * gradients in either direction end up as runs of zeros, which lz4 packs
+ * well, and getting the pixels back only takes adds. Done on bytes, it
+ * does not depend on endianness. */
+static void
+_eet_image_predict(uint32_t *p, unsigned int w, unsigned int h)
+{
+   unsigned int x, y;
+
+   if (!w || !h) return;
+   for (y = h - 1; y > 0; y--)
+     {
+        uint32_t *row = p + y * w;
+        const uint32_t *above = row - w;
+
+        for (x = 0; x < w; x++)
+          row[x] = _eet_image_bytes_sub(row[x], above[x]);
+     }
+   for (y = 0; y < h; y++)
+     {
+        uint32_t *row = p + y * w;
+
+        for (x = w - 1; x > 0; x--)
+          row[x] = _eet_image_bytes_sub(row[x], row[x - 1]);
+     }
+}
+
+static void
+_eet_image_unpredict(uint32_t *p, unsigned int w, unsigned int h)
+{
+   unsigned int x, y;
+
+   for (y = 0; y < h; y++)
+     {
+        uint32_t *row = p + y * w;
+        const uint32_t *above = row - w;
+        uint32_t left = 0;
+
+        x = 0;
+#ifdef EET_IMAGE_SSE2
+        {
+           __m128i carry = _mm_setzero_si128();
+
+           for (; x + 4 <= w; x += 4)
+             {
+                __m128i v = _mm_loadu_si128((const __m128i *)(row + x));
+
+                /* Prefix sum of the four pixels, then of the previous ones */
+                v = _mm_add_epi8(v, _mm_slli_si128(v, 4));
+                v = _mm_add_epi8(v, _mm_slli_si128(v, 8));
+                v = _mm_add_epi8(v, carry);
+                carry = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+                if (y)
+                  v = _mm_add_epi8(v, _mm_loadu_si128((const __m128i *)(above + x)));
+                _mm_storeu_si128((__m128i *)(row + x), v);
+             }
+           if (x) left = _mm_cvtsi128_si32(carry);
+        }
+#endif
+        for (; x < w; x++)
+          {
+             left = _eet_image_bytes_add(row[x], left);
+             row[x] = y ? _eet_image_bytes_add(left, above[x]) : left;
+          }
+     }
+}
+
+/*---*/
+
 static void
 _eet_image_jpeg_error_exit_cb(j_common_ptr cinfo)
 {
@@ -439,7 +651,6 @@ eet_data_image_jpeg_alpha_decode(const void   *data,
    unsigned char *remember = NULL, *tmp;
    Emile_Image_Load_Error error;
    int r = 0;
-   unsigned int i;
 
    /* FIXME: handle src_x, src_y and row_stride correctly */
    if (!pixels)
@@ -472,29 +683,9 @@ eet_data_image_jpeg_alpha_decode(const void   *data,
      goto on_error;
 
    if (cspace == EMILE_COLORSPACE_AGRY88)
-     {
-        unsigned short *d = pixels;
-
-        for (i = 0; i < w * h; i++)
-          {
-             *d = ((*d) & 0x00ff) |
-               ((*tmp) << 8);
-             tmp++;
-             d++;
-          }
-     }
+     _eet_image_alpha_merge_agry88(pixels, tmp, w * h);
    else if (cspace == EMILE_COLORSPACE_ARGB8888)
-     {
-        unsigned int *d = pixels;
-
-        for (i = 0; i < w * h; i++)
-          {
-             *d = ((*d) & 0x00ffffff) |
-               ((*tmp) << 24);
-             tmp++;
-             d++;
-          }
-     }
+     _eet_image_alpha_merge(pixels, tmp, w * h);
 
    r = 1;
 
@@ -513,6 +704,33 @@ _eet_argb_premul(unsigned int *data, unsigned int len)
 {
    unsigned int *de = data + len;
 
+#ifdef EET_IMAGE_SSE2
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i one = _mm_set1_epi16(1);
+   const __m128i amask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+   /* Same maths as below on 16 bits channels: (c * (a + 1)) >> 8 */
+   for (; data + 4 <= de; data += 4)
+     {
+        __m128i p = _mm_loadu_si128((const __m128i *)data);
+        __m128i lo = _mm_unpacklo_epi8(p, zero);
+        __m128i hi = _mm_unpackhi_epi8(p, zero);
+        __m128i alo, ahi;
+
+        alo = _mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3));
+        alo = _mm_add_epi16(_mm_shufflehi_epi16(alo, _MM_SHUFFLE(3, 3, 3, 3)), one);
+        ahi = _mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3));
+        ahi = _mm_add_epi16(_mm_shufflehi_epi16(ahi, _MM_SHUFFLE(3, 3, 3, 3)), one);
+
+        alo = _mm_srli_epi16(_mm_mullo_epi16(lo, alo), 8);
+        ahi = _mm_srli_epi16(_mm_mullo_epi16(hi, ahi), 8);
+        lo = _mm_or_si128(_mm_and_si128(amask, lo), _mm_andnot_si128(amask, alo));
+        hi = _mm_or_si128(_mm_and_si128(amask, hi), _mm_andnot_si128(amask, ahi));
+
+        _mm_storeu_si128((__m128i *)data, _mm_packus_epi16(lo, hi));
+     }
+#endif
+
    while (data < de)
      {
         unsigned int  a = 1 + (*data >> 24);
@@ -687,7 +905,8 @@ eet_data_image_lossless_compressed_convert(int         *size,
                                            unsigned int w,
                                            unsigned int h,
                                            int          alpha,
-                                           int          compression)
+                                           int          compression,
+                                           Eina_Bool    predict)
 {
    _eet_image_endian_check();
 
@@ -698,13 +917,14 @@ eet_data_image_lossless_compressed_convert(int         *size,
       int *bigend_data = NULL;
       int header[8];
 
-      if (_eet_image_words_bigendian)
+      if (_eet_image_words_bigendian || predict)
         {
            bigend_data = (int *) malloc(w * h * 4);
            if (!bigend_data) return NULL;
 
            memcpy(bigend_data, data, w * h * 4);
            _eet_image_endian_swap(bigend_data, w * h);
+           if (predict) _eet_image_predict((uint32_t *)bigend_data, w, h);
 
            data = (const char *) bigend_data;
         }
@@ -730,7 +950,7 @@ eet_data_image_lossless_compressed_convert(int         *size,
       eina_binbuf_free(in);
 
       memset(header, 0, 8 * sizeof(int));
-      header[0] = 0xac1dfeed;
+      header[0] = predict ? 0xac1dfeef : 0xac1dfeed;
       header[1] = w;
       header[2] = h;
       header[3] = alpha;
@@ -765,13 +985,258 @@ _block_size_get(int size)
 static inline void
 _alpha_to_greyscale_convert(uint32_t *data, int len)
 {
-   for (int k = 0; k < len; k++)
+   int k = 0;
+
+#ifdef EET_IMAGE_SSE2
+   for (; k + 4 <= len; k += 4, data += 4)
+     {
+        __m128i a = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)data), 24);
+
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+        _mm_storeu_si128((__m128i *)data, _mm_or_si128(a, _mm_slli_epi32(a, 16)));
+     }
+#endif
+   for (; k < len; k++)
      {
         int alpha = A_VAL(data);
         *data++ = ARGB_JOIN(alpha, alpha, alpha, alpha);
      }
 }
 
+#ifdef DEBUG_STATS
+typedef struct _Eet_Etc_Stats Eet_Etc_Stats;
+struct _Eet_Etc_Stats
+{
+   long long mse, mse_alpha, mse_div;
+};
+#endif
+
+typedef struct _Eet_Etc_Job Eet_Etc_Job;
+struct _Eet_Etc_Job
+{
+   uint32_t *data;
+   Eina_Binbuf **rows;
+#ifdef DEBUG_STATS
+   Eet_Etc_Stats *stats; // one per row, summed once the rows are done
+#endif
+   rg_etc1_pack_params *param;
+   Eina_Spinlock lock;
+   Eet_Colorspace cspace;
+   int image_stride, image_height;
+   int macro_block_width, macro_block_height;
+   int block_count, etc_block_size;
+   int plane;
+   int count;
+   int next;
+   Eina_Bool compress;
+   Eina_Bool alpha;
+};
+
+// Encode one row of macro blocks, each row being independent
+static Eina_Binbuf *
+_eet_etc_row_encode(Eet_Etc_Job *job, int y)
+{
+   uint32_t *data = job->data;
+   const int image_stride = job->image_stride;
+   const int image_height = job->image_height;
+   const int macro_block_width = job->macro_block_width;
+   const int macro_block_height = job->macro_block_height;
+   uint32_t *input, *last_col, *last_row, *last_pix;
+   Eina_Binbuf *r;
+   uint8_t *buffer;
+   int real_y;
+#ifdef DEBUG_STATS
+   Eet_Etc_Stats *stats = &job->stats[y / macro_block_height];
+#endif
+
+   r = eina_binbuf_new();
+   if (!r) return NULL;
+   buffer = alloca(job->block_count * job->etc_block_size);
+
+   if (y == 0) real_y = 0;
+   else if (y < image_height + 1) real_y = y - 1;
+   else real_y = image_height - 1;
+
+   for (int x = 0; x < image_stride + 2; x += macro_block_width)
+     {
+        Eina_Binbuf *in;
+        uint8_t *offset = buffer;
+        int real_x = x;
+
+        if (x == 0) real_x = 0;
+        else if (x < image_stride + 1) real_x = x - 1;
+        else real_x = image_stride - 1;
+
+        input = data + real_y * image_stride + real_x;
+        last_row = data + image_stride * (image_height - 1) + real_x;
+        last_col = data + (real_y + 1) * image_stride - 1;
+        last_pix = data + image_height * image_stride - 1;
+
+        for (int by = 0; by < macro_block_height; by += 4)
+          {
+             int dup_top = ((y + by) == 0) ? 1 : 0;
+             int max_row = MAX(0, MIN(4, image_height - real_y - by));
+             int oy = (y == 0) ? 1 : 0;
+
+             for (int bx = 0; bx < macro_block_width; bx += 4)
+               {
+                  int dup_left = ((x + bx) == 0) ? 1 : 0;
+                  int max_col = MAX(0, MIN(4, image_stride - real_x - bx));
+                  uint32_t todo[16] = { 0 };
+                  int row, col;
+                  int ox = (x == 0) ? 1 : 0;
+
+                  if (dup_left)
+                    {
+                       // Duplicate left column
+                       for (row = 0; row < max_row; row++)
+                         todo[row * 4] = input[row * image_stride];
+                       for (row = max_row; row < 4; row++)
+                         todo[row * 4] = last_row[0];
+                    }
+
+                  if (dup_top)
+                    {
+                       // Duplicate top row
+                       for (col = 0; col < max_col; col++)
+                         todo[col] = input[MAX(col + bx - ox, 0)];
+                       for (col = max_col; col < 4; col++)
+                         todo[col] = last_col[0];
+                    }
+
+                  for (row = dup_top; row < 4; row++)
+                    {
+                       for (col = dup_left; col < max_col; col++)
+                         {
+                            if (row < max_row)
+                              {
+                                 // Normal copy
+                                 todo[row * 4 + col] = input[(row + by - oy) * image_stride + bx + col - ox];
+                              }
+                            else
+                              {
+                                 // Copy last line
+                                 todo[row * 4 + col] = last_row[col + bx - ox];
+                              }
+                         }
+                       for (col = max_col; col < 4; col++)
+                         {
+                            // Right edge
+                            if (row < max_row)
+                              {
+                                 // Duplicate last column
+                                 todo[row * 4 + col] = last_col[MAX(row + by - oy, 0) * image_stride];
+                              }
+                            else
+                              {
+                                 // Duplicate very last pixel again and again
+                                 todo[row * 4 + col] = *last_pix;
+                              }
+                         }
+                    }
+
+                  switch (job->cspace)
+                    {
+                     case EET_COLORSPACE_ETC1:
+                     case EET_COLORSPACE_ETC1_ALPHA:
+                       rg_etc1_pack_block(offset, (uint32_t *) todo, job->param);
+                       break;
+                     case EET_COLORSPACE_RGB8_ETC2:
+                       etc2_rgb8_block_pack(offset, (uint32_t *) todo, job->param);
+                       break;
+                     case EET_COLORSPACE_RGBA8_ETC2_EAC:
+                       etc2_rgba8_block_pack(offset, (uint32_t *) todo, job->param);
+                       break;
+                     default:
+                       eina_binbuf_free(r);
+                       return NULL;
+                    }
+
+#ifdef DEBUG_STATS
+                  if (job->plane == 0)
+                    {
+                       // Decode to compute PSNR, this is slow.
+                       uint32_t done[16];
+
+                       if (job->alpha)
+                         rg_etc2_rgba8_decode_block(offset, done);
+                       else
+                          rg_etc2_rgb8_decode_block(offset, done);
+
+                       for (int k = 0; k < 16; k++)
+                         {
+                            const int dr = (R_VAL(&(todo[k])) - R_VAL(&(done[k])));
+                            const int dg = (G_VAL(&(todo[k])) - G_VAL(&(done[k])));
+                            const int db = (B_VAL(&(todo[k])) - B_VAL(&(done[k])));
+                            const int da = (A_VAL(&(todo[k])) - A_VAL(&(done[k])));
+                            stats->mse += dr*dr + dg*dg + db*db;
+                            if (job->alpha) stats->mse_alpha += da*da;
+                            stats->mse_div++;
+                         }
+                    }
+#endif
+
+                  offset += job->etc_block_size;
+               }
+          }
+
+        in = eina_binbuf_manage_new(buffer, job->block_count * job->etc_block_size, EINA_TRUE);
+        if (job->compress)
+          {
+             Eina_Binbuf *out;
+
+             out = emile_compress(in, EMILE_LZ4HC, EMILE_COMPRESSOR_BEST);
+             eina_binbuf_free(in);
+             in = out;
+          }
+
+        if (eina_binbuf_length_get(in) > 0)
+          {
+             unsigned int blen = eina_binbuf_length_get(in);
+
+             while (blen)
+               {
+                  unsigned char plen;
+
+                  plen = blen & 0x7F;
+                  blen = blen >> 7;
+
+                  if (blen) plen = 0x80 | plen;
+                  eina_binbuf_append_length(r, &plen, 1);
+               }
+             eina_binbuf_append_buffer(r, in);
+          }
+        eina_binbuf_free(in);
+     } // 4 rows
+
+   return r;
+}
+
+// Run by the encoding thread and the workers, each row is only touched by
+// the one thread that picked it.
+static void
+_eet_etc_job_run(Eet_Etc_Job *job)
+{
+   while (1)
+     {
+        int i;
+
+        eina_spinlock_take(&job->lock);
+        i = job->next++;
+        eina_spinlock_release(&job->lock);
+        if (i >= job->count) break;
+
+        job->rows[i] = _eet_etc_row_encode(job, i * job->macro_block_height);
+     }
+}
+
+static void *
+_eet_etc_job_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   _eet_etc_job_run(data);
+   return NULL;
+}
+
 static void *
 eet_data_image_etc1_compressed_convert(int         *size,
                                        const unsigned char *data8,
@@ -782,7 +1247,10 @@ eet_data_image_etc1_compressed_convert(int         *size,
                                        Eet_Image_Encoding lossy)
 {
    rg_etc1_pack_params param;
-   uint8_t *buffer;
+   Eet_Etc_Job job;
+   Eina_Thread *threads = NULL;
+   int wanted, created;
+   Eina_Bool failed = EINA_FALSE;
    uint32_t *data;
    uint32_t nl_width, nl_height;
    uint8_t header[8] = "TGV1";
@@ -875,7 +1343,49 @@ eet_data_image_etc1_compressed_convert(int         *size,
 
    // Number of ETC1 blocks in a compressed block
    block_count = (macro_block_width * macro_block_height) / (4 * 4);
-   buffer = alloca(block_count * etc_block_size);
+
+   memset(&job, 0, sizeof (job));
+   job.param = &param;
+   job.cspace = cspace;
+   job.image_stride = image_stride;
+   job.image_height = image_height;
+   job.macro_block_width = macro_block_width;
+   job.macro_block_height = macro_block_height;
+   job.block_count = block_count;
+   job.etc_block_size = etc_block_size;
+   job.compress = compress;
+   job.alpha = (cspace == EET_COLORSPACE_RGBA8_ETC2_EAC);
+   job.count = (image_height + 2 + macro_block_height - 1) / macro_block_height;
+   job.rows = calloc(job.count, sizeof (Eina_Binbuf *));
+#ifdef DEBUG_STATS
+   job.stats = calloc(job.count, sizeof (Eet_Etc_Stats));
+   if (!job.stats)
+     {
+        free(job.rows);
+        eina_binbuf_free(r);
+        return NULL;
+     }
+#endif
+   if (!job.rows || !eina_spinlock_new(&job.lock))
+     {
+#ifdef DEBUG_STATS
+        free(job.stats);
+#endif
+        free(job.rows);
+        eina_binbuf_free(r);
+        return NULL;
+     }
+
+   wanted = eina_cpu_count();
+   if (wanted > EET_COMPRESSION_THREADS_MAX) wanted = EET_COMPRESSION_THREADS_MAX;
+   if (wanted > job.count) wanted = job.count;
+   wanted--;
+   if (wanted > 0)
+     {
+        // The encoder tables are lazily set up, do it before the threads
+        rg_etc1_pack_block_init();
+        threads = malloc(wanted * sizeof (Eina_Thread));
+     }
 
    // Write a whole plane (RGB or Alpha)
    for (int plane = 0; plane < num_planes; plane++)
@@ -890,7 +1400,11 @@ eet_data_image_etc1_compressed_convert(int         *size,
              int len = image_stride * image_height;
              // RGB plane for ETC1+Alpha
              data = malloc(len * 4);
-             if (!data) goto finish;
+             if (!data)
+               {
+                  failed = EINA_TRUE;
+                  goto finish;
+               }
              memcpy(data, data8, len * 4);
              if (unpremul) _eet_argb_unpremul(data, len);
           }
@@ -900,170 +1414,65 @@ eet_data_image_etc1_compressed_convert(int         *size,
              _alpha_to_greyscale_convert(data, image_stride * image_height);
           }
 
-        // Write macro block
-        for (int y = 0; y < image_height + 2; y += macro_block_height)
+        // Write macro blocks, rows spread over the threads but written
+        // in order, so the output does not depend on the number of threads
+        job.data = data;
+        job.plane = plane;
+        job.next = 0;
+
+        created = 0;
+        for (; threads && created < wanted; created++)
+          if (!eina_thread_create(&threads[created], EINA_THREAD_NORMAL, -1,
+                                  _eet_etc_job_thread, &job))
+            break;
+        _eet_etc_job_run(&job);
+        for (int i = 0; i < created; i++)
+          eina_thread_join(threads[i]);
+
+        for (int i = 0; i < job.count; i++)
           {
-             uint32_t *input, *last_col, *last_row, *last_pix;
-             int real_y;
-
-             if (y == 0) real_y = 0;
-             else if (y < image_height + 1) real_y = y - 1;
-             else real_y = image_height - 1;
-
-             for (int x = 0; x < image_stride + 2; x += macro_block_width)
+             if (!job.rows[i])
                {
-                  Eina_Binbuf *in;
-                  uint8_t *offset = buffer;
-                  int real_x = x;
-
-                  if (x == 0) real_x = 0;
-                  else if (x < image_stride + 1) real_x = x - 1;
-                  else real_x = image_stride - 1;
-
-                  input = data + real_y * image_stride + real_x;
-                  last_row = data + image_stride * (image_height - 1) + real_x;
-                  last_col = data + (real_y + 1) * image_stride - 1;
-                  last_pix = data + image_height * image_stride - 1;
-
-                  for (int by = 0; by < macro_block_height; by += 4)
-                    {
-                       int dup_top = ((y + by) == 0) ? 1 : 0;
-                       int max_row = MAX(0, MIN(4, image_height - real_y - by));
-                       int oy = (y == 0) ? 1 : 0;
-
-                       for (int bx = 0; bx < macro_block_width; bx += 4)
-                         {
-                            int dup_left = ((x + bx) == 0) ? 1 : 0;
-                            int max_col = MAX(0, MIN(4, image_stride - real_x - bx));
-                            uint32_t todo[16] = { 0 };
-                            int row, col;
-                            int ox = (x == 0) ? 1 : 0;
-
-                            if (dup_left)
-                              {
-                                 // Duplicate left column
-                                 for (row = 0; row < max_row; row++)
-                                   todo[row * 4] = input[row * image_stride];
-                                 for (row = max_row; row < 4; row++)
-                                   todo[row * 4] = last_row[0];
-                              }
-
-                            if (dup_top)
-                              {
-                                 // Duplicate top row
-                                 for (col = 0; col < max_col; col++)
-                                   todo[col] = input[MAX(col + bx - ox, 0)];
-                                 for (col = max_col; col < 4; col++)
-                                   todo[col] = last_col[0];
-                              }
-
-                            for (row = dup_top; row < 4; row++)
-                              {
-                                 for (col = dup_left; col < max_col; col++)
-                                   {
-                                      if (row < max_row)
-                                        {
-                                           // Normal copy
-                                           todo[row * 4 + col] = input[(row + by - oy) * image_stride + bx + col - ox];
-                                        }
-                                      else
-                                        {
-                                           // Copy last line
-                                           todo[row * 4 + col] = last_row[col + bx - ox];
-                                        }
-                                   }
-                                 for (col = max_col; col < 4; col++)
-                                   {
-                                      // Right edge
-                                      if (row < max_row)
-                                        {
-                                           // Duplicate last column
-                                           todo[row * 4 + col] = last_col[MAX(row + by - oy, 0) * image_stride];
-                                        }
-                                      else
-                                        {
-                                           // Duplicate very last pixel again and again
-                                           todo[row * 4 + col] = *last_pix;
-                                        }
-                                   }
-                              }
-
-                            switch (cspace)
-                              {
-                               case EET_COLORSPACE_ETC1:
-                               case EET_COLORSPACE_ETC1_ALPHA:
-                                 rg_etc1_pack_block(offset, (uint32_t *) todo, &param);
-                                 break;
-                               case EET_COLORSPACE_RGB8_ETC2:
-                                 etc2_rgb8_block_pack(offset, (uint32_t *) todo, &param);
-                                 break;
-                               case EET_COLORSPACE_RGBA8_ETC2_EAC:
-                                 etc2_rgba8_block_pack(offset, (uint32_t *) todo, &param);
-                                 break;
-                               default: return 0;
-                              }
+                  failed = EINA_TRUE;
+                  continue;
+               }
+             eina_binbuf_append_buffer(r, job.rows[i]);
+             eina_binbuf_free(job.rows[i]);
+             job.rows[i] = NULL;
+          }
+        if (failed) goto finish;
+     } // planes
 
 #ifdef DEBUG_STATS
-                            if (plane == 0)
-                              {
-                                 // Decode to compute PSNR, this is slow.
-                                 uint32_t done[16];
-
-                                 if (alpha)
-                                   rg_etc2_rgba8_decode_block(offset, done);
-                                 else
-                                    rg_etc2_rgb8_decode_block(offset, done);
-
-                                 for (int k = 0; k < 16; k++)
-                                   {
-                                      const int r = (R_VAL(&(todo[k])) - R_VAL(&(done[k])));
-                                      const int g = (G_VAL(&(todo[k])) - G_VAL(&(done[k])));
-                                      const int b = (B_VAL(&(todo[k])) - B_VAL(&(done[k])));
-                                      const int a = (A_VAL(&(todo[k])) - A_VAL(&(done[k])));
-                                      mse += r*r + g*g + b*b;
-                                      if (alpha) mse_alpha += a*a;
-                                      mse_div++;
-                                   }
-                              }
-#endif
-
-                            offset += etc_block_size;
-                         }
-                    }
-
-                  in = eina_binbuf_manage_new(buffer, block_count * etc_block_size, EINA_TRUE);
-                  if (compress)
-                    {
-                       Eina_Binbuf *out;
-
-                       out = emile_compress(in, EMILE_LZ4HC, EMILE_COMPRESSOR_BEST);
-                       eina_binbuf_free(in);
-                       in = out;
-                    }
-
-                  if (eina_binbuf_length_get(in) > 0)
-                    {
-                       unsigned int blen = eina_binbuf_length_get(in);
-
-                       while (blen)
-                         {
-                            unsigned char plen;
-
-                            plen = blen & 0x7F;
-                            blen = blen >> 7;
+     {
+        Eet_Etc_Stats total = { 0, 0, 0 };
 
-                            if (blen) plen = 0x80 | plen;
-                            eina_binbuf_append_length(r, &plen, 1);
-                         }
-                       eina_binbuf_append_buffer(r, in);
-                    }
-                  eina_binbuf_free(in);
-               } // 4 rows
-          } // macroblocks
-     } // planes
+        for (int i = 0; i < job.count; i++)
+          {
+             total.mse += job.stats[i].mse;
+             total.mse_alpha += job.stats[i].mse_alpha;
+             total.mse_div += job.stats[i].mse_div;
+          }
+        if (total.mse_div)
+          INF("Encoded %dx%d image to %s, MSE %f (RGB) %f (alpha)", w, h, codec,
+              (double) total.mse / (3.0 * total.mse_div),
+              (double) total.mse_alpha / (double) total.mse_div);
+     }
+#endif
 
 finish:
    if (alpha_texture) free(data);
+   free(threads);
+#ifdef DEBUG_STATS
+   free(job.stats);
+#endif
+   free(job.rows);
+   eina_spinlock_free(&job.lock);
+   if (failed)
+     {
+        eina_binbuf_free(r);
+        return NULL;
+     }
    *size = eina_binbuf_length_get(r);
    result = eina_binbuf_string_steal(r);
    eina_binbuf_free(r);
@@ -1124,15 +1533,9 @@ _eet_data_image_grey_encode(const void *data,
 
    while (cinfo.next_scanline < cinfo.image_height)
      {
-        unsigned int i, j;
-
         ptr = ((const int *)data) + cinfo.next_scanline * w;
-        /* convert scaline from ARGB to RGB packed */
-        for (j = 0, i = 0; i < w; i++)
-          {
-             buf[j++] = ((*ptr) >> 24) & 0xff;
-             ptr++;
-          }
+        /* convert scaline from ARGB to its alpha */
+        _eet_image_alpha_extract(buf, (const uint32_t *)ptr, w);
         jbuf = (JSAMPROW *)(&buf);
         jpeg_write_scanlines(&cinfo, jbuf, 1);
      }
@@ -1170,22 +1573,7 @@ _eet_data_image_rgb_encode(const void *data,
    grey = malloc(sizeof (int) * w * h);
    if (grey)
      {
-        const unsigned int *pixels = data;
-        unsigned int i;
-
-        for (i = 0; i < w * h; i++)
-          {
-             uint8_t r, g, b;
-
-             r = R_VAL(&pixels[i]);
-             g = G_VAL(&pixels[i]);
-             b = B_VAL(&pixels[i]);
-             if (!(r == g && g == b))
-               break ;
-             grey[i] = r << 24;
-          }
-
-        if (i == w * h)
+        if (_eet_image_grey_get(grey, data, w * h) == w * h)
           {
              d = _eet_data_image_grey_encode(grey, w, h, quality, size);
              free(grey);
@@ -1576,13 +1964,23 @@ eet_data_image_encode_cipher(const void  *data,
       case EET_IMAGE_LOSSLESS:
          if (comp > 0)
            d = eet_data_image_lossless_compressed_convert(&size, data,
-                                                          w, h, alpha, comp);
+                                                          w, h, alpha, comp,
+                                                          EINA_FALSE);
 
          /* eet_data_image_lossless_compressed_convert will refuse to compress something
             if the result is bigger than the entry. */
          if (comp <= 0 || !d)
            d = eet_data_image_lossless_convert(&size, data, w, h, alpha);
          break;
+      case EET_IMAGE_LOSSLESS_PREDICTED:
+         /* Without compression it would just be slower to decode */
+         if (comp <= 0) comp = EET_COMPRESSION_SUPERFAST;
+         d = eet_data_image_lossless_compressed_convert(&size, data,
+                                                        w, h, alpha, comp,
+                                                        EINA_TRUE);
+         if (!d)
+           d = eet_data_image_lossless_convert(&size, data, w, h, alpha);
+         break;
       case EET_IMAGE_JPEG:
          if (!alpha)
            d = eet_data_image_jpeg_convert(&size, data, w, h, alpha, quality);
@@ -1706,8 +2104,10 @@ eet_data_image_header_advance_decode_cipher(const void   *data,
    memcpy(header, data, 32);
    _eet_image_endian_swap(header, 8);
 
-   if ((unsigned)header[0] == 0xac1dfeed)
+   if (((unsigned)header[0] == 0xac1dfeed) ||
+       ((unsigned)header[0] == 0xac1dfeef))
      {
+        Eina_Bool predicted = (unsigned)header[0] == 0xac1dfeef;
         int iw, ih, al, cp;
 
         iw = header[1];
@@ -1720,6 +2120,10 @@ eet_data_image_header_advance_decode_cipher(const void   *data,
         if ((cp == 0) && (size < ((iw * ih * 4) + 32)))
           goto on_error;
 
+        /* Predicted pixels are always compressed */
+        if (predicted && (cp == 0))
+          goto on_error;
+
         if (w)
           *w = iw;
 
@@ -1733,7 +2137,7 @@ eet_data_image_header_advance_decode_cipher(const void   *data,
           *comp = cp;
 
         if (lossy)
-          *lossy = EET_IMAGE_LOSSLESS;
+          *lossy = predicted ? EET_IMAGE_LOSSLESS_PREDICTED : EET_IMAGE_LOSSLESS;
 
         if (quality)
           *quality = 100;
@@ -1943,7 +2347,7 @@ _eet_data_image_copy_buffer(const unsigned int *src,
         unsigned int *over = dst;
         unsigned int y;
 
-        for (y = 0; y < h; ++y, src += src_w, over += row_stride)
+        for (y = 0; y < h; ++y, src += src_w, over += row_stride / 4)
           memcpy(over, src, w * 4);
      }
 }
@@ -1967,8 +2371,10 @@ _eet_data_image_decode_inside(const void   *data,
 {
    _eet_image_endian_check();
 
-   if (lossy == EET_IMAGE_LOSSLESS && quality == 100)
+   if ((lossy == EET_IMAGE_LOSSLESS || lossy == EET_IMAGE_LOSSLESS_PREDICTED) &&
+       quality == 100)
      {
+        Eina_Bool predicted = lossy == EET_IMAGE_LOSSLESS_PREDICTED;
         unsigned int *body;
 
         body = ((unsigned int *)data) + 8;
@@ -1991,6 +2397,7 @@ _eet_data_image_decode_inside(const void   *data,
                   eina_binbuf_free(in);
                   eina_binbuf_free(out);
                   if (!expanded) return 0;
+                  if (predicted) _eet_image_unpredict(d, w, h);
                }
              else
                {
@@ -1998,10 +2405,13 @@ _eet_data_image_decode_inside(const void   *data,
                      compressed data and tile could not always work.*/
                   out = emile_decompress(in,
                                          eet_2_emile_compressor(comp),
-                                         w * h * 4);
+                                         src_w * src_h * 4);
                   eina_binbuf_free(in);
                   if (!out) return 0;
 
+                  if (predicted)
+                    _eet_image_unpredict((uint32_t *)eina_binbuf_string_get(out),
+                                         src_w, src_h);
                   _eet_data_image_copy_buffer((const unsigned int *) eina_binbuf_string_get(out),
                                               src_x, src_y, src_w, d,
                                               w, h, row_stride);
@@ -2,6 +2,7 @@
 # include <config.h>
 #endif /* ifdef HAVE_CONFIG_H */
 
+#include <stddef.h>
 #include <stdio.h>
 #include <errno.h>
 #include <sys/types.h>
@@ -33,6 +34,10 @@ EAPI Eet_Version *eet_version = &_version;
 #define EET_MAGIC_FILE_HEADER 0x1ee7ff01
 
 #define EET_MAGIC_FILE2       0x1ee70f42
+/* Appended files start with this magic, followed by the offset of their
+ * latest v2 directory block. */
+#define EET_MAGIC_FILE2_APPEND 0x1ee70f43
+#define EET_MAGIC_DIRECTORY_INDEX 0x1ee70f44
 
 #define EET_FILE2_HEADER_COUNT           3
 #define EET_FILE2_DIRECTORY_ENTRY_COUNT  6
@@ -45,6 +50,12 @@ EAPI Eet_Version *eet_version = &_version;
 #define EET_FILE2_DICTIONARY_ENTRY_SIZE  (sizeof(int) * \
                                           EET_FILE2_DICTIONARY_ENTRY_COUNT)
 
+/* Set on the first directory entry when it is an up to date index */
+#define EET_FILE2_FLAG_INDEX             (1 << 11)
+#define EET_DIRECTORY_INDEX_HEADER_COUNT 3
+/* Give up building an index past that many seeds for a bucket */
+#define EET_DIRECTORY_INDEX_SEED_MAX     (1 << 20)
+
 // force data alignmenmt in the eet file so direct mmap can work without
 // copies and we can work with alignment
 #define ALIGN 8
@@ -93,6 +104,13 @@ static Eina_Lock eet_cache_lock;
 #define UNLOCK_FILE(File)  eina_lock_release(&File->file_lock)
 #define DESTROY_FILE(File) eina_lock_free(&File->file_lock)
 
+/* Files opened read only never change once eet_internal_read() is done, so
+ * any number of threads can look them up and decode them without locking */
+#define LOCK_FILE_READ(File)                                            \
+  do { if ((File)->mode != EET_FILE_MODE_READ) LOCK_FILE(File); } while (0)
+#define UNLOCK_FILE_READ(File)                                          \
+  do { if ((File)->mode != EET_FILE_MODE_READ) UNLOCK_FILE(File); } while (0)
+
 /* cache. i don't expect this to ever be large, so arrays will do */
 static int eet_writers_num = 0;
 static int eet_writers_alloc = 0;
@@ -287,6 +305,885 @@ eet_string_match(const char *s1,
     return !strcmp(s1, s2);
 }
 
+/* Called with the file locked, read only files load it when opened */
+static const Eina_Binbuf *
+eet_compression_dictionary_get(Eet_File *ef)
+{
+   Eet_File_Node *efn;
+   Eina_Binbuf *in;
+   Eina_Binbuf *dict;
+
+   if ((ef->compression_dictionary) || (ef->mode == EET_FILE_MODE_READ))
+     return ef->compression_dictionary;
+
+   efn = find_node_by_name(ef, EET_COMPRESSION_DICTIONARY_KEY);
+   if ((!efn) || (efn->compression) || (efn->ciphered))
+     return NULL;
+
+   in = read_binbuf_from_disk(ef, efn);
+   if (!in) return NULL;
+
+   /* Keep our own copy, the entry may be rewritten while the file is open */
+   dict = eina_binbuf_new();
+   if ((dict) && (!eina_binbuf_append_buffer(dict, in)))
+     {
+        eina_binbuf_free(dict);
+        dict = NULL;
+     }
+   eina_binbuf_free(in);
+
+   ef->compression_dictionary = dict;
+   return dict;
+}
+
+/* The mapping of a read only file stays as is, its dictionary is used
+ * from there by all the threads reading the file. */
+static void
+eet_compression_dictionary_load(Eet_File *ef)
+{
+   Eet_File_Node *efn;
+
+   efn = find_node_by_name(ef, EET_COMPRESSION_DICTIONARY_KEY);
+   if ((!efn) || (efn->compression) || (efn->ciphered))
+     return;
+
+   ef->compression_dictionary = read_binbuf_from_disk(ef, efn);
+   ef->compression_expander =
+     emile_expand_dictionary_new(ef->compression_dictionary, EMILE_ZSTD);
+}
+
+/* Called with the file locked, read only files prepare it when opened */
+static const Emile_Compressor_Dictionary *
+eet_compression_expander_get(Eet_File *ef)
+{
+   const Eina_Binbuf *dict;
+
+   if ((ef->compression_expander) || (ef->mode == EET_FILE_MODE_READ))
+     return ef->compression_expander;
+
+   dict = eet_compression_dictionary_get(ef);
+   if (!dict) return NULL;
+
+   ef->compression_expander = emile_expand_dictionary_new(dict, EMILE_ZSTD);
+   return ef->compression_expander;
+}
+
+static Eina_Bool
+eet_compression_dictionary_node_add(Eet_File *ef, const Eina_Binbuf *dict)
+{
+   Eet_File_Node *efn;
+   int hash;
+
+   if (find_node_by_name(ef, EET_COMPRESSION_DICTIONARY_KEY))
+     return EINA_FALSE;
+
+   efn = eet_file_node_calloc(1);
+   if (!efn) return EINA_FALSE;
+
+   efn->name = strdup(EET_COMPRESSION_DICTIONARY_KEY);
+   efn->data = malloc(eina_binbuf_length_get(dict));
+   if ((!efn->name) || (!efn->data))
+     {
+        free(efn->name);
+        free(efn->data);
+        eet_file_node_mp_free(efn);
+        return EINA_FALSE;
+     }
+   memcpy(efn->data, eina_binbuf_string_get(dict), eina_binbuf_length_get(dict));
+
+   efn->name_size = strlen(efn->name) + 1;
+   efn->free_name = 1;
+   efn->size = eina_binbuf_length_get(dict);
+   efn->data_size = efn->size;
+   /* Put the offset above the limit to avoid direct access */
+   efn->offset = ef->data_size + 1;
+   efn->dirty = 1;
+
+   hash = _eet_hash_gen(efn->name, ef->header->directory->size);
+   efn->next = ef->header->directory->nodes[hash];
+   ef->header->directory->nodes[hash] = efn;
+   ef->header->directory->free_count += 2;
+
+   return EINA_TRUE;
+}
+
+typedef struct _Eet_Compress_Job Eet_Compress_Job;
+struct _Eet_Compress_Job
+{
+   Eet_File_Node **nodes;
+   Eina_Binbuf **results;
+   Emile_Compressor_Dictionary *dict;
+   Eina_Spinlock lock;
+   unsigned int count;
+   unsigned int next;
+};
+
+/* Run by the flushing thread and the workers, each node is only touched
+ * by the one thread that picked it. */
+static void
+eet_compress_job_run(Eet_Compress_Job *job)
+{
+   while (1)
+     {
+        Eet_File_Node *efn;
+        Eina_Binbuf *in;
+        unsigned int i;
+
+        eina_spinlock_take(&job->lock);
+        i = job->next++;
+        eina_spinlock_release(&job->lock);
+        if (i >= job->count) break;
+
+        efn = job->nodes[i];
+        in = eina_binbuf_manage_new(efn->data, efn->size, EINA_TRUE);
+        if (!in) continue;
+
+        if ((job->dict) && (efn->compression_type == EET_COMPRESSION_ZSTD))
+          job->results[i] = emile_compress_prepared(in, job->dict);
+        else
+          job->results[i] = emile_compress(in,
+                                           eet_2_emile_compressor(efn->compression_type),
+                                           EMILE_COMPRESSOR_BEST);
+        eina_binbuf_free(in);
+     }
+}
+
+static void *
+eet_compress_job_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   eet_compress_job_run(data);
+   return NULL;
+}
+
+static const Eina_Binbuf *
+eet_compression_dictionary_train_pending(Eet_File *ef, Eet_File_Node **nodes, unsigned int count)
+{
+   const Eina_Binbuf *dict;
+   Eina_Binbuf *trained = NULL;
+   Eina_Binbuf **samples;
+   unsigned int n = 0;
+   unsigned int i;
+
+   if (!ef->compression_dictionary_size)
+     return NULL;
+
+   for (i = 0; i < count; i++)
+     if (nodes[i]->compression_type == EET_COMPRESSION_ZSTD) n++;
+   if (!n) return NULL;
+
+   dict = eet_compression_dictionary_get(ef);
+   if (dict) return dict;
+
+   samples = calloc(n, sizeof (Eina_Binbuf *));
+   if (!samples) return NULL;
+
+   n = 0;
+   for (i = 0; i < count; i++)
+     if (nodes[i]->compression_type == EET_COMPRESSION_ZSTD)
+       {
+          samples[n] = eina_binbuf_manage_new(nodes[i]->data, nodes[i]->size, EINA_TRUE);
+          if (samples[n]) n++;
+       }
+
+   trained = emile_compress_dictionary_train((const Eina_Binbuf * const *)samples,
+                                             n, ef->compression_dictionary_size);
+   for (i = 0; i < n; i++)
+     eina_binbuf_free(samples[i]);
+   free(samples);
+
+   if ((trained) && (eet_compression_dictionary_node_add(ef, trained)))
+     {
+        ef->compression_dictionary = trained;
+        return trained;
+     }
+   if (trained)
+     eina_binbuf_free(trained);
+   return NULL;
+}
+
+/* Compress all the entries left to the flush, spread over the compression
+ * threads. Entries are compressed exactly like eet_write_cipher() would
+ * have, so the file content does not depend on the number of threads. The
+ * zstd ones use the file dictionary, trained out of them first if the file
+ * does not have one yet. */
+static void
+eet_pending_flush(Eet_File *ef)
+{
+   Eet_Compress_Job job;
+   Eina_Thread *threads = NULL;
+   Eet_File_Node *efn;
+   unsigned int count = 0;
+   unsigned int created = 0;
+   unsigned int i;
+   int num;
+   int j;
+
+   num = (1 << ef->header->directory->size);
+   for (j = 0; j < num; j++)
+     for (efn = ef->header->directory->nodes[j]; efn; efn = efn->next)
+       if (efn->compression_pending) count++;
+   if (!count) return;
+
+   memset(&job, 0, sizeof (job));
+   job.count = count;
+   job.nodes = malloc(count * sizeof (Eet_File_Node *));
+   job.results = calloc(count, sizeof (Eina_Binbuf *));
+   if ((!job.nodes) || (!job.results) ||
+       (!eina_spinlock_new(&job.lock)))
+     {
+        /* Keep them uncompressed */
+        for (j = 0; j < num; j++)
+          for (efn = ef->header->directory->nodes[j]; efn; efn = efn->next)
+            if (efn->compression_pending)
+              {
+                 efn->compression_pending = 0;
+                 efn->compression_type = 0;
+              }
+        goto on_error;
+     }
+
+   i = 0;
+   for (j = 0; j < num; j++)
+     for (efn = ef->header->directory->nodes[j]; efn; efn = efn->next)
+       if (efn->compression_pending)
+         job.nodes[i++] = efn;
+
+   /* Digested once for all the entries of this flush */
+   job.dict = emile_compress_dictionary_new
+     (eet_compression_dictionary_train_pending(ef, job.nodes, count),
+      EMILE_ZSTD, EMILE_COMPRESSOR_BEST);
+
+   if ((ef->compression_threads > 1) && (count > 1))
+     {
+        unsigned int wanted = ef->compression_threads - 1;
+
+        if (wanted > count - 1) wanted = count - 1;
+        threads = malloc(wanted * sizeof (Eina_Thread));
+        for (; threads && created < wanted; created++)
+          if (!eina_thread_create(&threads[created], EINA_THREAD_NORMAL, -1,
+                                  eet_compress_job_thread, &job))
+            break;
+     }
+
+   eet_compress_job_run(&job);
+   for (i = 0; i < created; i++)
+     eina_thread_join(threads[i]);
+   free(threads);
+   eina_spinlock_free(&job.lock);
+
+   for (i = 0; i < count; i++)
+     {
+        Eina_Binbuf *out = job.results[i];
+
+        efn = job.nodes[i];
+        efn->compression_pending = 0;
+
+        if ((out) && (eina_binbuf_length_get(out) < efn->size))
+          {
+             free(efn->data);
+             efn->size = eina_binbuf_length_get(out);
+             efn->data = eina_binbuf_string_steal(out);
+             efn->compression = 1;
+             if ((job.dict) && (efn->compression_type == EET_COMPRESSION_ZSTD))
+               efn->compression_type = EET_COMPRESSION_ZSTD_DICTIONARY;
+          }
+        else
+          efn->compression_type = 0;
+
+        if (out) eina_binbuf_free(out);
+     }
+   emile_compressor_dictionary_free(job.dict);
+
+on_error:
+   free(job.results);
+   free(job.nodes);
+}
+
+/* Called with the file locked */
+static Eina_Binbuf *
+eet_node_decompress(Eet_File *ef, Eet_File_Node *efn, const Eina_Binbuf *in)
+{
+   if (efn->compression_type == EET_COMPRESSION_ZSTD_DICTIONARY)
+     {
+        const Emile_Compressor_Dictionary *dict;
+
+        dict = eet_compression_expander_get(ef);
+        if (!dict) return NULL;
+
+        return emile_decompress_prepared(in, efn->data_size, dict);
+     }
+
+   return emile_decompress(in,
+                           eet_2_emile_compressor(efn->compression_type),
+                           efn->data_size);
+}
+
+static Eet_Error
+eet_write_error_get(Eet_File *ef, FILE *fp)
+{
+   if (!ferror(fp))
+     return EET_ERROR_NONE;
+
+   ERR("Error during write on '%s'.", ef->path);
+   switch (errno)
+     {
+      case EFBIG: return EET_ERROR_WRITE_ERROR_FILE_TOO_BIG;
+
+      case EIO: return EET_ERROR_WRITE_ERROR_IO_ERROR;
+
+      case ENOSPC: return EET_ERROR_WRITE_ERROR_OUT_OF_SPACE;
+
+      case EPIPE: return EET_ERROR_WRITE_ERROR_FILE_CLOSED;
+
+      default: return EET_ERROR_WRITE_ERROR;
+     }
+}
+
+static inline unsigned int
+eet_directory_index_hash(const char *name, unsigned int seed)
+{
+   const unsigned char *p;
+   unsigned int h = 0x811c9dc5 ^ seed;
+
+   for (p = (const unsigned char *)name; *p; p++)
+     h = (h ^ *p) * 0x01000193;
+
+   /* FNV alone spreads the last characters of a name poorly */
+   h ^= h >> 16;
+   h *= 0x85ebca6b;
+   h ^= h >> 13;
+   h *= 0xc2b2ae35;
+   h ^= h >> 16;
+
+   return h;
+}
+
+/* Hash and displace: names are spread in count buckets by a first hash,
+ * then the biggest buckets first look for a seed of a second hash that
+ * sends all their names to free slots. Buckets of a single name just take
+ * the first free slot. Fills displace and entry in host order. */
+static Eina_Bool
+eet_directory_index_fill(Eet_File_Node **order, unsigned int count,
+                         int *displace, int *entry)
+{
+   unsigned int *start = NULL;
+   unsigned int *members = NULL;
+   unsigned int *bucket = NULL;
+   unsigned int *slots = NULL;
+   unsigned char *used = NULL;
+   unsigned int biggest = 0;
+   unsigned int size;
+   unsigned int free_slot;
+   unsigned int i, j, k;
+   Eina_Bool ret = EINA_FALSE;
+
+   start = calloc(count + 1, sizeof (unsigned int));
+   members = malloc(count * sizeof (unsigned int));
+   bucket = malloc(count * sizeof (unsigned int));
+   used = calloc(count, sizeof (unsigned char));
+   if ((!start) || (!members) || (!bucket) || (!used))
+     goto on_error;
+
+   for (i = 0; i < count; i++)
+     {
+        bucket[i] = eet_directory_index_hash(order[i]->name, 0) % count;
+        start[bucket[i] + 1]++;
+     }
+   for (i = 0; i < count; i++)
+     {
+        if (start[i + 1] > biggest) biggest = start[i + 1];
+        start[i + 1] += start[i];
+     }
+   /* displace[] first holds where the next name of each bucket goes */
+   for (i = 0; i < count; i++)
+     displace[i] = start[i];
+   for (i = 0; i < count; i++)
+     members[displace[bucket[i]]++] = i;
+
+   slots = malloc(biggest * sizeof (unsigned int));
+   if (!slots) goto on_error;
+
+   for (i = 0; i < count; i++)
+     displace[i] = 0;
+
+   for (size = biggest; size > 1; size--)
+     for (i = 0; i < count; i++)
+       {
+          unsigned int seed;
+
+          if (start[i + 1] - start[i] != size) continue;
+
+          for (seed = 1; seed < EET_DIRECTORY_INDEX_SEED_MAX; seed++)
+            {
+               for (j = 0; j < size; j++)
+                 {
+                    slots[j] = eet_directory_index_hash(order[members[start[i] + j]]->name,
+                                                        seed) % count;
+                    if (used[slots[j]]) break;
+                    for (k = 0; k < j; k++)
+                      if (slots[k] == slots[j]) break;
+                    if (k < j) break;
+                 }
+               if (j == size) break;
+            }
+          if (seed == EET_DIRECTORY_INDEX_SEED_MAX)
+            goto on_error;
+
+          displace[i] = seed;
+          for (j = 0; j < size; j++)
+            {
+               used[slots[j]] = 1;
+               entry[slots[j]] = members[start[i] + j];
+            }
+       }
+
+   free_slot = 0;
+   for (i = 0; i < count; i++)
+     {
+        if (start[i + 1] - start[i] != 1) continue;
+
+        while (used[free_slot]) free_slot++;
+        used[free_slot] = 1;
+        displace[i] = -(int)free_slot - 1;
+        entry[free_slot] = members[start[i]];
+     }
+
+   ret = EINA_TRUE;
+
+on_error:
+   free(start);
+   free(members);
+   free(bucket);
+   free(slots);
+   free(used);
+   return ret;
+}
+
+/* Rebuild the index entry of a file that has one or wants one, before the
+ * data offsets are set. It lists the entries in the order
+ * eet_directory_write() puts them: the index first, then each bucket. If
+ * no index can be built, an empty one is written that readers ignore. */
+static void
+eet_directory_index_update(Eet_File *ef)
+{
+   Eet_File_Node **order = NULL;
+   Eet_File_Node *index;
+   Eet_File_Node *efn;
+   unsigned int count = 0;
+   unsigned int size;
+   int *data = NULL;
+   int num;
+   int i;
+   unsigned int j;
+
+   index = find_node_by_name(ef, EET_DIRECTORY_INDEX_KEY);
+   if ((!index) && (!ef->directory_index))
+     return;
+
+   num = (1 << ef->header->directory->size);
+   for (i = 0; i < num; i++)
+     for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
+       count++;
+   if (!index) count++;
+
+   order = malloc(count * sizeof (Eet_File_Node *));
+   size = (EET_DIRECTORY_INDEX_HEADER_COUNT + 2 * count) * sizeof (int);
+   data = malloc(size);
+   if ((!order) || (!data))
+     goto on_error;
+
+   if (!index)
+     {
+        int hash;
+
+        index = eet_file_node_calloc(1);
+        if (!index) goto on_error;
+
+        index->name = strdup(EET_DIRECTORY_INDEX_KEY);
+        if (!index->name)
+          {
+             eet_file_node_mp_free(index);
+             index = NULL;
+             goto on_error;
+          }
+        index->name_size = strlen(index->name) + 1;
+        index->free_name = 1;
+        ef->header->directory->free_count++;
+
+        hash = _eet_hash_gen(index->name, ef->header->directory->size);
+        index->next = ef->header->directory->nodes[hash];
+        ef->header->directory->nodes[hash] = index;
+     }
+
+   j = 0;
+   order[j++] = index;
+   for (i = 0; i < num; i++)
+     for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
+       if (efn != index)
+         order[j++] = efn;
+
+   if (eet_directory_index_fill(order, count,
+                                data + EET_DIRECTORY_INDEX_HEADER_COUNT,
+                                data + EET_DIRECTORY_INDEX_HEADER_COUNT + count))
+     {
+        for (j = EET_DIRECTORY_INDEX_HEADER_COUNT; j < size / sizeof (int); j++)
+          data[j] = (int)eina_htonl((unsigned int)data[j]);
+     }
+   else
+     {
+        WRN("Could not build a directory index for '%s'", ef->path);
+        size = EET_DIRECTORY_INDEX_HEADER_COUNT * sizeof (int);
+        count = 0;
+     }
+
+   data[0] = (int)eina_htonl((unsigned int)EET_MAGIC_DIRECTORY_INDEX);
+   data[1] = (int)eina_htonl(count);
+   /* set once the data is laid out, appended files are never signed */
+   data[2] = 0;
+
+   if (index->data)
+     free(index->data);
+   else
+     ef->header->directory->free_count++;
+   index->data = data;
+   index->size = size;
+   index->data_size = size;
+   index->compression = 0;
+   index->compression_type = 0;
+   index->ciphered = 0;
+   index->alias = 0;
+   /* Put the offset above the limit to avoid direct access */
+   index->offset = ef->data_size + 1;
+   index->dirty = 1;
+
+   free(order);
+   return;
+
+on_error:
+   /* An index left as it was would point to the wrong entries */
+   if ((index) && (index->data) &&
+       (index->size >= EET_DIRECTORY_INDEX_HEADER_COUNT * sizeof (int)))
+     {
+        ((int *)index->data)[1] = 0;
+        index->offset = ef->data_size + 1;
+        index->dirty = 1;
+     }
+   free(order);
+   free(data);
+}
+
+static Eina_Bool
+eet_directory_entry_write(Eet_File_Node *efn, FILE *fp,
+                          int strings_offset, unsigned int flag)
+{
+   int ibuf[EET_FILE2_DIRECTORY_ENTRY_COUNT];
+
+   flag |= (efn->alias << 2) | (efn->ciphered << 1) | efn->compression;
+   flag |= efn->compression_type << 3;
+
+   ibuf[0] = (int)eina_htonl((unsigned int)efn->offset);
+   ibuf[1] = (int)eina_htonl((unsigned int)efn->size);
+   ibuf[2] = (int)eina_htonl((unsigned int)efn->data_size);
+   ibuf[3] = (int)eina_htonl((unsigned int)strings_offset);
+   ibuf[4] = (int)eina_htonl((unsigned int)efn->name_size);
+   ibuf[5] = (int)eina_htonl((unsigned int)flag);
+
+   return fwrite(ibuf, sizeof(ibuf), 1, fp) == 1;
+}
+
+/* Write a v2 directory block at base: the header, the directory and
+ * dictionary entries, then the names and the strings they point to. The
+ * data offsets must already be set in the nodes. The directory index, if
+ * any, always comes first. */
+static Eina_Bool
+eet_directory_write(Eet_File *ef, FILE *fp, int base, int num_directory_entries)
+{
+   Eet_File_Node *index;
+   Eet_File_Node *efn;
+   int head[EET_FILE2_HEADER_COUNT];
+   int num_dictionary_entries = 0;
+   int strings_offset;
+   int num;
+   int i;
+   int j;
+
+   if (ef->ed)
+     num_dictionary_entries = ef->ed->count;
+
+   head[0] = (int)eina_htonl((unsigned int)EET_MAGIC_FILE2);
+   head[1] = (int)eina_htonl((unsigned int)num_directory_entries);
+   head[2] = (int)eina_htonl((unsigned int)num_dictionary_entries);
+
+   if (fwrite(head, sizeof (head), 1, fp) != 1)
+     return EINA_FALSE;
+
+   strings_offset = base + EET_FILE2_HEADER_SIZE +
+     EET_FILE2_DIRECTORY_ENTRY_SIZE * num_directory_entries +
+     EET_FILE2_DICTIONARY_ENTRY_SIZE * num_dictionary_entries;
+
+   /* write directories entry */
+   index = find_node_by_name(ef, EET_DIRECTORY_INDEX_KEY);
+   if (index)
+     {
+        if (!eet_directory_entry_write(index, fp, strings_offset,
+                                       EET_FILE2_FLAG_INDEX))
+          return EINA_FALSE;
+        strings_offset += index->name_size;
+     }
+
+   num = (1 << ef->header->directory->size);
+   for (i = 0; i < num; i++)
+     {
+        for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
+          {
+             if (efn == index) continue;
+
+             if (!eet_directory_entry_write(efn, fp, strings_offset, 0))
+               return EINA_FALSE;
+
+             strings_offset += efn->name_size;
+          }
+     }
+
+   /* write dictionary */
+   if (ef->ed)
+     {
+        int offset = strings_offset;
+
+        /* calculate dictionary strings offset */
+        ef->ed->offset = strings_offset;
+
+        for (j = 0; j < ef->ed->count; ++j)
+          {
+             int sbuf[EET_FILE2_DICTIONARY_ENTRY_COUNT];
+             int prev = 0;
+
+             // We still use the prev as an hint for knowing if it is the head of the hash
+             if (ef->ed->hash[ef->ed->all_hash[j]] == j)
+               prev = -1;
+
+             sbuf[0] = (int)eina_htonl((unsigned int)ef->ed->all_hash[j]);
+             sbuf[1] = (int)eina_htonl((unsigned int)offset);
+             sbuf[2] = (int)eina_htonl((unsigned int)ef->ed->all[j].len);
+             sbuf[3] = (int)eina_htonl((unsigned int)prev);
+             sbuf[4] = (int)eina_htonl((unsigned int)ef->ed->all[j].next);
+
+             offset += ef->ed->all[j].len;
+
+             if (fwrite(sbuf, sizeof (sbuf), 1, fp) != 1)
+               return EINA_FALSE;
+          }
+     }
+
+   /* write directories name */
+   if ((index) && (fwrite(index->name, index->name_size, 1, fp) != 1))
+     return EINA_FALSE;
+   for (i = 0; i < num; i++)
+     {
+        for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
+          {
+             if (efn == index) continue;
+
+             if (fwrite(efn->name, efn->name_size, 1, fp) != 1)
+               return EINA_FALSE;
+          }
+     }
+
+   /* write strings */
+   if (ef->ed)
+     for (j = 0; j < ef->ed->count; ++j)
+       {
+          if (fwrite(ef->ed->all[j].str, ef->ed->all[j].len, 1, fp) != 1)
+            return EINA_FALSE;
+       }
+
+   return EINA_TRUE;
+}
+
+/* Remember what the file looks like on disk once it was read or written */
+static void
+eet_disk_state_set(Eet_File *ef, const struct stat *st)
+{
+   if (st)
+     {
+        ef->disk_size = st->st_size;
+        ef->disk_ino = st->st_ino;
+        ef->disk_mtime = st->st_mtime;
+     }
+   else
+     {
+        ef->disk_size = 0;
+        ef->disk_ino = 0;
+        ef->disk_mtime = 0;
+     }
+}
+
+/* The header alone does not tell whether the file was replaced or
+ * rewritten with the same number of entries, its layout may still be
+ * entirely different */
+static Eina_Bool
+eet_disk_state_check(const Eet_File *ef, const struct stat *st)
+{
+   return (ef->disk_size > 0) &&
+     (st->st_size == ef->disk_size) &&
+     (st->st_ino == ef->disk_ino) &&
+     (st->st_mtime == ef->disk_mtime);
+}
+
+/* Only write what changed: the new data and a new directory block go at
+ * the end of the file, then the header is pointed at that block. Nothing
+ * in use is overwritten before the header is, and that is a single 12
+ * bytes write, so a crash leaves either the old or the new content. The
+ * file is rewritten as a whole instead, by returning EINA_FALSE, when it
+ * changed on disk since it was read or when more than half of it would
+ * be garbage. */
+static Eina_Bool
+eet_flush_append(Eet_File *ef, Eet_Error *error)
+{
+   Eet_File_Node *efn;
+   FILE *fp;
+   struct stat st;
+   int head[EET_FILE2_HEADER_COUNT];
+   int tail[2];
+   unsigned char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+   unsigned long int live = 0;
+   int num_directory_entries = 0;
+   int data_offset;
+   int base;
+   int pad;
+   int num;
+   int fd;
+   int i;
+
+   if ((!ef->append) || (ef->mode != EET_FILE_MODE_READ_WRITE) ||
+       (!ef->readfp) || (ef->key))
+     return EINA_FALSE;
+
+   fd = open(ef->path, O_RDWR | O_BINARY);
+   if (fd < 0)
+     return EINA_FALSE;
+
+   fp = fdopen(fd, "r+b");
+   if (!fp)
+     {
+        close(fd);
+        return EINA_FALSE;
+     }
+
+   if (!eina_file_close_on_exec(fd, EINA_TRUE)) ERR("can't set CLOEXEC on write fd");
+
+   if ((fstat(fd, &st) < 0) ||
+       (!eet_disk_state_check(ef, &st)) ||
+       (fread(head, sizeof (head), 1, fp) != 1) ||
+       (memcmp(head, ef->disk_head, sizeof (head))))
+     goto on_rewrite;
+
+   num = (1 << ef->header->directory->size);
+   for (i = 0; i < num; i++)
+     for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
+       {
+          num_directory_entries++;
+          live += EET_FILE2_DIRECTORY_ENTRY_SIZE + efn->name_size +
+            efn->size + ALIGN;
+       }
+   if (ef->ed)
+     for (i = 0; i < ef->ed->count; i++)
+       live += EET_FILE2_DICTIONARY_ENTRY_SIZE + ef->ed->all[i].len;
+
+   if ((unsigned long int)st.st_size > 2 * live)
+     goto on_rewrite;
+
+   /* write new data after everything else */
+   if (fseek(fp, st.st_size, SEEK_SET))
+     goto write_error;
+
+   data_offset = st.st_size;
+   pad = (((data_offset + (ALIGN - 1)) / ALIGN) * ALIGN) - data_offset;
+   for (i = 0; i < num; i++)
+     {
+        for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
+          {
+             if (!efn->dirty) continue;
+
+             if (pad > 0)
+               {
+                  data_offset += pad;
+                  if (fwrite(zeros, pad, 1, fp) != 1)
+                    goto write_error;
+               }
+             if (fwrite(efn->data, efn->size, 1, fp) != 1)
+               goto write_error;
+
+             efn->offset = data_offset;
+             data_offset += efn->size;
+             pad = (((data_offset + (ALIGN - 1)) / ALIGN) * ALIGN) - data_offset;
+          }
+     }
+   if (pad > 0)
+     {
+        data_offset += pad;
+        if (fwrite(zeros, pad, 1, fp) != 1)
+          goto write_error;
+     }
+
+   /* then the new directory, followed by a trailer so that its names and
+    * strings never end the file */
+   base = data_offset;
+   if (!eet_directory_write(ef, fp, base, num_directory_entries))
+     goto write_error;
+
+   tail[0] = (int)eina_htonl((unsigned int)EET_MAGIC_FILE2_APPEND);
+   tail[1] = (int)eina_htonl((unsigned int)base);
+   if (fwrite(tail, sizeof (tail), 1, fp) != 1)
+     goto write_error;
+
+   /* all of it has to be on disk before the header points to it */
+   if (fflush(fp))
+     goto write_error;
+#ifndef _WIN32
+   fsync(fd);
+#endif
+
+   head[0] = (int)eina_htonl((unsigned int)EET_MAGIC_FILE2_APPEND);
+   head[1] = (int)eina_htonl((unsigned int)base);
+   head[2] = 0;
+
+   if (fseek(fp, 0, SEEK_SET))
+     goto write_error;
+   if (fwrite(head, sizeof (head), 1, fp) != 1)
+     goto write_error;
+   if (fflush(fp))
+     goto write_error;
+#ifndef _WIN32
+   fsync(fd);
+#endif
+
+   memcpy(ef->disk_head, head, sizeof (head));
+   eet_disk_state_set(ef, (fstat(fd, &st) < 0) ? NULL : &st);
+   for (i = 0; i < num; i++)
+     for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
+       efn->dirty = 0;
+
+   /* no more writes pending */
+   ef->writes_pending = 0;
+
+   fclose(fp);
+
+   *error = EET_ERROR_NONE;
+   return EINA_TRUE;
+
+write_error:
+   *error = eet_write_error_get(ef, fp);
+   if (*error == EET_ERROR_NONE)
+     *error = EET_ERROR_WRITE_ERROR;
+   fclose(fp);
+   return EINA_TRUE;
+
+on_rewrite:
+   fclose(fp);
+   return EINA_FALSE;
+}
+
 /* flush out writes to a v2 eet file */
 static Eet_Error
 eet_flush2(Eet_File *ef)
@@ -294,21 +1191,20 @@ eet_flush2(Eet_File *ef)
    Eet_File_Node *efn;
    FILE *fp;
    Eet_Error error = EET_ERROR_NONE;
-   int head[EET_FILE2_HEADER_COUNT];
    int num_directory_entries = 0;
    int num_dictionary_entries = 0;
    int bytes_directory_entries = 0;
    int bytes_dictionary_entries = 0;
    int bytes_strings = 0;
    int data_offset = 0;
-   int strings_offset = 0;
+   int data_end = 0;
    int data_pad = 0;
    int pad = 0;
    int orig_data_offset = 0;
    int num;
    int i;
-   int j;
    unsigned char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+   struct stat st;
 
    if (eet_check_pointer(ef))
      return EET_ERROR_BAD_OBJECT;
@@ -319,6 +1215,12 @@ eet_flush2(Eet_File *ef)
    if (!ef->writes_pending)
      return EET_ERROR_NONE;
 
+   eet_pending_flush(ef);
+   eet_directory_index_update(ef);
+
+   if (eet_flush_append(ef, &error))
+     return error;
+
    if ((ef->mode == EET_FILE_MODE_READ_WRITE)
        || (ef->mode == EET_FILE_MODE_WRITE))
      {
@@ -369,104 +1271,39 @@ eet_flush2(Eet_File *ef)
    bytes_directory_entries = EET_FILE2_DIRECTORY_ENTRY_SIZE *
      num_directory_entries + EET_FILE2_HEADER_SIZE;
    bytes_dictionary_entries = EET_FILE2_DICTIONARY_ENTRY_SIZE *
-     num_dictionary_entries;
-
-   /* go thru and write the header */
-   head[0] = (int)eina_htonl((unsigned int)EET_MAGIC_FILE2);
-   head[1] = (int)eina_htonl((unsigned int)num_directory_entries);
-   head[2] = (int)eina_htonl((unsigned int)num_dictionary_entries);
-
-   fseek(fp, 0, SEEK_SET);
-   if (fwrite(head, sizeof (head), 1, fp) != 1)
-     goto write_error;
-
-   /* calculate per entry base offset */
-   strings_offset = bytes_directory_entries + bytes_dictionary_entries;
-   data_offset = bytes_directory_entries + bytes_dictionary_entries +
-     bytes_strings;
-
-   data_pad = (((data_offset + (ALIGN - 1)) / ALIGN) * ALIGN) - data_offset;
-   data_offset += data_pad;
-   orig_data_offset = data_offset;
-
-   /* write directories entry */
-   for (i = 0; i < num; i++)
-     {
-        for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
-          {
-             unsigned int flag;
-             int ibuf[EET_FILE2_DIRECTORY_ENTRY_COUNT];
-
-             flag = (efn->alias << 2) | (efn->ciphered << 1) | efn->compression;
-             flag |= efn->compression_type << 3;
-
-             efn->offset = data_offset;
-
-             ibuf[0] = (int)eina_htonl((unsigned int)data_offset);
-             ibuf[1] = (int)eina_htonl((unsigned int)efn->size);
-             ibuf[2] = (int)eina_htonl((unsigned int)efn->data_size);
-             ibuf[3] = (int)eina_htonl((unsigned int)strings_offset);
-             ibuf[4] = (int)eina_htonl((unsigned int)efn->name_size);
-             ibuf[5] = (int)eina_htonl((unsigned int)flag);
-
-             strings_offset += efn->name_size;
-             data_offset += efn->size;
-
-             pad = (((data_offset + (ALIGN - 1)) / ALIGN) * ALIGN) - data_offset;
-             data_offset += pad;
-
-             if (fwrite(ibuf, sizeof(ibuf), 1, fp) != 1)
-               goto write_error;
-          }
-     }
-
-   /* write dictionary */
-   if (ef->ed)
-     {
-        int offset = strings_offset;
-
-        /* calculate dictionary strings offset */
-        ef->ed->offset = strings_offset;
-
-        for (j = 0; j < ef->ed->count; ++j)
-          {
-             int sbuf[EET_FILE2_DICTIONARY_ENTRY_COUNT];
-             int prev = 0;
-
-             // We still use the prev as an hint for knowing if it is the head of the hash
-             if (ef->ed->hash[ef->ed->all_hash[j]] == j)
-               prev = -1;
-
-             sbuf[0] = (int)eina_htonl((unsigned int)ef->ed->all_hash[j]);
-             sbuf[1] = (int)eina_htonl((unsigned int)offset);
-             sbuf[2] = (int)eina_htonl((unsigned int)ef->ed->all[j].len);
-             sbuf[3] = (int)eina_htonl((unsigned int)prev);
-             sbuf[4] = (int)eina_htonl((unsigned int)ef->ed->all[j].next);
+     num_dictionary_entries;
 
-             offset += ef->ed->all[j].len;
+   /* calculate per entry base offset */
+   data_offset = bytes_directory_entries + bytes_dictionary_entries +
+     bytes_strings;
 
-             if (fwrite(sbuf, sizeof (sbuf), 1, fp) != 1)
-               goto write_error;
-          }
-     }
+   data_pad = (((data_offset + (ALIGN - 1)) / ALIGN) * ALIGN) - data_offset;
+   data_offset += data_pad;
+   orig_data_offset = data_offset;
 
-   /* write directories name */
    for (i = 0; i < num; i++)
      {
         for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
           {
-             if (fwrite(efn->name, efn->name_size, 1, fp) != 1)
-               goto write_error;
+             efn->offset = data_offset;
+             data_offset += efn->size;
+             data_end = data_offset;
+
+             pad = (((data_offset + (ALIGN - 1)) / ALIGN) * ALIGN) - data_offset;
+             data_offset += pad;
           }
      }
 
-   /* write strings */
-   if (ef->ed)
-     for (j = 0; j < ef->ed->count; ++j)
-       {
-          if (fwrite(ef->ed->all[j].str, ef->ed->all[j].len, 1, fp) != 1)
-            goto write_error;
-       }
+   /* a signature would start right after the data */
+   efn = find_node_by_name(ef, EET_DIRECTORY_INDEX_KEY);
+   if ((efn) && (efn->data) &&
+       (efn->size >= EET_DIRECTORY_INDEX_HEADER_COUNT * sizeof (int)))
+     ((int *)efn->data)[2] = (int)eina_htonl((unsigned int)data_end);
+
+   /* go thru and write the header */
+   fseek(fp, 0, SEEK_SET);
+   if (!eet_directory_write(ef, fp, 0, num_directory_entries))
+     goto write_error;
 
    if (data_pad > 0)
      {
@@ -489,6 +1326,7 @@ eet_flush2(Eet_File *ef)
                }
              if (fwrite(efn->data, efn->size, 1, fp) != 1)
                goto write_error;
+             efn->dirty = 0;
 
              data_offset += efn->size;
              pad = (((data_offset + (ALIGN - 1)) / ALIGN) * ALIGN) - data_offset;
@@ -509,27 +1347,20 @@ eet_flush2(Eet_File *ef)
    /* no more writes pending */
    ef->writes_pending = 0;
 
+   ef->disk_head[0] = (int)eina_htonl((unsigned int)EET_MAGIC_FILE2);
+   ef->disk_head[1] = (int)eina_htonl((unsigned int)num_directory_entries);
+   ef->disk_head[2] = (int)eina_htonl((unsigned int)num_dictionary_entries);
+   if ((fflush(fp)) || (fstat(fileno(fp), &st) < 0))
+     eet_disk_state_set(ef, NULL);
+   else
+     eet_disk_state_set(ef, &st);
+
    fclose(fp);
 
    return EET_ERROR_NONE;
 
 write_error:
-   if (ferror(fp))
-     {
-        ERR("Error during write on '%s'.", ef->path);
-        switch (errno)
-          {
-           case EFBIG: error = EET_ERROR_WRITE_ERROR_FILE_TOO_BIG; break;
-
-           case EIO: error = EET_ERROR_WRITE_ERROR_IO_ERROR; break;
-
-           case ENOSPC: error = EET_ERROR_WRITE_ERROR_OUT_OF_SPACE; break;
-
-           case EPIPE: error = EET_ERROR_WRITE_ERROR_FILE_CLOSED; break;
-
-           default: error = EET_ERROR_WRITE_ERROR; break;
-          }
-     }
+   error = eet_write_error_get(ef, fp);
 
 sign_error:
    fclose(fp);
@@ -728,6 +1559,210 @@ eet_clearcache(void)
    UNLOCK_CACHE;
 }
 
+/* Fill efn out of a directory entry in the mapping, checking that its data
+ * and name lie inside the file. Appended data lies before the directory
+ * block at base, the rest after its end. */
+static Eina_Bool
+eet_directory_entry_read(Eet_File *ef, const int *entry, Eet_File_Node *efn,
+                         unsigned long int base, unsigned long int end)
+{
+   const char *name;
+   unsigned long int name_offset;
+   unsigned long int name_size;
+   int flag;
+
+   efn->offset = eina_ntohl(entry[0]);
+   efn->size = eina_ntohl(entry[1]);
+   efn->data_size = eina_ntohl(entry[2]);
+   name_offset = eina_ntohl(entry[3]);
+   name_size = eina_ntohl(entry[4]);
+   flag = eina_ntohl(entry[5]);
+
+   efn->compression = flag & 0x1 ? 1 : 0;
+   efn->ciphered = flag & 0x2 ? 1 : 0;
+   efn->alias = flag & 0x4 ? 1 : 0;
+   efn->compression_type = (flag >> 3) & 0xff;
+   efn->compression_pending = 0;
+   efn->dirty = 0;
+
+   /* check data pointer position */
+   if (!((efn->size > 0)
+         && (((efn->offset + efn->size <= ef->data_size)
+              && (efn->offset > end))
+             || ((base)
+                 && (efn->offset >= EET_FILE2_HEADER_SIZE)
+                 && (efn->offset + efn->size <= base)))))
+     return EINA_FALSE;
+
+   /* check name position */
+   if (!((name_size > 0)
+         && (name_offset + name_size < ef->data_size)
+         && (name_offset >= end)))
+     return EINA_FALSE;
+
+   name = (const char *)ef->data + name_offset;
+
+   /* check '\0' at the end of name string */
+   if (name[name_size - 1] != '\0')
+     return EINA_FALSE;
+
+   efn->free_name = 0;
+   efn->name = (char *)name;
+   efn->name_size = name_size;
+   efn->data = NULL;
+   efn->next = NULL;
+
+   return EINA_TRUE;
+}
+
+/* Use the index of a read only file if its first entry is one that is up
+ * to date and fits the directory. Only that entry and the index header are
+ * looked at, the slots are checked as they are used. */
+static Eina_Bool
+eet_directory_index_load(Eet_File *ef, const int *entries,
+                         unsigned long int count,
+                         unsigned long int base, unsigned long int end)
+{
+   Eet_File_Directory *dir = ef->header->directory;
+   Eet_File_Node efn;
+   const int *index;
+   unsigned long int data_end;
+
+   if ((count == 0) ||
+       (!(eina_ntohl(entries[5]) & EET_FILE2_FLAG_INDEX)))
+     return EINA_FALSE;
+
+   if ((!eet_directory_entry_read(ef, entries, &efn, base, end)) ||
+       (efn.compression) || (efn.ciphered) || (efn.alias) ||
+       (strcmp(efn.name, EET_DIRECTORY_INDEX_KEY)) ||
+       (efn.offset % sizeof (int)) ||
+       (efn.size != (EET_DIRECTORY_INDEX_HEADER_COUNT + 2 * count) * sizeof (int)))
+     return EINA_FALSE;
+
+   index = (const int *)(ef->data + efn.offset);
+   if (((int)eina_ntohl(index[0]) != EET_MAGIC_DIRECTORY_INDEX) ||
+       (eina_ntohl(index[1]) != count))
+     return EINA_FALSE;
+
+   data_end = eina_ntohl(index[2]);
+   if ((!base) && ((data_end <= end) || (data_end > ef->data_size)))
+     return EINA_FALSE;
+
+   dir->loaded = calloc(count, sizeof (Eet_File_Node));
+   if (!dir->loaded) return EINA_FALSE;
+   if (!eina_spinlock_new(&dir->lock))
+     {
+        free(dir->loaded);
+        dir->loaded = NULL;
+        return EINA_FALSE;
+     }
+
+   dir->index = index;
+   dir->entries = entries;
+   dir->count = count;
+   dir->base = base;
+   dir->end = end;
+
+   return EINA_TRUE;
+}
+
+/* Called with the directory lock held */
+static Eet_File_Node *
+eet_directory_index_node_load(Eet_File *ef, unsigned int i)
+{
+   Eet_File_Directory *dir = ef->header->directory;
+   Eet_File_Node *efn = dir->loaded + i;
+   Eet_File_Node tmp;
+
+   if (efn->name) return efn;
+
+   if (!eet_directory_entry_read(ef,
+                                 dir->entries + i * EET_FILE2_DIRECTORY_ENTRY_COUNT,
+                                 &tmp, dir->base, dir->end))
+     return NULL;
+
+   /* the name tells the other threads the rest is there, so it is the
+    * only field they may look at before it is set */
+   memcpy(&efn->data, &tmp.data,
+          sizeof (Eet_File_Node) - offsetof(Eet_File_Node, data));
+   __atomic_store_n(&efn->name, tmp.name, __ATOMIC_RELEASE);
+
+   return efn;
+}
+
+static Eet_File_Node *
+eet_directory_index_node_get(Eet_File *ef, unsigned int i)
+{
+   Eet_File_Directory *dir = ef->header->directory;
+   Eet_File_Node *efn = dir->loaded + i;
+
+   if (__atomic_load_n(&efn->name, __ATOMIC_ACQUIRE))
+     return efn;
+
+   eina_spinlock_take(&dir->lock);
+   efn = eet_directory_index_node_load(ef, i);
+   eina_spinlock_release(&dir->lock);
+
+   return efn;
+}
+
+static Eet_File_Node *
+eet_directory_index_find(Eet_File *ef, const char *name)
+{
+   Eet_File_Directory *dir = ef->header->directory;
+   const int *displace = dir->index + EET_DIRECTORY_INDEX_HEADER_COUNT;
+   const int *entry = displace + dir->count;
+   Eet_File_Node *efn;
+   unsigned int slot;
+   unsigned int i;
+   int d;
+
+   d = (int)eina_ntohl(displace[eet_directory_index_hash(name, 0) % dir->count]);
+   if (d < 0)
+     slot = (unsigned int)(-(d + 1));
+   else
+     slot = eet_directory_index_hash(name, d) % dir->count;
+   if (slot >= dir->count) return NULL;
+
+   i = eina_ntohl(entry[slot]);
+   if (i >= dir->count) return NULL;
+
+   efn = eet_directory_index_node_get(ef, i);
+   if ((!efn) || (strcmp(efn->name, name)))
+     return NULL;
+
+   return efn;
+}
+
+/* Listing needs every entry in the hash buckets, as other files have */
+static void
+eet_directory_index_complete(Eet_File *ef)
+{
+   Eet_File_Directory *dir = ef->header->directory;
+   Eet_File_Node *efn;
+   unsigned int i;
+   int hash;
+
+   if ((!dir->index) || (__atomic_load_n(&dir->complete, __ATOMIC_ACQUIRE)))
+     return;
+
+   eina_spinlock_take(&dir->lock);
+   if (!dir->complete)
+     {
+        for (i = 0; i < dir->count; i++)
+          {
+             efn = eet_directory_index_node_load(ef, i);
+             if (!efn) continue;
+
+             hash = _eet_hash_gen(efn->name, dir->size);
+             efn->next = dir->nodes[hash];
+             dir->nodes[hash] = efn;
+          }
+        __atomic_store_n(&dir->complete, EINA_TRUE, __ATOMIC_RELEASE);
+     }
+   eina_spinlock_release(&dir->lock);
+}
+
 /* FIXME: MMAP race condition in READ_WRITE_MODE */
 static Eet_File *
 eet_internal_read2(Eet_File *ef)
@@ -740,8 +1775,25 @@ eet_internal_read2(Eet_File *ef)
    unsigned long int signature_base_offset;
    unsigned long int num_directory_entries;
    unsigned long int num_dictionary_entries;
+   unsigned long int base = 0;
+   unsigned long int end;
    unsigned int i;
 
+   /* remember what is on disk, appending is only safe on top of it */
+   memcpy(ef->disk_head, data, sizeof (ef->disk_head));
+
+   /* appended file, the directory block is somewhere after the data */
+   if ((int)eina_ntohl(*data) == EET_MAGIC_FILE2_APPEND)
+     {
+        base = eina_ntohl(data[1]);
+        if (eet_test_close((base < EET_FILE2_HEADER_SIZE) ||
+                           (base % ALIGN) ||
+                           (base + EET_FILE2_HEADER_SIZE > ef->data_size), ef))
+          return NULL;
+
+        data = (const int *)(ef->data + base);
+     }
+
    idx += sizeof(int);
    if (eet_test_close((int)eina_ntohl(*data) != EET_MAGIC_FILE2, ef))
      return NULL;
@@ -770,10 +1822,13 @@ eet_internal_read2(Eet_File *ef)
      return NULL;
 
    /* we can't have more bytes directory and bytes in dictionaries than the size of the file */
-   if (eet_test_close((bytes_directory_entries + bytes_dictionary_entries) >
+   if (eet_test_close((base + bytes_directory_entries + bytes_dictionary_entries) >
                       ef->data_size, ef))
      return NULL;
 
+   /* end of the directory block, names and strings follow it */
+   end = base + bytes_directory_entries + bytes_dictionary_entries;
+
    /* allocate header */
    ef->header = eet_file_header_calloc(1);
    if (eet_test_close(!ef->header, ef))
@@ -795,20 +1850,29 @@ eet_internal_read2(Eet_File *ef)
      return NULL;
 
    signature_base_offset = 0;
-   if (num_directory_entries == 0)
+   /* appended files are never signed */
+   if ((num_directory_entries == 0) || (base))
      {
         signature_base_offset = ef->data_size;
      }
 
+   /* a read only file with an index only reads entries when asked for */
+   if ((ef->mode == EET_FILE_MODE_READ) &&
+       (eet_directory_index_load(ef, data, num_directory_entries, base, end)))
+     {
+        data += EET_FILE2_DIRECTORY_ENTRY_COUNT * num_directory_entries;
+        idx += EET_FILE2_DIRECTORY_ENTRY_SIZE * num_directory_entries;
+
+        if (!base)
+          signature_base_offset = eina_ntohl(ef->header->directory->index[2]);
+        num_directory_entries = 0;
+     }
+
    /* actually read the directory block - all of it, into ram */
    for (i = 0; i < num_directory_entries; ++i)
      {
-        const char *name;
         Eet_File_Node *efn;
-        unsigned long int name_offset;
-        unsigned long int name_size;
         int hash;
-        int flag;
 
         /* out directory block is inconsistent - we have overrun our */
         /* dynamic block buffer before we finished scanning dir entries */
@@ -822,45 +1886,13 @@ eet_internal_read2(Eet_File *ef)
           }
 
         /* get entrie header */
-        GET_INT(efn->offset, data, idx);
-        GET_INT(efn->size, data, idx);
-        GET_INT(efn->data_size, data, idx);
-        GET_INT(name_offset, data, idx);
-        GET_INT(name_size, data, idx);
-        GET_INT(flag, data, idx);
-
-        efn->compression = flag & 0x1 ? 1 : 0;
-        efn->ciphered = flag & 0x2 ? 1 : 0;
-        efn->alias = flag & 0x4 ? 1 : 0;
-        efn->compression_type = (flag >> 3) & 0xff;
-
-#define EFN_TEST(Test, Ef, Efn) \
-  if (eet_test_close(Test, Ef)) \
-    {                           \
-       eet_file_node_mp_free(Efn);               \
-       return NULL;             \
-    }
-
-        /* check data pointer position */
-        EFN_TEST(!((efn->size > 0)
-                   && (efn->offset + efn->size <= ef->data_size)
-                   && (efn->offset > bytes_dictionary_entries +
-                       bytes_directory_entries)), ef, efn);
-
-        /* check name position */
-        EFN_TEST(!((name_size > 0)
-                   && (name_offset + name_size < ef->data_size)
-                   && (name_offset >= bytes_dictionary_entries +
-                       bytes_directory_entries)), ef, efn);
-
-        name = start + name_offset;
-
-        /* check '\0' at the end of name string */
-        EFN_TEST(name[name_size - 1] != '\0', ef, efn);
-
-        efn->free_name = 0;
-        efn->name = (char *)name;
-        efn->name_size = name_size;
+        if (eet_test_close(!eet_directory_entry_read(ef, data, efn, base, end), ef))
+          {
+             eet_file_node_mp_free(efn);
+             return NULL;
+          }
+        data += EET_FILE2_DIRECTORY_ENTRY_COUNT;
+        idx += EET_FILE2_DIRECTORY_ENTRY_SIZE;
 
         hash = _eet_hash_gen(efn->name, ef->header->directory->size);
         efn->next = ef->header->directory->nodes[hash];
@@ -888,7 +1920,7 @@ eet_internal_read2(Eet_File *ef)
 
    if (num_dictionary_entries)
      {
-        const int *dico = (const int *)ef->data +
+        const int *dico = (const int *)(ef->data + base) +
           EET_FILE2_DIRECTORY_ENTRY_COUNT * num_directory_entries +
           EET_FILE2_HEADER_COUNT;
         int j;
@@ -920,8 +1952,7 @@ eet_internal_read2(Eet_File *ef)
 
         ef->ed->count = num_dictionary_entries;
         ef->ed->total = num_dictionary_entries;
-        ef->ed->start = start + bytes_dictionary_entries +
-          bytes_directory_entries;
+        ef->ed->start = start + end;
         ef->ed->end = ef->ed->start;
 
         for (j = 0; j < ef->ed->count; ++j)
@@ -943,9 +1974,7 @@ eet_internal_read2(Eet_File *ef)
 
              /* Check string position */
              if (eet_test_close(!((ef->ed->all[j].len > 0)
-                                  && (offset >
-                                      (bytes_dictionary_entries +
-                                       bytes_directory_entries))
+                                  && (offset > end)
                                   && (offset + ef->ed->all[j].len <
                                       ef->data_size)), ef))
                return NULL;
@@ -1018,6 +2047,12 @@ eet_internal_read2(Eet_File *ef)
 #endif /* ifdef HAVE_SIGNATURE */
      }
 
+   if (ef->mode == EET_FILE_MODE_READ)
+     {
+        if (ef->ed) ef->ed->readonly = 1;
+        eet_compression_dictionary_load(ef);
+     }
+
    /* At this stage we have a valid eet file, let's tell the system we are likely to need most of its data */
    if (ef->readfp && ef->ed)
      {
@@ -1140,6 +2175,8 @@ eet_internal_read1(Eet_File *ef)
         efn->name_size = name_size;
         efn->ciphered = 0;
         efn->alias = 0;
+        efn->compression_pending = 0;
+        efn->dirty = 0;
 
         /* invalid size */
         if (eet_test_close(efn->size <= 0, ef))
@@ -1244,6 +2281,7 @@ eet_internal_read(Eet_File *ef)
 
 #endif /* if EET_OLD_EET_FILE_FORMAT */
       case EET_MAGIC_FILE2:
+      case EET_MAGIC_FILE2_APPEND:
         return eet_internal_read2(ef);
 
       default:
@@ -1346,6 +2384,13 @@ eet_internal_close(Eet_File *ef,
                   free(ef->header->directory->nodes);
                }
 
+             /* the nodes of an indexed file all live in one array */
+             if (ef->header->directory->index)
+               {
+                  free(ef->header->directory->loaded);
+                  eina_spinlock_free(&ef->header->directory->lock);
+               }
+
              if (!shutdown)
                eet_file_directory_mp_free(ef->header->directory);
           }
@@ -1356,6 +2401,10 @@ eet_internal_close(Eet_File *ef,
 
    eet_dictionary_free(ef->ed);
 
+   if (ef->compression_dictionary)
+     eina_binbuf_free(ef->compression_dictionary);
+   emile_compressor_dictionary_free(ef->compression_expander);
+
    if (ef->sha1)
      free(ef->sha1);
 
@@ -1414,6 +2463,13 @@ eet_memopen_read(const void *data,
    ef->sha1 = NULL;
    ef->sha1_length = 0;
    ef->readfp_owned = EINA_FALSE;
+   ef->compression_dictionary = NULL;
+   ef->compression_expander = NULL;
+   ef->compression_dictionary_size = 0;
+   ef->compression_threads = 0;
+   ef->append = 0;
+   ef->directory_index = 0;
+   eet_disk_state_set(ef, NULL);
 
    ef = eet_internal_read(ef);
    UNLOCK_CACHE;
@@ -1473,6 +2529,13 @@ eet_mmap(const Eina_File *file)
    ef->sha1 = NULL;
    ef->sha1_length = 0;
    ef->readfp_owned = EINA_TRUE;
+   ef->compression_dictionary = NULL;
+   ef->compression_expander = NULL;
+   ef->compression_dictionary_size = 0;
+   ef->compression_threads = 0;
+   ef->append = 0;
+   ef->directory_index = 0;
+   eet_disk_state_set(ef, NULL);
 
    ef->data_size = eina_file_size_get(ef->readfp);
    ef->data = eina_file_map_all(ef->readfp, EINA_FILE_SEQUENTIAL);
@@ -1620,6 +2683,25 @@ open_error:
    ef->sha1 = NULL;
    ef->sha1_length = 0;
    ef->readfp_owned = EINA_TRUE;
+   ef->compression_dictionary = NULL;
+   ef->compression_expander = NULL;
+   ef->compression_dictionary_size = 0;
+   ef->compression_threads = 0;
+   ef->append = 0;
+   ef->directory_index = 0;
+   eet_disk_state_set(ef, NULL);
+   memset(ef->disk_head, 0, sizeof (ef->disk_head));
+
+   /* appending later is only safe on top of the file read here */
+   if ((mode == EET_FILE_MODE_READ_WRITE) && (fp))
+     {
+        struct stat st;
+
+        if ((!stat(file, &st)) &&
+            ((unsigned long int)st.st_size == size) &&
+            (st.st_mtime == eina_file_mtime_get(fp)))
+          eet_disk_state_set(ef, &st);
+     }
 
    ef->ed = (mode == EET_FILE_MODE_WRITE)
      || (!ef->readfp && mode == EET_FILE_MODE_READ_WRITE) ?
@@ -1665,6 +2747,20 @@ on_error:
    return NULL;
 }
 
+/* Keeps a file open for as long as something points into it, it is released
+ * with eet_close() like any other reference */
+Eet_File *
+eet_file_ref(Eet_File *ef)
+{
+   if (eet_check_pointer(ef))
+     return NULL;
+
+   LOCK_CACHE;
+   ef->references++;
+   UNLOCK_CACHE;
+   return ef;
+}
+
 EAPI Eet_File_Mode
 eet_mode_get(Eet_File *ef)
 {
@@ -1929,7 +3025,7 @@ eet_read_cipher(Eet_File   *ef,
    if (eet_check_header(ef))
      return NULL;
 
-   LOCK_FILE(ef);
+   LOCK_FILE_READ(ef);
 
    /* hunt hash bucket */
    efn = find_node_by_name(ef, name);
@@ -1962,9 +3058,7 @@ eet_read_cipher(Eet_File   *ef,
      {
         Eina_Binbuf *out;
 
-        out = emile_decompress(in,
-                               eet_2_emile_compressor(efn->compression_type),
-                               efn->data_size);
+        out = eet_node_decompress(ef, efn, in);
 
         eina_binbuf_free(in);
         if (!out) goto on_error;
@@ -1972,7 +3066,7 @@ eet_read_cipher(Eet_File   *ef,
         in = out;
      }
 
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
 
    if (size_ret)
      *size_ret = eina_binbuf_length_get(in);
@@ -1997,7 +3091,7 @@ eet_read_cipher(Eet_File   *ef,
    return data;
 
 on_error:
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
    free(data);
    return NULL;
 }
@@ -2037,7 +3131,7 @@ eet_read_direct(Eet_File   *ef,
    if (eet_check_header(ef))
      return NULL;
 
-   LOCK_FILE(ef);
+   LOCK_FILE_READ(ef);
 
    /* hunt hash bucket */
    efn = find_node_by_name(ef, name);
@@ -2063,9 +3157,7 @@ eet_read_direct(Eet_File   *ef,
              in = read_binbuf_from_disk(ef, efn);
              if (!in) goto on_error;
 
-             out = emile_decompress(in,
-                                    eet_2_emile_compressor(efn->compression_type),
-                                    efn->data_size);
+             out = eet_node_decompress(ef, efn, in);
              eina_binbuf_free(in);
              if (!out) goto on_error;
 
@@ -2076,7 +3168,7 @@ eet_read_direct(Eet_File   *ef,
                   goto on_error;
                }
 
-             UNLOCK_FILE(ef);
+             UNLOCK_FILE_READ(ef);
 
              retptr = eet_read_direct(ef, (const char *) tmp, size_ret);
 
@@ -2090,7 +3182,7 @@ eet_read_direct(Eet_File   *ef,
         if (data[size - 1] != '\0')
           goto on_error;
 
-        UNLOCK_FILE(ef);
+        UNLOCK_FILE_READ(ef);
 
         return eet_read_direct(ef, data, size_ret);
      }
@@ -2105,12 +3197,12 @@ eet_read_direct(Eet_File   *ef,
    if (size_ret)
      *size_ret = size;
 
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
 
    return data;
 
 on_error:
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
    return NULL;
 }
 
@@ -2137,7 +3229,7 @@ eet_alias_get(Eet_File   *ef,
    if (eet_check_header(ef))
      return NULL;
 
-   LOCK_FILE(ef);
+   LOCK_FILE_READ(ef);
 
    /* hunt hash bucket */
    efn = find_node_by_name(ef, name);
@@ -2165,9 +3257,7 @@ eet_alias_get(Eet_File   *ef,
         in = read_binbuf_from_disk(ef, efn);
         if (!in) goto on_error;
 
-        out = emile_decompress(in,
-                               eet_2_emile_compressor(efn->compression_type),
-                               efn->data_size);
+        out = eet_node_decompress(ef, efn, in);
         eina_binbuf_free(in);
         if (!out) goto on_error;
 
@@ -2178,7 +3268,7 @@ eet_alias_get(Eet_File   *ef,
              goto on_error;
           }
 
-        UNLOCK_FILE(ef);
+        UNLOCK_FILE_READ(ef);
 
         retptr = eina_stringshare_add((const char *) tmp);
 
@@ -2192,12 +3282,12 @@ eet_alias_get(Eet_File   *ef,
    if (data[size - 1] != '\0')
      goto on_error;
 
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
 
    return eina_stringshare_add(data);
 
 on_error:
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
    return NULL;
 }
 
@@ -2206,6 +3296,7 @@ eet_define_data(Eet_File *ef, Eet_File_Node *efn, Eina_Binbuf *data, int origina
 {
    free(efn->data);
    efn->alias = 0;
+   efn->compression_pending = 0;
    efn->ciphered = ciphered;
    efn->compression = !!comp;
    efn->compression_type = comp;
@@ -2214,6 +3305,111 @@ eet_define_data(Eet_File *ef, Eet_File_Node *efn, Eina_Binbuf *data, int origina
    efn->data = efn->size ? eina_binbuf_string_steal(data) : NULL;
    /* Put the offset above the limit to avoid direct access */
    efn->offset = ef->data_size + 1;
+   efn->dirty = 1;
+}
+
+EAPI Eina_Bool
+eet_compression_dictionary_train(Eet_File    *ef,
+                                 unsigned int size)
+{
+   /* check to see its' an eet file pointer */
+   if (eet_check_pointer(ef))
+     return EINA_FALSE;
+
+   if ((ef->mode != EET_FILE_MODE_WRITE) &&
+       (ef->mode != EET_FILE_MODE_READ_WRITE))
+     return EINA_FALSE;
+
+   LOCK_FILE(ef);
+   ef->compression_dictionary_size = size;
+   UNLOCK_FILE(ef);
+
+   return EINA_TRUE;
+}
+
+EAPI Eina_Bool
+eet_compression_threads_set(Eet_File *ef,
+                            int       threads)
+{
+   /* check to see its' an eet file pointer */
+   if (eet_check_pointer(ef))
+     return EINA_FALSE;
+
+   if ((ef->mode != EET_FILE_MODE_WRITE) &&
+       (ef->mode != EET_FILE_MODE_READ_WRITE))
+     return EINA_FALSE;
+
+   if (threads < 0) threads = eina_cpu_count();
+   if (threads > EET_COMPRESSION_THREADS_MAX)
+     threads = EET_COMPRESSION_THREADS_MAX;
+
+   LOCK_FILE(ef);
+   ef->compression_threads = threads;
+   UNLOCK_FILE(ef);
+
+   return EINA_TRUE;
+}
+
+EAPI Eina_Bool
+eet_file_append_set(Eet_File *ef,
+                    Eina_Bool append)
+{
+   /* check to see its' an eet file pointer */
+   if (eet_check_pointer(ef))
+     return EINA_FALSE;
+
+   if (ef->mode != EET_FILE_MODE_READ_WRITE)
+     return EINA_FALSE;
+
+   LOCK_FILE(ef);
+   ef->append = !!append;
+   UNLOCK_FILE(ef);
+
+   return EINA_TRUE;
+}
+
+EAPI Eina_Bool
+eet_directory_index_set(Eet_File *ef,
+                        Eina_Bool index)
+{
+   /* check to see its' an eet file pointer */
+   if (eet_check_pointer(ef))
+     return EINA_FALSE;
+
+   if ((ef->mode != EET_FILE_MODE_WRITE) &&
+       (ef->mode != EET_FILE_MODE_READ_WRITE))
+     return EINA_FALSE;
+
+   LOCK_FILE(ef);
+   ef->directory_index = !!index;
+   UNLOCK_FILE(ef);
+
+   return EINA_TRUE;
+}
+
+EAPI Eet_Error
+eet_compact(Eet_File *ef)
+{
+   Eet_Error ret;
+   unsigned char append;
+
+   if (eet_check_pointer(ef))
+     return EET_ERROR_BAD_OBJECT;
+
+   if ((ef->mode != EET_FILE_MODE_WRITE) &&
+       (ef->mode != EET_FILE_MODE_READ_WRITE))
+     return EET_ERROR_NOT_WRITABLE;
+
+   LOCK_FILE(ef);
+
+   append = ef->append;
+   ef->append = 0;
+   ef->writes_pending = 1;
+   ret = eet_flush2(ef);
+   ef->append = append;
+
+   UNLOCK_FILE(ef);
+   return ret;
 }
 
 EAPI Eina_Bool
@@ -2348,6 +3544,7 @@ eet_write_cipher(Eet_File   *ef,
 {
    Eina_Binbuf *in;
    Eet_File_Node *efn;
+   int pending;
    int exists_already = 0;
    int hash;
 
@@ -2398,6 +3595,17 @@ eet_write_cipher(Eet_File   *ef,
    /* figure hash bucket */
    hash = _eet_hash_gen(name, ef->header->directory->size);
 
+   /* leave it to the flush, to compress it in parallel or once the file
+    * dictionary is known */
+   pending = 0;
+   if ((comp) && (!cipher_key) &&
+       ((ef->compression_threads > 1) ||
+        ((comp == EET_COMPRESSION_ZSTD) && (ef->compression_dictionary_size > 0))))
+     {
+        pending = comp;
+        comp = 0;
+     }
+
    UNLOCK_FILE(ef);
 
    in = eina_binbuf_manage_new(data, size, EINA_TRUE);
@@ -2474,6 +3682,11 @@ eet_write_cipher(Eet_File   *ef,
         eet_define_data(ef, efn, in, size, comp, !!cipher_key);
         ef->header->directory->free_count++;
      }
+   if (pending)
+     {
+        efn->compression_pending = 1;
+        efn->compression_type = pending;
+     }
 
    /* flags that writes are pending */
    ef->writes_pending = 1;
@@ -2595,7 +3808,8 @@ eet_list(Eet_File   *ef,
    if (!strcmp(glob, "*"))
      glob = NULL;
 
-   LOCK_FILE(ef);
+   LOCK_FILE_READ(ef);
+   eet_directory_index_complete(ef);
 
    /* loop through all entries */
    num = (1 << ef->header->directory->size);
@@ -2636,7 +3850,7 @@ eet_list(Eet_File   *ef,
           }
      }
 
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
 
    /* return count and list */
    if (count_ret)
@@ -2645,7 +3859,7 @@ eet_list(Eet_File   *ef,
    return list_ret;
 
 on_error:
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
 
    if (count_ret)
      *count_ret = 0;
@@ -2665,7 +3879,8 @@ eet_num_entries(Eet_File *ef)
         (ef->mode != EET_FILE_MODE_READ_WRITE)))
      return -1;
 
-   LOCK_FILE(ef);
+   LOCK_FILE_READ(ef);
+   eet_directory_index_complete(ef);
 
    /* loop through all entries */
    num = (1 << ef->header->directory->size);
@@ -2675,7 +3890,7 @@ eet_num_entries(Eet_File *ef)
           ret++;
      }
 
-   UNLOCK_FILE(ef);
+   UNLOCK_FILE_READ(ef);
 
    return ret;
 }
@@ -2778,6 +3993,9 @@ eet_list_entries(Eet_File *ef)
 {
    Eet_Entries_Iterator *it;
 
+   if ((!eet_check_pointer(ef)) && (!eet_check_header(ef)))
+     eet_directory_index_complete(ef);
+
    it = malloc(sizeof (Eet_Entries_Iterator));
    if (!it) return NULL;
 
@@ -2803,6 +4021,9 @@ find_node_by_name(Eet_File   *ef,
    Eet_File_Node *efn;
    int hash;
 
+   if (ef->header->directory->index)
+     return eet_directory_index_find(ef, name);
+
    /* get hash bucket this should be in */
    hash = _eet_hash_gen(name, ef->header->directory->size);
 
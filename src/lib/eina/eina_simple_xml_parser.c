@@ -26,6 +26,16 @@
 #include <string.h>
 #include <ctype.h>
 
+/* SSE2 is always there on x86_64 and NEON on aarch64, no need to check the
+ * cpu at runtime for them. */
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+# include <emmintrin.h>
+# define EINA_SIMPLE_XML_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+# include <arm_neon.h>
+# define EINA_SIMPLE_XML_NEON 1
+#endif
+
 #include "eina_config.h"
 #include "eina_private.h"
 #include "eina_alloca.h"
@@ -129,18 +139,59 @@ _eina_simple_xml_tag_start_find(const char *itr, const char *itr_end)
    return memchr(itr, '<', itr_end - itr);
 }
 
+/* Returns the first of the a, b or c bytes, itr_end if there is none.
+ * Checks 16 bytes at once when possible. */
 static inline const char *
-_eina_simple_xml_tag_end_find(const char *itr, const char *itr_end)
+_eina_simple_xml_any_find(const char *itr, const char *itr_end,
+                          char a, char b, char c)
 {
-   Eina_Bool inside_quote = EINA_FALSE;
+#ifdef EINA_SIMPLE_XML_SSE2
+   const __m128i va = _mm_set1_epi8(a);
+   const __m128i vb = _mm_set1_epi8(b);
+   const __m128i vc = _mm_set1_epi8(c);
+
+   for (; itr_end - itr >= 16; itr += 16)
+     {
+        __m128i v = _mm_loadu_si128((const __m128i *)itr);
+        int mask;
+
+        mask = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, va),
+                                                           _mm_cmpeq_epi8(v, vb)),
+                                              _mm_cmpeq_epi8(v, vc)));
+        if (mask) return itr + __builtin_ctz(mask);
+     }
+#elif defined(EINA_SIMPLE_XML_NEON)
+   const uint8x16_t va = vdupq_n_u8(a);
+   const uint8x16_t vb = vdupq_n_u8(b);
+   const uint8x16_t vc = vdupq_n_u8(c);
+
+   // No movemask here, the matching block is scanned below
+   for (; itr_end - itr >= 16; itr += 16)
+     {
+        uint8x16_t v = vld1q_u8((const uint8_t *)itr);
+
+        if (vmaxvq_u8(vorrq_u8(vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb)),
+                               vceqq_u8(v, vc))))
+          break;
+     }
+#endif
    for (; itr < itr_end; itr++)
+     if ((*itr == a) || (*itr == b) || (*itr == c)) break;
+   return itr;
+}
+
+static inline const char *
+_eina_simple_xml_tag_end_find(const char *itr, const char *itr_end)
+{
+   while ((itr = _eina_simple_xml_any_find(itr, itr_end, '"', '>', '<')) < itr_end)
      {
-        if (*itr == '"') inside_quote = !inside_quote;
-        if (!inside_quote)
-          {
-             if ((*itr == '>') || (*itr == '<')) /* consider < also ends a tag */
-               return itr;
-          }
+        /* consider < also ends a tag */
+        if (*itr != '"') return itr;
+
+        /* nothing ends a tag in quotes */
+        itr = memchr(itr + 1, '"', itr_end - itr - 1);
+        if (!itr) return NULL;
+        itr++;
      }
    return NULL;
 }
@@ -148,32 +199,34 @@ _eina_simple_xml_tag_end_find(const char *itr, const char *itr_end)
 static inline const char *
 _eina_simple_xml_tag_comment_end_find(const char *itr, const char *itr_end)
 {
-   for (; itr < itr_end; itr++)
-     if ((*itr == '-') &&
-         ((itr + 1 < itr_end) && (*(itr + 1) == '-')) &&
-         ((itr + 2 < itr_end) && (*(itr + 2) == '>')))
-       return itr + 2;
+   while ((itr < itr_end) && (itr = memchr(itr, '-', itr_end - itr)))
+     {
+        if (((itr + 1 < itr_end) && (*(itr + 1) == '-')) &&
+            ((itr + 2 < itr_end) && (*(itr + 2) == '>')))
+          return itr + 2;
+        itr++;
+     }
    return NULL;
 }
 
 static inline const char *
 _eina_simple_xml_tag_cdata_end_find(const char *itr, const char *itr_end)
 {
-   for (; itr < itr_end; itr++)
-     if ((*itr == ']') &&
-         ((itr + 1 < itr_end) && (*(itr + 1) == ']')) &&
-         ((itr + 2 < itr_end) && (*(itr + 2) == '>')))
-       return itr + 2;
+   while ((itr < itr_end) && (itr = memchr(itr, ']', itr_end - itr)))
+     {
+        if (((itr + 1 < itr_end) && (*(itr + 1) == ']')) &&
+            ((itr + 2 < itr_end) && (*(itr + 2) == '>')))
+          return itr + 2;
+        itr++;
+     }
    return NULL;
 }
 
 static inline const char *
 _eina_simple_xml_tag_doctype_child_end_find(const char *itr, const char *itr_end)
 {
-   for (; itr < itr_end; itr++)
-     if (*itr == '>')
-       return itr;
-   return NULL;
+   if (itr >= itr_end) return NULL;
+   return memchr(itr, '>', itr_end - itr);
 }
 
 /**
@@ -2,6 +2,7 @@
 #include <config.h>
 #endif
 
+#include <string.h>
 #include <zlib.h>
 
 #ifdef ENABLE_LIBLZ4
@@ -12,9 +13,110 @@
 #include "lz4hc.h"
 #endif
 
+#ifdef HAVE_ZSTD
+# include <zstd.h>
+# include <zdict.h>
+#endif
+
 #include <Eina.h>
 
 #include "Emile.h"
+#include "emile_private.h"
+
+struct _Emile_Compressor_Dictionary
+{
+   Emile_Compressor_Type t;
+   Emile_Compressor_Level level;
+   Eina_Binbuf *dict; /* for the types that can not digest it beforehand */
+#ifdef HAVE_ZSTD
+   ZSTD_CDict *cdict;
+   ZSTD_DDict *ddict;
+#endif
+};
+
+#ifdef HAVE_ZSTD
+/* zstd contexts are expensive to set up, each thread keeps its own */
+static Eina_TLS _emile_zstd_cctx_key;
+static Eina_TLS _emile_zstd_dctx_key;
+static Eina_Bool _emile_zstd_tls = EINA_FALSE;
+
+static void
+_emile_zstd_cctx_free(void *ctx)
+{
+   ZSTD_freeCCtx(ctx);
+}
+
+static void
+_emile_zstd_dctx_free(void *ctx)
+{
+   ZSTD_freeDCtx(ctx);
+}
+
+static ZSTD_CCtx *
+_emile_zstd_cctx_get(Eina_Bool *owned)
+{
+   ZSTD_CCtx *ctx;
+
+   *owned = !_emile_zstd_tls;
+   if (*owned) return ZSTD_createCCtx();
+
+   ctx = eina_tls_get(_emile_zstd_cctx_key);
+   if (ctx) return ctx;
+
+   ctx = ZSTD_createCCtx();
+   if ((ctx) && (!eina_tls_set(_emile_zstd_cctx_key, ctx)))
+     *owned = EINA_TRUE;
+   return ctx;
+}
+
+static ZSTD_DCtx *
+_emile_zstd_dctx_get(Eina_Bool *owned)
+{
+   ZSTD_DCtx *ctx;
+
+   *owned = !_emile_zstd_tls;
+   if (*owned) return ZSTD_createDCtx();
+
+   ctx = eina_tls_get(_emile_zstd_dctx_key);
+   if (ctx) return ctx;
+
+   ctx = ZSTD_createDCtx();
+   if ((ctx) && (!eina_tls_set(_emile_zstd_dctx_key, ctx)))
+     *owned = EINA_TRUE;
+   return ctx;
+}
+#endif
+
+Eina_Bool
+_emile_compress_init(void)
+{
+#ifdef HAVE_ZSTD
+   if (!eina_tls_cb_new(&_emile_zstd_cctx_key, _emile_zstd_cctx_free))
+     return EINA_FALSE;
+   if (!eina_tls_cb_new(&_emile_zstd_dctx_key, _emile_zstd_dctx_free))
+     {
+        eina_tls_free(_emile_zstd_cctx_key);
+        return EINA_FALSE;
+     }
+   _emile_zstd_tls = EINA_TRUE;
+#endif
+   return EINA_TRUE;
+}
+
+void
+_emile_compress_shutdown(void)
+{
+#ifdef HAVE_ZSTD
+   if (!_emile_zstd_tls) return;
+   _emile_zstd_tls = EINA_FALSE;
+
+   /* Threads still alive keep theirs, only the calling one can be cleaned */
+   ZSTD_freeCCtx(eina_tls_get(_emile_zstd_cctx_key));
+   ZSTD_freeDCtx(eina_tls_get(_emile_zstd_dctx_key));
+   eina_tls_free(_emile_zstd_cctx_key);
+   eina_tls_free(_emile_zstd_dctx_key);
+#endif
+}
 
 static int
 _emile_compress_buffer_size(const Eina_Binbuf *data, Emile_Compressor_Type t)
@@ -28,15 +130,44 @@ _emile_compress_buffer_size(const Eina_Binbuf *data, Emile_Compressor_Type t)
       case EMILE_LZ4HC:
         return LZ4_compressBound(eina_binbuf_length_get(data));
 
+#ifdef HAVE_ZSTD
+      case EMILE_ZSTD:
+        return ZSTD_compressBound(eina_binbuf_length_get(data));
+#endif
+
       default:
         return -1;
      }
 }
 
+#ifdef HAVE_ZSTD
+/* Map the zlib like levels onto zstd ones, best is still fast to expand */
+static int
+_emile_zstd_level(Emile_Compressor_Level l)
+{
+   int level = l;
+
+   if (level <= 0) return ZSTD_CLEVEL_DEFAULT;
+   if (level > EMILE_COMPRESSOR_BEST) level = EMILE_COMPRESSOR_BEST;
+   level = level * 2 + 1;
+   if (level > ZSTD_maxCLevel()) level = ZSTD_maxCLevel();
+   return level;
+}
+#endif
+
 EAPI Eina_Binbuf *
 emile_compress(const Eina_Binbuf *data,
                Emile_Compressor_Type t,
                Emile_Compressor_Level l)
+{
+   return emile_compress_dictionary(data, t, l, NULL);
+}
+
+EAPI Eina_Binbuf *
+emile_compress_dictionary(const Eina_Binbuf *data,
+                          Emile_Compressor_Type t,
+                          Emile_Compressor_Level l,
+                          const Eina_Binbuf *dict)
 {
    void *compact, *temp;
    int length;
@@ -44,6 +175,8 @@ emile_compress(const Eina_Binbuf *data,
    Eina_Bool ok = EINA_FALSE;
 
    length = _emile_compress_buffer_size(data, t);
+   if (length < 0)
+     return NULL;
 
    compact = malloc(length);
    if (!compact)
@@ -52,9 +185,24 @@ emile_compress(const Eina_Binbuf *data,
    switch (t)
      {
       case EMILE_LZ4:
-        length = LZ4_compress_default
-          ((const char *)eina_binbuf_string_get(data), compact,
-           eina_binbuf_length_get(data), length);
+        if (dict)
+          {
+             LZ4_stream_t *stream;
+
+             /* Only the last 64KB of the dictionary are used by lz4 */
+             stream = LZ4_createStream();
+             if (!stream) break;
+             LZ4_loadDict(stream, (const char *)eina_binbuf_string_get(dict),
+                          eina_binbuf_length_get(dict));
+             length = LZ4_compress_fast_continue
+               (stream, (const char *)eina_binbuf_string_get(data), compact,
+                eina_binbuf_length_get(data), length, 1);
+             LZ4_freeStream(stream);
+          }
+        else
+          length = LZ4_compress_default
+            ((const char *)eina_binbuf_string_get(data), compact,
+             eina_binbuf_length_get(data), length);
         /* It is going to be smaller and should never fail, if it does you are in deep poo. */
         temp = realloc(compact, length);
         if (temp) compact = temp;
@@ -81,7 +229,44 @@ emile_compress(const Eina_Binbuf *data,
          if (compress2((Bytef *)compact, &buflen, (Bytef *)eina_binbuf_string_get(data), (uLong)eina_binbuf_length_get(data), level) == Z_OK)
            ok = EINA_TRUE;
          length = (int)buflen;
+         break;
+      }
+
+#ifdef HAVE_ZSTD
+      case EMILE_ZSTD:
+      {
+         ZSTD_CCtx *ctx;
+         Eina_Bool owned;
+         size_t ret;
+
+         ctx = _emile_zstd_cctx_get(&owned);
+         if (!ctx) break;
+
+         if (dict)
+           ret = ZSTD_compress_usingDict(ctx, compact, length,
+                                         eina_binbuf_string_get(data),
+                                         eina_binbuf_length_get(data),
+                                         eina_binbuf_string_get(dict),
+                                         eina_binbuf_length_get(dict),
+                                         _emile_zstd_level(l));
+         else
+           ret = ZSTD_compressCCtx(ctx, compact, length,
+                                   eina_binbuf_string_get(data),
+                                   eina_binbuf_length_get(data),
+                                   _emile_zstd_level(l));
+         if (owned) ZSTD_freeCCtx(ctx);
+         if (ZSTD_isError(ret)) break;
+
+         length = (int)ret;
+         temp = realloc(compact, length);
+         if (temp) compact = temp;
+         ok = EINA_TRUE;
+         break;
       }
+#endif
+
+      default:
+        break;
      }
 
    if (!ok)
@@ -95,6 +280,13 @@ emile_compress(const Eina_Binbuf *data,
 
 EAPI Eina_Bool
 emile_expand(const Eina_Binbuf *in, Eina_Binbuf *out, Emile_Compressor_Type t)
+{
+   return emile_expand_dictionary(in, out, t, NULL);
+}
+
+EAPI Eina_Bool
+emile_expand_dictionary(const Eina_Binbuf *in, Eina_Binbuf *out,
+                        Emile_Compressor_Type t, const Eina_Binbuf *dict)
 {
    if (!in || !out)
      return EINA_FALSE;
@@ -106,10 +298,19 @@ emile_expand(const Eina_Binbuf *in, Eina_Binbuf *out, Emile_Compressor_Type t)
       {
          int ret;
 
-         ret = LZ4_decompress_safe((const char *)eina_binbuf_string_get(in),
-                                   (char *)eina_binbuf_string_get(out),
-                                   eina_binbuf_length_get(in),
-                                   eina_binbuf_length_get(out));
+         if (dict)
+           ret = LZ4_decompress_safe_usingDict
+             ((const char *)eina_binbuf_string_get(in),
+              (char *)eina_binbuf_string_get(out),
+              eina_binbuf_length_get(in),
+              eina_binbuf_length_get(out),
+              (const char *)eina_binbuf_string_get(dict),
+              eina_binbuf_length_get(dict));
+         else
+           ret = LZ4_decompress_safe((const char *)eina_binbuf_string_get(in),
+                                     (char *)eina_binbuf_string_get(out),
+                                     eina_binbuf_length_get(in),
+                                     eina_binbuf_length_get(out));
          if ((unsigned int)ret != eina_binbuf_length_get(out))
            return EINA_FALSE;
          break;
@@ -124,6 +325,37 @@ emile_expand(const Eina_Binbuf *in, Eina_Binbuf *out, Emile_Compressor_Type t)
          break;
       }
 
+#ifdef HAVE_ZSTD
+      case EMILE_ZSTD:
+      {
+         ZSTD_DCtx *ctx;
+         Eina_Bool owned;
+         size_t ret;
+
+         ctx = _emile_zstd_dctx_get(&owned);
+         if (!ctx) return EINA_FALSE;
+
+         if (dict)
+           ret = ZSTD_decompress_usingDict(ctx,
+                                           (void *)eina_binbuf_string_get(out),
+                                           eina_binbuf_length_get(out),
+                                           eina_binbuf_string_get(in),
+                                           eina_binbuf_length_get(in),
+                                           eina_binbuf_string_get(dict),
+                                           eina_binbuf_length_get(dict));
+         else
+           ret = ZSTD_decompressDCtx(ctx,
+                                     (void *)eina_binbuf_string_get(out),
+                                     eina_binbuf_length_get(out),
+                                     eina_binbuf_string_get(in),
+                                     eina_binbuf_length_get(in));
+         if (owned) ZSTD_freeDCtx(ctx);
+         if (ZSTD_isError(ret) || (ret != eina_binbuf_length_get(out)))
+           return EINA_FALSE;
+         break;
+      }
+#endif
+
       default:
         return EINA_FALSE;
      }
@@ -135,6 +367,15 @@ EAPI Eina_Binbuf *
 emile_decompress(const Eina_Binbuf *data,
                  Emile_Compressor_Type t,
                  unsigned int dest_length)
+{
+   return emile_decompress_dictionary(data, t, dest_length, NULL);
+}
+
+EAPI Eina_Binbuf *
+emile_decompress_dictionary(const Eina_Binbuf *data,
+                            Emile_Compressor_Type t,
+                            unsigned int dest_length,
+                            const Eina_Binbuf *dict)
 {
    Eina_Binbuf *out;
    void *expanded;
@@ -147,7 +388,7 @@ emile_decompress(const Eina_Binbuf *data,
    if (!out)
      goto on_error;
 
-   if (!emile_expand(data, out, t))
+   if (!emile_expand_dictionary(data, out, t, dict))
      goto on_error;
 
    return out;
@@ -159,3 +400,267 @@ on_error:
      eina_binbuf_free(out);
    return NULL;
 }
+
+EAPI Eina_Binbuf *
+emile_compress_dictionary_train(const Eina_Binbuf * const *samples,
+                                unsigned int count,
+                                unsigned int size)
+{
+#ifdef HAVE_ZSTD
+   unsigned char *buffer, *dict;
+   size_t *sizes;
+   size_t total = 0, offset = 0, ret;
+   unsigned int i;
+
+   if (!samples || !count || !size)
+     return NULL;
+
+   for (i = 0; i < count; i++)
+     total += eina_binbuf_length_get(samples[i]);
+
+   buffer = malloc(total);
+   sizes = malloc(count * sizeof (size_t));
+   dict = malloc(size);
+   if (!buffer || !sizes || !dict)
+     goto on_error;
+
+   /* The trainer wants all the samples in one contiguous buffer */
+   for (i = 0; i < count; i++)
+     {
+        sizes[i] = eina_binbuf_length_get(samples[i]);
+        memcpy(buffer + offset, eina_binbuf_string_get(samples[i]), sizes[i]);
+        offset += sizes[i];
+     }
+
+   ret = ZDICT_trainFromBuffer(dict, size, buffer, sizes, count);
+   if (ZDICT_isError(ret))
+     goto on_error;
+
+   free(buffer);
+   free(sizes);
+   return eina_binbuf_manage_new(dict, ret, EINA_FALSE);
+
+on_error:
+   free(buffer);
+   free(sizes);
+   free(dict);
+   return NULL;
+#else
+   (void)samples;
+   (void)count;
+   (void)size;
+   return NULL;
+#endif
+}
+
+static Emile_Compressor_Dictionary *
+_emile_compressor_dictionary_new(const Eina_Binbuf *dict,
+                                 Emile_Compressor_Type t,
+                                 Emile_Compressor_Level l)
+{
+   Emile_Compressor_Dictionary *d;
+
+   if (!dict)
+     return NULL;
+
+   d = calloc(1, sizeof (Emile_Compressor_Dictionary));
+   if (!d)
+     return NULL;
+
+   d->t = t;
+   d->level = l;
+#ifdef HAVE_ZSTD
+   if (t == EMILE_ZSTD)
+     return d;
+#endif
+
+   d->dict = eina_binbuf_new();
+   if ((!d->dict) || (!eina_binbuf_append_buffer(d->dict, dict)))
+     {
+        emile_compressor_dictionary_free(d);
+        return NULL;
+     }
+
+   return d;
+}
+
+EAPI Emile_Compressor_Dictionary *
+emile_compress_dictionary_new(const Eina_Binbuf *dict,
+                              Emile_Compressor_Type t,
+                              Emile_Compressor_Level l)
+{
+   Emile_Compressor_Dictionary *d;
+
+   d = _emile_compressor_dictionary_new(dict, t, l);
+   if (!d)
+     return NULL;
+
+#ifdef HAVE_ZSTD
+   if (t == EMILE_ZSTD)
+     {
+        d->cdict = ZSTD_createCDict(eina_binbuf_string_get(dict),
+                                    eina_binbuf_length_get(dict),
+                                    _emile_zstd_level(l));
+        if (!d->cdict)
+          {
+             emile_compressor_dictionary_free(d);
+             return NULL;
+          }
+     }
+#endif
+
+   return d;
+}
+
+EAPI Emile_Compressor_Dictionary *
+emile_expand_dictionary_new(const Eina_Binbuf *dict, Emile_Compressor_Type t)
+{
+   Emile_Compressor_Dictionary *d;
+
+   d = _emile_compressor_dictionary_new(dict, t, EMILE_COMPRESSOR_DEFAULT);
+   if (!d)
+     return NULL;
+
+#ifdef HAVE_ZSTD
+   if (t == EMILE_ZSTD)
+     {
+        d->ddict = ZSTD_createDDict(eina_binbuf_string_get(dict),
+                                    eina_binbuf_length_get(dict));
+        if (!d->ddict)
+          {
+             emile_compressor_dictionary_free(d);
+             return NULL;
+          }
+     }
+#endif
+
+   return d;
+}
+
+EAPI void
+emile_compressor_dictionary_free(Emile_Compressor_Dictionary *d)
+{
+   if (!d)
+     return;
+
+#ifdef HAVE_ZSTD
+   ZSTD_freeCDict(d->cdict);
+   ZSTD_freeDDict(d->ddict);
+#endif
+   if (d->dict)
+     eina_binbuf_free(d->dict);
+   free(d);
+}
+
+EAPI Eina_Binbuf *
+emile_compress_prepared(const Eina_Binbuf *data,
+                        const Emile_Compressor_Dictionary *d)
+{
+   if (!data || !d)
+     return NULL;
+
+#ifdef HAVE_ZSTD
+   if (d->t == EMILE_ZSTD)
+     {
+        ZSTD_CCtx *ctx;
+        Eina_Bool owned;
+        void *compact, *temp;
+        size_t length, ret;
+
+        if (!d->cdict)
+          return NULL;
+
+        length = ZSTD_compressBound(eina_binbuf_length_get(data));
+        compact = malloc(length);
+        if (!compact)
+          return NULL;
+
+        ctx = _emile_zstd_cctx_get(&owned);
+        if (!ctx)
+          {
+             free(compact);
+             return NULL;
+          }
+
+        ret = ZSTD_compress_usingCDict(ctx, compact, length,
+                                       eina_binbuf_string_get(data),
+                                       eina_binbuf_length_get(data),
+                                       d->cdict);
+        if (owned) ZSTD_freeCCtx(ctx);
+        if (ZSTD_isError(ret))
+          {
+             free(compact);
+             return NULL;
+          }
+
+        temp = realloc(compact, ret);
+        if (temp) compact = temp;
+        return eina_binbuf_manage_new(compact, ret, EINA_FALSE);
+     }
+#endif
+
+   return emile_compress_dictionary(data, d->t, d->level, d->dict);
+}
+
+EAPI Eina_Bool
+emile_expand_prepared(const Eina_Binbuf *in, Eina_Binbuf *out,
+                      const Emile_Compressor_Dictionary *d)
+{
+   if (!in || !out || !d)
+     return EINA_FALSE;
+
+#ifdef HAVE_ZSTD
+   if (d->t == EMILE_ZSTD)
+     {
+        ZSTD_DCtx *ctx;
+        Eina_Bool owned;
+        size_t ret;
+
+        if (!d->ddict)
+          return EINA_FALSE;
+
+        ctx = _emile_zstd_dctx_get(&owned);
+        if (!ctx)
+          return EINA_FALSE;
+
+        ret = ZSTD_decompress_usingDDict(ctx,
+                                         (void *)eina_binbuf_string_get(out),
+                                         eina_binbuf_length_get(out),
+                                         eina_binbuf_string_get(in),
+                                         eina_binbuf_length_get(in),
+                                         d->ddict);
+        if (owned) ZSTD_freeDCtx(ctx);
+        return (!ZSTD_isError(ret)) && (ret == eina_binbuf_length_get(out));
+     }
+#endif
+
+   return emile_expand_dictionary(in, out, d->t, d->dict);
+}
+
+EAPI Eina_Binbuf *
+emile_decompress_prepared(const Eina_Binbuf *data,
+                          unsigned int dest_length,
+                          const Emile_Compressor_Dictionary *d)
+{
+   Eina_Binbuf *out;
+   void *expanded;
+
+   expanded = malloc(dest_length);
+   if (!expanded)
+     return NULL;
+
+   out = eina_binbuf_manage_new(expanded, dest_length, EINA_FALSE);
+   if (!out)
+     {
+        free(expanded);
+        return NULL;
+     }
+
+   if (!emile_expand_prepared(data, out, d))
+     {
+        eina_binbuf_free(out);
+        return NULL;
+     }
+
+   return out;
+}
@@ -22,7 +22,8 @@ typedef enum
 {
   EMILE_ZLIB,
   EMILE_LZ4,
-  EMILE_LZ4HC
+  EMILE_LZ4HC,
+  EMILE_ZSTD /**< Zstandard, only available when built with libzstd @since 1.24 */
 } Emile_Compressor_Type;
 
 /**
@@ -39,6 +40,16 @@ typedef enum
   EMILE_COMPRESSOR_BEST = 9
 } Emile_Compressor_Level;
 
+/**
+ * @typedef Emile_Compressor_Dictionary
+ * A dictionary digested once to compress or expand many buffers with it.
+ * @since 1.24
+ *
+ * @see emile_compress_dictionary_new()
+ * @see emile_expand_dictionary_new()
+ */
+typedef struct _Emile_Compressor_Dictionary Emile_Compressor_Dictionary;
+
 /**
  * @brief Compress an Eina_Binbuf into a new Eina_Binbuf
  *
@@ -84,6 +95,151 @@ EAPI Eina_Binbuf *emile_decompress(const Eina_Binbuf * in, Emile_Compressor_Type
  * could fill the out buffer.
  */
 EAPI Eina_Bool emile_expand(const Eina_Binbuf * in, Eina_Binbuf * out, Emile_Compressor_Type t);
+
+/**
+ * @brief Compress an Eina_Binbuf into a new Eina_Binbuf using a dictionary.
+ *
+ * @param in Buffer to compress.
+ * @param t Type of compression logic to use.
+ * @param level Level of compression to apply.
+ * @param dict Dictionary to prime the compressor with, can be @c NULL.
+ *
+ * @return On success it will return a buffer that contains
+ * the compressed data, @c NULL otherwise.
+ *
+ * @since 1.24
+ *
+ * @note Only #EMILE_ZSTD and #EMILE_LZ4 make use of the dictionary, it
+ * is ignored by the other types. #EMILE_LZ4 only looks at its last 64KB,
+ * which makes it usable to carry the history of a stream. The very same
+ * dictionary has to be given back to expand the data.
+ *
+ * @see emile_compress_dictionary_train()
+ */
+EAPI Eina_Binbuf *emile_compress_dictionary(const Eina_Binbuf * in, Emile_Compressor_Type t, Emile_Compressor_Level level, const Eina_Binbuf * dict);
+
+/**
+ * @brief Uncompress a buffer into a newly allocated buffer using a dictionary.
+ *
+ * @param in Buffer to uncompress.
+ * @param t Type of compression logic to use.
+ * @param dest_length Expected length of the decompressed data.
+ * @param dict Dictionary used to compress the data, can be @c NULL.
+ *
+ * @return a newly allocated buffer with the uncompressed data,
+ * @c NULL if it failed.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Binbuf *emile_decompress_dictionary(const Eina_Binbuf * in, Emile_Compressor_Type t, unsigned int dest_length, const Eina_Binbuf * dict);
+
+/**
+ * @brief Uncompress a buffer into an existing buffer using a dictionary.
+ *
+ * @param in Buffer to uncompress.
+ * @param out Buffer to expand data into.
+ * @param t Type of compression logic to use.
+ * @param dict Dictionary used to compress the data, can be @c NULL.
+ *
+ * @return EINA_TRUE if it succeed, EINA_FALSE if it failed.
+ * @since 1.24
+ */
+EAPI Eina_Bool emile_expand_dictionary(const Eina_Binbuf * in, Eina_Binbuf * out, Emile_Compressor_Type t, const Eina_Binbuf * dict);
+
+/**
+ * @brief Train a compression dictionary out of a set of samples.
+ *
+ * @param samples Array of buffers representative of the data to compress.
+ * @param count Number of buffers in @p samples.
+ * @param size Maximum size of the dictionary.
+ *
+ * @return a newly allocated dictionary, @c NULL if there was not enough
+ * samples or if the library was built without #EMILE_ZSTD support.
+ *
+ * @since 1.24
+ *
+ * @note A dictionary helps a lot when compressing many small buffers
+ * looking alike, like the entries of an eet file.
+ */
+EAPI Eina_Binbuf *emile_compress_dictionary_train(const Eina_Binbuf * const * samples, unsigned int count, unsigned int size);
+
+/**
+ * @brief Prepare a dictionary to compress many buffers with it.
+ *
+ * @param dict Dictionary to use, it is copied.
+ * @param t Type of compression logic to use.
+ * @param level Level of compression to apply.
+ *
+ * @return a dictionary for emile_compress_prepared(), @c NULL on failure.
+ *
+ * @since 1.24
+ *
+ * @note The result is the same as emile_compress_dictionary(), without
+ * digesting the dictionary again for every buffer. It can be used from
+ * many threads at once.
+ */
+EAPI Emile_Compressor_Dictionary *emile_compress_dictionary_new(const Eina_Binbuf * dict, Emile_Compressor_Type t, Emile_Compressor_Level level);
+
+/**
+ * @brief Prepare a dictionary to expand many buffers with it.
+ *
+ * @param dict Dictionary the buffers were compressed with, it is copied.
+ * @param t Type of compression logic to use.
+ *
+ * @return a dictionary for emile_expand_prepared() and
+ * emile_decompress_prepared(), @c NULL on failure.
+ *
+ * @since 1.24
+ */
+EAPI Emile_Compressor_Dictionary *emile_expand_dictionary_new(const Eina_Binbuf * dict, Emile_Compressor_Type t);
+
+/**
+ * @brief Free a prepared dictionary.
+ *
+ * @param d Dictionary to free, can be @c NULL.
+ *
+ * @since 1.24
+ */
+EAPI void emile_compressor_dictionary_free(Emile_Compressor_Dictionary * d);
+
+/**
+ * @brief Compress an Eina_Binbuf into a new Eina_Binbuf using a prepared dictionary.
+ *
+ * @param in Buffer to compress.
+ * @param d Dictionary from emile_compress_dictionary_new().
+ *
+ * @return On success it will return a buffer that contains
+ * the compressed data, @c NULL otherwise.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Binbuf *emile_compress_prepared(const Eina_Binbuf * in, const Emile_Compressor_Dictionary * d);
+
+/**
+ * @brief Uncompress a buffer into a newly allocated buffer using a prepared dictionary.
+ *
+ * @param in Buffer to uncompress.
+ * @param dest_length Expected length of the decompressed data.
+ * @param d Dictionary from emile_expand_dictionary_new().
+ *
+ * @return a newly allocated buffer with the uncompressed data,
+ * @c NULL if it failed.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Binbuf *emile_decompress_prepared(const Eina_Binbuf * in, unsigned int dest_length, const Emile_Compressor_Dictionary * d);
+
+/**
+ * @brief Uncompress a buffer into an existing buffer using a prepared dictionary.
+ *
+ * @param in Buffer to uncompress.
+ * @param out Buffer to expand data into.
+ * @param d Dictionary from emile_expand_dictionary_new().
+ *
+ * @return EINA_TRUE if it succeed, EINA_FALSE if it failed.
+ * @since 1.24
+ */
+EAPI Eina_Bool emile_expand_prepared(const Eina_Binbuf * in, Eina_Binbuf * out, const Emile_Compressor_Dictionary * d);
 /**
  * @}
  */
@@ -392,6 +392,482 @@ _tgv_length_get(const unsigned char *m,
    return r;
 }
 
+/* Decoded TGV macro blocks. The software engines want ARGB, which meant
+ * decoding every ETC block again on each load. Decoded macro blocks are
+ * kept here instead, looked up by the data they were decoded from, so
+ * that loading an image again, a region of it, or another image sharing
+ * the same blocks only has to copy pixels. */
+typedef struct _Emile_Tgv_Cached Emile_Tgv_Cached;
+struct _Emile_Tgv_Cached
+{
+   EINA_INLIST;
+
+   const unsigned char *data;
+   unsigned int         length;
+   unsigned int         hash;
+   unsigned int         block_width, block_height;
+   Emile_Colorspace     cspace;
+   /* Only the part of the macro block inside the image is decoded */
+   unsigned int         width, height;
+   uint32_t            *pixels;
+   int                  ref;
+
+   Eina_Bool            compress : 1;
+   Eina_Bool            dead : 1;
+};
+
+#define EMILE_TGV_CACHE_DEFAULT (4 * 1024 * 1024)
+#define EMILE_TGV_THREADS_MAX 8
+/* Below that many pixels, starting threads costs more than decoding */
+#define EMILE_TGV_THREADS_AREA (512 * 512)
+
+static Eina_Hash *_emile_tgv_cache = NULL;
+static Eina_Inlist *_emile_tgv_cache_lru = NULL;
+static Eina_Lock _emile_tgv_cache_lock;
+static unsigned int _emile_tgv_cache_size = 0;
+static unsigned int _emile_tgv_cache_max = EMILE_TGV_CACHE_DEFAULT;
+
+static unsigned int
+_emile_tgv_cached_key_length(const void *key EINA_UNUSED)
+{
+   return sizeof (Emile_Tgv_Cached);
+}
+
+static int
+_emile_tgv_cached_key_cmp(const void *key1, int key1_length EINA_UNUSED,
+                          const void *key2, int key2_length EINA_UNUSED)
+{
+   const Emile_Tgv_Cached *a = key1;
+   const Emile_Tgv_Cached *b = key2;
+
+   if (a->length != b->length) return a->length < b->length ? -1 : 1;
+   if (a->block_width != b->block_width) return a->block_width < b->block_width ? -1 : 1;
+   if (a->block_height != b->block_height) return a->block_height < b->block_height ? -1 : 1;
+   if (a->width != b->width) return a->width < b->width ? -1 : 1;
+   if (a->height != b->height) return a->height < b->height ? -1 : 1;
+   if (a->cspace != b->cspace) return a->cspace < b->cspace ? -1 : 1;
+   if (a->compress != b->compress) return a->compress ? 1 : -1;
+   return memcmp(a->data, b->data, a->length);
+}
+
+static int
+_emile_tgv_cached_key_hash(const void *key, int key_length EINA_UNUSED)
+{
+   return ((const Emile_Tgv_Cached *)key)->hash;
+}
+
+static inline unsigned int
+_emile_tgv_cached_size(const Emile_Tgv_Cached *cached)
+{
+   return sizeof (Emile_Tgv_Cached) +
+     cached->width * cached->height * sizeof (uint32_t) + cached->length;
+}
+
+/* Called with the lock held */
+static void
+_emile_tgv_cache_trim(void)
+{
+   while (_emile_tgv_cache_lru &&
+          (_emile_tgv_cache_size > _emile_tgv_cache_max))
+     {
+        Emile_Tgv_Cached *cached;
+
+        cached = EINA_INLIST_CONTAINER_GET(_emile_tgv_cache_lru, Emile_Tgv_Cached);
+        _emile_tgv_cache_lru = eina_inlist_remove(_emile_tgv_cache_lru,
+                                                  EINA_INLIST_GET(cached));
+        eina_hash_del(_emile_tgv_cache, cached, cached);
+        _emile_tgv_cache_size -= _emile_tgv_cached_size(cached);
+
+        /* Still being copied from, the last user frees it */
+        if (cached->ref) cached->dead = EINA_TRUE;
+        else free(cached);
+     }
+}
+
+static Emile_Tgv_Cached *
+_emile_tgv_cached_get(const Emile_Tgv_Cached *key)
+{
+   Emile_Tgv_Cached *cached;
+
+   eina_lock_take(&_emile_tgv_cache_lock);
+   cached = eina_hash_find(_emile_tgv_cache, key);
+   if (cached)
+     {
+        cached->ref++;
+        _emile_tgv_cache_lru = eina_inlist_demote(_emile_tgv_cache_lru,
+                                                  EINA_INLIST_GET(cached));
+     }
+   eina_lock_release(&_emile_tgv_cache_lock);
+
+   return cached;
+}
+
+/* Takes a freshly decoded block, referenced once by its caller. If it
+   does not make it into the cache, it stays dead and is freed on release. */
+static void
+_emile_tgv_cached_add(Emile_Tgv_Cached *cached)
+{
+   eina_lock_take(&_emile_tgv_cache_lock);
+   /* Another thread may have decoded the same data in the meantime */
+   if ((_emile_tgv_cached_size(cached) <= _emile_tgv_cache_max) &&
+       !eina_hash_find(_emile_tgv_cache, cached))
+     {
+        cached->dead = EINA_FALSE;
+        eina_hash_direct_add(_emile_tgv_cache, cached, cached);
+        _emile_tgv_cache_lru = eina_inlist_append(_emile_tgv_cache_lru,
+                                                  EINA_INLIST_GET(cached));
+        _emile_tgv_cache_size += _emile_tgv_cached_size(cached);
+        _emile_tgv_cache_trim();
+     }
+   eina_lock_release(&_emile_tgv_cache_lock);
+}
+
+static void
+_emile_tgv_cached_release(Emile_Tgv_Cached *cached)
+{
+   eina_lock_take(&_emile_tgv_cache_lock);
+   if ((--cached->ref == 0) && cached->dead)
+     free(cached);
+   eina_lock_release(&_emile_tgv_cache_lock);
+}
+
+Eina_Bool
+_emile_image_init(void)
+{
+   if (!eina_lock_new(&_emile_tgv_cache_lock))
+     return EINA_FALSE;
+
+   _emile_tgv_cache = eina_hash_new(_emile_tgv_cached_key_length,
+                                    _emile_tgv_cached_key_cmp,
+                                    _emile_tgv_cached_key_hash,
+                                    NULL, 8);
+   if (!_emile_tgv_cache)
+     {
+        eina_lock_free(&_emile_tgv_cache_lock);
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+void
+_emile_image_shutdown(void)
+{
+   Emile_Tgv_Cached *cached;
+
+   EINA_INLIST_FREE(_emile_tgv_cache_lru, cached)
+     {
+        _emile_tgv_cache_lru = eina_inlist_remove(_emile_tgv_cache_lru,
+                                                  EINA_INLIST_GET(cached));
+        free(cached);
+     }
+   eina_hash_free(_emile_tgv_cache);
+   _emile_tgv_cache = NULL;
+   _emile_tgv_cache_size = 0;
+   eina_lock_free(&_emile_tgv_cache_lock);
+}
+
+EAPI void
+emile_image_tgv_cache_size_set(unsigned int size)
+{
+   if (!_emile_tgv_cache)
+     {
+        _emile_tgv_cache_max = size;
+        return;
+     }
+
+   eina_lock_take(&_emile_tgv_cache_lock);
+   _emile_tgv_cache_max = size;
+   _emile_tgv_cache_trim();
+   eina_lock_release(&_emile_tgv_cache_lock);
+}
+
+EAPI unsigned int
+emile_image_tgv_cache_size_get(void)
+{
+   return _emile_tgv_cache_max;
+}
+
+/* Decodes the ETC blocks of a macro block that are inside clip, in macro
+   block coordinates, to ARGB pixels stride apart. */
+static void
+_emile_tgv_block_decode(Emile_Colorspace cspace,
+                        const unsigned char *it,
+                        unsigned int etc_block_size,
+                        unsigned int width, unsigned int height,
+                        const Eina_Rectangle *clip,
+                        uint32_t *pixels, unsigned int stride)
+{
+   unsigned int i, j;
+   int k;
+
+   for (i = 0; i < height; i += 4)
+     for (j = 0; j < width; j += 4, it += etc_block_size)
+       {
+          unsigned int temporary[4 * 4];
+          uint32_t *dst;
+
+          if (!RECTS_INTERSECT(j, i, 4, 4, clip->x, clip->y, clip->w, clip->h))
+            continue;
+
+          switch (cspace)
+            {
+             case EMILE_COLORSPACE_ETC1:
+             case EMILE_COLORSPACE_ETC1_ALPHA:
+               /* Still decoded, with clamping */
+               if (!rg_etc1_unpack_block(it, temporary, 0))
+                 fprintf(stderr, "ETC1: Block starting at {%i, %i} is corrupted!\n", j, i);
+               break;
+
+             case EMILE_COLORSPACE_RGB8_ETC2:
+               rg_etc2_rgb8_decode_block((uint8_t *)it, temporary);
+               break;
+
+             case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
+               rg_etc2_rgba8_decode_block((uint8_t *)it, temporary);
+               break;
+
+             default:
+               abort();
+            }
+
+          dst = pixels + i * stride + j;
+          for (k = 0; k < 4; k++)
+            memcpy(dst + k * stride, temporary + k * 4, 4 * sizeof (uint32_t));
+       }
+}
+
+typedef struct _Emile_Tgv_Job Emile_Tgv_Job;
+struct _Emile_Tgv_Job
+{
+   Emile_Image          *image;
+   Emile_Image_Property *prop;
+   const unsigned char **data;
+   unsigned int         *length;
+   unsigned char        *pixels;
+   Eina_Rectangle        master;
+   unsigned int          etc_block_size;
+   unsigned int          etc_width;
+   unsigned int          alpha_offset;
+   unsigned int          block_count;
+   unsigned int          columns;
+
+   Eina_Spinlock         lock;
+   unsigned int          first;
+   unsigned int          count;
+   unsigned int          next;
+   int                   plane;
+   Eina_Bool             cache;
+   Eina_Bool             failed;
+};
+
+static Eina_Bool
+_emile_tgv_job_block(Emile_Tgv_Job *job, unsigned int b,
+                     Eina_Binbuf *buffer, uint32_t *scratch)
+{
+   Emile_Image *image = job->image;
+   Emile_Tgv_Cached *cached = NULL;
+   const unsigned char *it;
+   const uint32_t *decoded;
+   Eina_Rectangle current;
+   unsigned int block_length;
+   unsigned int x, y, stride;
+   int k, l;
+
+   x = (b % job->columns) * image->block.width;
+   y = (b / job->columns) * image->block.height;
+   it = job->data[job->first + b];
+   block_length = job->length[job->first + b];
+
+   EINA_RECTANGLE_SET(&current,
+                      x, y,
+                      image->block.width, image->block.height);
+
+   if (!eina_rectangle_intersection(&current, &job->master))
+     return EINA_TRUE;
+
+   if (job->cache)
+     {
+        Emile_Tgv_Cached key;
+
+        key.data = it;
+        key.length = block_length;
+        key.block_width = image->block.width;
+        key.block_height = image->block.height;
+        key.cspace = image->cspace;
+        key.compress = image->compress;
+        /* The padded image, rounded to whole ETC blocks */
+        key.width = MIN(image->block.width,
+                        _roundup(image->size.width + 2, 4) - x);
+        key.height = MIN(image->block.height,
+                         _roundup(image->size.height + 2, 4) - y);
+        key.hash = eina_hash_superfast((const char *)it, block_length) ^
+          (key.width << 16) ^ key.height ^ (key.cspace << 8);
+
+        cached = _emile_tgv_cached_get(&key);
+        if (cached) goto copy;
+
+        cached = malloc(_emile_tgv_cached_size(&key));
+        if (cached)
+          {
+             *cached = key;
+             cached->pixels = (uint32_t *)(cached + 1);
+             cached->data = (const unsigned char *)(cached->pixels + key.width * key.height);
+             memcpy((unsigned char *)cached->data, it, block_length);
+             cached->ref = 1;
+             /* Not in the cache until decoded below */
+             cached->dead = EINA_TRUE;
+          }
+     }
+
+   if (image->compress)
+     {
+        Eina_Binbuf *data_start;
+        Eina_Bool expanded;
+
+        data_start = eina_binbuf_manage_new(it, block_length, EINA_TRUE);
+        expanded = emile_expand(data_start, buffer, EMILE_LZ4HC);
+        eina_binbuf_free(data_start);
+        if (!expanded) goto on_error;
+        it = eina_binbuf_string_get(buffer);
+     }
+   else if (job->block_count * job->etc_block_size != block_length)
+     {
+        goto on_error;
+     }
+
+   if (job->prop->cspace != EMILE_COLORSPACE_ARGB8888)
+     {
+        unsigned int i, j;
+
+        /* The GPU does the decoding, copy the ETC blocks as they are */
+        for (i = 0; i < image->block.height; i += 4)
+          for (j = 0; j < image->block.width; j += 4, it += job->etc_block_size)
+            {
+               Eina_Rectangle current_etc;
+
+               EINA_RECTANGLE_SET(&current_etc, x + j, y + i, 4, 4);
+
+               if (!eina_rectangle_intersection(&current_etc, &current))
+                 continue;
+
+               memcpy(&job->pixels[(current_etc.x / 4) * job->etc_block_size +
+                                   (current_etc.y / 4) * job->etc_width +
+                                   job->plane * job->alpha_offset],
+                      it,
+                      job->etc_block_size);
+            }
+        return EINA_TRUE;
+     }
+
+   if (cached)
+     {
+        Eina_Rectangle all = { 0, 0, cached->width, cached->height };
+
+        _emile_tgv_block_decode(image->cspace, it, job->etc_block_size,
+                                image->block.width, image->block.height,
+                                &all, cached->pixels, cached->width);
+        _emile_tgv_cached_add(cached);
+     }
+   else
+     {
+        Eina_Rectangle clip = { current.x - x, current.y - y, current.w, current.h };
+
+        _emile_tgv_block_decode(image->cspace, it, job->etc_block_size,
+                                image->block.width, image->block.height,
+                                &clip, scratch, image->block.width);
+     }
+
+ copy:
+   stride = cached ? cached->width : image->block.width;
+   decoded = cached ? cached->pixels : scratch;
+   decoded += (current.x - x) + (current.y - y) * stride;
+
+   for (k = 0; k < current.h; k++)
+     {
+        uint32_t *p = (uint32_t *)job->pixels;
+        const uint32_t *src = decoded + k * stride;
+
+        p += (current.x - job->master.x) +
+          (current.y - job->master.y + k) * job->master.w;
+        if (!job->plane)
+          {
+             memcpy(p, src, current.w * sizeof (uint32_t));
+          }
+        else
+          {
+             for (l = 0; l < current.w; l++)
+               A_VAL(p + l) = G_VAL(src + l);
+          }
+     }
+
+   if (cached) _emile_tgv_cached_release(cached);
+   return EINA_TRUE;
+
+ on_error:
+   if (cached) _emile_tgv_cached_release(cached);
+   return EINA_FALSE;
+}
+
+/* Run by the loading thread and the workers, each macro block writes its
+   own part of the destination. */
+static void
+_emile_tgv_job_run(Emile_Tgv_Job *job)
+{
+   Eina_Binbuf *buffer = NULL;
+   unsigned char *expanded = NULL;
+   uint32_t *scratch = NULL;
+
+   if (job->image->compress)
+     {
+        expanded = malloc(job->etc_block_size * job->block_count);
+        if (expanded)
+          buffer = eina_binbuf_manage_new(expanded,
+                                          job->etc_block_size * job->block_count,
+                                          EINA_TRUE);
+        if (!buffer) goto on_error;
+     }
+   if (job->prop->cspace == EMILE_COLORSPACE_ARGB8888)
+     {
+        scratch = malloc(job->image->block.width * job->image->block.height *
+                         sizeof (uint32_t));
+        if (!scratch) goto on_error;
+     }
+
+   while (1)
+     {
+        unsigned int b;
+
+        eina_spinlock_take(&job->lock);
+        b = job->next++;
+        if (job->failed) b = job->count;
+        eina_spinlock_release(&job->lock);
+        if (b >= job->count) break;
+
+        if (!_emile_tgv_job_block(job, b, buffer, scratch))
+          goto on_error;
+     }
+
+   goto end;
+
+ on_error:
+   eina_spinlock_take(&job->lock);
+   job->failed = EINA_TRUE;
+   eina_spinlock_release(&job->lock);
+
+ end:
+   eina_binbuf_free(buffer);
+   free(expanded);
+   free(scratch);
+}
+
+static void *
+_emile_tgv_job_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   _emile_tgv_job_run(data);
+   return NULL;
+}
+
 static Eina_Bool
 _emile_tgv_data(Emile_Image *image,
                 Emile_Image_Property *prop,
@@ -400,17 +876,12 @@ _emile_tgv_data(Emile_Image *image,
                 Emile_Image_Load_Error *error)
 {
    const unsigned char *m;
-   unsigned int *p = pixels;
-   unsigned char *p_etc = pixels;
-   Eina_Binbuf *buffer = NULL;
-   Eina_Rectangle master;
-   unsigned int block_length;
+   Emile_Tgv_Job job;
+   Eina_Thread *threads = NULL;
    unsigned int length, offset;
-   unsigned int x, y;
-   unsigned int block_count;
-   unsigned int etc_width = 0;
-   unsigned int etc_block_size;
-   int num_planes = 1, plane, alpha_offset = 0;
+   unsigned int rows, total, i;
+   int num_planes = 1, plane;
+   int wanted = 0, created;
    Eina_Bool r = EINA_FALSE;
 
    m = _emile_image_file_source_map(image, &length);
@@ -423,12 +894,17 @@ _emile_tgv_data(Emile_Image *image,
    if (sizeof(Emile_Image_Property) != property_size)
      return EINA_FALSE;
 
+   memset(&job, 0, sizeof (job));
+   job.image = image;
+   job.prop = prop;
+   job.pixels = pixels;
+
    offset = OFFSET_BLOCKS;
 
    *error = EMILE_IMAGE_LOAD_ERROR_CORRUPT_FILE;
 
    /* By definition, prop{.w, .h} == region{.w, .h} */
-   EINA_RECTANGLE_SET(&master,
+   EINA_RECTANGLE_SET(&job.master,
                       image->region.x, image->region.y,
                       prop->w, prop->h);
 
@@ -436,23 +912,23 @@ _emile_tgv_data(Emile_Image *image,
      {
       case EMILE_COLORSPACE_ETC1:
       case EMILE_COLORSPACE_RGB8_ETC2:
-        etc_block_size = 8;
+        job.etc_block_size = 8;
         break;
 
       case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
-        etc_block_size = 16;
+        job.etc_block_size = 16;
         break;
 
       case EMILE_COLORSPACE_ETC1_ALPHA:
-        etc_block_size = 8;
+        job.etc_block_size = 8;
         num_planes = 2;
-        alpha_offset = ((prop->w + 2 + 3) / 4) * ((prop->h + 2 + 3) / 4) * 8 / sizeof(*p_etc);
+        job.alpha_offset = ((prop->w + 2 + 3) / 4) * ((prop->h + 2 + 3) / 4) * 8;
         break;
 
       default:
         abort();
      }
-   etc_width = ((prop->w + 2 + 3) / 4) * etc_block_size;
+   job.etc_width = ((prop->w + 2 + 3) / 4) * job.etc_block_size;
 
    switch (prop->cspace)
      {
@@ -460,15 +936,15 @@ _emile_tgv_data(Emile_Image *image,
       case EMILE_COLORSPACE_RGB8_ETC2:
       case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
       case EMILE_COLORSPACE_ETC1_ALPHA:
-        if (master.x % 4 || master.y % 4)
+        if (job.master.x % 4 || job.master.y % 4)
           // FIXME: Should we really abort here ? Seems like a late check for me
           abort();
         break;
 
       case EMILE_COLORSPACE_ARGB8888:
         /* Offset to take duplicated pixels into account */
-        master.x += 1;
-        master.y += 1;
+        job.master.x += 1;
+        job.master.y += 1;
         break;
 
       default:
@@ -487,173 +963,78 @@ _emile_tgv_data(Emile_Image *image,
         /* else: ETC2 is compatible with ETC1 and is preferred */
      }
 
-   /* Allocate space for each ETC block (8 or 16 bytes per 4 * 4 pixels group) */
-   block_count = image->block.width * image->block.height / (4 * 4);
-   if (image->compress)
-     buffer = eina_binbuf_manage_new(alloca(etc_block_size * block_count),
-                                     etc_block_size * block_count,
-                                     EINA_TRUE);
-
-   for (plane = 0; plane < num_planes; plane++)
-     for (y = 0; y < image->size.height + 2; y += image->block.height)
-       for (x = 0; x < image->size.width + 2; x += image->block.width)
-         {
-            Eina_Rectangle current;
-            Eina_Binbuf *data_start;
-            const unsigned char *it;
-            unsigned int i, j;
-
-            block_length = _tgv_length_get(m + offset, length, &offset);
-
-            if (block_length == 0)
-              {
-                 *error = EMILE_IMAGE_LOAD_ERROR_CORRUPT_FILE;
-                 goto on_error;
-              }
-
-            data_start = eina_binbuf_manage_new(m + offset,
-                                                block_length,
-                                                EINA_TRUE);
-            offset += block_length;
-
-            EINA_RECTANGLE_SET(&current,
-                               x, y,
-                               image->block.width, image->block.height);
-
-            if (!eina_rectangle_intersection(&current, &master))
-              {
-                 eina_binbuf_free(data_start);
-                 continue;
-              }
-
-            if (image->compress)
-              {
-                 if (!emile_expand(data_start, buffer, EMILE_LZ4HC))
-                   {
-                      eina_binbuf_free(data_start);
-                      goto on_error;
-                   }
-              }
-            else
-              {
-                 buffer = data_start;
-                 if (block_count * etc_block_size != block_length)
-                   {
-                      eina_binbuf_free(data_start);
-                      goto on_error;
-                   }
-              }
-            it = eina_binbuf_string_get(buffer);
-
-            for (i = 0; i < image->block.height; i += 4)
-              for (j = 0; j < image->block.width; j += 4, it += etc_block_size)
-                {
-                   Eina_Rectangle current_etc;
-                   unsigned int temporary[4 * 4];
-                   unsigned int offset_x, offset_y;
-                   int k, l;
-
-                   EINA_RECTANGLE_SET(&current_etc, x + j, y + i, 4, 4);
-
-                   if (!eina_rectangle_intersection(&current_etc, &current))
-                     continue;
-
-                   switch (prop->cspace)
-                     {
-                      case EMILE_COLORSPACE_ARGB8888:
-                        switch (image->cspace)
-                          {
-                           case EMILE_COLORSPACE_ETC1:
-                           case EMILE_COLORSPACE_ETC1_ALPHA:
-                             if (!rg_etc1_unpack_block(it, temporary, 0))
-                               {
-                                  // TODO: Should we decode as RGB8_ETC2?
-                                  fprintf(stderr, "ETC1: Block starting at {%i, %i} is corrupted!\n", x + j, y + i);
-                                  continue;
-                               }
-                             break;
+   /* Number of ETC blocks (8 or 16 bytes per 4 * 4 pixels group) in a macro block */
+   job.block_count = image->block.width * image->block.height / (4 * 4);
 
-                           case EMILE_COLORSPACE_RGB8_ETC2:
-                             rg_etc2_rgb8_decode_block((uint8_t *)it, temporary);
-                             break;
+   /* Find where every macro block starts first, so that they can be
+      decoded in any order */
+   job.columns = (image->size.width + 2 + image->block.width - 1) / image->block.width;
+   rows = (image->size.height + 2 + image->block.height - 1) / image->block.height;
+   total = job.columns * rows * num_planes;
 
-                           case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
-                             rg_etc2_rgba8_decode_block((uint8_t *)it, temporary);
-                             break;
+   job.data = malloc(total * sizeof (const unsigned char *));
+   job.length = malloc(total * sizeof (unsigned int));
+   if (!job.data || !job.length)
+     {
+        *error = EMILE_IMAGE_LOAD_ERROR_RESOURCE_ALLOCATION_FAILED;
+        goto on_error;
+     }
 
-                           default:
-                             abort();
-                          }
+   for (i = 0; i < total; i++)
+     {
+        unsigned int block_length;
 
-                        offset_x = current_etc.x - x - j;
-                        offset_y = current_etc.y - y - i;
+        block_length = _tgv_length_get(m + offset, length, &offset);
+        if ((block_length == 0) || (block_length > length - offset))
+          goto on_error;
 
-                        if (!plane)
-                          {
-#ifdef BUILD_NEON
-                             if (eina_cpu_features_get() & EINA_CPU_NEON)
-                               {
-                                  uint32_t *dst = &p[current_etc.x - 1 + (current_etc.y - 1) * master.w];
-                                  uint32_t *src = &temporary[offset_x + offset_y * 4];
-                                  for (k = 0; k < current_etc.h; k++)
-                                    {
-                                       if (current_etc.w == 4)
-                                         vst1q_u32(dst, vld1q_u32(src));
-                                       else if (current_etc.w == 3)
-                                         {
-                                            vst1_u32(dst, vld1_u32(src));
-                                            *(dst + 2) = *(src + 2);
-                                         }
-                                       else if (current_etc.w == 2)
-                                         vst1_u32(dst, vld1_u32(src));
-                                       else
-                                         *dst = *src;
-                                       dst += master.w;
-                                       src += 4;
-                                    }
-                               }
-                             else
-#endif
-                             for (k = 0; k < current_etc.h; k++)
-                               {
-                                  memcpy(&p[current_etc.x - 1 + (current_etc.y - 1 + k) * master.w],
-                                         &temporary[offset_x + (offset_y + k) * 4],
-                                         current_etc.w * sizeof(unsigned int));
-                               }
-                          }
-                        else
-                          {
-                             for (k = 0; k < current_etc.h; k++)
-                               for (l = 0; l < current_etc.w; l++)
-                                 {
-                                    unsigned int *rgbdata = &p[current_etc.x - 1 + (current_etc.y - 1 + k) * master.w + l];
-                                    unsigned int *adata = &temporary[offset_x + (offset_y + k) * 4 + l];
-                                    A_VAL(rgbdata) = G_VAL(adata);
-                                 }
-                          }
-                        break;
-
-                      case EMILE_COLORSPACE_ETC1:
-                      case EMILE_COLORSPACE_RGB8_ETC2:
-                      case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
-                        memcpy(&p_etc[(current_etc.x / 4) * etc_block_size + (current_etc.y / 4) * etc_width],
-                               it,
-                               etc_block_size);
-                        break;
-
-                      case EMILE_COLORSPACE_ETC1_ALPHA:
-                        memcpy(&p_etc[(current_etc.x / 4) * etc_block_size + (current_etc.y / 4) * etc_width + plane * alpha_offset],
-                               it,
-                               etc_block_size);
-                        break;
-
-                      default:
-                        abort();
-                     }
-                } /* bx,by inside blocks */
-
-            eina_binbuf_free(data_start);
-         } /* x,y macroblocks */
+        job.data[i] = m + offset;
+        job.length[i] = block_length;
+        offset += block_length;
+     }
+
+   if (!eina_spinlock_new(&job.lock))
+     {
+        *error = EMILE_IMAGE_LOAD_ERROR_RESOURCE_ALLOCATION_FAILED;
+        goto on_error;
+     }
+
+   /* Only worth it if the whole image can stay in the cache */
+   job.cache = (prop->cspace == EMILE_COLORSPACE_ARGB8888) && _emile_tgv_cache &&
+     ((unsigned long long)prop->w * prop->h * sizeof (uint32_t) * num_planes <=
+      _emile_tgv_cache_max);
+
+   /* Copying ETC blocks is fast enough as is */
+   if ((prop->cspace == EMILE_COLORSPACE_ARGB8888) &&
+       (prop->w * prop->h >= EMILE_TGV_THREADS_AREA))
+     {
+        wanted = eina_cpu_count();
+        if (wanted > EMILE_TGV_THREADS_MAX) wanted = EMILE_TGV_THREADS_MAX;
+        if (wanted > (int)(total / num_planes)) wanted = total / num_planes;
+        wanted--;
+        if (wanted > 0)
+          threads = malloc(wanted * sizeof (Eina_Thread));
+     }
+
+   /* The alpha plane goes into the pixels written by the first one */
+   for (plane = 0; plane < num_planes && !job.failed; plane++)
+     {
+        job.plane = plane;
+        job.first = plane * job.columns * rows;
+        job.count = job.columns * rows;
+        job.next = 0;
+
+        created = 0;
+        for (; threads && created < wanted; created++)
+          if (!eina_thread_create(&threads[created], EINA_THREAD_NORMAL, -1,
+                                  _emile_tgv_job_thread, &job))
+            break;
+        _emile_tgv_job_run(&job);
+        for (i = 0; i < (unsigned int)created; i++)
+          eina_thread_join(threads[i]);
+     }
+   eina_spinlock_free(&job.lock);
+   if (job.failed) goto on_error;
 
    // TODO: Add support for more unpremultiplied modes (ETC2)
    if (prop->cspace == EMILE_COLORSPACE_ARGB8888)
@@ -663,7 +1044,9 @@ _emile_tgv_data(Emile_Image *image,
    r = EINA_TRUE;
 
 on_error:
-   if (image->compress) eina_binbuf_free(buffer);
+   free(threads);
+   free(job.data);
+   free(job.length);
    _emile_image_file_source_unmap(image);
    return r;
 }
@@ -60,7 +60,8 @@ typedef enum _Emile_Image_Encoding
   EMILE_IMAGE_ETC1 = 2,
   EMILE_IMAGE_ETC2_RGB = 3,
   EMILE_IMAGE_ETC2_RGBA = 4,
-  EMILE_IMAGE_ETC1_ALPHA = 5
+  EMILE_IMAGE_ETC1_ALPHA = 5,
+  EMILE_IMAGE_LOSSLESS_PREDICTED = 6 /**< Lossless, predicted from the neighbour pixels then compressed. Faster to decode than PNG. @since 1.24 */
 } Emile_Image_Encoding;
 
 /**
@@ -345,6 +346,29 @@ EAPI void emile_image_close(Emile_Image * source);
  */
 EAPI const char *emile_load_error_str(Emile_Image * source, Emile_Image_Load_Error error);
 
+/**
+ * Set how much memory decoded TGV blocks can keep.
+ *
+ * @param size The size in bytes, 0 disables the cache.
+ *
+ * When TGV images are loaded as ARGB, their ETC blocks are decoded on
+ * the CPU. The decoded blocks are kept and found again by their content,
+ * so that loading an image again, or a region of it, only copies pixels.
+ * The default is 4 MB.
+ *
+ * @since 1.24
+ */
+EAPI void emile_image_tgv_cache_size_set(unsigned int size);
+
+/**
+ * Get how much memory decoded TGV blocks can keep.
+ *
+ * @return The size in bytes.
+ *
+ * @since 1.24
+ */
+EAPI unsigned int emile_image_tgv_cache_size_get(void);
+
 /**
  * @}
  */
@@ -3,6 +3,8 @@
 
 #include "evas_vg_private.h"
 
+#include <Ecore.h>
+
 #define MY_CLASS EFL_CANVAS_VG_OBJECT_CLASS
 
 /* private magic number for vector objects */
@@ -28,6 +30,7 @@ static int _efl_canvas_vg_object_is_opaque(Evas_Object *eo_obj,
 static int _efl_canvas_vg_object_was_opaque(Evas_Object *eo_obj,
                                             Evas_Object_Protected_Data *obj,
                                             void *type_private_data);
+static void _frame_cache_render_post(void *data, const Efl_Event *event);
 
 static const Evas_Object_Func object_func =
 {
@@ -90,6 +93,65 @@ _update_vgtree_viewport(Eo *obj, Efl_Canvas_Vg_Object_Data *pd)
    evas_object_change(obj, efl_data_scope_get(obj, EFL_CANVAS_OBJECT_CLASS));
 }
 
+/* Frames of an animation kept compressed at the object size, in the
+   EFL_CANVAS_VG_FRAME_CACHE_MODE_ALL mode. A single surface is used to draw
+   them: a frame is either expanded or rendered into it. */
+struct _Vg_Frame_Cache
+{
+   Eina_Binbuf         **frames;   //compressed pixels, by frame index
+   unsigned int          count;
+   unsigned int          size;     //compressed bytes held
+   int                   w, h;
+   void                 *surface;
+   int                   pending;  //frame drawn in surface by this render
+   int                   next;     //next frame to render while idle
+   Ecore_Idler          *idler;
+
+   Eina_Bool             full : 1;
+};
+
+//compressed bytes held by all the frame caches.
+static unsigned int _frame_cache_used = 0;
+
+static unsigned int
+_frame_cache_budget_get(void)
+{
+   static int budget = -1;
+
+   //In KB, shared by all the vector objects.
+   if (budget < 0)
+     {
+        const char *s = getenv("EVAS_VG_FRAME_CACHE_SIZE");
+
+        budget = s ? atoi(s) : (32 * 1024);
+        if (budget < 0) budget = 0;
+     }
+
+   return (unsigned int) budget * 1024;
+}
+
+static void
+_frame_cache_free(Efl_Canvas_Vg_Object_Data *pd)
+{
+   Vg_Frame_Cache *fc = pd->frame_cache;
+   Evas_Object_Protected_Data *obj = pd->obj;
+   unsigned int i;
+
+   if (!fc) return;
+
+   efl_event_callback_del(obj->layer->evas->evas,
+                          EFL_CANVAS_SCENE_EVENT_RENDER_POST,
+                          _frame_cache_render_post, pd);
+   if (fc->idler) ecore_idler_del(fc->idler);
+   for (i = 0; i < fc->count; i++)
+     if (fc->frames[i]) eina_binbuf_free(fc->frames[i]);
+   _frame_cache_used -= fc->size;
+   if (fc->surface) ENFN->ector_surface_destroy(ENC, fc->surface);
+   free(fc->frames);
+   free(fc);
+   pd->frame_cache = NULL;
+}
+
 static void
 _evas_vg_resize(void *data, const Efl_Event *ev)
 {
@@ -189,6 +251,22 @@ _efl_canvas_vg_object_fill_mode_get(const Eo *obj EINA_UNUSED, Efl_Canvas_Vg_Obj
    return pd->fill_mode;
 }
 
+EOLIAN static void
+_efl_canvas_vg_object_frame_cache_mode_set(Eo *obj EINA_UNUSED, Efl_Canvas_Vg_Object_Data *pd, Efl_Canvas_Vg_Frame_Cache_Mode mode)
+{
+   if (pd->frame_cache_mode == mode) return;
+
+   pd->frame_cache_mode = mode;
+   if (mode != EFL_CANVAS_VG_FRAME_CACHE_MODE_ALL)
+     _frame_cache_free(pd);
+}
+
+EOLIAN static Efl_Canvas_Vg_Frame_Cache_Mode
+_efl_canvas_vg_object_frame_cache_mode_get(const Eo *obj EINA_UNUSED, Efl_Canvas_Vg_Object_Data *pd)
+{
+   return pd->frame_cache_mode;
+}
+
 EOLIAN static void
 _efl_canvas_vg_object_viewbox_set(Eo *obj, Efl_Canvas_Vg_Object_Data *pd, Eina_Rect viewbox)
 {
@@ -259,6 +337,7 @@ _efl_canvas_vg_object_efl_file_file_set(Eo *eo_obj, Efl_Canvas_Vg_Object_Data *p
           {
              Evas_Object_Protected_Data *obj;
              obj = efl_data_scope_get(eo_obj, EFL_CANVAS_OBJECT_CLASS);
+             _frame_cache_free(pd);
              evas_cache_vg_entry_del(pd->vg_entry);
              evas_object_change(eo_obj, obj);
              pd->vg_entry = NULL;
@@ -306,6 +385,7 @@ _efl_canvas_vg_object_efl_file_unload(Eo *eo_obj, Efl_Canvas_Vg_Object_Data *pd)
 
    Evas_Object_Protected_Data *obj;
    obj = efl_data_scope_get(eo_obj, EFL_CANVAS_OBJECT_CLASS);
+   _frame_cache_free(pd);
    evas_cache_vg_entry_del(pd->vg_entry);
    evas_object_change(eo_obj, obj);
    pd->vg_entry = NULL;
@@ -352,6 +432,7 @@ _efl_canvas_vg_object_efl_object_invalidate(Eo *eo_obj, Efl_Canvas_Vg_Object_Dat
         free(pd->user_entry);
      }
    pd->user_entry = NULL;
+   _frame_cache_free(pd);
    evas_cache_vg_entry_del(pd->vg_entry);
 
    efl_invalidate(efl_super(eo_obj, MY_CLASS));
@@ -574,6 +655,217 @@ _render_buffer_to_screen(Evas_Object_Protected_Data *obj,
    if (!cacheable) ENFN->ector_surface_destroy(engine, buffer);
 }
 
+//keeps the frame rendered in the cache surface, once its drawing is done.
+static void
+_frame_cache_store(Evas_Object_Protected_Data *obj, Vg_Frame_Cache *fc)
+{
+   Eina_Binbuf *in, *out;
+   DATA32 *pixels = NULL;
+   int idx = fc->pending;
+   int err = 0;
+
+   if (idx < 0) return;
+   fc->pending = -1;
+   if (fc->frames[idx] || fc->full) return;
+
+   ENFN->image_data_get(ENC, fc->surface, 0, &pixels, &err, NULL);
+   if (!pixels) return;
+
+   in = eina_binbuf_manage_new((unsigned char *) pixels, fc->w * fc->h * 4, EINA_TRUE);
+   out = emile_compress(in, EMILE_LZ4, EMILE_COMPRESSOR_FAST);
+   eina_binbuf_free(in);
+   if (!out) return;
+
+   //Out of budget, the other frames keep being rendered when shown.
+   if (_frame_cache_used + eina_binbuf_length_get(out) > _frame_cache_budget_get())
+     {
+        eina_binbuf_free(out);
+        fc->full = EINA_TRUE;
+        return;
+     }
+
+   fc->frames[idx] = out;
+   fc->size += eina_binbuf_length_get(out);
+   _frame_cache_used += eina_binbuf_length_get(out);
+}
+
+static Eina_Bool
+_frame_cache_expand(Evas_Object_Protected_Data *obj, Vg_Frame_Cache *fc,
+                    void *engine, int idx)
+{
+   Eina_Binbuf *out;
+   DATA32 *pixels = NULL;
+   void *image;
+   Eina_Bool ret;
+   int err = 0;
+
+   image = ENFN->image_data_get(engine, fc->surface, 1, &pixels, &err, NULL);
+   if (!image || !pixels) return EINA_FALSE;
+   fc->surface = image;
+
+   out = eina_binbuf_manage_new((unsigned char *) pixels, fc->w * fc->h * 4, EINA_TRUE);
+   ret = emile_expand(fc->frames[idx], out, EMILE_LZ4);
+   eina_binbuf_free(out);
+
+   fc->surface = ENFN->image_data_put(engine, fc->surface, pixels);
+   ENFN->image_dirty_region(engine, fc->surface, 0, 0, fc->w, fc->h);
+
+   return ret;
+}
+
+//renders the frames not kept yet, one by one while the main loop is idle.
+static Eina_Bool
+_frame_cache_idler(void *data)
+{
+   Efl_Canvas_Vg_Object_Data *pd = data;
+   Vg_Frame_Cache *fc = pd->frame_cache;
+   Evas_Object_Protected_Data *obj = pd->obj;
+   Efl_VG *root;
+   unsigned int i;
+   int idx = -1;
+
+   //The surface is in use by the render thread, try again after.
+   if (obj->layer->evas->rendering || fc->full)
+     {
+        fc->idler = NULL;
+        return ECORE_CALLBACK_CANCEL;
+     }
+
+   for (i = 0; i < fc->count; i++)
+     {
+        int n = (fc->next + i) % fc->count;
+
+        if (!fc->frames[n])
+          {
+             idx = n;
+             break;
+          }
+     }
+   if (idx < 0)
+     {
+        fc->full = EINA_TRUE;
+        fc->idler = NULL;
+        return ECORE_CALLBACK_CANCEL;
+     }
+   fc->next = (idx + 1) % fc->count;
+
+   root = evas_cache_vg_tree_get(pd->vg_entry, idx);
+   if (!root ||
+       !_render_to_buffer(obj, pd, ENC, root, fc->w, fc->h, fc->surface,
+                          NULL, EINA_FALSE))
+     {
+        fc->idler = NULL;
+        return ECORE_CALLBACK_CANCEL;
+     }
+   fc->pending = idx;
+   _frame_cache_store(obj, fc);
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void
+_frame_cache_render_post(void *data, const Efl_Event *event EINA_UNUSED)
+{
+   Efl_Canvas_Vg_Object_Data *pd = data;
+   Vg_Frame_Cache *fc = pd->frame_cache;
+
+   if (!fc) return;
+
+   _frame_cache_store(pd->obj, fc);
+   if (!fc->idler && !fc->full)
+     fc->idler = ecore_idler_add(_frame_cache_idler, pd);
+}
+
+static Vg_Frame_Cache *
+_frame_cache_get(Evas_Object_Protected_Data *obj, Efl_Canvas_Vg_Object_Data *pd,
+                 void *engine, int w, int h)
+{
+   Vg_Frame_Cache *fc = pd->frame_cache;
+   unsigned int count;
+   int error = 0;
+
+   count = evas_cache_vg_anim_frame_count_get(pd->vg_entry);
+   if (fc && (fc->w == w) && (fc->h == h) && (fc->count == count))
+     return fc;
+
+   //Size is changed, the kept frames are invalid.
+   _frame_cache_free(pd);
+   if (count < 2) return NULL;
+
+   fc = calloc(1, sizeof(Vg_Frame_Cache));
+   if (!fc) return NULL;
+   fc->frames = calloc(count, sizeof(Eina_Binbuf *));
+   fc->surface = ENFN->ector_surface_create(engine, w, h, &error);
+   if (!fc->frames || !fc->surface || error)
+     {
+        if (fc->surface) ENFN->ector_surface_destroy(engine, fc->surface);
+        free(fc->frames);
+        free(fc);
+        return NULL;
+     }
+   fc->count = count;
+   fc->w = w;
+   fc->h = h;
+   fc->pending = -1;
+   pd->frame_cache = fc;
+
+   efl_event_callback_add(obj->layer->evas->evas,
+                          EFL_CANVAS_SCENE_EVENT_RENDER_POST,
+                          _frame_cache_render_post, pd);
+
+   return fc;
+}
+
+//draws the current frame from the frame cache, rendering it if not kept yet.
+static Eina_Bool
+_frame_cache_render(Evas_Object_Protected_Data *obj,
+                    Efl_Canvas_Vg_Object_Data *pd,
+                    void *engine, void *output, void *context, void *surface,
+                    int x, int y, int w, int h, Eina_Bool do_async)
+{
+   Vg_Frame_Cache *fc;
+   Efl_VG *root;
+   int idx = pd->frame_idx;
+
+   fc = _frame_cache_get(obj, pd, engine, w, h);
+   if (!fc || (idx < 0) || (idx >= (int) fc->count)) return EINA_FALSE;
+
+   //Another update region of this render: the surface is drawn already,
+   //or queued to the render thread. It is only kept on render post.
+   if (fc->pending == idx)
+     {
+        _render_buffer_to_screen(obj,
+                                 engine, output, context, surface,
+                                 fc->surface,
+                                 x, y, w, h,
+                                 do_async, EINA_TRUE);
+        return EINA_TRUE;
+     }
+   fc->pending = -1;
+
+   if (fc->frames[idx])
+     {
+        if (!_frame_cache_expand(obj, fc, engine, idx)) return EINA_FALSE;
+     }
+   else
+     {
+        root = evas_cache_vg_tree_get(pd->vg_entry, idx);
+        if (!root) return EINA_FALSE;
+        if (!_render_to_buffer(obj, pd, engine, root, w, h, fc->surface,
+                               NULL, do_async))
+          return EINA_FALSE;
+     }
+   //Expanded or rendered once per render, the other regions reuse it.
+   fc->pending = idx;
+
+   _render_buffer_to_screen(obj,
+                            engine, output, context, surface,
+                            fc->surface,
+                            x, y, w, h,
+                            do_async, EINA_TRUE);
+   return EINA_TRUE;
+}
+
 static void
 _cache_vg_entry_render(Evas_Object_Protected_Data *obj,
                        Efl_Canvas_Vg_Object_Data *pd,
@@ -651,6 +943,12 @@ _cache_vg_entry_render(Evas_Object_Protected_Data *obj,
         w = size.w;
         h = size.h;
      }
+
+   if ((pd->frame_cache_mode == EFL_CANVAS_VG_FRAME_CACHE_MODE_ALL) &&
+       _frame_cache_render(obj, pd, engine, output, context, surface,
+                           x + offset.x, y + offset.y, w, h, do_async))
+     return;
+
    root = evas_cache_vg_tree_get(vg_entry, pd->frame_idx);
    if (!root) return;
 
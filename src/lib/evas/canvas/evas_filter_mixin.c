@@ -52,7 +52,10 @@ struct _Evas_Object_Filter_Data
 
 struct _Evas_Filter_Data
 {
+   EINA_INLIST; // Output cache LRU
    const Evas_Object_Filter_Data *data;
+   size_t output_size;
+   Eina_Bool output_cached : 1;
 };
 
 struct _Evas_Filter_Post_Render_Data
@@ -70,12 +73,32 @@ static const Evas_Object_Filter_Data evas_filter_data_cow_default = {
 };
 Eina_Cow *evas_object_filter_cow = NULL;
 
+/* Filter output cache
+ *
+ * The output of the last filter run is kept with the object and drawn again
+ * as a plain image as long as the object's content, filter program, state
+ * and size don't change, eg. when it only moves. Outputs of hidden objects
+ * count against a global budget (in KB, EVAS_FILTER_CACHE) and the least
+ * recently drawn ones get dropped first.
+ */
+#define FILTER_OUTPUT_CACHE_DEFAULT (32 * 1024 * 1024)
+
+static Eina_Inlist *_filter_outputs = NULL;
+static size_t _filter_outputs_usage = 0;
+static size_t _filter_outputs_size = FILTER_OUTPUT_CACHE_DEFAULT;
+
 void
 evas_filter_mixin_init(void)
 {
+   const char *s;
+
    evas_object_filter_cow = eina_cow_add
          ("Evas Filter Data", sizeof(Evas_Object_Filter_Data), 8,
           &evas_filter_data_cow_default, EINA_TRUE);
+
+   s = getenv("EVAS_FILTER_CACHE");
+   if (s) _filter_outputs_size = (size_t) MAX(atoi(s), 0) * 1024;
+   else _filter_outputs_size = FILTER_OUTPUT_CACHE_DEFAULT;
 }
 
 void
@@ -94,6 +117,73 @@ _state_check(Evas_Object_Filter_Data *fcow)
      fcow->state.next.name = eina_stringshare_add("default");
 }
 
+static void
+_filter_output_cache_del(Evas_Filter_Data *pd)
+{
+   if (!pd->output_cached) return;
+
+   _filter_outputs = eina_inlist_remove(_filter_outputs, EINA_INLIST_GET(pd));
+   _filter_outputs_usage -= pd->output_size;
+   pd->output_size = 0;
+   pd->output_cached = EINA_FALSE;
+}
+
+static void
+_filter_output_free(Evas_Filter_Data *pd)
+{
+   Evas_Object_Protected_Data *obj = pd->data->obj;
+   Evas_Object_Filter_Data *fcow;
+
+   _filter_output_cache_del(pd);
+   if (!pd->data->output) return;
+
+   if (!pd->data->async)
+     ENFN->image_free(ENC, pd->data->output);
+   else
+     evas_unref_queue_image_put(obj->layer->evas, pd->data->output);
+   FCOW_WRITE(pd, output, NULL);
+}
+
+static void
+_filter_output_cache_trim(void)
+{
+   Eina_Inlist *l;
+
+   l = _filter_outputs ? _filter_outputs->last : NULL;
+   while (l && (_filter_outputs_usage > _filter_outputs_size))
+     {
+        Evas_Filter_Data *pd = EINA_INLIST_CONTAINER_GET(l, Evas_Filter_Data);
+        Evas_Object_Protected_Data *obj = pd->data->obj;
+
+        l = l->prev;
+
+        // Outputs of visible objects and proxy sources are used directly
+        // (drawing, proxies, pointer checks), those have to stay around.
+        if (obj->cur->visible || obj->proxy->proxies) continue;
+
+        DBG("Dropping filter output of %p (%zu bytes)", obj->object, pd->output_size);
+        _filter_output_free(pd);
+     }
+}
+
+static void
+_filter_output_cache_add(Evas_Filter_Data *pd)
+{
+   Evas_Object_Protected_Data *obj = pd->data->obj;
+   int w = 0, h = 0;
+
+   _filter_output_cache_del(pd);
+   if (!pd->data->output) return;
+
+   ENFN->image_size_get(ENC, pd->data->output, &w, &h);
+   pd->output_size = (size_t) w * h * 4;
+   pd->output_cached = EINA_TRUE;
+   _filter_outputs = eina_inlist_prepend(_filter_outputs, EINA_INLIST_GET(pd));
+   _filter_outputs_usage += pd->output_size;
+
+   _filter_output_cache_trim();
+}
+
 static void
 _filter_end_sync(Evas_Filter_Context *ctx, Evas_Object_Protected_Data *obj,
                  Evas_Filter_Data *pd, Eina_Bool success)
@@ -104,6 +194,7 @@ _filter_end_sync(Evas_Filter_Context *ctx, Evas_Object_Protected_Data *obj,
    Eo *eo_obj = obj->object;
    void *output = NULL;
 
+   _filter_output_cache_del(pd);
    if (!success)
      {
         ERR("Filter failed at runtime!");
@@ -112,13 +203,12 @@ _filter_end_sync(Evas_Filter_Context *ctx, Evas_Object_Protected_Data *obj,
         destroy = EINA_TRUE;
      }
    else
-     {
-        output = evas_filter_buffer_backing_get(ctx, EVAS_FILTER_BUFFER_OUTPUT_ID, EINA_FALSE);
-        FCOW_WRITE(pd, output, output);
-     }
+     output = evas_filter_buffer_backing_get(ctx, EVAS_FILTER_BUFFER_OUTPUT_ID, EINA_FALSE);
+   FCOW_WRITE(pd, output, output);
 
    if (previous)
      ENFN->image_free(ENC, previous);
+   _filter_output_cache_add(pd);
 
    if (destroy && (ctx == pd->data->context))
      {
@@ -313,10 +403,13 @@ evas_filter_object_render(Eo *eo_obj, Evas_Object_Protected_Data *obj,
      {
         Eina_Bool redraw = EINA_TRUE;
 
+        // need_surface_clear is set by any change but a move
         if (_evas_filter_state_set_internal(pd->data->chain, pd))
           DBG("Filter redraw by state change!");
-        else if (obj->changed)
+        else if (obj->changed && obj->need_surface_clear)
           DBG("Filter redraw by object content change!");
+        else if (obj->occluded_change)
+          DBG("Filter redraw by object change while hidden!");
         else if (obj->snapshot_needs_redraw)
           DBG("Filter redraw by snapshot change!");
         else if (_evas_filter_obscured_region_changed(pd))
@@ -345,6 +438,9 @@ evas_filter_object_render(Eo *eo_obj, Evas_Object_Protected_Data *obj,
 
         if (!redraw)
           {
+             if (pd->output_cached)
+               _filter_outputs = eina_inlist_promote(_filter_outputs, EINA_INLIST_GET(pd));
+
              // Render this image only
              if (use_map)
                {
@@ -732,6 +828,7 @@ _efl_canvas_filter_internal_efl_object_destructor(Eo *eo_obj, Evas_Filter_Data *
         FCOW_WRITE(pd, context, NULL);
      }
 
+   _filter_output_cache_del(pd);
    if (pd->data->output)
      {
         if (!pd->data->async)
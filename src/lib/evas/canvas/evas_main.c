@@ -630,6 +630,8 @@ _evas_canvas_efl_object_destructor(Eo *eo_e, Evas_Public_Data *e)
    eina_array_flush(&e->image_unref_queue);
    eina_array_flush(&e->glyph_unref_queue);
    eina_array_flush(&e->texts_unref_queue);
+   free(e->occlusion.cells);
+   free(e->occlusion.hidden);
    eina_hash_free(e->focused_objects);
 
    SLKL(e->post_render.lock);
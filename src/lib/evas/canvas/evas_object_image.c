@@ -3412,6 +3412,21 @@ evas_object_image_is_opaque(Evas_Object *eo_obj EINA_UNUSED,
    return o->cur->opaque;
 }
 
+/* Tells if evas_object_image_is_opaque() can answer from its cached state,
+ * without writing anything. Always true for other object types. */
+Eina_Bool
+_evas_object_image_opaque_cached_get(const Evas_Object_Protected_Data *obj)
+{
+   Evas_Image_Data *o;
+
+   if (!obj->is_image_object) return EINA_TRUE;
+   o = obj->private_data;
+   if (o->preload == EVAS_IMAGE_PRELOADING) return EINA_TRUE;
+   if (!o->cur->opaque_valid) return EINA_FALSE;
+   if (!o->cur->opaque) return EINA_TRUE;
+   return !((obj->map->cur.map) && (obj->map->cur.usemap));
+}
+
 static int
 evas_object_image_was_opaque(Evas_Object *eo_obj EINA_UNUSED,
                              Evas_Object_Protected_Data *obj,
@@ -399,6 +399,42 @@ evas_object_clip_recalc_do(Evas_Object_Protected_Data *obj, Evas_Object_Protecte
    EINA_COW_STATE_WRITE_END(obj, state_write, cur);
 }
 
+/* Read only check telling if evas_object_clip_recalc() has nothing to update
+ * on this object. Unclipped objects are recalculated on every call, so their
+ * cached clip is compared with what would be computed. */
+Eina_Bool
+evas_object_clip_recalc_done_get(const Evas_Object_Protected_Data *obj)
+{
+   const Evas_Object_Protected_Data *clipper = obj->cur->clipper;
+   int ca;
+   Eina_Bool cvis;
+
+   if (obj->layer->evas->is_frozen) return EINA_TRUE;
+   if (obj->cur->cache.clip.dirty) return EINA_FALSE;
+   if (clipper) return !clipper->cur->cache.clip.dirty;
+
+   // Smart objects may need their bounding box to be updated first
+   if (obj->is_smart) return EINA_FALSE;
+   if ((obj->map->cur.map) && (obj->map->cur.usemap)) return EINA_FALSE;
+
+   ca = obj->cur->color.a;
+   if ((ca == 0) && (obj->cur->render_op == EVAS_RENDER_BLEND))
+     cvis = EINA_FALSE;
+   else cvis = obj->cur->visible;
+   if ((obj->cur->geometry.w <= 0) || (obj->cur->geometry.h <= 0))
+     cvis = EINA_FALSE;
+
+   return ((obj->cur->cache.clip.visible == cvis) &&
+           (obj->cur->cache.clip.x == obj->cur->geometry.x) &&
+           (obj->cur->cache.clip.y == obj->cur->geometry.y) &&
+           (obj->cur->cache.clip.w == obj->cur->geometry.w) &&
+           (obj->cur->cache.clip.h == obj->cur->geometry.h) &&
+           (obj->cur->cache.clip.r == obj->cur->color.r) &&
+           (obj->cur->cache.clip.g == obj->cur->color.g) &&
+           (obj->cur->cache.clip.b == obj->cur->color.b) &&
+           (obj->cur->cache.clip.a == ca));
+}
+
 static inline Eina_Bool
 _map_same(const void *map1, const void *map2)
 {
@@ -568,32 +568,42 @@ evas_object_smart_members_get(const Evas_Object *eo_obj)
    return members;
 }
 
+/* The render cache helpers take the object private data directly, as they
+ * are used while walking the object tree, possibly from render threads. */
 void
-evas_object_smart_render_cache_clear(Evas_Object *eo_obj)
+evas_object_smart_render_cache_clear(Evas_Object_Protected_Data *obj)
 {
-   Evas_Smart_Data *o = efl_data_scope_get(eo_obj, MY_CLASS);
+   Evas_Smart_Data *o = obj->private_data;
    if (!o) return;
    if (!o->render_cache) return;
-   evas_render_object_render_cache_free(eo_obj, o->render_cache);
+   evas_render_object_render_cache_free(obj->object, o->render_cache);
    o->render_cache = NULL;
 }
 
 void *
-evas_object_smart_render_cache_get(const Evas_Object *eo_obj)
+evas_object_smart_render_cache_get(const Evas_Object_Protected_Data *obj)
 {
-   Evas_Smart_Data *o = efl_data_scope_get(eo_obj, MY_CLASS);
+   Evas_Smart_Data *o = obj->private_data;
    if (!o) return NULL;
    return o->render_cache;
 }
 
 void
-evas_object_smart_render_cache_set(Evas_Object *eo_obj, void *data)
+evas_object_smart_render_cache_set(Evas_Object_Protected_Data *obj, void *data)
 {
-   Evas_Smart_Data *o = efl_data_scope_get(eo_obj, MY_CLASS);
+   Evas_Smart_Data *o = obj->private_data;
    if (!o) return;
    o->render_cache = data;
 }
 
+const Eina_Inlist *
+_evas_object_smart_members_get(const Evas_Object_Protected_Data *obj)
+{
+   Evas_Smart_Data *o = obj->private_data;
+   if (!o) return NULL;
+   return o->contained;
+}
+
 const Eina_Inlist *
 evas_object_smart_members_get_direct(const Evas_Object *eo_obj)
 {
@@ -259,6 +259,7 @@ struct _Evas_Object_Textblock_Paragraph
    Evas_BiDi_Direction                direction;  /**< Bidi direction enum value. The display direction like right to left.*/
    Evas_Coord                         y, w, h;  /**< Text block co-ordinates. y co-ord, width and height. */
    Evas_Coord                         last_fw;   /**< Last calculated formatted width  */
+   Evas_Coord                         min_w;   /**< Smallest object width the current lines stay valid for, -1 if they depend on the width. */
    int                                line_no;  /**< Line no of the text block. */
    Eina_Bool                          is_bidi : 1;  /**< EINA_TRUE if this is BiDi Paragraph, else EINA_FALSE. */
    Eina_Bool                          visible : 1;  /**< EINA_TRUE if paragraph visible, else EINA_FALSE. */
@@ -4124,6 +4125,7 @@ _layout_paragraph_new(Ctxt *c, Evas_Object_Textblock_Node_Text *n,
    if (n)
       n->par = c->par;
    c->par->line_no = -1;
+   c->par->min_w = -1;
    c->par->visible = 1;
    c->o->num_paragraphs++;
 
@@ -4796,6 +4798,7 @@ _layout_line_finalize(Ctxt *c, Evas_Object_Textblock_Format *fmt)
    Eina_List *i;
    Evas_Textblock_Obstacle_Info *obs_info = NULL;
    Evas_Coord x = 0;
+   double align;
 
    /* If there are no text items yet, calc ascent/descent
     * according to the current format. */
@@ -4912,6 +4915,7 @@ loop_advance:
              _line_free(c->ln);
              c->ln = NULL;
              c->vertical_ellipsis = EINA_TRUE;
+             c->par->min_w = -1;
 
              return;
           }
@@ -4934,13 +4938,17 @@ loop_advance:
         c->line_no++;
         c->y += c->ascent + c->descent;
      }
+   align = _layout_line_align_get(c);
+   /* Only left aligned lines keep their position when the width changes */
+   if (!EINA_DBL_EQ(align, 0.0))
+      c->par->min_w = -1;
    if (c->w >= 0)
      {
         /* c->o->style_pad.r is already included in the line width, so it's
          * not used in this calculation. . */
         c->ln->x = c->marginl + c->o->style_pad.l +
            ((c->w - c->ln->w - c->o->style_pad.l -
-             c->marginl - c->marginr) * _layout_line_align_get(c));
+             c->marginl - c->marginr) * align);
      }
    else
      {
@@ -6512,6 +6520,19 @@ _layout_item_obstacle_get(Ctxt *c, Evas_Object_Textblock_Item *it);
 /* 0 means go ahead, 1 means break without an error, 2 means
  * break with an error, should probably clean this a bit (enum/macro)
  * FIXME ^ */
+/**
+ * @internal
+ * Check if the current lines of the paragraph are still valid for the
+ * context width: nothing wrapped, all lines are left aligned and every
+ * item still fits.
+ */
+static inline Eina_Bool
+_layout_par_width_fits(const Ctxt *c)
+{
+   if (c->par->min_w < 0) return EINA_FALSE;
+   return (c->w < 0) || (c->w >= c->par->min_w);
+}
+
 static int
 _layout_par(Ctxt *c)
 {
@@ -6534,10 +6555,12 @@ _layout_par(Ctxt *c)
 
    if (c->par->text_node)
      {
-        /* Skip this paragraph if width is the same, there is no ellipsis
-         * and we aren't just calculating. */
+        /* Skip this paragraph if width is the same (or its lines don't
+         * depend on it), there is no ellipsis and we aren't just
+         * calculating. */
         if (!c->par->text_node->is_new && !c->par->text_node->dirty &&
-              !c->width_changed && c->par->lines &&
+              (!c->width_changed || _layout_par_width_fits(c)) &&
+              c->par->lines &&
               !c->o->have_ellipsis && !c->o->obstacle_changed &&
               !c->o->wrap_changed)
           {
@@ -6595,6 +6618,9 @@ _layout_par(Ctxt *c)
      }
 
    c->y = c->par->y;
+   /* Anything else than plain left aligned lines that never had to wrap
+    * resets this to -1 while laying out. */
+   c->par->min_w = (c->o->obstacles) ? -1 : 0;
 
 
 #ifdef BIDI_SUPPORT
@@ -6619,7 +6645,10 @@ _layout_par(Ctxt *c)
         double ellip;
         ellip = it->format->ellipsis;
         if ((0 <= ellip) && (ellip < 1.0) && c->line_no == 0)
-           _layout_par_ellipsis_items(c, ellip);
+          {
+             c->par->min_w = -1;
+             _layout_par_ellipsis_items(c, ellip);
+          }
      }
 
    Eina_Bool item_preadv = EINA_FALSE;
@@ -6685,12 +6714,22 @@ _layout_par(Ctxt *c)
              itw -= _ITEM_TEXT(it)->x_adjustment;
           }
 
+        /* Track the width needed to lay this item out without wrapping */
+        if (c->par->min_w >= 0)
+          {
+             Evas_Coord need_w = c->x + itw + c->o->style_pad.l +
+                c->o->style_pad.r + c->marginl + c->marginr;
+             if (need_w > c->par->min_w) c->par->min_w = need_w;
+          }
+
         if ((c->w >= 0) &&
               (obs ||
                  (((c->x + itw) >
                    (c->w - c->o->style_pad.l - c->o->style_pad.r -
                     c->marginl - c->marginr)) || (wrap > 0))))
           {
+             /* Wrapping, ellipsis and obstacles all depend on the width */
+             c->par->min_w = -1;
              /* Handle ellipsis here. If we don't have more width left
               * and no height left, or no more width left and no wrapping.
               * Note that this is only for ellipsis == 1.0, and is treated in a
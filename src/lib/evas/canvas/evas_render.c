@@ -3,6 +3,8 @@
 #include <math.h>
 #include <assert.h>
 
+#include <Ecore.h>
+
 #ifdef EVAS_RENDER_DEBUG_TIMING
 #include <sys/time.h>
 #endif
@@ -692,7 +694,9 @@ typedef struct
    Eina_Array       *snapshot_objects;
    Eina_Array       *restack_objects;
    Eina_Array       *delete_objects;
+   Eina_Array       *pending_objects;
    int               redraw_all;
+   int               clippers_fixed;
 } Phase1_Context;
 
 #define RENDCACHE 1
@@ -773,7 +777,7 @@ _evas_render_phase1_object_restack_handle(Phase1_Context *p1ctx,
 {
    if (!obj_changed)
      {
-        OBJ_ARRAY_PUSH(&(p1ctx->e->pending_objects), obj);
+        OBJ_ARRAY_PUSH(p1ctx->pending_objects, obj);
         obj->changed = EINA_TRUE;
         obj->in_pending_objects = EINA_TRUE;
      }
@@ -806,8 +810,11 @@ _evas_render_phase1_object_mapped(Phase1_Context *p1ctx,
    if (!obj_changed) return;
 
    if (!hmap && obj->cur->clipper)
-     // Fix some bad clipping issues before an evas map animation starts
-     _evas_render_phase1_object_map_clipper_fix(eo_obj, obj);
+     {
+        // Fix some bad clipping issues before an evas map animation starts
+        _evas_render_phase1_object_map_clipper_fix(eo_obj, obj);
+        p1ctx->clippers_fixed++;
+     }
 
    _evas_render_object_map_change_update(p1ctx->e, obj, EINA_TRUE, hmap, &(p1ctx->redraw_all));
    if (!((is_active) &&
@@ -821,8 +828,8 @@ _evas_render_phase1_object_mapped(Phase1_Context *p1ctx,
    _evas_render_prev_cur_clip_cache_add(p1ctx->e, obj);
    obj->render_pre = EINA_TRUE;
    if (!obj->is_smart) return;
-   if (obj_changed) evas_object_smart_render_cache_clear(eo_obj);
-   EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(eo_obj), obj2)
+   if (obj_changed) evas_object_smart_render_cache_clear(obj);
+   EINA_INLIST_FOREACH(_evas_object_smart_members_get(obj), obj2)
      {
         _evas_render_phase1_object_process(p1ctx, obj2, obj->restack,
                                            EINA_TRUE, src_changed, level + 1);
@@ -857,6 +864,7 @@ _evas_render_phase1_object_mapped_had_restack(Phase1_Context *p1ctx,
      }
    if (!(!map && obj->cur->clipper)) return;
    // Fix some bad clipping issues after an evas_map animation finishes
+   p1ctx->clippers_fixed++;
    evas_object_change(obj->cur->clipper->object, obj->cur->clipper);
    evas_object_clip_dirty(obj->cur->clipper->object, obj->cur->clipper);
    evas_object_clip_recalc(obj->cur->clipper);
@@ -873,7 +881,6 @@ _evas_render_phase1_object_changed_smart(Phase1_Context *p1ctx,
                                          int level)
 {
    Evas_Object_Protected_Data *obj2;
-   Evas_Object *eo_obj = obj->object;
 
    RD(level, "  changed + smart - render ok\n");
    OBJ_ARRAY_PUSH(p1ctx->render_objects, obj);
@@ -883,8 +890,8 @@ _evas_render_phase1_object_changed_smart(Phase1_Context *p1ctx,
    obj->render_pre = EINA_TRUE;
    if (obj_changed)
      {
-        evas_object_smart_render_cache_clear(eo_obj);
-        EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(eo_obj), obj2)
+        evas_object_smart_render_cache_clear(obj);
+        EINA_INLIST_FOREACH(_evas_object_smart_members_get(obj), obj2)
           {
              _evas_render_phase1_object_process(p1ctx, obj2, obj->restack,
                                                 mapped_parent, src_changed,
@@ -902,18 +909,18 @@ _evas_render_phase1_object_changed_smart(Phase1_Context *p1ctx,
 
         if (obj->no_change_render > 3)
           {
-             rc = evas_object_smart_render_cache_get(eo_obj);
+             rc = evas_object_smart_render_cache_get(obj);
              if (!rc)
                {
                   rc = _evas_render_phase1_object_render_cache_new();
-                  evas_object_smart_render_cache_set(eo_obj, rc);
+                  evas_object_smart_render_cache_set(obj, rc);
                   ctx = &tmpctx;
                   *ctx = *p1ctx;
                   p_del_redir = p1ctx->e->update_del_redirect_array;
                   p1ctx->e->update_del_redirect_array = rc->update_del;
                   _evas_render_phase1_object_ctx_render_cache_fill(ctx, rc);
                   EINA_INLIST_FOREACH
-                    (evas_object_smart_members_get_direct(eo_obj), obj2)
+                    (_evas_object_smart_members_get(obj), obj2)
                     {
                        _evas_render_phase1_object_process(ctx, obj2,
                                                           obj->restack,
@@ -922,6 +929,7 @@ _evas_render_phase1_object_changed_smart(Phase1_Context *p1ctx,
                                                           level + 1);
                     }
                   p1ctx->redraw_all = ctx->redraw_all;
+                  p1ctx->clippers_fixed = ctx->clippers_fixed;
                   p1ctx->e->update_del_redirect_array = p_del_redir;
                }
              _evas_render_phase1_object_ctx_render_cache_append(p1ctx, rc);
@@ -930,7 +938,7 @@ _evas_render_phase1_object_changed_smart(Phase1_Context *p1ctx,
 #endif
           {
              EINA_INLIST_FOREACH
-               (evas_object_smart_members_get_direct(eo_obj), obj2)
+               (_evas_object_smart_members_get(obj), obj2)
                {
                   _evas_render_phase1_object_process(ctx, obj2, obj->restack,
                                                      mapped_parent,
@@ -1002,7 +1010,6 @@ _evas_render_phase1_object_no_changed_smart(Phase1_Context *p1ctx,
 {
    Evas_Object_Protected_Data *obj2;
    Phase1_Context *ctx = p1ctx;
-   Evas_Object *eo_obj = obj->object;
 
    RD(level, "  smart + visible/was visible + not clip\n");
    OBJ_ARRAY_PUSH(p1ctx->render_objects, obj);
@@ -1014,24 +1021,25 @@ _evas_render_phase1_object_no_changed_smart(Phase1_Context *p1ctx,
 
    if (obj->no_change_render > 3)
      {
-        rc = evas_object_smart_render_cache_get(eo_obj);
+        rc = evas_object_smart_render_cache_get(obj);
         if (!rc)
           {
              rc = _evas_render_phase1_object_render_cache_new();
-             evas_object_smart_render_cache_set(eo_obj, rc);
+             evas_object_smart_render_cache_set(obj, rc);
              ctx = &tmpctx;
              *ctx = *p1ctx;
              p_del_redir = p1ctx->e->update_del_redirect_array;
              p1ctx->e->update_del_redirect_array = rc->update_del;
              _evas_render_phase1_object_ctx_render_cache_fill(ctx, rc);
              EINA_INLIST_FOREACH
-               (evas_object_smart_members_get_direct(eo_obj), obj2)
+               (_evas_object_smart_members_get(obj), obj2)
                {
                   _evas_render_phase1_object_process(ctx, obj2, restack,
                                                      mapped_parent,
                                                      src_changed, level + 1);
                }
              p1ctx->redraw_all = ctx->redraw_all;
+             p1ctx->clippers_fixed = ctx->clippers_fixed;
              p1ctx->e->update_del_redirect_array = p_del_redir;
           }
         _evas_render_phase1_object_ctx_render_cache_append(p1ctx, rc);
@@ -1040,7 +1048,7 @@ _evas_render_phase1_object_no_changed_smart(Phase1_Context *p1ctx,
 #endif
      {
         EINA_INLIST_FOREACH
-          (evas_object_smart_members_get_direct(eo_obj), obj2)
+          (_evas_object_smart_members_get(obj), obj2)
           {
              _evas_render_phase1_object_process(ctx, obj2, restack,
                                                 mapped_parent,
@@ -1251,22 +1259,302 @@ done:
 
 
 
+/* Top level subtrees can be walked in parallel, as long as walking them does
+ * not touch anything but their own objects and the walk arrays. Clip, map and
+ * image state updates go through Eina_Cow and eo, which are not thread safe,
+ * so subtrees needing any of these (or a new render cache) are walked on the
+ * main thread first. Each subtree remembers the range of the arrays it filled
+ * and all ranges are merged in stacking order, like a serial walk does.
+ */
+#define PHASE1_SLICE_UNITS 16
+
+typedef struct
+{
+   unsigned int active, render, snapshot, restack, delete, pending;
+} Phase1_Marks;
+
+typedef struct
+{
+   Evas_Object_Protected_Data *obj;
+   Phase1_Context             *ctx;
+   Phase1_Marks                start, end;
+   Eina_Bool                   quiet : 1;
+   Eina_Bool                   ctx_owner : 1;
+   Eina_Bool                   clean_them : 1;
+} Phase1_Unit;
+
+typedef struct
+{
+   Evas_Public_Data *e;
+   Phase1_Unit      *units;
+} Phase1_Parallel;
+
+static Phase1_Context *
+_evas_render_phase1_ctx_new(Evas_Public_Data *e)
+{
+   Phase1_Context *ctx;
+
+   ctx = calloc(1, sizeof(Phase1_Context));
+   if (!ctx) return NULL;
+   ctx->e                = e;
+   ctx->active_objects   = eina_inarray_new(sizeof(Evas_Active_Entry), 32);
+   ctx->render_objects   = eina_array_new(32);
+   ctx->snapshot_objects = eina_array_new(4);
+   ctx->restack_objects  = eina_array_new(4);
+   ctx->delete_objects   = eina_array_new(4);
+   ctx->pending_objects  = eina_array_new(4);
+   return ctx;
+}
+
+static void
+_evas_render_phase1_ctx_free(Phase1_Context *ctx)
+{
+   eina_inarray_free(ctx->active_objects);
+   eina_array_free(ctx->render_objects);
+   eina_array_free(ctx->snapshot_objects);
+   eina_array_free(ctx->restack_objects);
+   eina_array_free(ctx->delete_objects);
+   eina_array_free(ctx->pending_objects);
+   free(ctx);
+}
+
+static void
+_evas_render_phase1_ctx_marks_get(const Phase1_Context *ctx, Phase1_Marks *m)
+{
+   m->active   = eina_inarray_count(ctx->active_objects);
+   m->render   = eina_array_count(ctx->render_objects);
+   m->snapshot = eina_array_count(ctx->snapshot_objects);
+   m->restack  = eina_array_count(ctx->restack_objects);
+   m->delete   = eina_array_count(ctx->delete_objects);
+   m->pending  = eina_array_count(ctx->pending_objects);
+}
+
+/* Read only, tells if walking this object can be done from any thread */
+static Eina_Bool
+_evas_render_phase1_object_is_quiet(Evas_Object_Protected_Data *obj,
+                                    Eina_Bool restack,
+                                    Eina_Bool root)
+{
+   Evas_Object_Protected_Data *obj2;
+   Eina_Bool obj_changed;
+
+   if (obj->is_static_clip) return EINA_TRUE;
+   // Roots had their clip updated before the walk
+   if (!root && !evas_object_clip_recalc_done_get(obj)) return EINA_FALSE;
+   if (obj->gfx_mapping_has ||
+       _evas_render_has_map(obj) || _evas_render_had_map(obj))
+     return EINA_FALSE;
+
+   obj_changed = obj->changed || restack;
+   if (!obj->is_smart)
+     {
+        // Objects being hidden get their prev state replaced
+        if (obj_changed)
+          return (evas_object_is_visible(obj) == evas_object_was_visible(obj));
+        return _evas_object_image_opaque_cached_get(obj);
+     }
+
+#ifdef RENDCACHE
+   if (!obj_changed && (obj->no_change_render > 3))
+     {
+        Render_Cache *rc = evas_object_smart_render_cache_get(obj);
+
+        // Filling a new render cache redirects the canvas update deletions
+        if (!rc) return EINA_FALSE;
+        return !eina_inarray_count(rc->update_del);
+     }
+#endif
+
+   EINA_INLIST_FOREACH(_evas_object_smart_members_get(obj), obj2)
+     {
+        if (!_evas_render_phase1_object_is_quiet(obj2, restack || obj->restack,
+                                                 EINA_FALSE))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+static void
+_evas_render_phase1_unit_process(Phase1_Context *ctx, Phase1_Unit *u)
+{
+   _evas_render_phase1_ctx_marks_get(ctx, &(u->start));
+   u->clean_them = _evas_render_phase1_object_process
+      (ctx, u->obj, EINA_FALSE, EINA_FALSE, EINA_FALSE, 2);
+   _evas_render_phase1_ctx_marks_get(ctx, &(u->end));
+   u->ctx = ctx;
+}
+
+static void
+_evas_render_phase1_unit_merge(Phase1_Context *p1ctx, const Phase1_Unit *u)
+{
+   const Phase1_Context *ctx = u->ctx;
+   unsigned int i;
+
+   for (i = u->start.active; i < u->end.active; i++)
+     eina_inarray_push(p1ctx->active_objects,
+                       eina_inarray_nth(ctx->active_objects, i));
+
+#define ARR_MERGE(x, m) \
+   for (i = u->start.m; i < u->end.m; i++) \
+     OBJ_ARRAY_PUSH(p1ctx->x, eina_array_data_get(ctx->x, i))
+   ARR_MERGE(render_objects, render);
+   ARR_MERGE(snapshot_objects, snapshot);
+   ARR_MERGE(restack_objects, restack);
+   ARR_MERGE(delete_objects, delete);
+   ARR_MERGE(pending_objects, pending);
+#undef ARR_MERGE
+}
+
+static void
+_evas_render_phase1_classify_cb(void *data, int start, int end)
+{
+   Phase1_Parallel *par = data;
+   int i;
+
+   for (i = start; i < end; i++)
+     par->units[i].quiet = _evas_render_phase1_object_is_quiet
+        (par->units[i].obj, EINA_FALSE, EINA_TRUE);
+}
+
+static void
+_evas_render_phase1_walk_cb(void *data, int start, int end)
+{
+   Phase1_Parallel *par = data;
+   Phase1_Context *ctx = NULL;
+   int i;
+
+   for (i = start; i < end; i++)
+     {
+        Phase1_Unit *u = &(par->units[i]);
+
+        if (!u->quiet) continue;
+        if (!ctx)
+          {
+             ctx = _evas_render_phase1_ctx_new(par->e);
+             // Left to the main thread
+             if (!ctx) return;
+             u->ctx_owner = EINA_TRUE;
+          }
+        _evas_render_phase1_unit_process(ctx, u);
+     }
+}
+
+static Phase1_Unit *
+_evas_render_phase1_units_get(Evas_Public_Data *e, int *count)
+{
+   Evas_Layer *lay;
+   Evas_Object_Protected_Data *obj;
+   Phase1_Unit *units;
+   int n = 0;
+
+   EINA_INLIST_FOREACH(e->layers, lay)
+     n += eina_inlist_count(EINA_INLIST_GET(lay->objects));
+   if (n < (2 * PHASE1_SLICE_UNITS)) return NULL;
+
+   units = calloc(n, sizeof(Phase1_Unit));
+   if (!units) return NULL;
+
+   n = 0;
+   EINA_INLIST_FOREACH(e->layers, lay)
+     {
+        EINA_INLIST_FOREACH(lay->objects, obj)
+          {
+             if (evas_object_is_on_plane(obj)) continue;
+             units[n++].obj = obj;
+          }
+     }
+   *count = n;
+   return units;
+}
+
+static Eina_Bool
+_evas_render_phase1_process_parallel(Phase1_Context *p1ctx,
+                                     Phase1_Unit *units, int count)
+{
+   Phase1_Parallel par;
+   Phase1_Context *serial;
+   Eina_Bool clean_them = EINA_FALSE;
+   int i;
+
+   serial = _evas_render_phase1_ctx_new(p1ctx->e);
+   if (!serial)
+     {
+        for (i = 0; i < count; i++)
+          clean_them |= _evas_render_phase1_object_process
+             (p1ctx, units[i].obj, EINA_FALSE, EINA_FALSE, EINA_FALSE, 2);
+        return clean_them;
+     }
+
+   par.e = p1ctx->e;
+   par.units = units;
+
+   // Nothing is left to recalculate on the roots once the walk starts, even
+   // for the unclipped ones
+   for (i = 0; i < count; i++)
+     evas_object_clip_recalc(units[i].obj);
+
+   evas_common_thread_slice_run(_evas_render_phase1_classify_cb, &par,
+                                count, PHASE1_SLICE_UNITS);
+   for (i = 0; i < count; i++)
+     {
+        if (!units[i].quiet)
+          _evas_render_phase1_unit_process(serial, &(units[i]));
+     }
+
+   // Clippers fixed up for maps may belong to any other subtree
+   if (!serial->clippers_fixed)
+     evas_common_thread_slice_run(_evas_render_phase1_walk_cb, &par,
+                                  count, PHASE1_SLICE_UNITS);
+
+   for (i = 0; i < count; i++)
+     {
+        if (!units[i].ctx)
+          _evas_render_phase1_unit_process(serial, &(units[i]));
+        clean_them |= units[i].clean_them;
+        _evas_render_phase1_unit_merge(p1ctx, &(units[i]));
+     }
+
+   p1ctx->redraw_all |= serial->redraw_all;
+   p1ctx->clippers_fixed += serial->clippers_fixed;
+   for (i = 0; i < count; i++)
+     {
+        if (units[i].ctx_owner)
+          _evas_render_phase1_ctx_free(units[i].ctx);
+     }
+   _evas_render_phase1_ctx_free(serial);
+   return clean_them;
+}
+
 static Eina_Bool
 _evas_render_phase1_process(Phase1_Context *p1ctx)
 {
    Evas_Layer *lay;
+   Phase1_Unit *units = NULL;
    Eina_Bool clean_them = EINA_FALSE;
+   int count = 0;
 
    RD(0, "  [--- PHASE 1\n");
-   EINA_INLIST_FOREACH(p1ctx->e->layers, lay)
+#ifndef REND_DBG
+   if (evas_common_thread_slice_count_get() > 1)
+     units = _evas_render_phase1_units_get(p1ctx->e, &count);
+#endif
+   if (units)
      {
-        Evas_Object_Protected_Data *obj;
-
-        EINA_INLIST_FOREACH(lay->objects, obj)
+        clean_them = _evas_render_phase1_process_parallel(p1ctx, units, count);
+        free(units);
+     }
+   else
+     {
+        EINA_INLIST_FOREACH(p1ctx->e->layers, lay)
           {
-             if (evas_object_is_on_plane(obj)) continue;
-             clean_them |= _evas_render_phase1_object_process
-                (p1ctx, obj, EINA_FALSE, EINA_FALSE, EINA_FALSE, 2);
+             Evas_Object_Protected_Data *obj;
+
+             EINA_INLIST_FOREACH(lay->objects, obj)
+               {
+                  if (evas_object_is_on_plane(obj)) continue;
+                  clean_them |= _evas_render_phase1_object_process
+                     (p1ctx, obj, EINA_FALSE, EINA_FALSE, EINA_FALSE, 2);
+               }
           }
      }
    RD(0, "  ---]\n");
@@ -2687,14 +2975,15 @@ end:
    eina_evlog("-mask_subrender", mask->object, 0.0, NULL);
 }
 
-static void
-_evas_render_cutout_add(Evas_Public_Data *evas, void *context,
-                        Evas_Object_Protected_Data *obj, int off_x, int off_y,
-                        Cutout_Margin *cutout_margin)
+/* Area drawn fully opaque by an obscuring object, in canvas coordinates */
+static Eina_Bool
+_evas_render_cutout_rect_get(Evas_Object_Protected_Data *obj,
+                             Evas_Coord *x, Evas_Coord *y,
+                             Evas_Coord *w, Evas_Coord *h)
 {
    Evas_Coord cox = 0, coy = 0, cow = 0, coh = 0;
 
-   if (evas_object_is_source_invisible(obj->object, obj)) return;
+   if (evas_object_is_source_invisible(obj->object, obj)) return EINA_FALSE;
    if (evas_object_is_opaque(obj))
      {
         cox = obj->cur->cache.clip.x;
@@ -2716,19 +3005,31 @@ _evas_render_cutout_add(Evas_Public_Data *evas, void *context,
                                      oo->cur->geometry.y,
                                      oo->cur->geometry.w,
                                      oo->cur->geometry.h);
-                  if ((cow <= 0) || (coh <= 0)) return;
+                  if ((cow <= 0) || (coh <= 0)) return EINA_FALSE;
                }
           }
      }
    else if (obj->func->get_opaque_rect)
      {
         obj->func->get_opaque_rect(obj->object, obj, obj->private_data, &cox, &coy, &cow, &coh);
-        if ((cow <= 0) || (coh <= 0)) return;
+        if ((cow <= 0) || (coh <= 0)) return EINA_FALSE;
         RECTS_CLIP_TO_RECT(cox, coy, cow, coh,
                            obj->cur->cache.clip.x, obj->cur->cache.clip.y,
                            obj->cur->cache.clip.w, obj->cur->cache.clip.h);
      }
-   else return;
+   else return EINA_FALSE;
+   *x = cox; *y = coy; *w = cow; *h = coh;
+   return EINA_TRUE;
+}
+
+static void
+_evas_render_cutout_add(Evas_Public_Data *evas, void *context,
+                        Evas_Object_Protected_Data *obj, int off_x, int off_y,
+                        Cutout_Margin *cutout_margin)
+{
+   Evas_Coord cox, coy, cow, coh;
+
+   if (!_evas_render_cutout_rect_get(obj, &cox, &coy, &cow, &coh)) return;
    if (cutout_margin)
      {
         cox += cutout_margin->l;
@@ -2740,6 +3041,210 @@ _evas_render_cutout_add(Evas_Public_Data *evas, void *context,
    ENFN->context_cutout_add(ENC, context, cox + off_x, coy + off_y, cow, coh);
 }
 
+/* Coarse coverage map of the opaque objects, used to find the objects that
+ * are entirely hidden and do not need to be drawn at all. A cell is only
+ * marked once an opaque area covers all of it, so the test is conservative:
+ * an object is hidden only if it lies on fully covered cells. */
+#define OCCLUSION_CELL 16
+
+typedef struct _Occlusion_Map Occlusion_Map;
+
+struct _Occlusion_Map
+{
+   unsigned char *cells;
+   int x, y, w, h; // area, in canvas coordinates
+   int cw, ch; // size in cells
+};
+
+static int
+_evas_render_occlusion_enabled(void)
+{
+   static int occlusion = -1;
+
+   if (occlusion == -1)
+     {
+        if (getenv("EVAS_RENDER_OCCLUSION"))
+          occlusion = !!atoi(getenv("EVAS_RENDER_OCCLUSION"));
+        else occlusion = 1;
+     }
+   return occlusion;
+}
+
+static Eina_Bool
+_evas_render_occlusion_map_init(Evas_Public_Data *evas, Occlusion_Map *om,
+                                int x, int y, int w, int h)
+{
+   unsigned int size;
+
+   if ((w <= 0) || (h <= 0)) return EINA_FALSE;
+   om->x = x;
+   om->y = y;
+   om->w = w;
+   om->h = h;
+   om->cw = (w + OCCLUSION_CELL - 1) / OCCLUSION_CELL;
+   om->ch = (h + OCCLUSION_CELL - 1) / OCCLUSION_CELL;
+   size = om->cw * om->ch;
+   if (size > evas->occlusion.cells_size)
+     {
+        unsigned char *cells = realloc(evas->occlusion.cells, size);
+
+        if (!cells) return EINA_FALSE;
+        evas->occlusion.cells = cells;
+        evas->occlusion.cells_size = size;
+     }
+   om->cells = evas->occlusion.cells;
+   memset(om->cells, 0, size);
+   return EINA_TRUE;
+}
+
+static void
+_evas_render_occlusion_map_add(Occlusion_Map *om, int x, int y, int w, int h)
+{
+   int x0, y0, x1, y1, row;
+
+   RECTS_CLIP_TO_RECT(x, y, w, h, om->x, om->y, om->w, om->h);
+   if ((w <= 0) || (h <= 0)) return;
+
+   // Cells entirely inside the rectangle, the last row and column of cells
+   // may be cut by the edge of the area.
+   x0 = (x - om->x + OCCLUSION_CELL - 1) / OCCLUSION_CELL;
+   y0 = (y - om->y + OCCLUSION_CELL - 1) / OCCLUSION_CELL;
+   if ((x + w) == (om->x + om->w)) x1 = om->cw;
+   else x1 = (x + w - om->x) / OCCLUSION_CELL;
+   if ((y + h) == (om->y + om->h)) y1 = om->ch;
+   else y1 = (y + h - om->y) / OCCLUSION_CELL;
+   if (x1 <= x0) return;
+
+   for (row = y0; row < y1; row++)
+     memset(om->cells + (row * om->cw) + x0, 1, x1 - x0);
+}
+
+static Eina_Bool
+_evas_render_occlusion_map_covers(const Occlusion_Map *om, int x, int y, int w, int h)
+{
+   int x0, y0, x1, y1, row, col;
+
+   RECTS_CLIP_TO_RECT(x, y, w, h, om->x, om->y, om->w, om->h);
+   if ((w <= 0) || (h <= 0)) return EINA_FALSE;
+
+   x0 = (x - om->x) / OCCLUSION_CELL;
+   y0 = (y - om->y) / OCCLUSION_CELL;
+   x1 = (x + w - om->x + OCCLUSION_CELL - 1) / OCCLUSION_CELL;
+   y1 = (y + h - om->y + OCCLUSION_CELL - 1) / OCCLUSION_CELL;
+   for (row = y0; row < y1; row++)
+     {
+        const unsigned char *cells = om->cells + (row * om->cw);
+
+        for (col = x0; col < x1; col++)
+          if (!cells[col]) return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+/* Objects that can be skipped when hidden: they draw nothing outside of their
+ * clip and nothing else depends on what they draw. */
+static inline Eina_Bool
+_evas_render_occlusion_candidate(Evas_Object_Protected_Data *obj)
+{
+   return ((!obj->is_smart) && (!obj->is_frame) &&
+           (!obj->clip.clipees) && (!obj->cur->snapshot) &&
+           (!obj->proxy->proxies) && (!_evas_render_has_map(obj)) &&
+           (obj->cur->visible) && (obj->cur->cache.clip.visible));
+}
+
+/* Front to back pass over the active objects, flags in evas->occlusion.hidden
+ * the ones entirely covered by the obscuring objects above them within the
+ * given update region (canvas coordinates), so that they are not drawn there.
+ * The obscurers must be in the same order as the active objects. Returns the
+ * number of hidden objects, the flags are only valid if it is not 0. */
+static unsigned int
+_evas_render_occlusion_cull(Evas_Public_Data *evas, Eina_Array *obscurers,
+                            Cutout_Margin *cutout_margin,
+                            int x, int y, int w, int h)
+{
+   Evas_Object_Protected_Data *obj;
+   Occlusion_Map om;
+   unsigned int culled = 0;
+   int i, k;
+
+   if (!obscurers->count) return 0;
+   if (!_evas_render_occlusion_map_init(evas, &om, x, y, w, h)) return 0;
+   if (evas->active_objects.len > evas->occlusion.hidden_size)
+     {
+        unsigned char *hidden;
+
+        hidden = realloc(evas->occlusion.hidden, evas->active_objects.len);
+        if (!hidden) return 0;
+        evas->occlusion.hidden = hidden;
+        evas->occlusion.hidden_size = evas->active_objects.len;
+     }
+   memset(evas->occlusion.hidden, 0, evas->active_objects.len);
+
+   eina_evlog("+render_occlusion", evas->evas, 0.0, NULL);
+   k = obscurers->count - 1;
+   for (i = evas->active_objects.len - 1; i >= 0; i--)
+     {
+        Evas_Active_Entry *ent = eina_inarray_nth(&evas->active_objects, i);
+        Evas_Coord cox, coy, cow, coh;
+
+        obj = ent->obj;
+        if (_evas_render_occlusion_candidate(obj) &&
+            _evas_render_occlusion_map_covers(&om,
+                                              obj->cur->cache.clip.x,
+                                              obj->cur->cache.clip.y,
+                                              obj->cur->cache.clip.w,
+                                              obj->cur->cache.clip.h))
+          {
+             evas->occlusion.hidden[i] = 1;
+             culled++;
+          }
+
+        if ((k < 0) || (eina_array_data_get(obscurers, k) != obj)) continue;
+        k--;
+
+        // A hidden obscurer does not cover anything new
+        if (evas->occlusion.hidden[i] || obj->is_frame) continue;
+        if (obj->cur->snapshot && !evas_object_is_opaque(obj))
+          continue;
+        if (!_evas_render_cutout_rect_get(obj, &cox, &coy, &cow, &coh))
+          continue;
+        if (cutout_margin)
+          {
+             cox += cutout_margin->l;
+             coy += cutout_margin->t;
+             cow -= cutout_margin->l + cutout_margin->r;
+             coh -= cutout_margin->t + cutout_margin->b;
+          }
+        _evas_render_occlusion_map_add(&om, cox, coy, cow, coh);
+     }
+   eina_evlog("-render_occlusion", evas->evas, 0.0, NULL);
+
+   return culled;
+}
+
+static void
+_evas_render_occlusion_stats_report(Evas *eo_e, Evas_Public_Data *evas)
+{
+   static int stats = -1;
+   double overdraw = 0.0;
+   char buf[128];
+
+   if (stats == -1)
+     {
+        if (getenv("EVAS_RENDER_OCCLUSION_STATS"))
+          stats = !!atoi(getenv("EVAS_RENDER_OCCLUSION_STATS"));
+        else stats = 0;
+     }
+
+   // Overdraw: pixels drawn by the objects over pixels updated
+   if (evas->occlusion.update_pixels > 0)
+     overdraw = evas->occlusion.drawn_pixels / evas->occlusion.update_pixels;
+   snprintf(buf, sizeof(buf), "drawn=%u culled=%u overdraw=%.2f",
+            evas->occlusion.drawn, evas->occlusion.culled, overdraw);
+   eina_evlog("!render_overdraw", eo_e, 0.0, buf);
+   if (stats) fprintf(stderr, "EVAS RENDER %p: %s\n", eo_e, buf);
+}
+
 void
 evas_render_rendering_wait(Evas_Public_Data *evas)
 {
@@ -2954,6 +3459,75 @@ evas_render_pending_objects_flush(Evas *eo_e)
    evas_render_pre(eo_e, evas);
 }
 
+/* Frame pipelining: while a frame is rasterized by the render thread, the
+ * next one is evaluated (pending objects finalized, smart objects
+ * calculated) on the main loop. Its own rendering starts as soon as the
+ * current one is done, so with the frame on screen there are up to three
+ * frames in progress. The render thread only works on the commands queued
+ * for its frame, objects are free to change in the meantime. */
+static int
+_evas_render_pipeline_enabled(void)
+{
+   static int pipeline = -1;
+
+   if (pipeline == -1)
+     {
+        if (getenv("EVAS_RENDER_PIPELINE"))
+          pipeline = !!atoi(getenv("EVAS_RENDER_PIPELINE"));
+        else pipeline = 1;
+     }
+   return pipeline;
+}
+
+static void
+_evas_render_frame_begin(Evas_Public_Data *evas)
+{
+   evas->frame.pipelined = (evas->frame.next_start > 0.0);
+   if (evas->frame.pipelined) evas->frame.start = evas->frame.next_start;
+   else evas->frame.start = ecore_time_get();
+   evas->frame.next_start = 0.0;
+}
+
+static void
+_evas_render_pipeline_evaluate(Evas *eo_e, Evas_Public_Data *evas)
+{
+   eina_evlog("+render_pipeline_evaluate", eo_e, 0.0, NULL);
+   if (evas->frame.next_start <= 0.0)
+     evas->frame.next_start = ecore_time_get();
+   evas_render_pre(eo_e, evas);
+   evas_call_smarts_calculate(eo_e);
+   eina_evlog("-render_pipeline_evaluate", eo_e, 0.0, NULL);
+}
+
+/* Latency: from the beginning of the evaluation of a frame to the end of its
+ * rendering. Interval: between the ends of two frames. */
+static void
+_evas_render_frame_end(Evas *eo_e, Evas_Public_Data *evas)
+{
+   static int stats = -1;
+   double now, latency, interval = 0.0;
+   char buf[128];
+
+   if (stats == -1)
+     {
+        if (getenv("EVAS_RENDER_FRAME_STATS"))
+          stats = !!atoi(getenv("EVAS_RENDER_FRAME_STATS"));
+        else stats = 0;
+     }
+
+   now = ecore_time_get();
+   latency = now - evas->frame.start;
+   if (evas->frame.count) interval = now - evas->frame.last;
+   evas->frame.last = now;
+   evas->frame.count++;
+
+   snprintf(buf, sizeof(buf), "frame=%u latency=%.2fms interval=%.2fms pipelined=%i",
+            evas->frame.count, latency * 1000.0, interval * 1000.0,
+            evas->frame.pipelined);
+   eina_evlog("!render_frame", eo_e, 0.0, buf);
+   if (stats) fprintf(stderr, "EVAS RENDER %p: %s\n", eo_e, buf);
+}
+
 static Eina_Bool
 evas_render_updates_internal_loop(Evas *eo_e, Evas_Public_Data *evas,
                                   void *output, void *surface, void *context,
@@ -2968,7 +3542,7 @@ evas_render_updates_internal_loop(Evas *eo_e, Evas_Public_Data *evas,
    Evas_Object *eo_obj;
    Evas_Object_Protected_Data *obj;
    int off_x, off_y;
-   unsigned int i, j;
+   unsigned int i, j, culled = 0;
    Eina_Bool clean_them = EINA_FALSE;
    Eina_Bool above_top = EINA_FALSE;
 
@@ -3009,6 +3583,15 @@ evas_render_updates_internal_loop(Evas *eo_e, Evas_Public_Data *evas,
         ENFN->context_cutout_clear(ENC, context);
         ENFN->context_clip_unset(ENC, context);
      }
+   /* find the objects entirely hidden under the opaque ones above them */
+   if (!top)
+     {
+        if (!skip_cutouts && _evas_render_occlusion_enabled())
+          culled = _evas_render_occlusion_cull(evas, &evas->temporary_objects,
+                                               cutout_margin,
+                                               ux - fx, uy - fy, uw, uh);
+        evas->occlusion.update_pixels += (double)uw * uh;
+     }
    eina_evlog("-render_setup", eo_e, 0.0, NULL);
 
    eina_evlog("+render_objects", eo_e, 0.0, NULL);
@@ -3044,6 +3627,13 @@ evas_render_updates_internal_loop(Evas *eo_e, Evas_Public_Data *evas,
              if ((evas->temporary_objects.count > *offset) &&
                  (eina_array_data_get(&evas->temporary_objects, *offset) == obj))
                (*offset)++;
+             if (culled && evas->occlusion.hidden[i])
+               {
+                  RD(level, "      HIDDEN\n");
+                  if (obj->changed) obj->occluded_change = EINA_TRUE;
+                  evas->occlusion.culled++;
+                  continue;
+               }
              x = cx; y = cy; w = cw; h = ch;
              if (((w > 0) && (h > 0)) || (obj->is_smart))
                {
@@ -3065,6 +3655,11 @@ evas_render_updates_internal_loop(Evas *eo_e, Evas_Public_Data *evas,
                        RECTS_CLIP_TO_RECT(x, y, w, h, cfx, cfy,
                                           obj->cur->cache.clip.w,
                                           obj->cur->cache.clip.h);
+                       if (!top && (w > 0) && (h > 0))
+                         {
+                            evas->occlusion.drawn++;
+                            evas->occlusion.drawn_pixels += (double)w * h;
+                         }
                     }
 
                   ENFN->context_clip_set(ENC, context, x, y, w, h);
@@ -3132,6 +3727,7 @@ evas_render_updates_internal_loop(Evas *eo_e, Evas_Public_Data *evas,
                                                    off_x + fx, off_y + fy, 0,
                                                    cx, cy, cw, ch,
                                                    NULL, level + 3, do_async);
+                  obj->occluded_change = EINA_FALSE;
                   ENFN->context_cutout_clear(ENC, context);
 
                   if (mask) ENFN->context_clip_image_unset(ENC, context);
@@ -3284,7 +3880,11 @@ evas_render_updates_internal(Evas *eo_e,
    if (e->rendering)
      {
         if (do_async)
-          return EINA_FALSE;
+          {
+             if (_evas_render_pipeline_enabled())
+               _evas_render_pipeline_evaluate(eo_e, e);
+             return EINA_FALSE;
+          }
         else
           {
               WRN("Mixing render sync as already doing async "
@@ -3299,6 +3899,7 @@ evas_render_updates_internal(Evas *eo_e,
    double start_time = _time_get();
 #endif
 
+   _evas_render_frame_begin(e);
    evas_render_pre(eo_e, evas);
 
    _evas_planes(e);
@@ -3330,7 +3931,9 @@ evas_render_updates_internal(Evas *eo_e,
         p1ctx.delete_objects   = &e->delete_objects;
         p1ctx.render_objects   = &e->render_objects;
         p1ctx.snapshot_objects = &e->snapshot_objects;
+        p1ctx.pending_objects  = &e->pending_objects;
         p1ctx.redraw_all       = redraw_all;
+        p1ctx.clippers_fixed   = 0;
         clean_them = _evas_render_phase1_process(&p1ctx);
         redraw_all = p1ctx.redraw_all;
         eina_evlog("-render_phase1", eo_e, 0.0, NULL);
@@ -3394,6 +3997,10 @@ evas_render_updates_internal(Evas *eo_e,
 
    /* phase 5. add obscures */
    eina_evlog("+render_phase5", eo_e, 0.0, NULL);
+   e->occlusion.drawn = 0;
+   e->occlusion.culled = 0;
+   e->occlusion.drawn_pixels = 0.0;
+   e->occlusion.update_pixels = 0.0;
    EINA_LIST_FOREACH(e->obscures, ll, r)
      evas_render_update_del(e, r->x, r->y, r->w, r->h);
 
@@ -3646,9 +4253,11 @@ evas_render_updates_internal(Evas *eo_e,
                   _cb_always_call(eo_e, e, EVAS_CALLBACK_RENDER_FLUSH_POST, NULL);
                   _deferred_callbacks_process(eo_e, evas);
                   eina_evlog("-render_output_flush", eo_e, 0.0, NULL);
+                  _evas_render_frame_end(eo_e, e);
                }
           }
         rendering = haveup;
+        if (haveup) _evas_render_occlusion_stats_report(eo_e, e);
      }
    eina_evlog("-render_phase8", eo_e, 0.0, NULL);
 
@@ -3720,7 +4329,7 @@ evas_render_updates_internal(Evas *eo_e,
                                               EFL_CANVAS_OBJECT_CLASS);
              evas_object_change(obj->smart.parent, smart_parent);
              /* render cache must be invalidated to correctly render subobj on next pass */
-             evas_object_smart_render_cache_clear(obj->smart.parent);
+             evas_object_smart_render_cache_clear(smart_parent);
           }
         obj->changed = EINA_TRUE;
      }
@@ -3868,6 +4477,7 @@ evas_render_wakeup(Evas *eo_e)
              _evas_object_image_video_overlay_do(eo_obj);
           }
         _cb_always_call(eo_e, evas, EVAS_CALLBACK_RENDER_FLUSH_POST, NULL);
+        _evas_render_frame_end(eo_e, evas);
      }
 
    /* clear redraws */
@@ -8,6 +8,7 @@ typedef struct _Efl_Canvas_Vg_Container_Data        Efl_Canvas_Vg_Container_Data
 typedef struct _Efl_Canvas_Vg_Gradient_Data         Efl_Canvas_Vg_Gradient_Data;
 typedef struct _Efl_Canvas_Vg_Interpolation         Efl_Canvas_Vg_Interpolation;
 typedef struct _Efl_Canvas_Vg_Object_Data           Efl_Canvas_Vg_Object_Data;
+typedef struct _Vg_Frame_Cache                      Vg_Frame_Cache;
 
 typedef enum _Efl_Gfx_Vg_Value_Provider_Change_Flag Efl_Gfx_Vg_Value_Provider_Change_Flag;
 
@@ -52,6 +53,8 @@ struct _Efl_Canvas_Vg_Object_Data
    Eina_Array                 cleanup;
    double                     align_x, align_y;
    Efl_Canvas_Vg_Fill_Mode    fill_mode;
+   Efl_Canvas_Vg_Frame_Cache_Mode frame_cache_mode;
+   Vg_Frame_Cache            *frame_cache; //animation frames kept compressed
    int                        frame_idx;
 
    Eina_Bool                  changed : 1;
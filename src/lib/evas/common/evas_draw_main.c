@@ -135,6 +135,7 @@ evas_common_init(void)
    evas_common_convert_init();
    evas_common_scale_init();
    evas_common_scale_sample_init();
+   evas_common_thread_slice_init();
    evas_common_rectangle_init();
    evas_common_polygon_init();
    evas_common_line_init();
@@ -153,6 +154,7 @@ evas_common_shutdown(void)
    evas_common_image_shutdown();
    evas_common_image_cache_free();
    evas_common_scale_sample_shutdown();
+   evas_common_thread_slice_shutdown();
 // just in case any thread is still doing things... don't del this here
 //   RGBA_Draw_Context *dc;
 //   SLKL(_ctx_spares_lock);
@@ -201,6 +201,7 @@ struct _Fash_Int
 
 typedef struct _Fash_Glyph_Map  Fash_Glyph_Map;
 typedef struct _Fash_Glyph_Map2 Fash_Glyph_Map2;
+typedef struct _Fash_Glyph_Atlas_Page Fash_Glyph_Atlas_Page;
 typedef struct _Fash_Glyph      Fash_Glyph;
 struct _Fash_Glyph_Map
 {
@@ -210,10 +211,24 @@ struct _Fash_Glyph_Map2
 {
    Fash_Glyph_Map *bucket[256];
 };
+/* glyph outputs (and their rle data) of a font instance are packed into
+ * large pages instead of being allocated one by one. pages live as long as
+ * the fash they belong to */
+struct _Fash_Glyph_Atlas_Page
+{
+   Fash_Glyph_Atlas_Page *next;
+   unsigned int           size;
+   unsigned int           used;
+};
+/* most text only ever uses glyph indexes in the low range of a font, so
+ * those get a flat lookup table in front of the 3 level bucket tree */
+#define FASH_GLYPH_HOT_MAX 256
 struct _Fash_Glyph
 {
    unsigned int MAGIC;
+   RGBA_Font_Glyph *hot[FASH_GLYPH_HOT_MAX];
    Fash_Glyph_Map2 *bucket[256];
+   Fash_Glyph_Atlas_Page *atlas;
    void (*freeme) (Fash_Glyph *fash);
 };
 
@@ -443,6 +458,7 @@ EAPI int               evas_common_font_query_run_font_end_get(RGBA_Font *fn, RG
 EAPI void              evas_common_font_ascent_descent_get(RGBA_Font *fn, const Evas_Text_Props *text_props, int *ascent, int *descent);
 
 EAPI void             *evas_common_font_glyph_compress(void *data, int num_grays, int pixel_mode, int pitch_data, int w, int h, int *size_ret);
+EAPI void             *evas_common_font_glyph_compress_alloc(void *data, int num_grays, int pixel_mode, int pitch_data, int w, int h, int *size_ret, void *(*alloc_cb)(void *alloc_data, size_t size), void *alloc_data);
 EAPI DATA8            *evas_common_font_glyph_uncompress(RGBA_Font_Glyph *fg, int *wret, int *hret);
 EAPI int               evas_common_font_glyph_search         (RGBA_Font *fn, RGBA_Font_Int **fi_ret, Eina_Unicode gl, Eina_Unicode variation_sequence, uint32_t evas_font_search_options);
 
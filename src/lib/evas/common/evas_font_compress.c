@@ -112,7 +112,9 @@ alpha8to4(int a8)
 // [char] last byte of RLE data
 //
 static DATA8 *
-compress_rle4(DATA8 *src, int pitch, int w, int h, int *size_ret)
+compress_rle4(DATA8 *src, int pitch, int w, int h, int *size_ret,
+              void *(*alloc_cb)(void *alloc_data, size_t size),
+              void *alloc_data)
 {
    unsigned char *scratch, *p, *pix, spanval;
    int *jumptab, x, y, spanlen, spannum, total, size, *iptr, *pos;
@@ -189,7 +191,7 @@ compress_rle4(DATA8 *src, int pitch, int w, int h, int *size_ret)
    *size_ret = size;
    // allocate a fresh buffer where we will merge header, jumptable and RLE
    // spans inot a single block
-   buf = dst = malloc(size);
+   buf = dst = alloc_cb(alloc_data, size);
    if (!buf) return NULL;
    // 32bit int header to indicate encoding type (3, 2 or 1)
    iptr = (int *)dst;
@@ -313,7 +315,9 @@ decompress_rle4(DATA8 *src, DATA8 *dst, int pitch, int w EINA_UNUSED, int h)
 // between 4bit rle and 4bit packed and easily switch between these 2 encodings
 // based on which one is likely more compact and/or faster at runtime.
 static DATA8 *
-compress_bpp4(DATA8 *src, int pitch, int w, int h, int *size_ret)
+compress_bpp4(DATA8 *src, int pitch, int w, int h, int *size_ret,
+              void *(*alloc_cb)(void *alloc_data, size_t size),
+              void *alloc_data)
 {
    int pitch2, x, y, *iptr;
    DATA8 *buf, *p, *d, *s;
@@ -321,7 +325,7 @@ compress_bpp4(DATA8 *src, int pitch, int w, int h, int *size_ret)
    // our horizontal pitch in bytes ... rounding up to account for odd lengths
    pitch2 = (w + 1) / 2;
    // allocate the buffer size for header plus data
-   buf = malloc(sizeof(int) + (pitch2 * h));
+   buf = alloc_cb(alloc_data, sizeof(int) + (pitch2 * h));
    if (!buf) return NULL;
    // write the header value of 0
    iptr = (int *)buf;
@@ -402,9 +406,28 @@ decompress_bpp4(DATA8 *src, DATA8 *dst, int pitch, int w, int h)
 //--------------------------------------------------------------------------
 //- GENERAL ----------------------------------------------------------------
 //--------------------------------------------------------------------------
+static void *
+_glyph_malloc(void *alloc_data EINA_UNUSED, size_t size)
+{
+   return malloc(size);
+}
+
 EAPI void *
 evas_common_font_glyph_compress(void *data, int num_grays, int pixel_mode,
                                 int pitch_data, int w, int h, int *size_ret)
+{
+   return evas_common_font_glyph_compress_alloc(data, num_grays, pixel_mode,
+                                                pitch_data, w, h, size_ret,
+                                                _glyph_malloc, NULL);
+}
+
+// same as above, but the final compressed blob is allocated through alloc_cb
+// so callers can pack glyphs into their own storage (eg a glyph atlas)
+EAPI void *
+evas_common_font_glyph_compress_alloc(void *data, int num_grays, int pixel_mode,
+                                      int pitch_data, int w, int h, int *size_ret,
+                                      void *(*alloc_cb)(void *alloc_data, size_t size),
+                                      void *alloc_data)
 {
    DATA8 *inbuf, *buf;
    int size = 0, pitch = 0;
@@ -428,10 +451,10 @@ evas_common_font_glyph_compress(void *data, int num_grays, int pixel_mode,
    // encoding is faster (and smaller) than 4bit RLE.
    if ((w * h) < (16 * 16))
      // compress to 4bit per pixel, raw
-     buf = compress_bpp4(inbuf, pitch, w, h, &size);
+     buf = compress_bpp4(inbuf, pitch, w, h, &size, alloc_cb, alloc_data);
    else
      // compress to 4bit per pixel, run length encoded per row
-     buf = compress_rle4(inbuf, pitch, w, h, &size);
+     buf = compress_rle4(inbuf, pitch, w, h, &size, alloc_cb, alloc_data);
    *size_ret = size;
    return buf;
 }
@@ -15,6 +15,17 @@ struct _Evas_Glyph
    FT_UInt idx;
 };
 
+typedef struct _Evas_Font_Glyph_Tab Evas_Font_Glyph_Tab;
+struct _Evas_Font_Glyph_Tab
+{
+   DATA32 coltab[16];
+   DATA16 mtab[16];
+};
+
+static inline Eina_Bool _evas_font_glyph_clip(int x, int y, int w, int h, int cx, int cy, int cw, int ch, int *x1, int *x2, int *y1, int *y2);
+static inline void _evas_font_glyph_tab_init(Evas_Font_Glyph_Tab *tab, DATA32 col);
+static void _evas_font_glyph_rle_draw(RGBA_Font_Glyph_Out *fgo, DATA32 *dst, int dst_pitch, int x, int y, int x1, int x2, int y1, int y2, const Evas_Font_Glyph_Tab *tab);
+
 EAPI void
 evas_common_font_draw_init(void)
 {
@@ -86,10 +97,19 @@ evas_common_font_rgba_draw(RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y,
                            int ext_h, int im_w, int im_h EINA_UNUSED)
 {
    Evas_Glyph *glyph;
+   Evas_Font_Glyph_Tab tab;
+   Eina_Bool batch;
 
    if (!glyphs) return EINA_FALSE;
    if (!glyphs->array) return EINA_FALSE;
 
+   // the common case of plain argb destination without mask or engine
+   // extension draws the whole run with one set of color tables and
+   // blits glyphs straight from the font atlas
+   batch = ((dst->cache_entry.space != EVAS_COLORSPACE_GRY8) &&
+            (!dc->clip.mask) && (!dc->font_ext.func.gl_draw));
+   if (batch) _evas_font_glyph_tab_init(&tab, dc->col.col);
+
    EINA_INARRAY_FOREACH(glyphs->array, glyph)
      {
         RGBA_Font_Glyph *fg;
@@ -147,6 +167,20 @@ evas_common_font_rgba_draw(RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y,
                          dc->font_ext.func.gl_draw(dc->font_ext.data, dst,
                                                    dc, fg,
                                                    chr_x, y - (chr_y - y), w, h);
+                       else if (batch)
+                         {
+                            int x1, x2, y1, y2;
+
+                            if (_evas_font_glyph_clip(chr_x, y - (chr_y - y),
+                                                      fg->glyph_out->bitmap.width,
+                                                      fg->glyph_out->bitmap.rows,
+                                                      ext_x, ext_y, ext_w, ext_h,
+                                                      &x1, &x2, &y1, &y2))
+                              _evas_font_glyph_rle_draw(fg->glyph_out,
+                                                        dst->image.data, im_w,
+                                                        chr_x, y - (chr_y - y),
+                                                        x1, x2, y1, y2, &tab);
+                         }
                        else
                          // TODO: scale with evas_font_compress_draw.c...
                          evas_common_font_glyph_draw(fg, dc, dst, im_w,
@@ -439,6 +473,79 @@ evas_common_font_draw_prepare_cutout(Cutout_Rects **reuse, RGBA_Image *dst, RGBA
    return EINA_TRUE;
 }
 
+// figure the x1/x2 and y1/y2 limit range of a glyph of size w x h at x, y
+// within the clip. returns false if it is totally clipped out
+static inline Eina_Bool
+_evas_font_glyph_clip(int x, int y, int w, int h,
+                      int cx, int cy, int cw, int ch,
+                      int *x1, int *x2, int *y1, int *y2)
+{
+   if ((y >= (cy + ch)) || ((y + h) <= cy) ||
+       (x >= (cx + cw)) || ((x + w) <= cx)) return EINA_FALSE;
+   *y1 = 0; *y2 = h;
+   if ((y + *y1) < cy) *y1 = cy - y;
+   if ((y + *y2) > (cy + ch)) *y2 = cy + ch - y;
+   *x1 = 0; *x2 = w;
+   if ((x + *x1) < cx) *x1 = cx - x;
+   if ((x + *x2) > (cx + cw)) *x2 = cx + cw - x;
+   return EINA_TRUE;
+}
+
+// build fast multiply + mask color tables to avoid compute. this works
+// because of our very limited 4bit range of alpha values
+static inline void
+_evas_font_glyph_tab_init(Evas_Font_Glyph_Tab *tab, DATA32 col)
+{
+   DATA16 v;
+   int i;
+
+   for (i = 0; i <= 0xf; i++)
+     {
+        v = (i << 4) | i;
+        tab->coltab[i] = MUL_SYM(v, col);
+        tab->mtab[i] = 256 - (tab->coltab[i] >> 24);
+     }
+}
+
+// blend the (already clipped to x1,y1 - x2,y2) compressed glyph with the
+// color tables given, picking the best cpu specific expansion available
+static void
+_evas_font_glyph_rle_draw(RGBA_Font_Glyph_Out *fgo, DATA32 *dst, int dst_pitch,
+                          int x, int y, int x1, int x2, int y1, int y2,
+                          const Evas_Font_Glyph_Tab *tab)
+{
+   const DATA32 *coltab = tab->coltab;
+   const DATA16 *mtab = tab->mtab;
+   int w, h, *iptr;
+   DATA16 v;
+
+   w = fgo->bitmap.width; h = fgo->bitmap.rows;
+#ifdef BUILD_MMX
+   if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
+     {
+#define MMX 1
+#include "evas_font_compress_draw.c"
+#undef MMX
+     }
+   else
+#endif
+
+#ifdef BUILD_NEON
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
+     {
+#define NEON 1
+#include "evas_font_compress_draw.c"
+#undef NEON
+     }
+   else
+#endif
+
+     // Plain C
+     {
+#include "evas_font_compress_draw.c"
+     }
+}
+
 // this draws a compressed font glyph and decompresses on the fly as it
 // draws, saving memory bandwidth and providing speedups
 EAPI void
@@ -448,10 +555,9 @@ evas_common_font_glyph_draw(RGBA_Font_Glyph *fg,
                             int dx, int dy, int dw, int dh, int cx, int cy, int cw, int ch)
 {
    RGBA_Font_Glyph_Out *fgo = fg->glyph_out;
-   int x, y, w, h, x1, x2, y1, y2, i, *iptr;
+   int x, y, w, h, x1, x2, y1, y2;
    DATA32 *dst = dst_image->image.data;
-   DATA32 coltab[16], col;
-   DATA16 mtab[16], v;
+   DATA32 col;
 
    // FIXME: Use dw, dh for scaling glyphs...
    (void) dw;
@@ -459,17 +565,8 @@ evas_common_font_glyph_draw(RGBA_Font_Glyph *fg,
    x = dx;
    y = dy;
    w = fgo->bitmap.width; h = fgo->bitmap.rows;
-   // skip if totally clipped out
-   if ((y >= (cy + ch)) || ((y + h) <= cy) ||
-       (x >= (cx + cw)) || ((x + w) <= cx)) return;
-   // figure y1/y2 limit range
-   y1 = 0; y2 = h;
-   if ((y + y1) < cy) y1 = cy - y;
-   if ((y + y2) > (cy + ch)) y2 = cy + ch - y;
-   // figure x1/x2 limit range
-   x1 = 0; x2 = w;
-   if ((x + x1) < cx) x1 = cx - x;
-   if ((x + x2) > (cx + cw)) x2 = cx + cw - x;
+   if (!_evas_font_glyph_clip(x, y, w, h, cx, cy, cw, ch,
+                              &x1, &x2, &y1, &y2)) return;
    col = dc->col.col;
    if (dst_image->cache_entry.space == EVAS_COLORSPACE_GRY8)
      {
@@ -555,38 +652,10 @@ evas_common_font_glyph_draw(RGBA_Font_Glyph *fg,
      }
    else
      {
-        // build fast multiply + mask color tables to avoid compute. this works
-        // because of our very limited 4bit range of alpha values
-        for (i = 0; i <= 0xf; i++)
-          {
-             v = (i << 4) | i;
-             coltab[i] = MUL_SYM(v, col);
-             mtab[i] = 256 - (coltab[i] >> 24);
-          }
-#ifdef BUILD_MMX
-        if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
-          {
-#define MMX 1
-#include "evas_font_compress_draw.c"
-#undef MMX
-          }
-        else
-#endif
+        Evas_Font_Glyph_Tab tab;
 
-#ifdef BUILD_NEON
-        if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
-          {
-#define NEON 1
-#include "evas_font_compress_draw.c"
-#undef NEON
-          }
-        else
-#endif
-
-          // Plain C
-          {
-#include "evas_font_compress_draw.c"
-          }
+        _evas_font_glyph_tab_init(&tab, col);
+        _evas_font_glyph_rle_draw(fgo, dst, dst_pitch, x, y,
+                                  x1, x2, y1, y2, &tab);
      }
 }
-
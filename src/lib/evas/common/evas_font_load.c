@@ -89,6 +89,7 @@ _evas_common_font_int_free(RGBA_Font_Int *fi)
    LKD(fi->ft_mutex);
 #ifdef USE_HARFBUZZ
    hb_font_destroy(fi->ft.hb_font);
+   evas_common_font_ot_cache_font_del(fi);
 #endif
    evas_common_font_source_free(fi->src);
    if (fi->references <= 0) fonts_lru = eina_list_remove(fonts_lru, fi);
@@ -70,6 +70,10 @@ evas_common_font_shutdown(void)
    FT_Done_FreeType(evas_ft_lib);
    evas_ft_lib = 0;
 
+#ifdef OT_SUPPORT
+   evas_common_font_ot_cache_shutdown();
+#endif
+
    LKD(lock_font_draw);
    LKD(lock_bidi);
    LKD(lock_ot);
@@ -660,10 +664,69 @@ _fash_gl_free(Fash_Glyph *fash)
                  fash->bucket[i] = NULL;
               }
           }
+         // glyphs may point into the atlas pages so they go last
+         while (fash->atlas)
+           {
+              Fash_Glyph_Atlas_Page *page = fash->atlas;
+
+              fash->atlas = page->next;
+              free(page);
+           }
          free(fash);
      }
 }
 
+// size of a regular atlas page. glyph data bigger than a quarter of that
+// gets a page of its own so we don't waste the tail of the current page
+#define FASH_GLYPH_ATLAS_PAGE_SIZE (64 * 1024)
+#define FASH_GLYPH_ATLAS_ALIGN(_s) (((_s) + 15) & ~((size_t)15))
+#define FASH_GLYPH_ATLAS_HEADER FASH_GLYPH_ATLAS_ALIGN(sizeof(Fash_Glyph_Atlas_Page))
+
+static void *
+_fash_gl_atlas_alloc(void *data, size_t size)
+{
+   Fash_Glyph *fash = data;
+   Fash_Glyph_Atlas_Page *page;
+   unsigned char *ptr;
+
+   size = FASH_GLYPH_ATLAS_ALIGN(size);
+   page = fash->atlas;
+   if ((page) && ((page->size - page->used) >= size))
+     {
+        ptr = (unsigned char *)page + FASH_GLYPH_ATLAS_HEADER + page->used;
+        page->used += size;
+        return ptr;
+     }
+
+   if (size > (FASH_GLYPH_ATLAS_PAGE_SIZE / 4))
+     {
+        page = malloc(FASH_GLYPH_ATLAS_HEADER + size);
+        if (!page) return NULL;
+        page->size = size;
+        page->used = size;
+        // keep the current (partially used) page at the head
+        if (fash->atlas)
+          {
+             page->next = fash->atlas->next;
+             fash->atlas->next = page;
+          }
+        else
+          {
+             page->next = NULL;
+             fash->atlas = page;
+          }
+        return (unsigned char *)page + FASH_GLYPH_ATLAS_HEADER;
+     }
+
+   page = malloc(FASH_GLYPH_ATLAS_HEADER + FASH_GLYPH_ATLAS_PAGE_SIZE);
+   if (!page) return NULL;
+   page->size = FASH_GLYPH_ATLAS_PAGE_SIZE;
+   page->used = size;
+   page->next = fash->atlas;
+   fash->atlas = page;
+   return (unsigned char *)page + FASH_GLYPH_ATLAS_HEADER;
+}
+
 static Fash_Glyph *
 _fash_gl_new(void)
 {
@@ -679,6 +742,7 @@ _fash_gl_find(Fash_Glyph *fash, int item)
 {
    int grp, maj, min;
 
+   if ((unsigned int)item < FASH_GLYPH_HOT_MAX) return fash->hot[item];
    // 24bits for unicode - v6 up to E01EF (chrs) & 10FFFD for private use (plane 16)
    grp = (item >> 16) & 0xff;
    maj = (item >> 8) & 0xff;
@@ -704,6 +768,8 @@ _fash_gl_add(Fash_Glyph *fash, int item, RGBA_Font_Glyph *glyph)
      fash->bucket[grp]->bucket[maj] = calloc(1, sizeof(Fash_Glyph_Map));
    EINA_SAFETY_ON_NULL_RETURN(fash->bucket[grp]->bucket[maj]);
    fash->bucket[grp]->bucket[maj]->item[min] = glyph;
+   // the hot table only aliases the buckets which still own the glyph
+   if ((unsigned int)item < FASH_GLYPH_HOT_MAX) fash->hot[item] = glyph;
 }
 
 EAPI RGBA_Font_Glyph *
@@ -824,7 +890,11 @@ evas_common_font_int_cache_glyph_render(RGBA_Font_Glyph *fg)
 
    fbg = (FT_BitmapGlyph)fg->glyph;
 
-   fg->glyph_out = calloc(1, sizeof(RGBA_Font_Glyph_Out));
+   if (!fi->fash) return EINA_FALSE;
+   fg->glyph_out = _fash_gl_atlas_alloc(fi->fash, sizeof(RGBA_Font_Glyph_Out));
+   if (!fg->glyph_out) return EINA_FALSE;
+   memset(fg->glyph_out, 0, sizeof(RGBA_Font_Glyph_Out));
+   fg->glyph_out->bitmap.no_free_glout = EINA_TRUE;
    fg->glyph_out->bitmap.rows = fbg->bitmap.rows;
    fg->glyph_out->bitmap.width = fbg->bitmap.width;
    fg->glyph_out->bitmap.pitch = fbg->bitmap.pitch;
@@ -841,11 +911,14 @@ evas_common_font_int_cache_glyph_render(RGBA_Font_Glyph *fg)
 
    if (!FT_HAS_COLOR(fi->src->ft.face))
      {
-        fg->glyph_out->rle = evas_common_font_glyph_compress
+        // rle data is packed in the atlas too so it is never freed alone
+        fg->glyph_out->rle = evas_common_font_glyph_compress_alloc
            (fbg->bitmap.buffer, fbg->bitmap.num_grays, fbg->bitmap.pixel_mode,
             fbg->bitmap.pitch, fbg->bitmap.width, fbg->bitmap.rows,
-            &(fg->glyph_out->rle_size));
-        fg->glyph_out->bitmap.rle_alloc = EINA_TRUE;
+            &(fg->glyph_out->rle_size), _fash_gl_atlas_alloc, fi->fash);
+        // the rle data belongs to the atlas, rle_alloc just keeps
+        // _glyph_free() from releasing the ft bitmap a second time
+        fg->glyph_out->bitmap.rle_alloc = !fg->glyph_out->rle;
 
         fg->glyph_out->bitmap.buffer = NULL;
 
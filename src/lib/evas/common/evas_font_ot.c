@@ -264,6 +264,278 @@ _evas_common_font_ot_shape(hb_buffer_t *buffer, RGBA_Font_Int *fi, Evas_Text_Pro
      }
 }
 
+/* Shaping cache
+ *
+ * Shaping the same run with the same font again always gives the same
+ * result, and layouts (lists, relayouts of textblocks) do that a lot. So
+ * keep the harfbuzz output (glyph indexes, advances and offsets) of recent
+ * runs in a LRU, keyed by everything that goes into hb_shape(). Entries are
+ * single allocations holding the key text and both result arrays. */
+
+typedef struct _Evas_Font_OT_Cache_Item Evas_Font_OT_Cache_Item;
+struct _Evas_Font_OT_Cache_Item
+{
+   EINA_INLIST;
+   RGBA_Font_Int *fi;
+   const char *lang;
+   const Eina_Unicode *text;
+   Evas_Font_OT_Info *ot;
+   Evas_Font_Glyph_Info *glyph;
+   unsigned int hash;
+   int generation;
+   int text_len;
+   unsigned int len;
+   unsigned int size;
+   unsigned char script;
+   unsigned char bidi_dir;
+   unsigned char mode;
+};
+
+/* runs longer than this are rarely shaped twice the same, don't bother */
+#define EVAS_FONT_OT_CACHE_RUN_MAX 512
+#define EVAS_FONT_OT_CACHE_DEFAULT (512 * 1024)
+
+static Eina_Hash *_ot_cache = NULL;
+static Eina_Inlist *_ot_cache_lru = NULL;
+static int _ot_cache_size = -1;
+static int _ot_cache_usage = 0;
+static Evas_Font_OT_Cache_Stats _ot_cache_stats;
+
+static unsigned int
+_evas_common_font_ot_cache_key_length(const void *key EINA_UNUSED)
+{
+   return sizeof(Evas_Font_OT_Cache_Item);
+}
+
+static int
+_evas_common_font_ot_cache_key_cmp(const Evas_Font_OT_Cache_Item *k1,
+                                   int k1_length EINA_UNUSED,
+                                   const Evas_Font_OT_Cache_Item *k2,
+                                   int k2_length EINA_UNUSED)
+{
+   if (k1->fi != k2->fi) return (k1->fi < k2->fi) ? -1 : 1;
+   if (k1->generation != k2->generation)
+     return k1->generation - k2->generation;
+   if (k1->text_len != k2->text_len) return k1->text_len - k2->text_len;
+   if (k1->script != k2->script) return k1->script - k2->script;
+   if (k1->bidi_dir != k2->bidi_dir) return k1->bidi_dir - k2->bidi_dir;
+   if (k1->mode != k2->mode) return k1->mode - k2->mode;
+   if (k1->lang != k2->lang)
+     {
+        if (!k1->lang) return -1;
+        if (!k2->lang) return 1;
+        if (strcmp(k1->lang, k2->lang)) return strcmp(k1->lang, k2->lang);
+     }
+   return memcmp(k1->text, k2->text, k1->text_len * sizeof(Eina_Unicode));
+}
+
+static int
+_evas_common_font_ot_cache_key_hash(const Evas_Font_OT_Cache_Item *key,
+                                    int key_length EINA_UNUSED)
+{
+   return key->hash;
+}
+
+static unsigned int
+_evas_common_font_ot_cache_hash_calc(const Evas_Font_OT_Cache_Item *key)
+{
+   unsigned long long fi = (uintptr_t)key->fi;
+   unsigned int hash;
+   int tmp;
+
+   hash = eina_hash_superfast((const char *)key->text,
+                              key->text_len * sizeof(Eina_Unicode));
+   hash ^= eina_hash_int64(&fi, sizeof(fi));
+   tmp = (key->script << 16) | (key->bidi_dir << 8) | key->mode;
+   hash ^= eina_hash_int32((const unsigned int *)&tmp, sizeof(int));
+   if (key->lang) hash ^= eina_hash_djb2(key->lang, strlen(key->lang));
+   return hash;
+}
+
+static void
+_evas_common_font_ot_cache_item_del(Evas_Font_OT_Cache_Item *item)
+{
+   _ot_cache_lru = eina_inlist_remove(_ot_cache_lru, EINA_INLIST_GET(item));
+   _ot_cache_usage -= item->size;
+   eina_hash_del_by_key(_ot_cache, item);
+   free(item);
+}
+
+static void
+_evas_common_font_ot_cache_trim(int size)
+{
+   while ((_ot_cache_usage > size) && (_ot_cache_lru))
+     {
+        Evas_Font_OT_Cache_Item *item;
+
+        /* least recently used items live at the end */
+        item = EINA_INLIST_CONTAINER_GET(_ot_cache_lru->last,
+                                         Evas_Font_OT_Cache_Item);
+        _evas_common_font_ot_cache_item_del(item);
+        _ot_cache_stats.evictions++;
+     }
+}
+
+static Eina_Bool
+_evas_common_font_ot_cache_enabled(void)
+{
+   if (_ot_cache_size < 0)
+     {
+        const char *s = getenv("EVAS_FONT_SHAPE_CACHE");
+
+        if (s) _ot_cache_size = atoi(s) * 1024;
+        else _ot_cache_size = EVAS_FONT_OT_CACHE_DEFAULT;
+        if (_ot_cache_size < 0) _ot_cache_size = 0;
+     }
+   if (_ot_cache_size == 0) return EINA_FALSE;
+   if (!_ot_cache)
+     _ot_cache = eina_hash_new
+       (EINA_KEY_LENGTH(_evas_common_font_ot_cache_key_length),
+        EINA_KEY_CMP(_evas_common_font_ot_cache_key_cmp),
+        EINA_KEY_HASH(_evas_common_font_ot_cache_key_hash),
+        NULL, 10);
+   return !!_ot_cache;
+}
+
+static Eina_Bool
+_evas_common_font_ot_cache_get(Evas_Font_OT_Cache_Item *key,
+                               Evas_Text_Props *props)
+{
+   Evas_Font_OT_Cache_Item *item;
+
+   item = eina_hash_find(_ot_cache, key);
+   if (!item)
+     {
+        _ot_cache_stats.misses++;
+        return EINA_FALSE;
+     }
+
+   props->len = item->len;
+   props->info->ot = malloc(item->len * sizeof(Evas_Font_OT_Info));
+   props->info->glyph = malloc(item->len * sizeof(Evas_Font_Glyph_Info));
+   if ((!props->info->ot) || (!props->info->glyph))
+     {
+        free(props->info->ot);
+        free(props->info->glyph);
+        props->info->ot = NULL;
+        props->info->glyph = NULL;
+        props->len = 0;
+        return EINA_FALSE;
+     }
+   memcpy(props->info->ot, item->ot, item->len * sizeof(Evas_Font_OT_Info));
+   memcpy(props->info->glyph, item->glyph,
+          item->len * sizeof(Evas_Font_Glyph_Info));
+
+   _ot_cache_lru = eina_inlist_promote(_ot_cache_lru, EINA_INLIST_GET(item));
+   _ot_cache_stats.hits++;
+   return EINA_TRUE;
+}
+
+static void
+_evas_common_font_ot_cache_add(const Evas_Font_OT_Cache_Item *key,
+                               const Evas_Text_Props *props)
+{
+   Evas_Font_OT_Cache_Item *item;
+   size_t text_size, ot_size, glyph_size, lang_size, size;
+   unsigned char *p;
+
+   text_size = key->text_len * sizeof(Eina_Unicode);
+   ot_size = props->len * sizeof(Evas_Font_OT_Info);
+   glyph_size = props->len * sizeof(Evas_Font_Glyph_Info);
+   lang_size = key->lang ? strlen(key->lang) + 1 : 0;
+   /* keep the arrays naturally aligned: biggest alignment first */
+   size = sizeof(Evas_Font_OT_Cache_Item) + ot_size + glyph_size +
+      text_size + lang_size;
+   if ((int)size > (_ot_cache_size / 4)) return;
+
+   _evas_common_font_ot_cache_trim(_ot_cache_size - size);
+
+   item = malloc(size);
+   if (!item) return;
+   *item = *key;
+   p = (unsigned char *)(item + 1);
+   item->ot = (Evas_Font_OT_Info *)p;
+   memcpy(p, props->info->ot, ot_size);
+   p += ot_size;
+   item->glyph = (Evas_Font_Glyph_Info *)p;
+   memcpy(p, props->info->glyph, glyph_size);
+   p += glyph_size;
+   item->text = (Eina_Unicode *)p;
+   memcpy(p, key->text, text_size);
+   p += text_size;
+   if (key->lang)
+     {
+        item->lang = (const char *)p;
+        memcpy(p, key->lang, lang_size);
+     }
+   item->len = props->len;
+   item->size = size;
+
+   if (!eina_hash_direct_add(_ot_cache, item, item))
+     {
+        free(item);
+        return;
+     }
+   _ot_cache_lru = eina_inlist_prepend(_ot_cache_lru, EINA_INLIST_GET(item));
+   _ot_cache_usage += size;
+}
+
+EAPI void
+evas_common_font_ot_cache_set(int size)
+{
+   OTLOCK();
+   _ot_cache_size = (size < 0) ? 0 : size;
+   _evas_common_font_ot_cache_trim(_ot_cache_size);
+   OTUNLOCK();
+}
+
+EAPI int
+evas_common_font_ot_cache_get(void)
+{
+   int size;
+
+   OTLOCK();
+   _evas_common_font_ot_cache_enabled();
+   size = _ot_cache_size;
+   OTUNLOCK();
+   return size;
+}
+
+EAPI void
+evas_common_font_ot_cache_stats_get(Evas_Font_OT_Cache_Stats *stats)
+{
+   if (!stats) return;
+   OTLOCK();
+   *stats = _ot_cache_stats;
+   stats->usage = _ot_cache_usage;
+   stats->items = _ot_cache ? eina_hash_population(_ot_cache) : 0;
+   OTUNLOCK();
+}
+
+void
+evas_common_font_ot_cache_font_del(void *fi)
+{
+   Evas_Font_OT_Cache_Item *item;
+   Eina_Inlist *l;
+
+   OTLOCK();
+   EINA_INLIST_FOREACH_SAFE(_ot_cache_lru, l, item)
+     {
+        if (item->fi == fi) _evas_common_font_ot_cache_item_del(item);
+     }
+   OTUNLOCK();
+}
+
+void
+evas_common_font_ot_cache_shutdown(void)
+{
+   _evas_common_font_ot_cache_trim(0);
+   if (_ot_cache) eina_hash_free(_ot_cache);
+   _ot_cache = NULL;
+   _ot_cache_size = -1;
+   memset(&_ot_cache_stats, 0, sizeof(_ot_cache_stats));
+}
+
 EAPI Eina_Bool
 evas_common_font_ot_populate_text_props(const Eina_Unicode *text,
                                         Evas_Text_Props *props, int len,
@@ -278,6 +550,8 @@ evas_common_font_ot_populate_text_props(const Eina_Unicode *text,
    unsigned int i;
    Evas_Font_Glyph_Info *gl_itr;
    Evas_Font_OT_Info *ot_itr;
+   Evas_Font_OT_Cache_Item key;
+   Eina_Bool use_cache;
    Evas_Coord pen_x = 0;
 
    fi = props->font_instance;
@@ -291,6 +565,28 @@ evas_common_font_ot_populate_text_props(const Eina_Unicode *text,
         slen = len;
      }
 
+   key.fi = fi;
+   key.generation = fi->generation;
+   key.text = text;
+   key.text_len = slen;
+   key.lang = lang;
+   key.script = props->script;
+   key.bidi_dir = props->bidi_dir;
+   key.mode = mode;
+   OTLOCK();
+   use_cache = ((slen <= EVAS_FONT_OT_CACHE_RUN_MAX) &&
+                _evas_common_font_ot_cache_enabled());
+   if (use_cache)
+     {
+        key.hash = _evas_common_font_ot_cache_hash_calc(&key);
+        if (_evas_common_font_ot_cache_get(&key, props))
+          {
+             OTUNLOCK();
+             return EINA_FALSE;
+          }
+     }
+   OTUNLOCK();
+
    buffer = hb_buffer_create();
    hb_buffer_set_unicode_funcs(buffer, _evas_common_font_ot_unicode_funcs_get());
    hb_buffer_set_language(buffer, hb_language_from_string(lang, -1));
@@ -331,6 +627,13 @@ evas_common_font_ot_populate_text_props(const Eina_Unicode *text,
    hb_buffer_destroy(buffer);
    evas_common_font_int_use_trim();
 
+   if ((use_cache) && (props->info->ot) && (props->info->glyph))
+     {
+        OTLOCK();
+        _evas_common_font_ot_cache_add(&key, props);
+        OTUNLOCK();
+     }
+
    return EINA_FALSE;
 }
 
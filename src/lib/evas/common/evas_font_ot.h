@@ -34,11 +34,43 @@ struct _Evas_Font_OT_Info
 
 #include "evas_font.h"
 
+typedef struct _Evas_Font_OT_Cache_Stats Evas_Font_OT_Cache_Stats;
+
+/* counters of the shaping cache, see evas_common_font_ot_cache_set() */
+struct _Evas_Font_OT_Cache_Stats
+{
+   unsigned long long hits;
+   unsigned long long misses;
+   unsigned long long evictions;
+   int usage; /* bytes */
+   int items;
+};
+
 EAPI int
 evas_common_font_ot_cluster_size_get(const Evas_Text_Props *props, size_t char_index);
 
 EAPI Eina_Bool
 evas_common_font_ot_populate_text_props(const Eina_Unicode *text,
       Evas_Text_Props *props, int len, Evas_Text_Props_Mode mode, const char *lang);
+
+# ifdef OT_SUPPORT
+/* the shaping cache size in bytes, 0 disables it. the default can be set in
+ * kilobytes with the EVAS_FONT_SHAPE_CACHE environment variable */
+EAPI void
+evas_common_font_ot_cache_set(int size);
+
+EAPI int
+evas_common_font_ot_cache_get(void);
+
+EAPI void
+evas_common_font_ot_cache_stats_get(Evas_Font_OT_Cache_Stats *stats);
+
+/* fi is a RGBA_Font_Int, which can't be seen from here */
+void
+evas_common_font_ot_cache_font_del(void *fi);
+
+void
+evas_common_font_ot_cache_shutdown(void);
+# endif
 #endif
 
@@ -0,0 +1,260 @@
+#include "evas_common_private.h"
+
+#include "Ecore.h"
+
+/* Small pool of worker threads used to split a data parallel job (rows of
+ * a filter buffer, ...) in slices. The calling thread always takes part in
+ * the work and only returns once every slice is done, so callers do not
+ * need any extra synchronisation. Only one job runs at a time, concurrent
+ * or nested callers just run their job inline. The threads are only
+ * started by the first job that can be split.
+ */
+
+#define SLICE_THREADS_MAX 16
+
+typedef struct _Evas_Thread_Slice_Job Evas_Thread_Slice_Job;
+
+struct _Evas_Thread_Slice_Job
+{
+   Evas_Thread_Slice_Cb cb;
+   void *data;
+   int count;
+   int step;
+   int next;
+   int done;
+};
+
+static Eina_Thread slice_threads[SLICE_THREADS_MAX];
+static int slice_threads_count = 0;
+static int slice_threads_wanted = 0;
+static Eina_Bool slice_started = EINA_FALSE;
+static Eina_Lock slice_start_lock;
+static Eina_Lock slice_run_lock;
+static Eina_Lock slice_lock;
+static Eina_Condition slice_cond;
+static Eina_Condition slice_done_cond;
+static Evas_Thread_Slice_Job *slice_job = NULL;
+static unsigned int slice_generation = 0;
+static Eina_Bool slice_exit = EINA_FALSE;
+
+/* Called and returns with slice_lock held */
+static void
+_evas_thread_slice_work(Evas_Thread_Slice_Job *job)
+{
+   while (job->next < job->count)
+     {
+        int start, end;
+
+        start = job->next;
+        end = start + job->step;
+        if (end > job->count) end = job->count;
+        job->next = end;
+
+        eina_lock_release(&slice_lock);
+        job->cb(job->data, start, end);
+        eina_lock_take(&slice_lock);
+
+        job->done += end - start;
+     }
+
+   if (job->done == job->count)
+     eina_condition_broadcast(&slice_done_cond);
+}
+
+static void *
+_evas_thread_slice_worker(void *data EINA_UNUSED, Eina_Thread t EINA_UNUSED)
+{
+   unsigned int generation;
+
+   eina_thread_name_set(eina_thread_self(), "Evas-slice");
+
+   eina_lock_take(&slice_lock);
+   generation = slice_generation;
+   while (1)
+     {
+        while (!slice_exit && (generation == slice_generation))
+          eina_condition_wait(&slice_cond);
+        if (slice_exit) break;
+
+        generation = slice_generation;
+        if (slice_job) _evas_thread_slice_work(slice_job);
+     }
+   eina_lock_release(&slice_lock);
+
+   return NULL;
+}
+
+static Eina_Bool
+_evas_thread_slice_start(int count)
+{
+   int i;
+
+   if (!eina_lock_new(&slice_run_lock))
+     goto on_error;
+   if (!eina_lock_new(&slice_lock))
+     goto on_error_run;
+   if (!eina_condition_new(&slice_cond, &slice_lock))
+     goto on_error_lock;
+   if (!eina_condition_new(&slice_done_cond, &slice_lock))
+     goto on_error_cond;
+
+   slice_exit = EINA_FALSE;
+   slice_job = NULL;
+   for (i = 0; i < count; i++)
+     {
+        if (!eina_thread_create(&slice_threads[i], EINA_THREAD_NORMAL, -1,
+                                _evas_thread_slice_worker, NULL))
+          {
+             ERR("Could not create slice thread %d", i);
+             break;
+          }
+     }
+   slice_threads_count = i;
+   if (!i) goto on_error_threads;
+   return EINA_TRUE;
+
+on_error_threads:
+   eina_condition_free(&slice_done_cond);
+on_error_cond:
+   eina_condition_free(&slice_cond);
+on_error_lock:
+   eina_lock_free(&slice_lock);
+on_error_run:
+   eina_lock_free(&slice_run_lock);
+on_error:
+   CRI("Could not start the slice threads");
+   slice_threads_count = 0;
+   return EINA_FALSE;
+}
+
+static void
+evas_common_thread_slice_fork_reset(void *data EINA_UNUSED)
+{
+   int count = slice_threads_count;
+
+   // Only the forking thread survives, just start over.
+   slice_threads_count = 0;
+   if (count) _evas_thread_slice_start(count);
+}
+
+static Eina_Bool
+_evas_thread_slice_started(void)
+{
+   eina_lock_take(&slice_start_lock);
+   if (!slice_started)
+     {
+        slice_started = EINA_TRUE;
+        _evas_thread_slice_start(slice_threads_wanted);
+     }
+   eina_lock_release(&slice_start_lock);
+
+   return slice_threads_count > 0;
+}
+
+EAPI void
+evas_common_thread_slice_init(void)
+{
+   const char *s;
+   int count;
+
+   count = eina_cpu_count();
+   s = getenv("EVAS_SLICE_THREADS");
+   if (s) count = atoi(s);
+   if (count > SLICE_THREADS_MAX) count = SLICE_THREADS_MAX;
+   // The calling thread works too
+   count--;
+   if (count <= 0) return;
+
+   if (!eina_lock_new(&slice_start_lock)) return;
+   if (!eina_threads_init())
+     {
+        eina_lock_free(&slice_start_lock);
+        return;
+     }
+
+   slice_threads_wanted = count;
+   slice_started = EINA_FALSE;
+   ecore_fork_reset_callback_add(evas_common_thread_slice_fork_reset, NULL);
+}
+
+EAPI void
+evas_common_thread_slice_shutdown(void)
+{
+   int i;
+
+   if (!slice_threads_wanted) return;
+
+   ecore_fork_reset_callback_del(evas_common_thread_slice_fork_reset, NULL);
+
+   if (slice_threads_count)
+     {
+        eina_lock_take(&slice_lock);
+        slice_exit = EINA_TRUE;
+        eina_condition_broadcast(&slice_cond);
+        eina_lock_release(&slice_lock);
+
+        for (i = 0; i < slice_threads_count; i++)
+          eina_thread_join(slice_threads[i]);
+        slice_threads_count = 0;
+
+        eina_condition_free(&slice_done_cond);
+        eina_condition_free(&slice_cond);
+        eina_lock_free(&slice_lock);
+        eina_lock_free(&slice_run_lock);
+     }
+
+   slice_threads_wanted = 0;
+   slice_started = EINA_FALSE;
+   eina_lock_free(&slice_start_lock);
+   eina_threads_shutdown();
+}
+
+EAPI int
+evas_common_thread_slice_count_get(void)
+{
+   // Not started yet, tell what the first split job will get
+   if (!slice_started) return slice_threads_wanted + 1;
+   return slice_threads_count + 1;
+}
+
+EAPI void
+evas_common_thread_slice_run(Evas_Thread_Slice_Cb cb, void *data,
+                             int count, int min)
+{
+   Evas_Thread_Slice_Job job;
+   int slices;
+
+   if (count <= 0) return;
+   if (min < 1) min = 1;
+
+   if ((!slice_threads_wanted) || (count < (2 * min)) ||
+       (!_evas_thread_slice_started()) ||
+       (eina_lock_take_try(&slice_run_lock) != EINA_LOCK_SUCCEED))
+     {
+        cb(data, 0, count);
+        return;
+     }
+
+   // Two slices per thread to balance uneven work a bit
+   slices = slice_threads_count + 1;
+   job.cb = cb;
+   job.data = data;
+   job.count = count;
+   job.step = (count + (2 * slices) - 1) / (2 * slices);
+   if (job.step < min) job.step = min;
+   job.next = 0;
+   job.done = 0;
+
+   eina_lock_take(&slice_lock);
+   slice_job = &job;
+   slice_generation++;
+   eina_condition_broadcast(&slice_cond);
+
+   _evas_thread_slice_work(&job);
+   while (job.done < job.count)
+     eina_condition_wait(&slice_done_cond);
+
+   slice_job = NULL;
+   eina_lock_release(&slice_lock);
+   eina_lock_release(&slice_run_lock);
+}
@@ -440,6 +440,7 @@ typedef void (*Evas_Render_Done_Cb)(void *);
 /*****************************************************************************/
 
 typedef void (*Evas_Thread_Command_Cb)(void *data);
+typedef void (*Evas_Thread_Slice_Cb)(void *data, int start, int end);
 typedef struct _Evas_Thread_Command Evas_Thread_Command;
 
 struct _Evas_Thread_Command
@@ -1131,6 +1132,11 @@ int               evas_thread_shutdown(void);
 EAPI void         evas_thread_cmd_enqueue(Evas_Thread_Command_Cb cb, void *data);
 EAPI void         evas_thread_queue_flush(Evas_Thread_Command_Cb cb, void *data);
 
+EAPI void         evas_common_thread_slice_init(void);
+EAPI void         evas_common_thread_slice_shutdown(void);
+EAPI int          evas_common_thread_slice_count_get(void);
+EAPI void         evas_common_thread_slice_run(Evas_Thread_Slice_Cb cb, void *data, int count, int min);
+
 typedef enum _Evas_Render_Mode
 {
    EVAS_RENDER_MODE_UNDEF,
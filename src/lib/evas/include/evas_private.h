@@ -853,6 +853,23 @@ struct _Evas_Public_Data
    Eina_Array     texts_unref_queue;
    Eina_List     *finalize_objects;
 
+   struct {
+      unsigned char *cells; // coverage map of the area being culled
+      unsigned char *hidden; // one flag per active object
+      unsigned int   cells_size;
+      unsigned int   hidden_size;
+      unsigned int   drawn, culled; // objects, this frame
+      double         drawn_pixels, update_pixels; // this frame
+   } occlusion;
+
+   struct {
+      double         start; // evaluation of the frame being rendered began
+      double         next_start; // evaluation of the next frame began
+      double         last; // previous frame done
+      unsigned int   count;
+      Eina_Bool      pipelined : 1; // evaluated while the previous one was rendering
+   } frame;
+
    struct {
       Evas_Post_Render_Job *jobs;
       Eina_Spinlock lock;
@@ -1206,6 +1223,7 @@ struct _Evas_Object_Protected_Data
 
    Eina_Bool                   snapshot_needs_redraw : 1;
    Eina_Bool                   snapshot_no_obscure : 1;
+   Eina_Bool                   occluded_change : 1; // changed while hidden under opaque objects
    Eina_Bool                   is_image_object : 1;
    Eina_Bool                   gfx_mapping_has : 1;
    Eina_Bool                   gfx_mapping_update : 1;
@@ -1588,6 +1606,7 @@ extern "C" {
 Evas_Object *evas_object_new(Evas *e);
 void evas_object_change_reset(Evas_Object_Protected_Data *obj);
 void evas_object_clip_recalc_do(Evas_Object_Protected_Data *obj, Evas_Object_Protected_Data *clipper);
+Eina_Bool evas_object_clip_recalc_done_get(const Evas_Object_Protected_Data *obj);
 void evas_object_cur_prev(Evas_Object_Protected_Data *obj);
 void evas_object_free(Evas_Object_Protected_Data *obj, Eina_Bool clean_layer);
 void evas_object_update_bounding_box(Evas_Object *obj, Evas_Object_Protected_Data *pd, Evas_Smart_Data *s);
@@ -1652,6 +1671,7 @@ void _evas_object_image_video_overlay_do(Evas_Object *obj);
 Eina_Bool _evas_object_image_can_use_plane(Evas_Object_Protected_Data *obj, Efl_Canvas_Output *output);
 void _evas_object_image_plane_release(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj, Efl_Canvas_Output *output);
 void _evas_object_image_free(Evas_Object *obj);
+Eina_Bool _evas_object_image_opaque_cached_get(const Evas_Object_Protected_Data *obj);
 void evas_object_smart_bounding_box_get(Evas_Object_Protected_Data *obj, Eina_Rectangle *cur_bounding_box, Eina_Rectangle *prev_bounding_box);
 void evas_object_smart_del(Evas_Object *obj);
 void evas_object_smart_cleanup(Evas_Object *obj);
@@ -1659,13 +1679,14 @@ void evas_object_smart_member_raise(Evas_Object *member);
 void evas_object_smart_member_lower(Evas_Object *member);
 void evas_object_smart_member_stack_above(Evas_Object *member, Evas_Object *other);
 void evas_object_smart_member_stack_below(Evas_Object *member, Evas_Object *other);
-void evas_object_smart_render_cache_clear(Evas_Object *eo_obj);
-void *evas_object_smart_render_cache_get(const Evas_Object *eo_obj);
-void evas_object_smart_render_cache_set(Evas_Object *eo_obj, void *data);
+void evas_object_smart_render_cache_clear(Evas_Object_Protected_Data *obj);
+void *evas_object_smart_render_cache_get(const Evas_Object_Protected_Data *obj);
+void evas_object_smart_render_cache_set(Evas_Object_Protected_Data *obj, void *data);
 
 const Eina_List *evas_object_event_grabber_members_list(const Eo *eo_obj);
 
 const Eina_Inlist *evas_object_smart_members_get_direct(const Evas_Object *obj);
+const Eina_Inlist *_evas_object_smart_members_get(const Evas_Object_Protected_Data *obj);
 void _efl_canvas_group_group_members_all_del(Evas_Object *eo_obj);
 void _evas_object_smart_clipped_init(Evas_Object *eo_obj);
 void evas_object_smart_clipped_smart_move(Evas_Object *eo_obj, Evas_Coord x, Evas_Coord y);
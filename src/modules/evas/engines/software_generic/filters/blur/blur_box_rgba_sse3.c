@@ -1,13 +1,160 @@
 #ifdef BUILD_SSE3
 
+/* This file is not built with -msse3, so only use SSE2 intrinsics here.
+ * They are always available on x86_64.
+ */
+#if defined(__SSE2__) && DIV_USING_BITSHIFT
+# include <emmintrin.h>
+# define BOX_BLUR_RGBA_SSE2 1
+#endif
+
+#ifdef BOX_BLUR_RGBA_SSE2
+
+static inline __m128i
+_box_blur_rgba_unpack_sse2(DATA32 c)
+{
+   const __m128i zero = _mm_setzero_si128();
+
+   return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(c), zero), zero);
+}
+
+static inline DATA32
+_box_blur_rgba_pack_sse2(__m128i v)
+{
+   v = _mm_packs_epi32(v, v);
+   return _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+}
+
+static inline DATA32
+_box_blur_rgba_div_sse2(__m128i acc, int divider)
+{
+   int a[4];
+
+   _mm_storeu_si128((__m128i *) a, acc);
+   return _box_blur_rgba_pack_sse2(_mm_set_epi32(a[3] / divider, a[2] / divider,
+                                                 a[1] / divider, a[0] / divider));
+}
+
+/* Same as DIVIDE(), for 4 channels at once */
+static inline DATA32
+_box_blur_rgba_divide_sse2(__m128i acc, __m128i numerator, __m128i pow2)
+{
+   // SSE2 has no 32 bits mullo
+   __m128i even = _mm_mul_epu32(acc, numerator);
+   __m128i odd = _mm_mul_epu32(_mm_srli_si128(acc, 4), numerator);
+
+   acc = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+   return _box_blur_rgba_pack_sse2(_mm_sra_epi32(acc, pow2));
+}
+
+/* One run of the box blur over a contiguous span. Gives exactly the same
+ * results as the generic code.
+ */
+static inline void
+_box_blur_rgba_span_sse2(const DATA32* restrict src, DATA32* restrict dst,
+                         int len, int radius, int pow2_shift, int numerator)
+{
+   const __m128i num = _mm_set1_epi32(numerator);
+   const __m128i pow2 = _mm_cvtsi32_si128(pow2_shift);
+   const int left = MIN(radius, len);
+   const DATA32* restrict sl = src;
+   const DATA32* restrict sr = src;
+   const DATA32* restrict sre = src + len;
+   const DATA32* restrict sle = src + len - radius;
+   __m128i acc = _mm_setzero_si128();
+   int count = 0;
+
+   // Read-ahead
+   for (int x = left; x > 0; x--)
+     {
+        acc = _mm_add_epi32(acc, _box_blur_rgba_unpack_sse2(*sr++));
+        count++;
+     }
+
+   // Left
+   for (int x = left; x > 0; x--)
+     {
+        if (sr < sre)
+          {
+             acc = _mm_add_epi32(acc, _box_blur_rgba_unpack_sse2(*sr++));
+             count++;
+          }
+        *dst++ = _box_blur_rgba_div_sse2(acc, count);
+     }
+
+   // Main part
+   for (; sr < sre; sr++, sl++)
+     {
+        acc = _mm_add_epi32(acc, _box_blur_rgba_unpack_sse2(*sr));
+        *dst++ = _box_blur_rgba_divide_sse2(acc, num, pow2);
+        acc = _mm_sub_epi32(acc, _box_blur_rgba_unpack_sse2(*sl));
+     }
+
+   // Right part
+   count = 2 * radius + 1;
+   for (; sl < sle; sl++)
+     {
+        *dst++ = _box_blur_rgba_div_sse2(acc, --count);
+        acc = _mm_sub_epi32(acc, _box_blur_rgba_unpack_sse2(*sl));
+     }
+}
+
+static inline void
+_box_blur_rgba_dividers_sse2(const int* restrict const radii,
+                             int *pow2_shifts, int *numerators)
+{
+   for (int run = 0; radii[run]; run++)
+     {
+        const int div = radii[run] * 2 + 1;
+        pow2_shifts[run] = evas_filter_smallest_pow2_larger_than(div << 10);
+        numerators[run] = (1 << pow2_shifts[run]) / (div);
+     }
+}
+
+#endif
+
 static inline void
 _box_blur_rgba_horiz_step_sse3(const uint32_t* restrict src, int src_stride,
                                uint32_t* restrict dst, int dst_stride,
                                const int* restrict const radii,
                                Eina_Rectangle region)
 {
-   // TODO: implement optimized code here and remove the following line:
+#ifdef BOX_BLUR_RGBA_SSE2
+   const int len = region.w;
+   int pow2_shifts[6] = {0};
+   int numerators[6] = {0};
+   DATA32 *span1, *span2;
+
+   _box_blur_rgba_dividers_sse2(radii, pow2_shifts, numerators);
+
+   src += region.x + src_stride * region.y;
+   dst += region.x + dst_stride * region.y;
+
+   span1 = alloca(len * sizeof(DATA32));
+   span2 = alloca(len * sizeof(DATA32));
+
+   for (int l = 0; l < region.h; l++)
+     {
+        const DATA32 *s = src + src_stride * l;
+        DATA32 *d;
+
+        // Intermediate runs ping-pong between the spans, the last one
+        // writes directly to the destination
+        for (int run = 0; radii[run]; run++)
+          {
+             if (!radii[run + 1])
+               d = dst + dst_stride * l;
+             else
+               d = (s == span1) ? span2 : span1;
+             _box_blur_rgba_span_sse2(s, d, len, radii[run],
+                                      pow2_shifts[run], numerators[run]);
+             s = d;
+          }
+     }
+#else
    _box_blur_rgba_horiz_step(src, src_stride, dst, dst_stride, radii, region);
+#endif
 }
 
 static inline void
@@ -16,8 +163,46 @@ _box_blur_rgba_vert_step_sse3(const uint32_t* restrict src, int src_stride,
                               const int* restrict const radii,
                               Eina_Rectangle region)
 {
-   // TODO: implement optimized code here and remove the following line:
+#ifdef BOX_BLUR_RGBA_SSE2
+   const int len = region.h;
+   int pow2_shifts[6] = {0};
+   int numerators[6] = {0};
+   DATA32 *span1, *span2;
+
+   _box_blur_rgba_dividers_sse2(radii, pow2_shifts, numerators);
+
+   src += region.x + src_stride * region.y;
+   dst += region.x + dst_stride * region.y;
+
+   span1 = alloca(len * sizeof(DATA32));
+   span2 = alloca(len * sizeof(DATA32));
+
+   for (int l = 0; l < region.w; l++)
+     {
+        const DATA32 *srcptr = src + l;
+        DATA32 *dstptr = dst + l;
+        DATA32 *s, *d;
+
+        // Rotate input into work span
+        for (int k = 0; k < len; k++, srcptr += src_stride)
+          span1[k] = *srcptr;
+
+        s = span1;
+        for (int run = 0; radii[run]; run++)
+          {
+             d = (s == span1) ? span2 : span1;
+             _box_blur_rgba_span_sse2(s, d, len, radii[run],
+                                      pow2_shifts[run], numerators[run]);
+             s = d;
+          }
+
+        // Rotate back into destination
+        for (int k = 0; k < len; k++, dstptr += dst_stride)
+          *dstptr = s[k];
+     }
+#else
    _box_blur_rgba_vert_step(src, src_stride, dst, dst_stride, radii, region);
+#endif
 }
 
 #endif
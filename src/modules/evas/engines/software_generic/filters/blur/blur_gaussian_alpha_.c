@@ -14,7 +14,7 @@
 static inline void
 FUNCTION_NAME(const DATA8* restrict srcdata, DATA8* restrict dstdata,
               const int radius, const int len,
-              const int loops, const int loopstep,
+              const int loops, const int loopstep, const int stride EINA_UNUSED,
               const int* restrict weights, const int pow2_divider)
 {
    int i, j, k, acc, divider;
@@ -13,7 +13,7 @@
 static inline void
 FUNCTION_NAME(const DATA32* restrict srcdata, DATA32* restrict dstdata,
               const int radius, const int len,
-              const int loops, const int loopstep,
+              const int loops, const int loopstep, const int stride EINA_UNUSED,
               const int* restrict weights, const int pow2_divider)
 {
    const int diameter = 2 * radius + 1;
@@ -229,12 +229,60 @@ _rect(int x, int y, int w, int h, int maxw, int maxh)
 
 #define RECT(_x, _y, _w, _h) _rect(_x, _y, _w, _h, w, h)
 
+// Don't bother waking up other threads for less than this many pixels
+#define BLUR_SLICE_PIXELS 8192
+
+typedef struct _Box_Blur_Slice Box_Blur_Slice;
+struct _Box_Blur_Slice
+{
+   void *src, *dst;
+   int src_stride, dst_stride;
+   int *radii;
+   Eina_Rectangle region;
+   Eina_Bool vert, rgba;
+};
+
+static void
+_box_blur_slice_cb(void *data, int start, int end)
+{
+   const Box_Blur_Slice *bs = data;
+   Eina_Rectangle region = bs->region;
+
+   // Rows are independent for horizontal blurs, columns for vertical ones
+   if (!bs->vert)
+     {
+        region.y += start;
+        region.h = end - start;
+     }
+   else
+     {
+        region.x += start;
+        region.w = end - start;
+     }
+
+   if (bs->rgba)
+     {
+        if (!bs->vert)
+          _box_blur_horiz_rgba(bs->src, bs->src_stride, bs->dst, bs->dst_stride, bs->radii, region);
+        else
+          _box_blur_vert_rgba(bs->src, bs->src_stride, bs->dst, bs->dst_stride, bs->radii, region);
+     }
+   else
+     {
+        if (!bs->vert)
+          _box_blur_horiz_alpha(bs->src, bs->src_stride, bs->dst, bs->dst_stride, bs->radii, region);
+        else
+          _box_blur_vert_alpha(bs->src, bs->src_stride, bs->dst, bs->dst_stride, bs->radii, region);
+     }
+}
+
 static Eina_Bool
 _box_blur_apply(Evas_Filter_Command *cmd, Eina_Bool vert, Eina_Bool rgba)
 {
    unsigned int src_len, src_stride, dst_len, dst_stride;
    Eina_Bool ret = EINA_FALSE;
    Eina_Rectangle o, region[4];
+   Box_Blur_Slice bs;
    int radii[7] = {0};
    int radius, regions, w, h;
    void *src, *dst;
@@ -276,24 +324,27 @@ _box_blur_apply(Evas_Filter_Command *cmd, Eina_Bool vert, Eina_Bool rgba)
         regions = 4;
      }
 
+   bs.src = src;
+   bs.dst = dst;
+   bs.src_stride = rgba ? (int) src_stride / 4 : (int) src_stride;
+   bs.dst_stride = rgba ? (int) dst_stride / 4 : (int) dst_stride;
+   bs.radii = radii;
+   bs.vert = vert;
+   bs.rgba = rgba;
+
    XDBG("Box blur on image %dx%d obscured by %d,%d %dx%d", w, h, o.x, o.y, o.w, o.h);
    for (int k = 0; k < regions; k++)
      {
+        int len, count;
+
         XDBG("Box blur in region %d,%d %dx%d", region[k].x, region[k].y, region[k].w, region[k].h);
-        if (rgba)
-          {
-             if (!vert)
-               _box_blur_horiz_rgba(src, src_stride / 4, dst, dst_stride / 4, radii, region[k]);
-             else
-               _box_blur_vert_rgba(src, src_stride / 4, dst, dst_stride / 4, radii, region[k]);
-          }
-        else
-          {
-             if (!vert)
-               _box_blur_horiz_alpha(src, src_stride, dst, dst_stride, radii, region[k]);
-             else
-               _box_blur_vert_alpha(src, src_stride, dst, dst_stride, radii, region[k]);
-          }
+        if (!region[k].w || !region[k].h) continue;
+
+        bs.region = region[k];
+        len = vert ? region[k].h : region[k].w;
+        count = vert ? region[k].w : region[k].h;
+        evas_common_thread_slice_run(_box_blur_slice_cb, &bs, count,
+                                     BLUR_SLICE_PIXELS / len);
      }
 
    ret = EINA_TRUE;
@@ -372,9 +423,9 @@ _sin_blur_weights_get(int *weights, int *pow2_divider, int radius)
 #define STEP 1
 #include "./blur/blur_gaussian_alpha_.c"
 
-// Step size is w (row by row), loops = w, so STEP = 'loops'
+// Step size is the row stride (w), so STEP = 'stride'
 #define FUNCTION_NAME _gaussian_blur_vert_alpha_step
-#define STEP loops
+#define STEP stride
 #include "./blur/blur_gaussian_alpha_.c"
 
 #define FUNCTION_NAME _gaussian_blur_horiz_rgba_step
@@ -382,9 +433,48 @@ _sin_blur_weights_get(int *weights, int *pow2_divider, int radius)
 #include "./blur/blur_gaussian_rgba_.c"
 
 #define FUNCTION_NAME _gaussian_blur_vert_rgba_step
-#define STEP loops
+#define STEP stride
 #include "./blur/blur_gaussian_rgba_.c"
 
+typedef struct _Gaussian_Blur_Slice Gaussian_Blur_Slice;
+struct _Gaussian_Blur_Slice
+{
+   void *src, *dst;
+   const int *weights;
+   int radius, pow2_div, w, h;
+   Eina_Bool vert, rgba;
+};
+
+static void
+_gaussian_blur_slice_cb(void *data, int start, int end)
+{
+   const Gaussian_Blur_Slice *gs = data;
+   const int loops = end - start;
+   const int radius = gs->radius;
+   const int w = gs->w, h = gs->h;
+
+   if (gs->rgba)
+     {
+        const DATA32 *src = gs->src;
+        DATA32 *dst = gs->dst;
+
+        if (!gs->vert)
+          _gaussian_blur_horiz_rgba_step(src + start * w, dst + start * w, radius, w, loops, w, 1, gs->weights, gs->pow2_div);
+        else
+          _gaussian_blur_vert_rgba_step(src + start, dst + start, radius, h, loops, 1, w, gs->weights, gs->pow2_div);
+     }
+   else
+     {
+        const DATA8 *src = gs->src;
+        DATA8 *dst = gs->dst;
+
+        if (!gs->vert)
+          _gaussian_blur_horiz_alpha_step(src + start * w, dst + start * w, radius, w, loops, w, 1, gs->weights, gs->pow2_div);
+        else
+          _gaussian_blur_vert_alpha_step(src + start, dst + start, radius, h, loops, 1, w, gs->weights, gs->pow2_div);
+     }
+}
+
 static Eina_Bool
 _gaussian_blur_apply(Evas_Filter_Command *cmd, Eina_Bool vert, Eina_Bool rgba)
 {
@@ -405,21 +495,18 @@ _gaussian_blur_apply(Evas_Filter_Command *cmd, Eina_Bool vert, Eina_Bool rgba)
 
    if (src && dst)
      {
+        Gaussian_Blur_Slice gs = {
+           .src = src, .dst = dst, .weights = weights,
+           .radius = radius, .pow2_div = pow2_div,
+           .w = w, .h = h, .vert = vert, .rgba = rgba
+        };
+
+        // Cost per pixel grows with the radius
+        int len = MAX(1, vert ? h : w) * (radius + 1);
+
         DEBUG_TIME_BEGIN();
-        if (rgba)
-          {
-             if (!vert)
-               _gaussian_blur_horiz_rgba_step(src, dst, radius, w, h, w, weights, pow2_div);
-             else
-               _gaussian_blur_vert_rgba_step(src, dst, radius, h, w, 1, weights, pow2_div);
-          }
-        else
-          {
-             if (!vert)
-               _gaussian_blur_horiz_alpha_step(src, dst, radius, w, h, w, weights, pow2_div);
-             else
-               _gaussian_blur_vert_alpha_step(src, dst, radius, h, w, 1, weights, pow2_div);
-          }
+        evas_common_thread_slice_run(_gaussian_blur_slice_cb, &gs,
+                                     vert ? w : h, BLUR_SLICE_PIXELS / len);
         DEBUG_TIME_END();
      }
    else ret = EINA_FALSE;
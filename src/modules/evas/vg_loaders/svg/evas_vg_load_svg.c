@@ -946,35 +946,91 @@ static const struct {
   STYLE_DEF(display, display)
 };
 
+static int
+_style_tag_find(const char *key, int sz)
+{
+   unsigned int i;
+
+   for (i = 0; i < sizeof (style_tags) / sizeof(style_tags[0]); i++)
+     if (style_tags[i].sz - 1 == sz && !strncmp(style_tags[i].tag, key, sz))
+       return i;
+
+   return -1;
+}
+
 static Eina_Bool
 _parse_style_attr(void *data, const char *key, const char *value)
 {
    Evas_SVG_Loader *loader = data;
    Svg_Node* node = loader->svg_parse->node;
-   unsigned int i;
-   int sz;
+   int i;
 
    // trim the white space
    key = _skip_space(key, NULL);
 
    value = _skip_space(value, NULL);
 
-   sz = strlen(key);
-   for (i = 0; i < sizeof (style_tags) / sizeof(style_tags[0]); i++)
-     if (style_tags[i].sz - 1 == sz && !strncmp(style_tags[i].tag, key, sz))
-       {
-          style_tags[i].tag_handler(loader, node, value);
-          return EINA_TRUE;
-       }
+   i = _style_tag_find(key, strlen(key));
+   if (i >= 0) style_tags[i].tag_handler(loader, node, value);
 
    return EINA_TRUE;
 }
 
+static Eina_Slice
+_style_slice_trim(const char *start, const char *end)
+{
+   Eina_Slice slice;
+
+   start = _skip_space(start, end);
+   while ((end > start) && isspace((unsigned char) end[-1])) end--;
+   slice.mem = start;
+   slice.len = end - start;
+
+   return slice;
+}
+
+/* Walks the "key: value;" declarations of a style in place: editors write
+ * a lot of properties that are not supported here, only the values of the
+ * supported ones are copied for their handler.
+ */
 static Eina_Bool
 _attr_style_node(void *data, const char *str)
 {
-   eina_simple_xml_attribute_w3c_parse(str,
-                                       _parse_style_attr, data);
+   Evas_SVG_Loader *loader = data;
+   Svg_Node* node = loader->svg_parse->node;
+   const char *itr = str, *end, *next, *sep;
+   Eina_Slice key, value;
+   char local[256];
+   char *buf;
+   int i;
+
+   end = str + strlen(str);
+
+   for (; itr < end; itr = next + 1)
+     {
+        next = memchr(itr, ';', end - itr);
+        if (!next) next = end;
+        sep = memchr(itr, ':', next - itr);
+        if (!sep) continue;
+
+        key = _style_slice_trim(itr, sep);
+        i = _style_tag_find(key.mem, key.len);
+        if (i < 0) continue;
+
+        // Values come from the file, only short ones fit on the stack
+        value = _style_slice_trim(sep + 1, next);
+        buf = local;
+        if (value.len >= sizeof(local))
+          {
+             buf = malloc(value.len + 1);
+             if (!buf) continue;
+          }
+        memcpy(buf, value.mem, value.len);
+        buf[value.len] = '\0';
+        style_tags[i].tag_handler(loader, node, buf);
+        if (buf != local) free(buf);
+     }
+
    return EINA_TRUE;
 }
 
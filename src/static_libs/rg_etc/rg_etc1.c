@@ -22,6 +22,11 @@
 
 #include "rg_etc1.h"
 
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+# include <emmintrin.h>
+# define RG_ETC1_SSE2 1
+#endif
+
 #if defined(_DEBUG) || defined(DEBUG)
 #define RG_ETC1_BUILD_DEBUG
 #endif
@@ -1219,6 +1224,104 @@ rg_etc1_block_subblock_color4_abs_get(unsigned int dst[4], unsigned short packed
    rg_etc1_block_sublock_diff(dst, pInten_modifer_table, r, g, b);
 }
 
+#ifdef RG_ETC1_SSE2
+// The four intensity modifiers of each table, spread over B, G and R of two
+// colors, so that adding them to a base color gives a whole subblock palette.
+static const short rg_etc1_inten_tables_sse2[cETC1IntenModifierValues][16] __attribute__((aligned(16))) = {
+  { -8, -8, -8, 0, -2, -2, -2, 0, 2, 2, 2, 0, 8, 8, 8, 0 },
+  { -17, -17, -17, 0, -5, -5, -5, 0, 5, 5, 5, 0, 17, 17, 17, 0 },
+  { -29, -29, -29, 0, -9, -9, -9, 0, 9, 9, 9, 0, 29, 29, 29, 0 },
+  { -42, -42, -42, 0, -13, -13, -13, 0, 13, 13, 13, 0, 42, 42, 42, 0 },
+  { -60, -60, -60, 0, -18, -18, -18, 0, 18, 18, 18, 0, 60, 60, 60, 0 },
+  { -80, -80, -80, 0, -24, -24, -24, 0, 24, 24, 24, 0, 80, 80, 80, 0 },
+  { -106, -106, -106, 0, -33, -33, -33, 0, 33, 33, 33, 0, 106, 106, 106, 0 },
+  { -183, -183, -183, 0, -47, -47, -47, 0, 47, 47, 47, 0, 183, 183, 183, 0 }
+};
+
+// Same as rg_etc1_block_sublock_diff(), the saturated pack does the clamping
+static inline __m128i
+rg_etc1_block_subblock_sse2(unsigned char r, unsigned char g, unsigned char b,
+                            unsigned char table_idx)
+{
+   const __m128i *modifiers = (const __m128i *)rg_etc1_inten_tables_sse2[table_idx];
+   const __m128i base = _mm_set_epi16(255, r, g, b, 255, r, g, b);
+
+   return _mm_packus_epi16(_mm_add_epi16(base, modifiers[0]),
+                           _mm_add_epi16(base, modifiers[1]));
+}
+
+// Picks the color of each pixel from its two selector bits, one row of four
+// pixels at a time. Pixel (x, y) uses bit x * 4 + y of the selector words,
+// so moving down a row is a shift of the bit masks.
+static bool
+rg_etc1_unpack_block_sse2(const unsigned char *bytes, unsigned int *pDst_pixels_BGRA)
+{
+   const __m128i msb = _mm_set1_epi32((bytes[4] << 8) | bytes[5]);
+   const __m128i lsb = _mm_set1_epi32((bytes[6] << 8) | bytes[7]);
+   __m128i bit = _mm_set_epi32(1 << 12, 1 << 8, 1 << 4, 1);
+   __m128i palette0, palette1, colors[2][4];
+   unsigned char r0, g0, b0, r1, g1, b1;
+   unsigned char success = 1;
+   int y;
+
+   if (rg_etc1_block_diff_bit_get(bytes))
+     {
+        unsigned short base_color5 = rg_etc1_block_base5_color_get(bytes);
+
+        rg_etc1_block_color5_component_unpack(&r0, &g0, &b0, base_color5, 1);
+        success = rg_etc1_block_color5_delta3_component_unpack(&r1, &g1, &b1, base_color5,
+                                                               rg_etc1_block_delta3_color_get(bytes), 1);
+     }
+   else
+     {
+        rg_etc1_block_color4_component_unpack(&r0, &g0, &b0, rg_etc_block_base4_color_get(bytes, 0), 1);
+        rg_etc1_block_color4_component_unpack(&r1, &g1, &b1, rg_etc_block_base4_color_get(bytes, 1), 1);
+     }
+
+   palette0 = rg_etc1_block_subblock_sse2(r0, g0, b0, (bytes[3] >> 5) & 7);
+   palette1 = rg_etc1_block_subblock_sse2(r1, g1, b1, (bytes[3] >> 2) & 7);
+
+   // colors[][v] is the color for the raw selector value v, see
+   // rg_etc1_to_selector_index
+#define BROADCAST(Palette, Index) _mm_shuffle_epi32(Palette, _MM_SHUFFLE(Index, Index, Index, Index))
+   colors[0][0] = BROADCAST(palette0, 2);
+   colors[0][1] = BROADCAST(palette0, 3);
+   colors[0][2] = BROADCAST(palette0, 1);
+   colors[0][3] = BROADCAST(palette0, 0);
+   colors[1][0] = BROADCAST(palette1, 2);
+   colors[1][1] = BROADCAST(palette1, 3);
+   colors[1][2] = BROADCAST(palette1, 1);
+   colors[1][3] = BROADCAST(palette1, 0);
+#undef BROADCAST
+
+   if (!rg_etc1_block_flip_bit_get(bytes))
+     {
+        // Left and right subblocks: two pixels of each on every row
+        for (y = 0; y < 4; y++)
+          {
+             colors[0][y] = _mm_unpacklo_epi64(colors[0][y], colors[1][y]);
+             colors[1][y] = colors[0][y];
+          }
+     }
+
+   for (y = 0; y < 4; y++)
+     {
+        const __m128i *c = colors[y >> 1];
+        __m128i l = _mm_cmpeq_epi32(_mm_and_si128(lsb, bit), bit);
+        __m128i m = _mm_cmpeq_epi32(_mm_and_si128(msb, bit), bit);
+        __m128i lo, hi;
+
+        lo = _mm_or_si128(_mm_and_si128(l, c[1]), _mm_andnot_si128(l, c[0]));
+        hi = _mm_or_si128(_mm_and_si128(l, c[3]), _mm_andnot_si128(l, c[2]));
+        _mm_storeu_si128((__m128i *)(pDst_pixels_BGRA + y * 4),
+                         _mm_or_si128(_mm_and_si128(m, hi), _mm_andnot_si128(m, lo)));
+        bit = _mm_slli_epi32(bit, 1);
+     }
+
+   return success;
+}
+#endif
+
 // This is the exported function to unpack a block
 bool
 rg_etc1_unpack_block(const void *ETC1_block, unsigned int *pDst_pixels_BGRA, bool preserve_alpha)
@@ -1230,6 +1333,11 @@ rg_etc1_unpack_block(const void *ETC1_block, unsigned int *pDst_pixels_BGRA, boo
    const unsigned char *bytes;
    bytes = (unsigned char *)ETC1_block;
 
+#ifdef RG_ETC1_SSE2
+   if (!preserve_alpha)
+     return rg_etc1_unpack_block_sse2(bytes, pDst_pixels_BGRA);
+#endif
+
    diff_flag = rg_etc1_block_diff_bit_get(ETC1_block);
    flip_flag = rg_etc1_block_flip_bit_get(ETC1_block);
    table_index0 = (bytes[3] >> 5) & 7;
@@ -400,6 +400,28 @@ _reset_vg_tree(Efl_VG *node)
    efl_gfx_entity_visible_set(node, EINA_FALSE);
 }
 
+static int
+_matte_mode_get(LOTMatteType matte)
+{
+   switch (matte)
+     {
+      case MatteNone:
+         return 0;
+      case MatteAlpha:
+         return EFL_GFX_VG_COMPOSITE_METHOD_MATTE_ALPHA;
+      case MatteAlphaInv:
+         return EFL_GFX_VG_COMPOSITE_METHOD_MATTE_ALPHA_INVERSE;
+      case MatteLuma:
+         ERR("TODO: MatteLuma");
+         return 0;
+      case MatteLumaInv:
+         ERR("TODO: MatteLumaInv");
+         return 0;
+      default:
+         return 0;
+     }
+}
+
 static void
 _update_vg_tree(Efl_Canvas_Vg_Container *root, const LOTLayerNode *layer, int depth EINA_UNUSED)
 {
@@ -426,11 +448,40 @@ _update_vg_tree(Efl_Canvas_Vg_Container *root, const LOTLayerNode *layer, int de
         //Source Layer
         char *key = _get_key_val(clayer);
         Efl_Canvas_Vg_Container *ctree = efl_key_data_get(root, key);
+
+        //Matte source of a skipped target, it is never drawn on its own.
+        if (matte_mode && !ptree)
+          {
+             matte_mode = _matte_mode_get(clayer->mMatte);
+             mtarget = NULL;
+             continue;
+          }
+
         if (!ctree)
           {
+             /* Layers are only instantiated once they are shown, or matte
+                a shown layer. Long animations have many layers living in
+                a small frame range only. */
+             if (!clayer->mVisible && !(matte_mode && ptree))
+               {
+                  matte_mode = _matte_mode_get(clayer->mMatte);
+                  mtarget = NULL;
+                  ptree = NULL;
+                  continue;
+               }
              ctree = efl_add(EFL_CANVAS_VG_CONTAINER_CLASS, root);
              efl_key_data_set(root, key, ctree);
              if (clayer->keypath) efl_key_data_set(ctree, "_lot_node_name", clayer->keypath);
+
+             //Layer order: go below the next layer instantiated already.
+             for (unsigned int j = i + 1; j < layer->mLayerList.size; j++)
+               {
+                  Efl_Canvas_Vg_Container *ntree =
+                     efl_key_data_get(root, _get_key_val(layer->mLayerList.ptr[j]));
+                  if (!ntree) continue;
+                  efl_gfx_stack_below(ctree, ntree);
+                  break;
+               }
           }
 #if DEBUG
         for (int i = 0; i < depth; i++) printf("    ");
@@ -438,12 +489,12 @@ _update_vg_tree(Efl_Canvas_Vg_Container *root, const LOTLayerNode *layer, int de
 #endif
         _update_vg_tree(ctree, clayer, depth+1);
 
-        if (matte_mode != 0)
+        if ((matte_mode != 0) && ptree)
           {
              efl_canvas_vg_node_comp_method_set(ptree, ctree, matte_mode);
              mtarget = ctree;
           }
-        matte_mode = (int) clayer->mMatte;
+        matte_mode = _matte_mode_get(clayer->mMatte);
 
         if (clayer->mMaskList.size > 0)
           {
@@ -455,31 +506,6 @@ _update_vg_tree(Efl_Canvas_Vg_Container *root, const LOTLayerNode *layer, int de
 
         ptree = ctree;
 
-        //Remap Matte Mode
-        switch (matte_mode)
-          {
-           case MatteNone:
-              matte_mode = 0;
-              break;
-           case MatteAlpha:
-              matte_mode = EFL_GFX_VG_COMPOSITE_METHOD_MATTE_ALPHA;
-              break;
-           case MatteAlphaInv:
-              matte_mode = EFL_GFX_VG_COMPOSITE_METHOD_MATTE_ALPHA_INVERSE;
-              break;
-           case MatteLuma:
-              matte_mode = 0;
-              ERR("TODO: MatteLuma");
-              break;
-           case MatteLumaInv:
-              matte_mode = 0;
-              ERR("TODO: MatteLumaInv");
-              break;
-           default:
-              matte_mode = 0;
-              break;
-          }
-
         //Construct node that have mask.
         if (mlayer && mtarget)
           ptree = _construct_masks(mtarget, mlayer->mMaskList.ptr, mlayer->mMaskList.size, depth + 1);
@@ -208,6 +208,36 @@ EFL_START_TEST(edje_test_calculate_parens)
 }
 EFL_END_TEST
 
+EFL_START_TEST(edje_test_calculate_dependencies)
+{
+   int x, y, w, h;
+   Evas *evas = _setup_evas();
+   Evas_Object *obj;
+
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("test_recalc.edj"), "test_group"));
+   edje_object_animation_set(obj, EINA_FALSE);
+
+   evas_object_resize(obj, 1000, 1000);
+   edje_object_part_geometry_get(obj, "chain", &x, &y, &w, &h);
+   fail_if(x != 10 || y != 10 || w != 230 || h != 480);
+
+   /* Only "base" changes state, what is relative to it has to follow */
+   edje_object_signal_emit(obj, "move", "test");
+   edje_object_message_signal_process(obj);
+
+   edje_object_part_geometry_get(obj, "base", &x, &y, &w, &h);
+   fail_if(x != 500 || y != 0 || w != 500 || h != 500);
+   edje_object_part_geometry_get(obj, "follow", &x, &y, &w, &h);
+   fail_if(x != 500 || y != 0 || w != 250 || h != 500);
+   edje_object_part_geometry_get(obj, "chain", &x, &y, &w, &h);
+   fail_if(x != 510 || y != 10 || w != 230 || h != 480);
+   edje_object_part_geometry_get(obj, "other", &x, &y, &w, &h);
+   fail_if(x != 0 || y != 500 || w != 1000 || h != 500);
+
+}
+EFL_END_TEST
+
 EFL_START_TEST(edje_test_access)
 {
    Evas *evas = _setup_evas();
@@ -302,6 +332,7 @@ void edje_test_edje(TCase *tc)
    tcase_add_test(tc, edje_test_simple_layout_geometry);
    tcase_add_test(tc, edje_test_complex_layout);
    tcase_add_test(tc, edje_test_calculate_parens);
+   tcase_add_test(tc, edje_test_calculate_dependencies);
    tcase_add_test(tc, edje_test_access);
    tcase_add_test(tc, edje_test_combine_keywords);
    tcase_add_test(tc, edje_test_part_caching);
@@ -229,11 +229,59 @@ EFL_START_TEST(edje_test_signal_callback_del_full)
 }
 EFL_END_TEST
 
+EFL_START_TEST(edje_test_signal_callback_glob)
+{
+   Evas *evas;
+   Evas_Object *obj;
+   int data[4] = { 1, 2, 4, 8 };
+
+   evas = _setup_evas();
+
+   obj = efl_add(EFL_CANVAS_LAYOUT_CLASS, evas,
+                 efl_file_set(efl_added,
+                 test_layout_get("test_signal_callback_del_full.edj")),
+                 efl_file_key_set(efl_added, "test"),
+                 efl_gfx_entity_size_set(efl_added, EINA_SIZE2D(320, 240)),
+                 efl_gfx_entity_visible_set(efl_added, 1));
+
+   /* Nothing from loading and showing it should reach "*" */
+   edje_object_message_signal_process(obj);
+
+   edje_object_signal_callback_add(obj, "some,*", "event", _signal_callback_count_cb, &data[0]);
+   edje_object_signal_callback_add(obj, "*", "*", _signal_callback_count_cb, &data[1]);
+   edje_object_signal_callback_add(obj, "some,[a-c]?", "ev*", _signal_callback_count_cb, &data[2]);
+   edje_object_signal_callback_add(obj, "other", "event", _signal_callback_count_cb, &data[3]);
+
+   _signal_count = 0;
+   edje_object_signal_emit(obj, "some,bx", "event");
+   edje_object_message_signal_process(obj);
+   ck_assert_int_eq(_signal_count, data[0] + data[1] + data[2]);
+
+   _signal_count = 0;
+   edje_object_signal_emit(obj, "some,dx", "event");
+   edje_object_signal_emit(obj, "some,a", "other");
+   edje_object_signal_emit(obj, "other", "event");
+   edje_object_message_signal_process(obj);
+   ck_assert_int_eq(_signal_count, data[0] + 3 * data[1] + data[3]);
+
+   /* Once more, now that the patterns have seen these signals */
+   _signal_count = 0;
+   edje_object_signal_emit(obj, "some,bx", "event");
+   edje_object_signal_emit(obj, "some,bxy", "event");
+   edje_object_message_signal_process(obj);
+   ck_assert_int_eq(_signal_count, data[0] + data[1] + data[2] + data[0] + data[1]);
+
+   efl_del(obj);
+
+}
+EFL_END_TEST
+
 void edje_test_signal(TCase *tc)
 {
    tcase_add_test(tc, edje_test_message_send_legacy);
    tcase_add_test(tc, edje_test_message_send_eo);
    tcase_add_test(tc, edje_test_signals);
    tcase_add_test(tc, edje_test_signal_callback_del_full);
+   tcase_add_test(tc, edje_test_signal_callback_glob);
 
 }
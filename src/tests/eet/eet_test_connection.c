@@ -140,7 +140,133 @@ EFL_START_TEST(eet_test_connection_check)
 }
 EFL_END_TEST
 
+typedef struct _Eet_Connection_Batch Eet_Connection_Batch;
+struct _Eet_Connection_Batch
+{
+   Eet_Data_Descriptor *edd;
+   Eina_Binbuf         *wire;
+   int                  writes;
+   int                  reads;
+};
+
+static Eina_Bool
+_eet_connection_batch_read(const void *eet_data,
+                           size_t      size,
+                           void       *user_data)
+{
+   Eet_Connection_Batch *batch = user_data;
+   Eet_Test_Ex_Type *result;
+
+   result = eet_data_descriptor_decode(batch->edd, eet_data, size);
+   fail_if(!result);
+   fail_if(eet_test_ex_check(result, batch->reads, EINA_FALSE) != 0);
+   batch->reads++;
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eet_connection_batch_write(const void *data,
+                            size_t      size,
+                            void       *user_data)
+{
+   Eet_Connection_Batch *batch = user_data;
+
+   eina_binbuf_append_length(batch->wire, data, size);
+   batch->writes++;
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eet_connection_batch_writev(const Eina_Slice *slices,
+                             unsigned int      count,
+                             void             *user_data)
+{
+   Eet_Connection_Batch *batch = user_data;
+   unsigned int i;
+
+   for (i = 0; i < count; i++)
+     eina_binbuf_append_slice(batch->wire, slices[i]);
+   batch->writes++;
+
+   return EINA_TRUE;
+}
+
+EFL_START_TEST(eet_test_connection_batch)
+{
+   Eet_Data_Descriptor_Class eddc;
+   Eet_Connection_Batch batch;
+   Eet_Connection *conn;
+   Eet_Test_Ex_Type etbt[16];
+   const unsigned char *p;
+   size_t length, plain = 0;
+   unsigned int mode;
+   int i;
+
+   eet_eina_stream_data_descriptor_class_set(&eddc, sizeof (eddc),
+                                             "Eet_Test_Ex_Type",
+                                             sizeof(Eet_Test_Ex_Type));
+   batch.edd = eet_data_descriptor_stream_new(&eddc);
+   fail_if(!batch.edd);
+   eet_build_ex_descriptor(batch.edd, EINA_TRUE);
+
+   for (i = 0; i < 16; i++)
+     eet_test_ex_set(&etbt[i], i);
+
+   /* Plain or compressed, through writev or not, batched or not */
+   for (mode = 0; mode < 8; mode++)
+     {
+        batch.wire = eina_binbuf_new();
+        batch.writes = 0;
+        batch.reads = 0;
+
+        conn = eet_connection_new(_eet_connection_batch_read,
+                                  _eet_connection_batch_write, &batch);
+        fail_if(!conn);
+        if (!(mode & 4))
+          eet_connection_batch_set(conn, 1024 * 1024, 0.0);
+        eet_connection_compression_set(conn, mode & 1);
+        if (mode & 2)
+          eet_connection_writev_set(conn, _eet_connection_batch_writev);
+
+        for (i = 0; i < 16; i++)
+          fail_if(!eet_connection_send(conn, batch.edd, &etbt[i], NULL));
+        fail_if(batch.writes != ((mode & 4) ? 16 : 0));
+        fail_if(!eet_connection_flush(conn));
+        fail_if(batch.writes != ((mode & 4) ? 16 : 1));
+
+        /* Messages looking alike must compress well, even one by one */
+        length = eina_binbuf_length_get(batch.wire);
+        if (mode & 1) fail_if(length * 2 > plain);
+        else plain = length;
+
+        /* Receive it in small chunks to go through partial packets, what
+         * is left over (a split header) comes back with the next one */
+        p = eina_binbuf_string_get(batch.wire);
+        while (length > 0)
+          {
+             size_t step = length > 100 ? 100 : length;
+             int still;
+
+             still = eet_connection_received(conn, p, step);
+             fail_if((size_t)still >= step);
+             p += step - still;
+             length -= step - still;
+          }
+        fail_if(batch.reads != 16);
+        fail_if(!eet_connection_empty(conn));
+
+        fail_if(eet_connection_close(conn, NULL) != &batch);
+        eina_binbuf_free(batch.wire);
+     }
+
+   eet_data_descriptor_free(batch.edd);
+}
+EFL_END_TEST
+
 void eet_test_connection(TCase *tc)
 {
    tcase_add_test(tc, eet_test_connection_check);
+   tcase_add_test(tc, eet_test_connection_batch);
 }
@@ -782,6 +782,85 @@ EFL_START_TEST(eet_test_data_hash_value)
 } /* EFL_START_TEST */
 EFL_END_TEST
 
+EFL_START_TEST(eet_test_data_element_order)
+{
+   Eet_Data_Descriptor_Class eddc;
+   Eet_Data_Descriptor *writer;
+   Eet_Data_Descriptor *reader;
+   Eet_St1 st1, *result;
+   Eet_File *ef;
+   char *file;
+   void *blob;
+   int size;
+   int tmpfd;
+   int i;
+
+   EET_EINA_FILE_DATA_DESCRIPTOR_CLASS_SET(&eddc, Eet_St1);
+   writer = eet_data_descriptor_file_new(&eddc);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(writer, Eet_St1, "val1", val1, EET_T_DOUBLE);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(writer, Eet_St1, "stuff", stuff, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(writer, Eet_St1, "s1", s1, EET_T_STRING);
+
+   /* Same fields, declared in another order than they were encoded in */
+   reader = eet_data_descriptor_file_new(&eddc);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(reader, Eet_St1, "s1", s1, EET_T_STRING);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(reader, Eet_St1, "stuff", stuff, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(reader, Eet_St1, "val1", val1, EET_T_DOUBLE);
+
+   st1.val1 = EET_TEST_DOUBLE;
+   st1.stuff = EET_TEST_INT;
+   st1.s1 = EET_TEST_STRING;
+
+   blob = eet_data_descriptor_encode(writer, &st1, &size);
+   fail_if((!blob) || (size <= 0));
+
+   result = eet_data_descriptor_decode(reader, blob, size);
+   fail_if(!result);
+   fail_if(result->val1 != EET_TEST_DOUBLE);
+   fail_if(result->stuff != EET_TEST_INT);
+   fail_if(strcmp(result->s1, EET_TEST_STRING));
+   free(result);
+   free(blob);
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_data_write(ef, writer, "st1", &st1, 0));
+   eet_close(ef);
+
+   /* Read twice, the second time names are matched from the dictionary */
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+   for (i = 0; i < 2; i++)
+     {
+        result = eet_data_read(ef, reader, "st1");
+        fail_if(!result);
+        fail_if(result->val1 != EET_TEST_DOUBLE);
+        fail_if(result->stuff != EET_TEST_INT);
+        fail_if(strcmp(result->s1, EET_TEST_STRING));
+        free(result);
+
+        result = eet_data_read(ef, writer, "st1");
+        fail_if(!result);
+        fail_if(result->val1 != EET_TEST_DOUBLE);
+        fail_if(result->stuff != EET_TEST_INT);
+        fail_if(strcmp(result->s1, EET_TEST_STRING));
+        free(result);
+     }
+   eet_close(ef);
+
+   fail_if(unlink(file) != 0);
+   free(file);
+
+   eet_data_descriptor_free(reader);
+   eet_data_descriptor_free(writer);
+}
+EFL_END_TEST
+
 void eet_test_data(TCase *tc)
 {
    tcase_add_test(tc, eet_test_data_basic_type_encoding_decoding);
@@ -792,4 +871,5 @@ void eet_test_data(TCase *tc)
    tcase_add_test(tc, eet_test_data_union);
    tcase_add_test(tc, eet_test_data_variant);
    tcase_add_test(tc, eet_test_data_hash_value);
+   tcase_add_test(tc, eet_test_data_element_order);
 }
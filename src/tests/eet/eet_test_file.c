@@ -3,6 +3,7 @@
 #endif
 
 #include <stdlib.h>
+#include <stdio.h>
 #include <unistd.h>
 
 #include <Eina.h>
@@ -278,6 +279,132 @@ EFL_START_TEST(eet_test_file_data)
 }
 EFL_END_TEST
 
+static int _eet_test_list_free_count = 0;
+
+static void *
+_eet_test_list_free(void *list)
+{
+   _eet_test_list_free_count++;
+   return eina_list_free(list);
+}
+
+EFL_START_TEST(eet_test_file_data_arena)
+{
+   Eet_Data_Descriptor *edd;
+   Eet_Test_Ex_Type *result;
+   Eet_Data_Descriptor_Class eddc;
+   Eet_Test_Ex_Type etbt;
+   Eet_Data_Arena *arena;
+   Eet_Dictionary *ed;
+   Eet_File *ef;
+   char *file;
+   int test;
+   int tmpfd;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   eet_test_ex_set(&etbt, 0);
+   etbt.list = eina_list_prepend(etbt.list, eet_test_ex_set(NULL, 1));
+   etbt.list = eina_list_prepend(etbt.list, eet_test_ex_set(NULL, 1));
+   etbt.hash = eina_hash_string_superfast_new(NULL);
+   eina_hash_add(etbt.hash, EET_TEST_KEY1, eet_test_ex_set(NULL, 2));
+   etbt.ilist = eina_list_prepend(etbt.ilist, &i42);
+   etbt.ihash = eina_hash_string_superfast_new(NULL);
+   eina_hash_add(etbt.ihash, EET_TEST_KEY1, &i7);
+   etbt.slist = eina_list_prepend(NULL, "test");
+   etbt.shash = eina_hash_string_superfast_new(NULL);
+   eina_hash_add(etbt.shash, EET_TEST_KEY1, "test");
+   memset(&etbt.charray, 0, sizeof(etbt.charray));
+   etbt.charray[0] = "test";
+
+   eet_test_setup_eddc(&eddc);
+   eddc.name = "Eet_Test_Ex_Type";
+   eddc.size = sizeof(Eet_Test_Ex_Type);
+
+   edd = eet_data_descriptor_file_new(&eddc);
+   fail_if(!edd);
+
+   eet_build_ex_descriptor(edd, EINA_FALSE);
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_data_write(ef, edd, EET_TEST_FILE_KEY1, &etbt, 0));
+   fail_if(!eet_data_write(ef, edd, EET_TEST_FILE_KEY2, &etbt, 1));
+   eet_close(ef);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+
+   fail_if(eet_data_read_arena(ef, edd, "plop", &arena) != NULL);
+   fail_if(arena != NULL);
+
+   /* Compressed entries decode the same, only strings are borrowed */
+   result = eet_data_read_arena(ef, edd, EET_TEST_FILE_KEY2, &arena);
+   fail_if(!result);
+   fail_if(!arena);
+   fail_if(eet_test_ex_check(result, 0, EINA_FALSE) != 0);
+   eet_data_arena_free(arena);
+
+   result = eet_data_read_arena(ef, edd, EET_TEST_FILE_KEY1, &arena);
+   fail_if(!result);
+   fail_if(!arena);
+
+   ed = eet_dictionary_get(ef);
+   fail_if(!eet_dictionary_string_check(ed, result->str));
+   fail_if(eet_dictionary_string_check(ed, result->istr));
+
+   /* The arena keeps the strings of the file around */
+   eet_close(ef);
+
+   fail_if(eet_test_ex_check(result, 0, EINA_FALSE) != 0);
+   fail_if(eet_test_ex_check(eina_list_data_get(result->list), 1, EINA_FALSE) != 0);
+   fail_if(eina_list_data_get(result->ilist) == NULL);
+   fail_if(*((int *)eina_list_data_get(result->ilist)) != 42);
+   fail_if(eina_list_data_get(result->slist) == NULL);
+   fail_if(strcmp(eina_list_data_get(result->slist), "test") != 0);
+   fail_if(eina_hash_find(result->shash, EET_TEST_KEY1) == NULL);
+   fail_if(strcmp(eina_hash_find(result->shash, EET_TEST_KEY1), "test") != 0);
+   fail_if(strcmp(result->charray[0], "test") != 0);
+
+   test = 0;
+   if (result->hash)
+     eina_hash_foreach(result->hash, func, &test);
+   fail_if(test != 0);
+
+   eet_data_arena_free(arena);
+   eet_data_arena_free(NULL);
+
+   eet_data_descriptor_free(edd);
+
+   /* A list whose head changes on every insertion is only freed once */
+   eddc.func.list_append = (void *)eina_list_prepend;
+   eddc.func.list_free = _eet_test_list_free;
+   edd = eet_data_descriptor_file_new(&eddc);
+   fail_if(!edd);
+
+   eet_build_ex_descriptor(edd, EINA_FALSE);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+
+   result = eet_data_read_arena(ef, edd, EET_TEST_FILE_KEY1, &arena);
+   fail_if(!result);
+   fail_if(!arena);
+   fail_if(eina_list_count(result->list) != 2);
+   eet_close(ef);
+   eet_data_arena_free(arena);
+   /* list, ilist and slist */
+   fail_if(_eet_test_list_free_count != 3);
+
+   eet_data_descriptor_free(edd);
+   fail_if(unlink(file) != 0);
+   free(file);
+}
+EFL_END_TEST
+
 EFL_START_TEST(eet_test_file_data_dump)
 {
    Eet_Data_Descriptor *edd;
@@ -448,10 +575,576 @@ EFL_START_TEST(eet_test_file_fp)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eet_test_file_compression_dictionary)
+{
+   char buffer[1024];
+   char key[64];
+   char *file;
+   char *test;
+   Eet_File *ef;
+   int size;
+   int tmpfd;
+   int i;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_compression_dictionary_train(ef, 4096));
+
+   /* Entries that look alike, so that a dictionary can be trained */
+   for (i = 0; i < 256; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(buffer, sizeof (buffer),
+                 "part { name: \"part%i\"; type: RECT; description { state: \"default\" 0.0;"
+                 " color: %i %i %i 255; rel1.relative: 0.%i 0.0; } }",
+                 i, i, 255 - i, i / 2, i % 10);
+        fail_if(!eet_write(ef, key, buffer, strlen(buffer) + 1, EET_COMPRESSION_ZSTD));
+     }
+
+   /* Entries are still readable before being compressed on flush */
+   test = eet_read(ef, "keys/42", &size);
+   fail_if(!test);
+   fail_if(strncmp(test, "part { name: \"part42\";", 22));
+   free(test);
+
+   eet_close(ef);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+
+   for (i = 0; i < 256; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(buffer, sizeof (buffer),
+                 "part { name: \"part%i\"; type: RECT; description { state: \"default\" 0.0;"
+                 " color: %i %i %i 255; rel1.relative: 0.%i 0.0; } }",
+                 i, i, 255 - i, i / 2, i % 10);
+        test = eet_read(ef, key, &size);
+        fail_if(!test);
+        fail_if(size != (int)strlen(buffer) + 1);
+        fail_if(memcmp(test, buffer, size));
+        free(test);
+     }
+
+   eet_close(ef);
+
+   fail_if(unlink(file) != 0);
+   free(file);
+}
+EFL_END_TEST
+
+static Eina_Binbuf *
+_eet_test_file_content_get(const char *file)
+{
+   Eina_Binbuf *content;
+   Eina_File *f;
+   void *m;
+
+   f = eina_file_open(file, EINA_FALSE);
+   fail_if(!f);
+   m = eina_file_map_all(f, EINA_FILE_WILLNEED);
+   fail_if(!m);
+
+   content = eina_binbuf_new();
+   eina_binbuf_append_length(content, m, eina_file_size_get(f));
+
+   eina_file_map_free(f, m);
+   eina_file_close(f);
+
+   return content;
+}
+
+static Eina_Binbuf *
+_eet_test_file_compression_threads_write(const char *file, int threads)
+{
+   char buffer[1024];
+   char key[64];
+   Eet_File *ef;
+   int i;
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_compression_threads_set(ef, threads));
+
+   for (i = 0; i < 128; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i %i %i",
+                 i, i * 3, i * 5, i * 7);
+        fail_if(!eet_write(ef, key, buffer, strlen(buffer) + 1, (i % 3) ? EET_COMPRESSION_DEFAULT : EET_COMPRESSION_SUPERFAST));
+     }
+
+   eet_close(ef);
+
+   return _eet_test_file_content_get(file);
+}
+
+EFL_START_TEST(eet_test_file_compression_threads)
+{
+   Eina_Binbuf *serial;
+   Eina_Binbuf *parallel;
+   char *file;
+   int tmpfd;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   serial = _eet_test_file_compression_threads_write(file, 1);
+   parallel = _eet_test_file_compression_threads_write(file, 4);
+
+   /* The number of threads must not change the output */
+   fail_if(eina_binbuf_length_get(serial) != eina_binbuf_length_get(parallel));
+   fail_if(memcmp(eina_binbuf_string_get(serial), eina_binbuf_string_get(parallel),
+                  eina_binbuf_length_get(serial)));
+
+   eina_binbuf_free(serial);
+   eina_binbuf_free(parallel);
+
+   fail_if(unlink(file) != 0);
+   free(file);
+}
+EFL_END_TEST
+
+static void
+_eet_test_file_content_set(const char *file, const Eina_Binbuf *content, size_t length)
+{
+   FILE *fp;
+
+   fp = fopen(file, "wb");
+   fail_if(!fp);
+   fail_if(fwrite(eina_binbuf_string_get(content), length, 1, fp) != 1);
+   fail_if(fclose(fp));
+}
+
+static void
+_eet_test_file_append_check(const char *file, int generation)
+{
+   char buffer[1024];
+   char key[64];
+   Eet_File *ef;
+   char *test;
+   int size;
+   int i;
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+
+   for (i = 0; i < 128; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        test = eet_read(ef, key, &size);
+
+        /* the first update deletes keys/1, each one rewrites keys/0 */
+        if ((i == 1) && (generation > 0))
+          {
+             fail_if(!!test);
+             continue;
+          }
+
+        snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i",
+                 i, i == 0 ? generation : 0);
+        fail_if(!test);
+        fail_if(size != (int)strlen(buffer) + 1);
+        fail_if(memcmp(test, buffer, size));
+        free(test);
+     }
+
+   test = eet_read(ef, "keys/new", &size);
+   fail_if((generation > 0) != !!test);
+   free(test);
+
+   eet_close(ef);
+}
+
+EFL_START_TEST(eet_test_file_append)
+{
+   Eina_Binbuf *before;
+   Eina_Binbuf *after;
+   char buffer[1024];
+   char key[64];
+   Eet_File *ef;
+   char *file;
+   size_t length;
+   int tmpfd;
+   int i;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+   fail_if(eet_file_append_set(ef, EINA_TRUE));
+
+   for (i = 0; i < 128; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", i, 0);
+        fail_if(!eet_write(ef, key, buffer, strlen(buffer) + 1, i % 2));
+     }
+
+   eet_close(ef);
+   _eet_test_file_append_check(file, 0);
+   before = _eet_test_file_content_get(file);
+
+   /* Update a few entries, twice in the same session */
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_file_append_set(ef, EINA_TRUE));
+
+   snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", 0, 1);
+   fail_if(!eet_write(ef, "keys/0", buffer, strlen(buffer) + 1, 1));
+   fail_if(!eet_write(ef, "keys/new", buffer, strlen(buffer) + 1, 0));
+   fail_if(!eet_delete(ef, "keys/1"));
+   fail_if(eet_sync(ef) != EET_ERROR_NONE);
+
+   snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", 0, 2);
+   fail_if(!eet_write(ef, "keys/0", buffer, strlen(buffer) + 1, 1));
+
+   eet_close(ef);
+   _eet_test_file_append_check(file, 2);
+   after = _eet_test_file_content_get(file);
+
+   /* Nothing already there was moved */
+   length = eina_binbuf_length_get(before);
+   fail_if(eina_binbuf_length_get(after) <= length);
+   fail_if(memcmp(eina_binbuf_string_get(before) + 12,
+                  eina_binbuf_string_get(after) + 12, length - 12));
+
+   /* A crash anywhere before the header is updated keeps the old content */
+   _eet_test_file_content_set(file, before, length);
+   _eet_test_file_append_check(file, 0);
+
+   eina_binbuf_remove(after, 0, 12);
+   eina_binbuf_insert_length(after, eina_binbuf_string_get(before), 12, 0);
+   _eet_test_file_content_set(file, after, length + 40);
+   _eet_test_file_append_check(file, 0);
+   _eet_test_file_content_set(file, after, eina_binbuf_length_get(after));
+   _eet_test_file_append_check(file, 0);
+
+   eina_binbuf_free(before);
+   eina_binbuf_free(after);
+
+   fail_if(unlink(file) != 0);
+   free(file);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eet_test_file_append_replaced)
+{
+   char buffer[1024];
+   char key[64];
+   Eet_File *ef;
+   char *other;
+   char *file;
+   int tmpfd;
+   int i;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+   other = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+   fail_if(-1 == (tmpfd = mkstemp(other)));
+   fail_if(!!close(tmpfd));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+   for (i = 0; i < 128; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", i, 0);
+        fail_if(!eet_write(ef, key, buffer, strlen(buffer) + 1, i % 2));
+     }
+   eet_close(ef);
+
+   /* Same number of entries, so the same header, but another layout */
+   ef = eet_open(other, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+   for (i = 0; i < 128; i++)
+     {
+        snprintf(key, sizeof (key), "other/keys/%i", i);
+        snprintf(buffer, sizeof (buffer), "%i: Another string %i", i, i * 7);
+        fail_if(!eet_write(ef, key, buffer, strlen(buffer) + 1, 0));
+     }
+   eet_close(ef);
+
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_file_append_set(ef, EINA_TRUE));
+
+   snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", 0, 1);
+   fail_if(!eet_write(ef, "keys/0", buffer, strlen(buffer) + 1, 1));
+   fail_if(!eet_write(ef, "keys/new", buffer, strlen(buffer) + 1, 0));
+   fail_if(!eet_delete(ef, "keys/1"));
+
+   /* Replaced behind our back, it has to be rewritten as a whole */
+   fail_if(rename(other, file) != 0);
+   eet_close(ef);
+
+   _eet_test_file_append_check(file, 1);
+
+   fail_if(unlink(file) != 0);
+   free(other);
+   free(file);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eet_test_file_compact)
+{
+   Eina_Binbuf *content;
+   char buffer[1024];
+   char key[64];
+   Eet_File *ef;
+   char *file;
+   size_t length;
+   int tmpfd;
+   int i;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+
+   for (i = 0; i < 128; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", i, 0);
+        fail_if(!eet_write(ef, key, buffer, strlen(buffer) + 1, 0));
+     }
+
+   eet_close(ef);
+
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_file_append_set(ef, EINA_TRUE));
+
+   snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", 0, 2);
+   fail_if(!eet_write(ef, "keys/0", buffer, strlen(buffer) + 1, 0));
+   fail_if(!eet_write(ef, "keys/new", buffer, strlen(buffer) + 1, 0));
+   fail_if(!eet_delete(ef, "keys/1"));
+   fail_if(eet_sync(ef) != EET_ERROR_NONE);
+
+   content = _eet_test_file_content_get(file);
+   length = eina_binbuf_length_get(content);
+   eina_binbuf_free(content);
+
+   /* Compacting drops the replaced entries and the old directory */
+   fail_if(eet_compact(ef) != EET_ERROR_NONE);
+   eet_close(ef);
+
+   content = _eet_test_file_content_get(file);
+   fail_if(eina_binbuf_length_get(content) >= length);
+   eina_binbuf_free(content);
+
+   _eet_test_file_append_check(file, 2);
+
+   fail_if(unlink(file) != 0);
+   free(file);
+}
+EFL_END_TEST
+
+static void
+_eet_test_file_index_check(const char *file, int count, Eina_Bool updated)
+{
+   char buffer[1024];
+   char key[64];
+   Eet_File *ef;
+   char **list;
+   char *data;
+   int size;
+   int i;
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+
+   for (i = 0; i < count; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        data = eet_read(ef, key, &size);
+        if (updated && (i == 1))
+          {
+             fail_if(data != NULL);
+             continue;
+          }
+        snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i",
+                 i, (updated && !i) ? 2 : 0);
+        fail_if(!data);
+        fail_if(size != (int)strlen(buffer) + 1);
+        fail_if(strcmp(data, buffer));
+        free(data);
+     }
+
+   fail_if(eet_read(ef, "keys/missing", &size) != NULL);
+   fail_if(eet_read(ef, "", &size) != NULL);
+   data = eet_read(ef, "keys/new", &size);
+   fail_if(updated != !!data);
+   free(data);
+
+   /* The index is an entry like the others, updates drop one key and add
+      one */
+   fail_if(eet_num_entries(ef) != count + 1);
+   list = eet_list(ef, "keys/*", &size);
+   fail_if(size != count);
+   free(list);
+
+   eet_close(ef);
+}
+
+EFL_START_TEST(eet_test_file_directory_index)
+{
+   char buffer[1024];
+   char key[64];
+   Eet_File *ef;
+   char *file;
+   int tmpfd;
+   int i;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_directory_index_set(ef, EINA_TRUE));
+
+   for (i = 0; i < 1000; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", i, 0);
+        fail_if(!eet_write(ef, key, buffer, strlen(buffer) + 1, i & 1));
+     }
+
+   eet_close(ef);
+
+   _eet_test_file_index_check(file, 1000, EINA_FALSE);
+
+   /* Kept up to date by later writes, appended or not */
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_file_append_set(ef, EINA_TRUE));
+
+   snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", 0, 2);
+   fail_if(!eet_write(ef, "keys/0", buffer, strlen(buffer) + 1, 0));
+   fail_if(!eet_write(ef, "keys/new", buffer, strlen(buffer) + 1, 0));
+   fail_if(!eet_delete(ef, "keys/1"));
+   eet_close(ef);
+
+   _eet_test_file_index_check(file, 1000, EINA_TRUE);
+
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(eet_compact(ef) != EET_ERROR_NONE);
+   eet_close(ef);
+
+   _eet_test_file_index_check(file, 1000, EINA_TRUE);
+
+   fail_if(unlink(file) != 0);
+   free(file);
+}
+EFL_END_TEST
+
+static void *
+_eet_test_file_threads_reader(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Eet_File *ef = data;
+   char buffer[1024];
+   char key[64];
+   char *test;
+   int size;
+   int i, j;
+
+   for (j = 0; j < 16; j++)
+     for (i = 0; i < 128; i++)
+       {
+          snprintf(key, sizeof (key), "keys/%i", i);
+          snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", i, 0);
+
+          test = eet_read(ef, key, &size);
+          if ((!test) || (size != (int)strlen(buffer) + 1) ||
+              (memcmp(test, buffer, size)))
+            {
+               free(test);
+               return (void *)1;
+            }
+          free(test);
+       }
+
+   return NULL;
+}
+
+EFL_START_TEST(eet_test_file_threads_read)
+{
+   Eina_Thread threads[4];
+   char buffer[1024];
+   char key[64];
+   Eet_File *ef;
+   char *file;
+   void *ret;
+   int tmpfd;
+   int i;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+
+   for (i = 0; i < 128; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(buffer, sizeof (buffer), "%i: Here is a string of data to save ! %i", i, 0);
+        fail_if(!eet_write(ef, key, buffer, strlen(buffer) + 1, i % 3));
+     }
+
+   eet_close(ef);
+
+   /* Read only files are shared by all threads without locking */
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+
+   for (i = 0; i < 4; i++)
+     fail_if(!eina_thread_create(&threads[i], EINA_THREAD_NORMAL, -1,
+                                 _eet_test_file_threads_reader, ef));
+   for (i = 0; i < 4; i++)
+     {
+        ret = eina_thread_join(threads[i]);
+        fail_if(ret != NULL);
+     }
+
+   eet_close(ef);
+
+   fail_if(unlink(file) != 0);
+   free(file);
+}
+EFL_END_TEST
+
 void eet_test_file(TCase *tc)
 {
    tcase_add_test(tc, eet_test_file_simple_write);
    tcase_add_test(tc, eet_test_file_data);
+   tcase_add_test(tc, eet_test_file_data_arena);
    tcase_add_test(tc, eet_test_file_data_dump);
    tcase_add_test(tc, eet_test_file_fp);
+   tcase_add_test(tc, eet_test_file_compression_dictionary);
+   tcase_add_test(tc, eet_test_file_compression_threads);
+   tcase_add_test(tc, eet_test_file_append);
+   tcase_add_test(tc, eet_test_file_append_replaced);
+   tcase_add_test(tc, eet_test_file_compact);
+   tcase_add_test(tc, eet_test_file_directory_index);
+   tcase_add_test(tc, eet_test_file_threads_read);
 }
@@ -3,10 +3,12 @@
 #endif
 
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <Eina.h>
 #include <Eet.h>
+#include <Emile.h>
 
 #include "eet_suite.h"
 #include "eet_test_common.h"
@@ -489,8 +491,112 @@ EFL_START_TEST(eet_test_image_small)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eet_test_image_predicted)
+{
+   unsigned int image[37 * 29];
+   unsigned int region[10 * 7];
+   unsigned int *data;
+   void *encoded, *again;
+   unsigned int w, h, x, y;
+   int alpha;
+   int compression;
+   int quality;
+   Eet_Image_Encoding lossy;
+   int size, size2;
+
+   /* Gradients, flat areas and noise, on a size that is not a multiple
+      of any vector width */
+   for (y = 0; y < 29; y++)
+     for (x = 0; x < 37; x++)
+       {
+          unsigned int a = x < 20 ? 0xff : (x * 7) & 0xff;
+
+          image[y * 37 + x] = (a << 24) | ((x * 5) << 16) | ((y * 3) << 8)
+            | (y > 20 ? (x * y * 2654435761U) >> 24 : 0x80);
+       }
+
+   encoded = eet_data_image_encode(image, &size, 37, 29, 1, 0, 0,
+                                   EET_IMAGE_LOSSLESS_PREDICTED);
+   fail_if(!encoded);
+
+   data = eet_data_image_decode(encoded, size, &w, &h, &alpha,
+                                &compression, &quality, &lossy);
+   fail_if(!data);
+   fail_if(w != 37 || h != 29 || !alpha);
+   fail_if(lossy != EET_IMAGE_LOSSLESS_PREDICTED);
+   fail_if(memcmp(data, image, sizeof (image)));
+   free(data);
+
+   fail_if(!eet_data_image_decode_to_surface(encoded, size, 3, 17, region,
+                                             10, 7, 10 * 4, &alpha,
+                                             &compression, &quality, &lossy));
+   for (y = 0; y < 7; y++)
+     fail_if(memcmp(region + y * 10, image + (y + 17) * 37 + 3, 10 * 4));
+   free(encoded);
+
+   /* Bands are encoded in parallel, the result must not depend on it */
+   encoded = eet_data_image_encode(image, &size, 37, 29, 1, 0, 50,
+                                   EET_IMAGE_ETC2_RGBA);
+   again = eet_data_image_encode(image, &size2, 37, 29, 1, 0, 50,
+                                 EET_IMAGE_ETC2_RGBA);
+   fail_if(!encoded || !again);
+   fail_if(size != size2);
+   fail_if(memcmp(encoded, again, size));
+   free(encoded);
+   free(again);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eet_test_image_etc_cache)
+{
+   unsigned int image[300 * 200];
+   unsigned int *data, *cached;
+   void *encoded;
+   unsigned int w, h, x, y;
+   int alpha;
+   int compression;
+   int quality;
+   Eet_Image_Encoding lossy;
+   int size;
+
+   for (y = 0; y < 200; y++)
+     for (x = 0; x < 300; x++)
+       image[y * 300 + x] = 0xff000000 | ((x & 0xff) << 16) | ((y & 0xff) << 8)
+         | ((x * y * 2654435761U) >> 24);
+
+   encoded = eet_data_image_encode(image, &size, 300, 200, 0, 0, 50,
+                                   EET_IMAGE_ETC2_RGB);
+   fail_if(!encoded);
+
+   /* The second decode comes from the cache, the third skips it */
+   data = eet_data_image_decode(encoded, size, &w, &h, &alpha,
+                                &compression, &quality, &lossy);
+   fail_if(!data);
+   fail_if(w != 300 || h != 200);
+   cached = eet_data_image_decode(encoded, size, &w, &h, &alpha,
+                                  &compression, &quality, &lossy);
+   fail_if(!cached);
+   fail_if(memcmp(data, cached, 300 * 200 * 4));
+   free(cached);
+
+   emile_image_tgv_cache_size_set(0);
+   fail_if(emile_image_tgv_cache_size_get() != 0);
+   cached = eet_data_image_decode(encoded, size, &w, &h, &alpha,
+                                  &compression, &quality, &lossy);
+   fail_if(!cached);
+   fail_if(memcmp(data, cached, 300 * 200 * 4));
+   free(cached);
+   emile_image_tgv_cache_size_set(4 * 1024 * 1024);
+
+   free(data);
+   free(encoded);
+}
+EFL_END_TEST
+
 void eet_test_image(TCase *tc)
 {
    tcase_add_test(tc, eet_test_image_normal);
    tcase_add_test(tc, eet_test_image_small);
+   tcase_add_test(tc, eet_test_image_predicted);
+   tcase_add_test(tc, eet_test_image_etc_cache);
 }
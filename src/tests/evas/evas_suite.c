@@ -25,6 +25,7 @@ static const Efl_Test_Case etc[] = {
   { "Meshes", evas_test_mesh2 },
   { "Meshes", evas_test_mesh3 },
   { "Masking", evas_test_mask },
+  { "Vector", evas_test_vg },
   { "Evas GL", evas_test_evasgl },
   { "Object Smart", evas_test_object_smart },
   { "Matrix", evas_test_matrix },
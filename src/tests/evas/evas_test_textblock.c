@@ -2326,6 +2326,68 @@ EFL_START_TEST(evas_textblock_wrapping)
 }
 EFL_END_TEST
 
+/* Width changes only relayout paragraphs whose lines depend on the width */
+EFL_START_TEST(evas_textblock_relayout_width)
+{
+   Evas_Coord bw, bh, w, h, nh, cx, cy, cx2, cy2;
+   START_TB_TEST();
+
+   evas_object_textblock_text_markup_set(tb, "aaaa");
+   evas_object_textblock_size_formatted_get(tb, &bw, &bh);
+
+   evas_object_textblock_text_markup_set(tb, "aaaa aa<ps/>aaaa");
+   evas_textblock_cursor_format_prepend(cur, "+ wrap=word");
+   evas_object_resize(tb, 10 * bw, 10 * bh);
+   evas_object_textblock_size_formatted_get(tb, &w, &h);
+   fail_if(w <= bw);
+
+   evas_textblock_cursor_paragraph_last(cur);
+   evas_textblock_cursor_geometry_get(cur, &cx, &cy, NULL, NULL, NULL,
+         EVAS_TEXTBLOCK_CURSOR_BEFORE);
+
+   /* Growing keeps every line as is */
+   evas_object_resize(tb, 20 * bw, 10 * bh);
+   evas_object_textblock_size_formatted_get(tb, &w, &nh);
+   fail_if(nh != h);
+   evas_textblock_cursor_geometry_get(cur, &cx2, &cy2, NULL, NULL, NULL,
+         EVAS_TEXTBLOCK_CURSOR_BEFORE);
+   fail_if((cx != cx2) || (cy != cy2));
+
+   /* Shrinking below what the first paragraph needs wraps it */
+   evas_object_resize(tb, bw, 10 * bh);
+   evas_object_textblock_size_formatted_get(tb, &w, &nh);
+   fail_if(w != bw);
+   fail_if(nh <= h);
+   evas_textblock_cursor_geometry_get(cur, &cx2, &cy2, NULL, NULL, NULL,
+         EVAS_TEXTBLOCK_CURSOR_BEFORE);
+   fail_if(cy2 <= cy);
+
+   /* And growing back unwraps it again */
+   evas_object_resize(tb, 10 * bw, 10 * bh);
+   evas_object_textblock_size_formatted_get(tb, &w, &nh);
+   fail_if(nh != h);
+   evas_textblock_cursor_geometry_get(cur, &cx2, &cy2, NULL, NULL, NULL,
+         EVAS_TEXTBLOCK_CURSOR_BEFORE);
+   fail_if((cx != cx2) || (cy != cy2));
+
+   /* Right aligned lines move with the width */
+   evas_textblock_cursor_paragraph_first(cur);
+   evas_textblock_cursor_format_prepend(cur, "+ align=right");
+   evas_textblock_cursor_paragraph_last(cur);
+   evas_object_textblock_size_formatted_get(tb, &w, &h);
+   evas_textblock_cursor_geometry_get(cur, &cx, &cy, NULL, NULL, NULL,
+         EVAS_TEXTBLOCK_CURSOR_BEFORE);
+   evas_object_resize(tb, 20 * bw, 10 * bh);
+   evas_object_textblock_size_formatted_get(tb, &w, &h);
+   evas_textblock_cursor_geometry_get(cur, &cx2, &cy2, NULL, NULL, NULL,
+         EVAS_TEXTBLOCK_CURSOR_BEFORE);
+   fail_if(cx2 <= cx);
+   fail_if(cy != cy2);
+
+   END_TB_TEST();
+}
+EFL_END_TEST
+
 /* Various textblock stuff */
 EFL_START_TEST(evas_textblock_various)
 {
@@ -5034,6 +5096,7 @@ void evas_test_textblock(TCase *tc)
    tcase_add_test(tc, evas_textblock_geometries);
    tcase_add_test(tc, evas_textblock_various);
    tcase_add_test(tc, evas_textblock_wrapping);
+   tcase_add_test(tc, evas_textblock_relayout_width);
    tcase_add_test(tc, evas_textblock_items);
    tcase_add_test(tc, evas_textblock_delete);
    tcase_add_test(tc, evas_textblock_obstacle);
@@ -0,0 +1,175 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Evas.h>
+#include <Ecore_Evas.h>
+
+#include "evas_suite.h"
+
+#define TESTS_VG_DIR TESTS_SRC_DIR"/vg"
+
+#if defined(BUILD_ENGINE_BUFFER) && defined(BUILD_VG_LOADER_JSON)
+
+#define W 200
+#define H 100
+#define FRAMES 6
+
+/* Renders some frames of the animation, each with a small rectangle moving
+ * over the corner of the vector object, so that the update regions of the
+ * frame cut through it and its render function is called more than once. */
+static void
+_vg_frames_render(Ecore_Evas *ee, Evas_Object *vg, Evas_Object *rect,
+                  unsigned int **pixels)
+{
+   int i;
+
+   for (i = 0; i < FRAMES; i++)
+     {
+        evas_object_vg_animated_frame_set(vg, i * 3);
+        evas_object_move(rect, 90 - (i % 2) * 4, 90 - (i % 2) * 4);
+        ecore_evas_manual_render(ee);
+
+        if (!pixels[i])
+          {
+             pixels[i] = malloc(W * H * 4);
+             memcpy(pixels[i], ecore_evas_buffer_pixels_get(ee), W * H * 4);
+          }
+        else
+          ck_assert(!memcmp(pixels[i], ecore_evas_buffer_pixels_get(ee), W * H * 4));
+     }
+}
+
+EFL_START_TEST(evas_vg_frame_cache_regions)
+{
+   unsigned int *pixels[FRAMES] = { NULL };
+   Evas_Object *vg, *rect;
+   Ecore_Evas *ee;
+   Evas *e;
+   int i;
+
+   ee = ecore_evas_buffer_new(W, H);
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+
+   rect = evas_object_rectangle_add(e);
+   evas_object_color_set(rect, 0, 0, 255, 255);
+   evas_object_resize(rect, 20, 20);
+   evas_object_show(rect);
+
+   /* Reference, every frame rendered as it is shown */
+   vg = evas_object_vg_add(e);
+   ck_assert(evas_object_vg_file_set(vg, TESTS_VG_DIR"/emoji_wink.json", NULL));
+   ck_assert_int_ge(evas_object_vg_animated_frame_count_get(vg), FRAMES * 3);
+   evas_object_resize(vg, 100, 100);
+   evas_object_stack_below(vg, rect);
+   evas_object_show(vg);
+   _vg_frames_render(ee, vg, rect, pixels);
+   evas_object_del(vg);
+
+   /* The same frames drawn into the frame cache surface, then expanded
+    * from the kept frames */
+   vg = evas_object_vg_add(e);
+   ck_assert(evas_object_vg_file_set(vg, TESTS_VG_DIR"/emoji_wink.json", NULL));
+   efl_canvas_vg_object_frame_cache_mode_set(vg, EFL_CANVAS_VG_FRAME_CACHE_MODE_ALL);
+   evas_object_resize(vg, 100, 100);
+   evas_object_stack_below(vg, rect);
+   evas_object_show(vg);
+   _vg_frames_render(ee, vg, rect, pixels);
+   _vg_frames_render(ee, vg, rect, pixels);
+   evas_object_del(vg);
+
+   for (i = 0; i < FRAMES; i++)
+     free(pixels[i]);
+   evas_object_del(rect);
+   ecore_evas_free(ee);
+}
+EFL_END_TEST
+
+/* The matte target only lives from frame 10, its matte source from 0. The
+ * source must not be drawn on its own before the target shows. */
+EFL_START_TEST(evas_vg_matte_target_out_of_range)
+{
+   unsigned int *pixels;
+   Evas_Object *vg, *bg;
+   Ecore_Evas *ee;
+   Evas *e;
+
+   ee = ecore_evas_buffer_new(100, 100);
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+
+   bg = evas_object_rectangle_add(e);
+   evas_object_color_set(bg, 0, 0, 0, 255);
+   evas_object_resize(bg, 100, 100);
+   evas_object_show(bg);
+
+   vg = evas_object_vg_add(e);
+   ck_assert(evas_object_vg_file_set(vg, TESTS_VG_DIR"/matte_out_of_range.json", NULL));
+   evas_object_resize(vg, 100, 100);
+   evas_object_show(vg);
+
+   evas_object_vg_animated_frame_set(vg, 0);
+   ecore_evas_manual_render(ee);
+   pixels = (unsigned int *) ecore_evas_buffer_pixels_get(ee);
+   ck_assert_int_eq(pixels[50 * 100 + 50], 0xff000000);
+
+   evas_object_vg_animated_frame_set(vg, 15);
+   ecore_evas_manual_render(ee);
+   pixels = (unsigned int *) ecore_evas_buffer_pixels_get(ee);
+   ck_assert_int_eq(pixels[50 * 100 + 50], 0xff00ff00);
+
+   evas_object_del(vg);
+   evas_object_del(bg);
+   ecore_evas_free(ee);
+}
+EFL_END_TEST
+
+/* The bottom layer only lives from frame 10, it must still be drawn below
+ * the top layer that was there from the start. */
+EFL_START_TEST(evas_vg_layer_order_out_of_range)
+{
+   unsigned int *pixels;
+   Evas_Object *vg;
+   Ecore_Evas *ee;
+   Evas *e;
+
+   ee = ecore_evas_buffer_new(100, 100);
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+
+   vg = evas_object_vg_add(e);
+   ck_assert(evas_object_vg_file_set(vg, TESTS_VG_DIR"/layer_order.json", NULL));
+   evas_object_resize(vg, 100, 100);
+   evas_object_show(vg);
+
+   evas_object_vg_animated_frame_set(vg, 0);
+   ecore_evas_manual_render(ee);
+   pixels = (unsigned int *) ecore_evas_buffer_pixels_get(ee);
+   ck_assert_int_eq(pixels[50 * 100 + 50], 0xff00ff00);
+
+   evas_object_vg_animated_frame_set(vg, 15);
+   ecore_evas_manual_render(ee);
+   pixels = (unsigned int *) ecore_evas_buffer_pixels_get(ee);
+   ck_assert_int_eq(pixels[50 * 100 + 50], 0xff00ff00);
+
+   evas_object_del(vg);
+   ecore_evas_free(ee);
+}
+EFL_END_TEST
+
+#endif
+
+void evas_test_vg(TCase *tc)
+{
+#if defined(BUILD_ENGINE_BUFFER) && defined(BUILD_VG_LOADER_JSON)
+   tcase_add_test(tc, evas_vg_frame_cache_regions);
+   tcase_add_test(tc, evas_vg_matte_target_out_of_range);
+   tcase_add_test(tc, evas_vg_layer_order_out_of_range);
+#else
+   (void)tc;
+#endif
+}